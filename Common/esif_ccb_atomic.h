@@ -84,6 +84,7 @@
 # define atomic_dec(v)		(--(*(v)))
 # define atomic_add(i, v)	(*(v) += (i))
 # define atomic_sub(i, v)	(*(v) -= (i))
+# define atomic_cmpxchg(v, o, n)	(*(v) == (o) ? (*(v) = (n), (o)) : *(v))
 #endif
 
 #endif /* USER */
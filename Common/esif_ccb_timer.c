@@ -70,6 +70,14 @@
 */
 #define ESIF_TIMER_DISABLE_DELAY 50
 
+/*
+ * Number of buckets in the handle and callback handle indexes.  Timer handles
+ * are assigned sequentially, so they spread evenly across the buckets and a
+ * look-up only has to walk a chain of (count / ESIF_TMRM_INDEX_SIZE) items.
+ */
+#define ESIF_TMRM_INDEX_SIZE 64
+#define ESIF_TMRM_INDEX(handle) ((size_t)(handle) % ESIF_TMRM_INDEX_SIZE)
+
 /*
  * STRUCTURE DECLARATIONS
  */
@@ -79,6 +87,10 @@ struct esif_timer_manager {
 	u8 marked_for_delete; /* Indicates no additional timers may be created */
 	esif_ccb_lock_t mgr_lock;
 	struct esif_link_list *timer_list_ptr; /* List of initialized timers */
+
+	/* Hashed indexes of the timers in timer_list_ptr */
+	struct esif_tmrm_item *handle_index[ESIF_TMRM_INDEX_SIZE];
+	struct esif_tmrm_item *cb_handle_index[ESIF_TMRM_INDEX_SIZE];
 };
 
 struct esif_tmrm_item {
@@ -98,6 +110,10 @@ struct esif_tmrm_item {
 
 	/* List threads waiting for the timer callback to complete */
 	struct esif_link_list *destroy_list_ptr;
+
+	struct esif_link_list_node *node_ptr; /* Node in g_tmrm.timer_list_ptr */
+	struct esif_tmrm_item *next_by_handle_ptr; /* Chain in handle_index */
+	struct esif_tmrm_item *next_by_cb_handle_ptr; /* Chain in cb_handle_index */
 };
 
 
@@ -139,11 +155,16 @@ static void esif_ccb_tmrm_signal_waiters(
 	void *data_ptr
 	);
 
-static struct esif_link_list_node *esif_ccb_tmrm_find_timer_node_wlock(
+static struct esif_tmrm_item *esif_ccb_tmrm_find_timer_wlock(
 	esif_ccb_timer_handle_t handle
 	);
 
-static struct esif_link_list_node *esif_ccb_tmrm_find_timer_node_by_cb_wlock(
+static struct esif_tmrm_item *esif_ccb_tmrm_find_timer_by_cb_wlock(
+	esif_ccb_timer_handle_t cb_handle
+	);
+
+static void esif_ccb_tmrm_index_cb_handle_wlock(
+	struct esif_tmrm_item *self,
 	esif_ccb_timer_handle_t cb_handle
 	);
 
@@ -155,8 +176,8 @@ static void esif_ccb_tmrm_get_next_cb_handle_wlock(
 	esif_ccb_timer_handle_t *handle_ptr
 	);
 	
-static void esif_ccb_tmrm_destroy_timer_node_wlock(
-	struct esif_link_list_node *node_ptr
+static void esif_ccb_tmrm_destroy_timer_wlock(
+	struct esif_tmrm_item *tmrm_item_ptr
 	);
 
 
@@ -235,7 +256,16 @@ enum esif_rc esif_ccb_timer_init(
 			goto lock_exit;
 		}
 	}
-	rc = esif_link_list_add_at_back(g_tmrm.timer_list_ptr, tmrm_item_ptr);
+
+	tmrm_item_ptr->node_ptr = esif_link_list_create_node(tmrm_item_ptr);
+	if (NULL == tmrm_item_ptr->node_ptr) {
+		rc = ESIF_E_NO_MEMORY;
+		goto lock_exit;
+	}
+	esif_link_list_add_node_at_back(g_tmrm.timer_list_ptr, tmrm_item_ptr->node_ptr);
+
+	tmrm_item_ptr->next_by_handle_ptr = g_tmrm.handle_index[ESIF_TMRM_INDEX(tmrm_item_ptr->timer_handle)];
+	g_tmrm.handle_index[ESIF_TMRM_INDEX(tmrm_item_ptr->timer_handle)] = tmrm_item_ptr;
 lock_exit:
 	esif_ccb_write_unlock(&g_tmrm.mgr_lock);
 exit:
@@ -277,7 +307,6 @@ static enum esif_rc esif_ccb_timer_kill_w_event(
 {
 	enum esif_rc rc = ESIF_E_UNSPECIFIED;
 	struct esif_tmrm_item *tmrm_item_ptr = NULL;
-	struct esif_link_list_node *node_ptr = NULL;
 
 	if (NULL == timer_ptr) {
 		rc = ESIF_E_PARAMETER_IS_NULL;
@@ -289,14 +318,12 @@ static enum esif_rc esif_ccb_timer_kill_w_event(
 
 	esif_ccb_write_lock(&g_tmrm.mgr_lock);
 
-	node_ptr = esif_ccb_tmrm_find_timer_node_wlock(timer_ptr->timer_handle);
-	if ((NULL == node_ptr) || (NULL == node_ptr->data_ptr)) {
+	tmrm_item_ptr = esif_ccb_tmrm_find_timer_wlock(timer_ptr->timer_handle);
+	if (NULL == tmrm_item_ptr) {
 		rc = ESIF_E_INVALID_HANDLE;
 		goto lock_exit;
 	}
 
-	tmrm_item_ptr = (struct esif_tmrm_item *)node_ptr->data_ptr;
-
 	/* Mark for delete in case it is in the callback */
 	tmrm_item_ptr->marked_for_delete = ESIF_TRUE;
 
@@ -304,7 +331,7 @@ static enum esif_rc esif_ccb_timer_kill_w_event(
 
 	/* If not in callback, the timer can be destroyed now */
 	if (!tmrm_item_ptr->is_in_cb) {
-		esif_ccb_tmrm_destroy_timer_node_wlock(node_ptr);
+		esif_ccb_tmrm_destroy_timer_wlock(tmrm_item_ptr);
 	}
 	rc = ESIF_OK;
 lock_exit:
@@ -331,7 +358,6 @@ enum esif_rc esif_ccb_timer_set_msec(
 	)
 {
 	enum esif_rc rc = ESIF_E_UNSPECIFIED;
-	struct esif_link_list_node *node_ptr = NULL;
 	struct esif_tmrm_item *tmrm_item_ptr = NULL;
 	struct esif_timer_obj *timer_obj_ptr = NULL;
 	esif_ccb_timer_handle_t timer_cb_handle = {0};
@@ -352,21 +378,19 @@ enum esif_rc esif_ccb_timer_set_msec(
 
 	esif_ccb_write_lock(&g_tmrm.mgr_lock);
 
-	node_ptr = esif_ccb_tmrm_find_timer_node_wlock(timer_ptr->timer_handle);
-	if ((NULL == node_ptr) || (NULL == node_ptr->data_ptr)) {	
+	tmrm_item_ptr = esif_ccb_tmrm_find_timer_wlock(timer_ptr->timer_handle);
+	if (NULL == tmrm_item_ptr) {
 		rc = ESIF_E_INVALID_HANDLE;
 		goto lock_exit;
 	}
 
-	tmrm_item_ptr = (struct esif_tmrm_item *)node_ptr->data_ptr;
-
 	if (tmrm_item_ptr->marked_for_delete) {
 		rc = ESIF_E_INVALID_HANDLE;
 		goto lock_exit;
 	}
 
 	esif_ccb_tmrm_get_next_cb_handle_wlock(&timer_cb_handle);
-	tmrm_item_ptr->timer_cb_handle = timer_cb_handle;
+	esif_ccb_tmrm_index_cb_handle_wlock(tmrm_item_ptr, timer_cb_handle);
 
 	timer_obj_ptr = tmrm_item_ptr->timer_obj_ptr;
 	esif_ccb_timer_obj_save_pending_timeout(timer_obj_ptr,
@@ -481,22 +505,18 @@ void esif_ccb_tmrm_callback(
 	esif_ccb_timer_handle_t cb_handle
 	)
 {
-	struct esif_link_list_node *node_ptr = NULL;
 	struct esif_tmrm_item *tmrm_item_ptr = NULL;
 	struct esif_timer_obj *timer_obj_ptr = NULL;
 
 	esif_ccb_write_lock(&g_tmrm.mgr_lock);
 
-	node_ptr = esif_ccb_tmrm_find_timer_node_by_cb_wlock(cb_handle);
-
-	if ((NULL == node_ptr) || (NULL == node_ptr->data_ptr)) {
-		goto lock_exit;	
+	tmrm_item_ptr = esif_ccb_tmrm_find_timer_by_cb_wlock(cb_handle);
+	if (NULL == tmrm_item_ptr) {
+		goto lock_exit;
 	}
 
-	tmrm_item_ptr = (struct esif_tmrm_item *)node_ptr->data_ptr;
-
 	/* Clear the CB handle to lower probability of hitting same handle */
-	tmrm_item_ptr->timer_cb_handle = 0;
+	esif_ccb_tmrm_index_cb_handle_wlock(tmrm_item_ptr, 0);
 	tmrm_item_ptr->is_in_cb = ESIF_TRUE;
 
 	esif_ccb_write_unlock(&g_tmrm.mgr_lock);
@@ -507,7 +527,7 @@ void esif_ccb_tmrm_callback(
 
 	/*
 	 * Upon return, perform post processing
-	 * Note:  The item and node pointers will still be valid as the node
+	 * Note:  The item pointer will still be valid as the item
 	 * will not be removed while in the callback function
 	 */
 	esif_ccb_write_lock(&g_tmrm.mgr_lock);
@@ -515,7 +535,7 @@ void esif_ccb_tmrm_callback(
 	tmrm_item_ptr->is_in_cb = ESIF_FALSE;
 
 	if (tmrm_item_ptr->marked_for_delete) {
-		esif_ccb_tmrm_destroy_timer_node_wlock(node_ptr);
+		esif_ccb_tmrm_destroy_timer_wlock(tmrm_item_ptr);
 		goto lock_exit;
 	}
 
@@ -577,7 +597,7 @@ static enum esif_rc esif_ccb_tmrm_get_next_handle(
 	)
 {
 	enum esif_rc rc = ESIF_OK;
-	struct esif_link_list_node *node_ptr = NULL;
+	struct esif_tmrm_item *tmrm_item_ptr = NULL;
 	esif_ccb_timer_t timer = {0};
 	u32 try_count = 0;
 	/*
@@ -591,12 +611,12 @@ static enum esif_rc esif_ccb_tmrm_get_next_handle(
 	do {
 		try_count++;
 		timer.timer_handle = (esif_ccb_timer_handle_t)(size_t)++g_next_timer_handle;
-		node_ptr = esif_ccb_tmrm_find_timer_node_wlock(timer.timer_handle);
-	} while ((node_ptr != NULL) && (try_count < ESIF_CNT_HNDL_RETRIES_MAX));
+		tmrm_item_ptr = esif_ccb_tmrm_find_timer_wlock(timer.timer_handle);
+	} while ((tmrm_item_ptr != NULL) && (try_count < ESIF_CNT_HNDL_RETRIES_MAX));
 
 	esif_ccb_write_unlock(&g_tmrm.mgr_lock);
 
-	if(node_ptr != NULL) {
+	if(tmrm_item_ptr != NULL) {
 		rc = ESIF_E_UNSPECIFIED;
 		goto exit;
 	}
@@ -619,70 +639,102 @@ static void esif_ccb_tmrm_get_next_cb_handle_wlock(
 }
 
 
-static struct esif_link_list_node *esif_ccb_tmrm_find_timer_node_wlock(
+static struct esif_tmrm_item *esif_ccb_tmrm_find_timer_wlock(
 	esif_ccb_timer_handle_t handle
 	)
 {
-	struct esif_link_list_node *node_ptr = NULL;
-	struct esif_tmrm_item *tmrm_item_ptr = NULL;
+	struct esif_tmrm_item *tmrm_item_ptr = g_tmrm.handle_index[ESIF_TMRM_INDEX(handle)];
 
-	if (NULL == g_tmrm.timer_list_ptr)
-		goto exit;
-
-	node_ptr = g_tmrm.timer_list_ptr->head_ptr;
-	while (node_ptr != NULL) {
-		tmrm_item_ptr = (struct esif_tmrm_item *)node_ptr->data_ptr;
-		if (NULL == tmrm_item_ptr) /* Should never happen */
-			continue;
-
-		if (handle == tmrm_item_ptr->timer_handle)
-			break;	
-		node_ptr = node_ptr->next_ptr;
+	while ((tmrm_item_ptr != NULL) && (tmrm_item_ptr->timer_handle != handle)) {
+		tmrm_item_ptr = tmrm_item_ptr->next_by_handle_ptr;
 	}
-exit:
-	return node_ptr;
+	return tmrm_item_ptr;
 }
 
 
-static struct esif_link_list_node *esif_ccb_tmrm_find_timer_node_by_cb_wlock(
+static struct esif_tmrm_item *esif_ccb_tmrm_find_timer_by_cb_wlock(
 	esif_ccb_timer_handle_t cb_handle
 	)
 {
-	struct esif_link_list_node *node_ptr = NULL;
 	struct esif_tmrm_item *tmrm_item_ptr = NULL;
 
-	if (NULL == g_tmrm.timer_list_ptr)
+	/* Timers which are not set have a CB handle of 0 and are not indexed */
+	if (0 == cb_handle)
 		goto exit;
 
-	node_ptr = g_tmrm.timer_list_ptr->head_ptr;
-	while (node_ptr != NULL) {
-		tmrm_item_ptr = (struct esif_tmrm_item *)node_ptr->data_ptr;
-		if (NULL == tmrm_item_ptr) /* Should never happen */
-			continue;
-
-		if (cb_handle == tmrm_item_ptr->timer_cb_handle)
-			break;	
-		node_ptr = node_ptr->next_ptr;
+	tmrm_item_ptr = g_tmrm.cb_handle_index[ESIF_TMRM_INDEX(cb_handle)];
+	while ((tmrm_item_ptr != NULL) && (tmrm_item_ptr->timer_cb_handle != cb_handle)) {
+		tmrm_item_ptr = tmrm_item_ptr->next_by_cb_handle_ptr;
 	}
 exit:
-	return node_ptr;
+	return tmrm_item_ptr;
 }
 
 
-static void esif_ccb_tmrm_destroy_timer_node_wlock(
-	struct esif_link_list_node *node_ptr
+/*
+ * Removes the item from the handle index chains it is in.  Passing remove_handle
+ * as ESIF_FALSE only removes the item from the callback handle index.
+ */
+static void esif_ccb_tmrm_unindex_wlock(
+	struct esif_tmrm_item *self,
+	u8 remove_handle
 	)
 {
-	struct esif_tmrm_item *tmrm_item_ptr = NULL;
+	struct esif_tmrm_item **link_ptr = NULL;
 
-	ESIF_ASSERT(node_ptr != NULL);
-	ESIF_ASSERT(node_ptr->data_ptr != NULL);
+	if (self->timer_cb_handle != 0) {
+		link_ptr = &g_tmrm.cb_handle_index[ESIF_TMRM_INDEX(self->timer_cb_handle)];
+		while ((*link_ptr != NULL) && (*link_ptr != self)) {
+			link_ptr = &(*link_ptr)->next_by_cb_handle_ptr;
+		}
+		if (*link_ptr != NULL) {
+			*link_ptr = self->next_by_cb_handle_ptr;
+		}
+		self->next_by_cb_handle_ptr = NULL;
+	}
+
+	if (remove_handle) {
+		link_ptr = &g_tmrm.handle_index[ESIF_TMRM_INDEX(self->timer_handle)];
+		while ((*link_ptr != NULL) && (*link_ptr != self)) {
+			link_ptr = &(*link_ptr)->next_by_handle_ptr;
+		}
+		if (*link_ptr != NULL) {
+			*link_ptr = self->next_by_handle_ptr;
+		}
+		self->next_by_handle_ptr = NULL;
+	}
+}
+
+
+/* Assigns a new CB handle to the item and moves it in the CB handle index */
+static void esif_ccb_tmrm_index_cb_handle_wlock(
+	struct esif_tmrm_item *self,
+	esif_ccb_timer_handle_t cb_handle
+	)
+{
+	esif_ccb_tmrm_unindex_wlock(self, ESIF_FALSE);
+
+	self->timer_cb_handle = cb_handle;
+	if (cb_handle != 0) {
+		self->next_by_cb_handle_ptr = g_tmrm.cb_handle_index[ESIF_TMRM_INDEX(cb_handle)];
+		g_tmrm.cb_handle_index[ESIF_TMRM_INDEX(cb_handle)] = self;
+	}
+}
+
+
+static void esif_ccb_tmrm_destroy_timer_wlock(
+	struct esif_tmrm_item *tmrm_item_ptr
+	)
+{
+	ESIF_ASSERT(tmrm_item_ptr != NULL);
+	ESIF_ASSERT(tmrm_item_ptr->node_ptr != NULL);
+
+	esif_ccb_tmrm_unindex_wlock(tmrm_item_ptr, ESIF_TRUE);
+	esif_link_list_node_remove(g_tmrm.timer_list_ptr, tmrm_item_ptr->node_ptr);
+	tmrm_item_ptr->node_ptr = NULL;
 
-	tmrm_item_ptr = (struct esif_tmrm_item *)node_ptr->data_ptr;
 	esif_ccb_tmrm_destroy_tmrm_item(tmrm_item_ptr);
 
-	esif_link_list_node_remove(g_tmrm.timer_list_ptr, node_ptr);
-			
 	/* If the manager list is empty, destroy it */
 	if(NULL == g_tmrm.timer_list_ptr->head_ptr) {
 		esif_link_list_destroy(g_tmrm.timer_list_ptr);
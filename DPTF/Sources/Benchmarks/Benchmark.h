@@ -0,0 +1,69 @@
+/******************************************************************************
+** Copyright (c) 2013-2020 Intel Corporation All Rights Reserved
+**
+** Licensed under the Apache License, Version 2.0 (the "License"); you may not
+** use this file except in compliance with the License.
+**
+** You may obtain a copy of the License at
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+** WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+******************************************************************************/
+
+#pragma once
+
+#include "Dptf.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+//
+// Minimal timing support for the standalone micro-benchmarks.  Each benchmark runs a fixed number of iterations
+// after a short warm-up and reports the average time per iteration.
+//
+
+namespace Benchmark
+{
+	// Keeps the compiler from discarding work whose result is otherwise unused
+	extern volatile UInt64 sink;
+
+	inline UInt64 getIterations(int argc, char* argv[], UInt64 defaultIterations)
+	{
+		if (argc > 1)
+		{
+			UInt64 iterations = std::strtoull(argv[1], nullptr, 10);
+			if (iterations > 0)
+			{
+				return iterations;
+			}
+		}
+		return defaultIterations;
+	}
+
+	template <typename Function>
+	double run(const char* name, UInt64 iterations, Function function)
+	{
+		for (UInt64 i = 0; i < (iterations / 10) + 1; ++i)
+		{
+			function(i);
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		for (UInt64 i = 0; i < iterations; ++i)
+		{
+			function(i);
+		}
+		auto elapsed = std::chrono::steady_clock::now() - start;
+
+		double nsPerIteration =
+			(double)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / (double)iterations;
+		std::printf("%-48s %10.1f ns/op\n", name, nsPerIteration);
+		return nsPerIteration;
+	}
+}
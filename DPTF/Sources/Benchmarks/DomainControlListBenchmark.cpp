@@ -0,0 +1,296 @@
+/******************************************************************************
+** Copyright (c) 2013-2020 Intel Corporation All Rights Reserved
+**
+** Licensed under the Apache License, Version 2.0 (the "License"); you may not
+** use this file except in compliance with the License.
+**
+** You may obtain a copy of the License at
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+** WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+******************************************************************************/
+
+//
+// Measures the cost of fetching a control from a domain's control list, as policies do on every request.  The map
+// lookup plus dynamic_pointer_cast the list used before is reproduced against the same control objects and compared
+// with the typed DomainControlList getters.
+//
+
+#include "Benchmark.h"
+#include "UnifiedParticipant/DomainControlList.h"
+
+using namespace std;
+
+// Participant services that do nothing, so the version 0 controls can be made without the manager
+class NullParticipantServices : public ParticipantServicesInterface
+{
+public:
+	virtual void writeMessageFatal(const DptfMessage& message) override {}
+	virtual void writeMessageError(const DptfMessage& message) override {}
+	virtual void writeMessageWarning(const DptfMessage& message) override {}
+	virtual void writeMessageInfo(const DptfMessage& message) override {}
+	virtual void writeMessageDebug(const DptfMessage& message) override {}
+	virtual eLogType getLoggingLevel() override
+	{
+		return eLogTypeFatal;
+	}
+
+	virtual UInt8 primitiveExecuteGetAsUInt8(esif_primitive_type primitive, UIntN domainIndex, UInt8 instance) override
+	{
+		throw not_implemented();
+	}
+	virtual void primitiveExecuteSetAsUInt8(esif_primitive_type primitive, UInt8 value, UIntN domainIndex, UInt8 instance)
+		override
+	{
+		throw not_implemented();
+	}
+	virtual UInt32 primitiveExecuteGetAsUInt32(esif_primitive_type primitive, UIntN domainIndex, UInt8 instance) override
+	{
+		throw not_implemented();
+	}
+	virtual void primitiveExecuteSetAsUInt32(
+		esif_primitive_type primitive,
+		UInt32 value,
+		UIntN domainIndex,
+		UInt8 instance) override
+	{
+		throw not_implemented();
+	}
+	virtual UInt64 primitiveExecuteGetAsUInt64(esif_primitive_type primitive, UIntN domainIndex, UInt8 instance) override
+	{
+		throw not_implemented();
+	}
+	virtual void primitiveExecuteSetAsUInt64(
+		esif_primitive_type primitive,
+		UInt64 value,
+		UIntN domainIndex,
+		UInt8 instance) override
+	{
+		throw not_implemented();
+	}
+	virtual Temperature primitiveExecuteGetAsTemperatureTenthK(
+		esif_primitive_type primitive,
+		UIntN domainIndex,
+		UInt8 instance) override
+	{
+		throw not_implemented();
+	}
+	virtual void primitiveExecuteSetAsTemperatureTenthK(
+		esif_primitive_type primitive,
+		Temperature temperature,
+		UIntN domainIndex,
+		UInt8 instance) override
+	{
+		throw not_implemented();
+	}
+	virtual Percentage primitiveExecuteGetAsPercentage(esif_primitive_type primitive, UIntN domainIndex, UInt8 instance)
+		override
+	{
+		throw not_implemented();
+	}
+	virtual void primitiveExecuteSetAsPercentage(
+		esif_primitive_type primitive,
+		Percentage percentage,
+		UIntN domainIndex,
+		UInt8 instance) override
+	{
+		throw not_implemented();
+	}
+	virtual Frequency primitiveExecuteGetAsFrequency(esif_primitive_type primitive, UIntN domainIndex, UInt8 instance)
+		override
+	{
+		throw not_implemented();
+	}
+	virtual void primitiveExecuteSetAsFrequency(
+		esif_primitive_type primitive,
+		Frequency frequency,
+		UIntN domainIndex,
+		UInt8 instance) override
+	{
+		throw not_implemented();
+	}
+	virtual Power primitiveExecuteGetAsPower(esif_primitive_type primitive, UIntN domainIndex, UInt8 instance) override
+	{
+		throw not_implemented();
+	}
+	virtual void primitiveExecuteSetAsPower(esif_primitive_type primitive, Power power, UIntN domainIndex, UInt8 instance)
+		override
+	{
+		throw not_implemented();
+	}
+	virtual TimeSpan primitiveExecuteGetAsTimeInMilliseconds(
+		esif_primitive_type primitive,
+		UIntN domainIndex,
+		UInt8 instance) override
+	{
+		throw not_implemented();
+	}
+	virtual void primitiveExecuteSetAsTimeInMilliseconds(
+		esif_primitive_type primitive,
+		TimeSpan time,
+		UIntN domainIndex,
+		UInt8 instance) override
+	{
+		throw not_implemented();
+	}
+	virtual std::string primitiveExecuteGetAsString(esif_primitive_type primitive, UIntN domainIndex, UInt8 instance)
+		override
+	{
+		throw not_implemented();
+	}
+	virtual void primitiveExecuteSetAsString(
+		esif_primitive_type primitive,
+		std::string stringValue,
+		UIntN domainIndex,
+		UInt8 instance) override
+	{
+		throw not_implemented();
+	}
+	virtual DptfBuffer primitiveExecuteGet(
+		esif_primitive_type primitive,
+		esif_data_type esifDataType,
+		UIntN domainIndex,
+		UInt8 instance) override
+	{
+		throw not_implemented();
+	}
+	virtual void primitiveExecuteSet(
+		esif_primitive_type primitive,
+		esif_data_type esifDataType,
+		void* bufferPtr,
+		UInt32 bufferLength,
+		UInt32 dataLength,
+		UIntN domainIndex,
+		UInt8 instance) override
+	{
+		throw not_implemented();
+	}
+
+	virtual void registerEvent(ParticipantEvent::Type participantEvent) override {}
+	virtual void unregisterEvent(ParticipantEvent::Type participantEvent) override {}
+
+	virtual void createEventDomainPerformanceControlCapabilityChanged() override {}
+	virtual void createEventDomainPowerControlCapabilityChanged() override {}
+	virtual void createEventPowerLimitChanged() override {}
+	virtual void createEventPerformanceCapabilitiesChanged() override {}
+
+	virtual void sendDptfEvent(ParticipantEvent::Type participantEvent, UIntN domainId, esif_data eventData) override {}
+
+	virtual UIntN getUserPreferredDisplayCacheValue(UIntN participantIndex, UIntN domainIndex) override
+	{
+		return Constants::Invalid;
+	}
+	virtual void setUserPreferredDisplayCacheValue(UIntN participantIndex, UIntN domainIndex, UIntN userPreferredIndex)
+		override
+	{
+	}
+	virtual void invalidateUserPreferredDisplayCache(UIntN participantIndex, UIntN domainIndex) override {}
+	virtual Bool isUserPreferredDisplayCacheValid(UIntN participantIndex, UIntN domainIndex) override
+	{
+		return false;
+	}
+
+	virtual void registerRequestHandler(DptfRequestType::Enum requestType, RequestHandlerInterface* handler) override {}
+	virtual void unregisterRequestHandler(DptfRequestType::Enum requestType, RequestHandlerInterface* handler) override
+	{
+	}
+	virtual DomainType::Type getDomainType(UIntN domainIndex) override
+	{
+		return DomainType::Other;
+	}
+};
+
+// DomainControlList lookups before the controls were held in typed members
+class MapControlList
+{
+public:
+	MapControlList(const DomainControlList& controlList)
+	{
+		m_controlList[ControlFactoryType::Active] = controlList.getActiveControl();
+		m_controlList[ControlFactoryType::Performance] = controlList.getPerformanceControl();
+		m_controlList[ControlFactoryType::PowerControl] = controlList.getPowerControl();
+		m_controlList[ControlFactoryType::Temperature] = controlList.getTemperatureControl();
+	}
+
+	std::shared_ptr<DomainActiveControlBase> getActiveControl(void) const
+	{
+		return dynamic_pointer_cast<DomainActiveControlBase>(m_controlList.at(ControlFactoryType::Active));
+	}
+
+	std::shared_ptr<DomainPerformanceControlBase> getPerformanceControl(void) const
+	{
+		return dynamic_pointer_cast<DomainPerformanceControlBase>(m_controlList.at(ControlFactoryType::Performance));
+	}
+
+	std::shared_ptr<DomainPowerControlBase> getPowerControl(void) const
+	{
+		return dynamic_pointer_cast<DomainPowerControlBase>(m_controlList.at(ControlFactoryType::PowerControl));
+	}
+
+	std::shared_ptr<DomainTemperatureBase> getTemperatureControl(void) const
+	{
+		return dynamic_pointer_cast<DomainTemperatureBase>(m_controlList.at(ControlFactoryType::Temperature));
+	}
+
+private:
+	std::map<ControlFactoryType::Type, std::shared_ptr<ControlBase>> m_controlList;
+};
+
+// Fetches one of the controls a policy typically asks for and touches it, as a caller dereferencing the result would
+template <typename ControlList>
+static Bool useControl(const ControlList& controlList, UInt64 i)
+{
+	switch (i % 4)
+	{
+	case 0:
+		return controlList.getTemperatureControl()->isActivityLoggingEnabled();
+	case 1:
+		return controlList.getPerformanceControl()->isActivityLoggingEnabled();
+	case 2:
+		return controlList.getPowerControl()->isActivityLoggingEnabled();
+	default:
+		return controlList.getActiveControl()->isActivityLoggingEnabled();
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	try
+	{
+		auto iterations = Benchmark::getIterations(argc, argv, 10000000);
+		auto participantServices = std::make_shared<NullParticipantServices>();
+		ControlFactoryList controlFactoryList;
+		DomainControlList controlList(0, 0, DomainFunctionalityVersions(), controlFactoryList, participantServices);
+		MapControlList mapControlList(controlList);
+
+		if ((mapControlList.getActiveControl() != controlList.getActiveControl())
+			|| (mapControlList.getPerformanceControl() != controlList.getPerformanceControl())
+			|| (mapControlList.getPowerControl() != controlList.getPowerControl())
+			|| (mapControlList.getTemperatureControl() != controlList.getTemperatureControl())
+			|| (controlList.getTemperatureControl() == nullptr))
+		{
+			printf("Controls differ between the map and typed lists\n");
+			return 1;
+		}
+
+		printf("%llu iterations\n", (unsigned long long)iterations);
+		Benchmark::run("control lookup (map + dynamic_pointer_cast)", iterations, [&](UInt64 i) {
+			Benchmark::sink += useControl(mapControlList, i);
+		});
+		Benchmark::run("control lookup (DomainControlList)", iterations, [&](UInt64 i) {
+			Benchmark::sink += useControl(controlList, i);
+		});
+	}
+	catch (const std::exception& ex)
+	{
+		printf("Benchmark failed: %s\n", ex.what());
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,163 @@
+/******************************************************************************
+** Copyright (c) 2013-2020 Intel Corporation All Rights Reserved
+**
+** Licensed under the Apache License, Version 2.0 (the "License"); you may not
+** use this file except in compliance with the License.
+**
+** You may obtain a copy of the License at
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+** WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+******************************************************************************/
+
+//
+// Measures the front of the DptfEvent path that every ESIF event goes through: converting the event GUID to a
+// FrameworkEvent::Type and deciding whether to log its arrival.  The linear GUID search and the message built before
+// the logging level check, both used before, are reproduced and compared with FrameworkEventInfo's hash lookup and a
+// message that is only built when it will be written.  Work item creation needs a running manager and is not covered.
+//
+
+#include "Benchmark.h"
+#include "FrameworkEvent.h"
+#include "DptfMessage.h"
+#include "EsifDataGuid.h"
+#include "esif_sdk_iface.h"
+
+using namespace std;
+
+// Events are received at a level below info, so the arrival message is never written.  Volatile so the level is
+// read on every event, as DptfEvent does, instead of the check being folded away.
+static volatile eLogType LoggingLevel = eLogTypeWarning;
+
+// Stands in for ManagerMessage, which needs a running manager to construct
+class IngressMessage : public DptfMessage
+{
+public:
+	IngressMessage(const char* fileName, UIntN lineNumber, const char* executingFunctionName, const std::string& message)
+		: DptfMessage(fileName, lineNumber, executingFunctionName)
+	{
+		addMessage(message);
+	}
+
+	void setParticipantAndDomainIndex(UIntN participantIndex, UIntN domainIndex)
+	{
+		m_participantIndex = participantIndex;
+		m_domainIndex = domainIndex;
+	}
+
+	void setFrameworkEvent(FrameworkEvent::Type frameworkEvent)
+	{
+		m_frameworkEventValid = true;
+		m_frameworkEvent = frameworkEvent;
+	}
+};
+
+// FrameworkEventInfo::getFrameworkEventType before it used a hash table
+class LinearEventSearch
+{
+public:
+	LinearEventSearch()
+	{
+		for (UIntN i = 0; i < FrameworkEvent::Max; i++)
+		{
+			m_guids[i] = FrameworkEventInfo::instance()->getGuid(FrameworkEvent::Type(i));
+		}
+	}
+
+	FrameworkEvent::Type getFrameworkEventType(const Guid& guid) const
+	{
+		for (UIntN i = 0; i < FrameworkEvent::Max; i++)
+		{
+			if (m_guids[i] == guid)
+			{
+				return FrameworkEvent::Type(i);
+			}
+		}
+		throw dptf_exception("GUID is not a framework event known to DPTF.");
+	}
+
+private:
+	Guid m_guids[FrameworkEvent::Max];
+};
+
+static UInt64 writeIfLogged(const IngressMessage& message, eLogType messageLevel)
+{
+	// The message is not actually written; only its construction matters here
+	return (LoggingLevel >= messageLevel) ? 1 : 0;
+}
+
+int main(int argc, char* argv[])
+{
+	try
+	{
+		auto iterations = Benchmark::getIterations(argc, argv, 1000000);
+		auto eventInfo = FrameworkEventInfo::instance();
+		LinearEventSearch linearSearch;
+
+		// ESIF events arrive as an EsifData holding the GUID.  Internal events have no GUID and never come from ESIF.
+		vector<shared_ptr<EsifDataGuid>> eventGuids;
+		for (UIntN i = 0; i < FrameworkEvent::Max; i++)
+		{
+			auto guid = eventInfo->getGuid(FrameworkEvent::Type(i));
+			if (guid.isValid() && (eventInfo->getFrameworkEventType(guid) == FrameworkEvent::Type(i)))
+			{
+				eventGuids.push_back(make_shared<EsifDataGuid>(guid));
+			}
+		}
+		auto numberOfEvents = eventGuids.size();
+
+		for (auto eventGuid = eventGuids.begin(); eventGuid != eventGuids.end(); ++eventGuid)
+		{
+			Guid guid = EsifDataGuid((EsifDataPtr)(**eventGuid));
+			if (linearSearch.getFrameworkEventType(guid) != eventInfo->getFrameworkEventType(guid))
+			{
+				printf("Event types differ between the linear search and the hash table\n");
+				return 1;
+			}
+		}
+
+		printf("%u ESIF events, %llu iterations\n", (UInt32)numberOfEvents, (unsigned long long)iterations);
+
+		Benchmark::run("guid lookup (linear search)", iterations, [&](UInt64 i) {
+			Guid guid = EsifDataGuid((EsifDataPtr)(*eventGuids[i % numberOfEvents]));
+			Benchmark::sink += linearSearch.getFrameworkEventType(guid);
+		});
+		Benchmark::run("guid lookup (FrameworkEventInfo)", iterations, [&](UInt64 i) {
+			Guid guid = EsifDataGuid((EsifDataPtr)(*eventGuids[i % numberOfEvents]));
+			Benchmark::sink += eventInfo->getFrameworkEventType(guid);
+		});
+
+		Benchmark::run("event ingress (linear search, eager message)", iterations, [&](UInt64 i) {
+			Guid guid = EsifDataGuid((EsifDataPtr)(*eventGuids[i % numberOfEvents]));
+			auto frameworkEvent = linearSearch.getFrameworkEventType(guid);
+			IngressMessage startMessage(FLF, "Received event notification from ESIF");
+			startMessage.setParticipantAndDomainIndex((UIntN)i % 8, 0);
+			startMessage.setFrameworkEvent(frameworkEvent);
+			Benchmark::sink += frameworkEvent + writeIfLogged(startMessage, eLogTypeInfo);
+		});
+		Benchmark::run("event ingress (hash lookup, deferred message)", iterations, [&](UInt64 i) {
+			Guid guid = EsifDataGuid((EsifDataPtr)(*eventGuids[i % numberOfEvents]));
+			auto frameworkEvent = eventInfo->getFrameworkEventType(guid);
+			if (LoggingLevel >= eLogTypeInfo)
+			{
+				IngressMessage startMessage(FLF, "Received event notification from ESIF");
+				startMessage.setParticipantAndDomainIndex((UIntN)i % 8, 0);
+				startMessage.setFrameworkEvent(frameworkEvent);
+				Benchmark::sink += writeIfLogged(startMessage, eLogTypeInfo);
+			}
+			Benchmark::sink += frameworkEvent;
+		});
+	}
+	catch (const std::exception& ex)
+	{
+		printf("Benchmark failed: %s\n", ex.what());
+		return 1;
+	}
+	return 0;
+}
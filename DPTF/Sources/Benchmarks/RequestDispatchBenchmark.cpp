@@ -0,0 +1,257 @@
+/******************************************************************************
+** Copyright (c) 2013-2020 Intel Corporation All Rights Reserved
+**
+** Licensed under the Apache License, Version 2.0 (the "License"); you may not
+** use this file except in compliance with the License.
+**
+** You may obtain a copy of the License at
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+** WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+******************************************************************************/
+
+//
+// Measures the per-request overhead of routing a policy request to the control that handles it and of looking up
+// a cached control result.  Each case is run against the map based structures the manager and participant used
+// before, which are reproduced below, and against RequestDispatcher and RequestResultCache.
+//
+
+#include "Benchmark.h"
+#include "Manager/RequestDispatcher.h"
+#include "UnifiedParticipant/RequestResultCache.h"
+#include <tuple>
+
+using namespace std;
+
+static const UInt32 NumberOfParticipants = 16;
+static const UInt32 NumberOfDomains = 2;
+static const DptfRequestType::Enum HandledRequestTypes[] = {DptfRequestType::ActiveControlGetStatus,
+															DptfRequestType::ActiveControlSetFanSpeed,
+															DptfRequestType::TemperatureControlGetTemperatureStatus,
+															DptfRequestType::TemperatureControlSetTemperatureThresholds};
+static const UInt32 NumberOfRequestTypes = sizeof(HandledRequestTypes) / sizeof(HandledRequestTypes[0]);
+
+// Stands in for a control: handles its request types for a single participant and domain, the same way ControlBase
+// decides whether a request is for it
+class BenchmarkControl : public RequestHandlerInterface
+{
+public:
+	BenchmarkControl(UInt32 participantIndex, UInt32 domainIndex)
+		: m_participantIndex(participantIndex)
+		, m_domainIndex(domainIndex)
+	{
+	}
+
+	virtual DptfRequestResult processRequest(const PolicyRequest& policyRequest) override
+	{
+		return DptfRequestResult(true, Constants::EmptyString, policyRequest.getRequest());
+	}
+
+	virtual Bool canProcessRequest(const PolicyRequest& policyRequest) override
+	{
+		auto& request = policyRequest.getRequest();
+		return (request.getParticipantIndex() == m_participantIndex) && (request.getDomainIndex() == m_domainIndex);
+	}
+
+private:
+	UInt32 m_participantIndex;
+	UInt32 m_domainIndex;
+};
+
+// RequestDispatcher before handlers were indexed by request type
+class MapRequestDispatcher
+{
+public:
+	DptfRequestResult dispatch(const PolicyRequest& policyRequest)
+	{
+		auto& request = policyRequest.getRequest();
+		auto handlers = m_handlers[request.getRequestType()];
+		for (auto handler = handlers.begin(); handler != handlers.end(); ++handler)
+		{
+			if ((*handler)->canProcessRequest(policyRequest))
+			{
+				return (*handler)->processRequest(policyRequest);
+			}
+		}
+		return DptfRequestResult(false, "No handler for request.", request);
+	}
+
+	void registerHandler(DptfRequestType::Enum requestType, RequestHandlerInterface* handler)
+	{
+		m_handlers[requestType].insert(handler);
+	}
+
+private:
+	map<DptfRequestType::Enum, set<RequestHandlerInterface*>> m_handlers;
+};
+
+// ControlBase result cache before it was flattened
+class MapRequestResultCache
+{
+public:
+	Bool contains(DptfRequestType::Enum requestType, UInt32 participantIndex, UInt32 domainIndex) const
+	{
+		return m_cache.find(makeKey(requestType, participantIndex, domainIndex)) != m_cache.end();
+	}
+
+	const DptfRequestResult& get(DptfRequestType::Enum requestType, UInt32 participantIndex, UInt32 domainIndex) const
+	{
+		auto cachedItem = m_cache.find(makeKey(requestType, participantIndex, domainIndex));
+		if (cachedItem == m_cache.end())
+		{
+			throw dptf_exception("No cached result for request.");
+		}
+		return cachedItem->second;
+	}
+
+	void set(const DptfRequestResult& requestResult)
+	{
+		auto& request = requestResult.getRequest();
+		m_cache[makeKey(request.getRequestType(), request.getParticipantIndex(), request.getDomainIndex())] =
+			requestResult;
+	}
+
+	void remove(DptfRequestType::Enum requestType, UInt32 participantIndex, UInt32 domainIndex)
+	{
+		m_cache.erase(makeKey(requestType, participantIndex, domainIndex));
+	}
+
+private:
+	typedef tuple<DptfRequestType::Enum, UInt32, UInt32> Key;
+	map<Key, DptfRequestResult> m_cache;
+
+	static Key makeKey(DptfRequestType::Enum requestType, UInt32 participantIndex, UInt32 domainIndex)
+	{
+		return Key(requestType, participantIndex, domainIndex);
+	}
+};
+
+static vector<PolicyRequest> makeRequests(void)
+{
+	vector<PolicyRequest> requests;
+	for (UInt32 participant = 0; participant < NumberOfParticipants; ++participant)
+	{
+		for (UInt32 domain = 0; domain < NumberOfDomains; ++domain)
+		{
+			for (UInt32 type = 0; type < NumberOfRequestTypes; ++type)
+			{
+				requests.push_back(PolicyRequest(0, DptfRequest(HandledRequestTypes[type], participant, domain)));
+			}
+		}
+	}
+	return requests;
+}
+
+template <typename Dispatcher>
+static void registerControls(Dispatcher& dispatcher, vector<BenchmarkControl>& controls)
+{
+	for (auto control = controls.begin(); control != controls.end(); ++control)
+	{
+		for (UInt32 type = 0; type < NumberOfRequestTypes; ++type)
+		{
+			dispatcher.registerHandler(HandledRequestTypes[type], &(*control));
+		}
+	}
+}
+
+template <typename Cache>
+static void fillCache(Cache& cache, const vector<PolicyRequest>& requests)
+{
+	for (auto request = requests.begin(); request != requests.end(); ++request)
+	{
+		DptfRequestResult result(true, Constants::EmptyString, request->getRequest());
+		result.setDataFromUInt32(request->getRequest().getParticipantIndex());
+		cache.set(result);
+	}
+}
+
+template <typename Cache>
+static UInt64 lookUp(const Cache& cache, const DptfRequest& request)
+{
+	if (cache.contains(request.getRequestType(), request.getParticipantIndex(), request.getDomainIndex()))
+	{
+		return cache.get(request.getRequestType(), request.getParticipantIndex(), request.getDomainIndex())
+			.getDataAsUInt32();
+	}
+	return 0;
+}
+
+int main(int argc, char* argv[])
+{
+	try
+	{
+		auto iterations = Benchmark::getIterations(argc, argv, 1000000);
+		auto requests = makeRequests();
+		auto numberOfRequests = requests.size();
+
+		vector<BenchmarkControl> controls;
+		for (UInt32 participant = 0; participant < NumberOfParticipants; ++participant)
+		{
+			for (UInt32 domain = 0; domain < NumberOfDomains; ++domain)
+			{
+				controls.push_back(BenchmarkControl(participant, domain));
+			}
+		}
+
+		MapRequestDispatcher mapDispatcher;
+		RequestDispatcher dispatcher;
+		registerControls(mapDispatcher, controls);
+		registerControls(dispatcher, controls);
+
+		MapRequestResultCache mapCache;
+		RequestResultCache cache;
+		fillCache(mapCache, requests);
+		fillCache(cache, requests);
+
+		// Both versions must agree before their timings mean anything
+		for (auto request = requests.begin(); request != requests.end(); ++request)
+		{
+			if ((mapDispatcher.dispatch(*request).isSuccessful() != dispatcher.dispatch(*request).isSuccessful())
+				|| (lookUp(mapCache, request->getRequest()) != lookUp(cache, request->getRequest())))
+			{
+				printf("Request results differ between the map and indexed versions\n");
+				return 1;
+			}
+		}
+
+		printf("%u controls, %u request types, %llu iterations\n",
+			(UInt32)controls.size(),
+			NumberOfRequestTypes,
+			(unsigned long long)iterations);
+
+		Benchmark::run("dispatch (map of sets)", iterations, [&](UInt64 i) {
+			Benchmark::sink += mapDispatcher.dispatch(requests[i % numberOfRequests]).isSuccessful();
+		});
+		Benchmark::run("dispatch (RequestDispatcher)", iterations, [&](UInt64 i) {
+			Benchmark::sink += dispatcher.dispatch(requests[i % numberOfRequests]).isSuccessful();
+		});
+		Benchmark::run("cached result (map)", iterations, [&](UInt64 i) {
+			Benchmark::sink += lookUp(mapCache, requests[i % numberOfRequests].getRequest());
+		});
+		Benchmark::run("cached result (RequestResultCache)", iterations, [&](UInt64 i) {
+			Benchmark::sink += lookUp(cache, requests[i % numberOfRequests].getRequest());
+		});
+		Benchmark::run("cache update (map)", iterations, [&](UInt64 i) {
+			auto& request = requests[i % numberOfRequests].getRequest();
+			mapCache.remove(request.getRequestType(), request.getParticipantIndex(), request.getDomainIndex());
+			mapCache.set(DptfRequestResult(true, Constants::EmptyString, request));
+		});
+		Benchmark::run("cache update (RequestResultCache)", iterations, [&](UInt64 i) {
+			auto& request = requests[i % numberOfRequests].getRequest();
+			cache.remove(request.getRequestType(), request.getParticipantIndex(), request.getDomainIndex());
+			cache.set(DptfRequestResult(true, Constants::EmptyString, request));
+		});
+	}
+	catch (const std::exception& ex)
+	{
+		printf("Benchmark failed: %s\n", ex.what());
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,100 @@
+/******************************************************************************
+** Copyright (c) 2013-2020 Intel Corporation All Rights Reserved
+**
+** Licensed under the Apache License, Version 2.0 (the "License"); you may not
+** use this file except in compliance with the License.
+**
+** You may obtain a copy of the License at
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+** WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+******************************************************************************/
+
+
+#include "CachedDataScope.h"
+
+CachedDataScope::CachedDataScope(UIntN participantIndex, UIntN domainIndex)
+	: m_participantIndex(participantIndex)
+	, m_domainIndex(domainIndex)
+	, m_cachedDataTypes()
+{
+}
+
+CachedDataScope CachedDataScope::createForAllData(void)
+{
+	return createForParticipant(Constants::Invalid);
+}
+
+CachedDataScope CachedDataScope::createForVolatileData(void)
+{
+	return CachedDataScope(Constants::Invalid, Constants::Invalid);
+}
+
+CachedDataScope CachedDataScope::createForParticipant(UIntN participantIndex)
+{
+	CachedDataScope scope(participantIndex, Constants::Invalid);
+	for (auto typeIndex = (UIntN)DomainCachedDataType::FIRST; typeIndex < DomainCachedDataType::MAX; typeIndex++)
+	{
+		scope.addCachedDataType((DomainCachedDataType::Type)typeIndex);
+	}
+	return scope;
+}
+
+CachedDataScope CachedDataScope::createForDomain(
+	UIntN participantIndex,
+	UIntN domainIndex,
+	DomainCachedDataType::Type cachedDataType)
+{
+	CachedDataScope scope(participantIndex, domainIndex);
+	scope.addCachedDataType(cachedDataType);
+	return scope;
+}
+
+void CachedDataScope::addCachedDataType(DomainCachedDataType::Type cachedDataType)
+{
+	m_cachedDataTypes.insert(cachedDataType);
+}
+
+Bool CachedDataScope::includesAllData(void) const
+{
+	return (m_participantIndex == Constants::Invalid) && (m_domainIndex == Constants::Invalid)
+		   && (m_cachedDataTypes.size() == DomainCachedDataType::MAX);
+}
+
+Bool CachedDataScope::includesParticipant(UIntN participantIndex) const
+{
+	return (m_participantIndex == Constants::Invalid) || (m_participantIndex == participantIndex);
+}
+
+Bool CachedDataScope::includesDomain(UIntN domainIndex) const
+{
+	return (m_domainIndex == Constants::Invalid) || (m_domainIndex == domainIndex);
+}
+
+Bool CachedDataScope::includesCachedDataType(DomainCachedDataType::Type cachedDataType) const
+{
+	return (m_cachedDataTypes.find(cachedDataType) != m_cachedDataTypes.end());
+}
+
+Bool CachedDataScope::includesAllCachedDataTypes(void) const
+{
+	return (m_cachedDataTypes.size() == DomainCachedDataType::MAX);
+}
+
+Bool CachedDataScope::hasNonVolatileData(void) const
+{
+	for (auto cachedDataType = m_cachedDataTypes.begin(); cachedDataType != m_cachedDataTypes.end(); ++cachedDataType)
+	{
+		if (DomainCachedDataType::isVolatile(*cachedDataType) == false)
+		{
+			return true;
+		}
+	}
+	return false;
+}
@@ -0,0 +1,55 @@
+/******************************************************************************
+** Copyright (c) 2013-2020 Intel Corporation All Rights Reserved
+**
+** Licensed under the Apache License, Version 2.0 (the "License"); you may not
+** use this file except in compliance with the License.
+**
+** You may obtain a copy of the License at
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+** WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+******************************************************************************/
+
+
+#pragma once
+
+#include "Dptf.h"
+#include "DomainCachedDataType.h"
+#include <set>
+
+// Describes the framework cached data that a work item may have made stale.  Volatile data is cleared after every
+// work item regardless of the scope.
+class CachedDataScope
+{
+public:
+	static CachedDataScope createForAllData(void);
+	static CachedDataScope createForVolatileData(void);
+	static CachedDataScope createForParticipant(UIntN participantIndex);
+	static CachedDataScope createForDomain(
+		UIntN participantIndex,
+		UIntN domainIndex,
+		DomainCachedDataType::Type cachedDataType);
+
+	void addCachedDataType(DomainCachedDataType::Type cachedDataType);
+
+	Bool includesAllData(void) const;
+	Bool includesParticipant(UIntN participantIndex) const;
+	Bool includesDomain(UIntN domainIndex) const;
+	Bool includesCachedDataType(DomainCachedDataType::Type cachedDataType) const;
+	Bool includesAllCachedDataTypes(void) const;
+	Bool hasNonVolatileData(void) const;
+
+private:
+	CachedDataScope(UIntN participantIndex, UIntN domainIndex);
+
+	// Constants::Invalid means all participants or all domains
+	UIntN m_participantIndex;
+	UIntN m_domainIndex;
+	std::set<DomainCachedDataType::Type> m_cachedDataTypes;
+};
@@ -0,0 +1,184 @@
+/******************************************************************************
+** Copyright (c) 2013-2020 Intel Corporation All Rights Reserved
+**
+** Licensed under the Apache License, Version 2.0 (the "License"); you may not
+** use this file except in compliance with the License.
+**
+** You may obtain a copy of the License at
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+** WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+******************************************************************************/
+#include "ControlWriteShadow.h"
+#include "EsifMutexHelper.h"
+
+ControlWriteShadow::ControlWriteShadow()
+	: m_lastWrites()
+	, m_issuedWriteCount(0)
+	, m_suppressedWriteCount(0)
+	, m_mutex()
+{
+}
+
+ControlWriteShadow::~ControlWriteShadow()
+{
+}
+
+Bool ControlWriteShadow::isRedundantWrite(
+	esif_primitive_type primitive,
+	UIntN domainIndex,
+	UInt8 instance,
+	UInt64 value)
+{
+	if (isShadowed(primitive) == false)
+	{
+		return false;
+	}
+
+	Bool isRedundant = false;
+	EsifMutexHelper esifMutexHelper(&m_mutex);
+	esifMutexHelper.lock();
+
+	auto lastWrite = m_lastWrites.find(WriteKey(primitive, domainIndex, instance));
+	if ((lastWrite != m_lastWrites.end()) && (lastWrite->second == value))
+	{
+		m_suppressedWriteCount++;
+		isRedundant = true;
+	}
+
+	esifMutexHelper.unlock();
+	return isRedundant;
+}
+
+void ControlWriteShadow::recordWrite(esif_primitive_type primitive, UIntN domainIndex, UInt8 instance, UInt64 value)
+{
+	EsifMutexHelper esifMutexHelper(&m_mutex);
+	esifMutexHelper.lock();
+	if (isShadowed(primitive))
+	{
+		m_lastWrites[WriteKey(primitive, domainIndex, instance)] = value;
+	}
+	m_issuedWriteCount++;
+	esifMutexHelper.unlock();
+}
+
+void ControlWriteShadow::invalidate(esif_primitive_type primitive, UIntN domainIndex, UInt8 instance)
+{
+	if (isShadowed(primitive) == false)
+	{
+		return;
+	}
+
+	EsifMutexHelper esifMutexHelper(&m_mutex);
+	esifMutexHelper.lock();
+	m_lastWrites.erase(WriteKey(primitive, domainIndex, instance));
+	esifMutexHelper.unlock();
+}
+
+void ControlWriteShadow::invalidate(const CachedDataScope& scope)
+{
+	EsifMutexHelper esifMutexHelper(&m_mutex);
+	esifMutexHelper.lock();
+
+	auto lastWrite = m_lastWrites.begin();
+	while (lastWrite != m_lastWrites.end())
+	{
+		if (isDirtiedBy(std::get<0>(lastWrite->first), std::get<1>(lastWrite->first), scope))
+		{
+			lastWrite = m_lastWrites.erase(lastWrite);
+		}
+		else
+		{
+			++lastWrite;
+		}
+	}
+
+	esifMutexHelper.unlock();
+}
+
+void ControlWriteShadow::invalidateDomain(UIntN domainIndex)
+{
+	EsifMutexHelper esifMutexHelper(&m_mutex);
+	esifMutexHelper.lock();
+
+	auto lastWrite = m_lastWrites.begin();
+	while (lastWrite != m_lastWrites.end())
+	{
+		if (std::get<1>(lastWrite->first) == domainIndex)
+		{
+			lastWrite = m_lastWrites.erase(lastWrite);
+		}
+		else
+		{
+			++lastWrite;
+		}
+	}
+
+	esifMutexHelper.unlock();
+}
+
+void ControlWriteShadow::invalidateAll(void)
+{
+	EsifMutexHelper esifMutexHelper(&m_mutex);
+	esifMutexHelper.lock();
+	m_lastWrites.clear();
+	esifMutexHelper.unlock();
+}
+
+UInt64 ControlWriteShadow::getIssuedWriteCount(void) const
+{
+	EsifMutexHelper esifMutexHelper(&m_mutex);
+	esifMutexHelper.lock();
+	UInt64 count = m_issuedWriteCount;
+	esifMutexHelper.unlock();
+	return count;
+}
+
+UInt64 ControlWriteShadow::getSuppressedWriteCount(void) const
+{
+	EsifMutexHelper esifMutexHelper(&m_mutex);
+	esifMutexHelper.lock();
+	UInt64 count = m_suppressedWriteCount;
+	esifMutexHelper.unlock();
+	return count;
+}
+
+Bool ControlWriteShadow::isShadowed(esif_primitive_type primitive)
+{
+	// Only controls whose current value is owned by DPTF.  Primitives that notify the platform or that the platform
+	// can change without an event must always be written.  Display brightness (brightness keys), the RAPL and
+	// platform power limits (powercap) and the performance capability (intel_pstate max_perf_pct or cpufreq
+	// scaling_max_freq) are changed outside of DPTF without an event by thermald, TLP and power-profiles-daemon, so
+	// they are never shadowed.
+	switch (primitive)
+	{
+	case esif_primitive_type::SET_TSTATE_CURRENT:
+	case esif_primitive_type::SET_FAN_LEVEL:
+		return true;
+	default:
+		return false;
+	}
+}
+
+Bool ControlWriteShadow::isDirtiedBy(esif_primitive_type primitive, UIntN domainIndex, const CachedDataScope& scope)
+{
+	if (scope.includesDomain(domainIndex) == false)
+	{
+		return false;
+	}
+
+	switch (primitive)
+	{
+	case esif_primitive_type::SET_TSTATE_CURRENT:
+		return scope.includesCachedDataType(DomainCachedDataType::PerformanceControl);
+	default:
+		// fan speed has no cached data type, so only a scope covering the whole domain clears it
+		return scope.includesAllCachedDataTypes();
+	}
+}
@@ -0,0 +1,57 @@
+/******************************************************************************
+** Copyright (c) 2013-2020 Intel Corporation All Rights Reserved
+**
+** Licensed under the Apache License, Version 2.0 (the "License"); you may not
+** use this file except in compliance with the License.
+**
+** You may obtain a copy of the License at
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+** WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+******************************************************************************/
+#pragma once
+
+#include "Dptf.h"
+#include "esif_sdk_primitive_type.h"
+#include "CachedDataScope.h"
+#include "EsifMutex.h"
+#include <map>
+#include <tuple>
+
+// Remembers the last value successfully written to the control primitives that only DPTF changes, so writing the
+// same value again can be skipped.  An entry is dropped when a work item says the control's cached data may be stale
+// (resume, capability and external change events) and before every write in case the write fails part way.
+class ControlWriteShadow
+{
+public:
+	ControlWriteShadow();
+	~ControlWriteShadow();
+
+	Bool isRedundantWrite(esif_primitive_type primitive, UIntN domainIndex, UInt8 instance, UInt64 value);
+	void recordWrite(esif_primitive_type primitive, UIntN domainIndex, UInt8 instance, UInt64 value);
+	void invalidate(esif_primitive_type primitive, UIntN domainIndex, UInt8 instance);
+	void invalidate(const CachedDataScope& scope);
+	void invalidateDomain(UIntN domainIndex);
+	void invalidateAll(void);
+
+	// Every successful write recorded, shadowed or not, and the writes skipped as redundant
+	UInt64 getIssuedWriteCount(void) const;
+	UInt64 getSuppressedWriteCount(void) const;
+
+private:
+	typedef std::tuple<esif_primitive_type, UIntN, UInt8> WriteKey;
+
+	std::map<WriteKey, UInt64> m_lastWrites;
+	UInt64 m_issuedWriteCount;
+	UInt64 m_suppressedWriteCount;
+	mutable EsifMutex m_mutex;
+
+	static Bool isShadowed(esif_primitive_type primitive);
+	static Bool isDirtiedBy(esif_primitive_type primitive, UIntN domainIndex, const CachedDataScope& scope);
+};
@@ -69,6 +69,11 @@ std::string DeferredWorkItem::toXml(void) const
 	return m_workItem->toXml();
 }
 
+CachedDataScope DeferredWorkItem::getDirtiedCachedData(void) const
+{
+	return m_workItem->getDirtiedCachedData();
+}
+
 void DeferredWorkItem::execute(void)
 {
 	m_workItem->execute();
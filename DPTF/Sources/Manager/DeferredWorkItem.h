@@ -41,6 +41,7 @@ public:
 	virtual void signalAtCompletion(EsifSemaphore* semaphore) override;
 	virtual Bool matches(const WorkItemMatchCriteria& matchCriteria) const override;
 	virtual std::string toXml(void) const override;
+	virtual CachedDataScope getDirtiedCachedData(void) const override;
 	virtual void execute(void) override;
 	virtual void signal(void) override;
 
@@ -25,6 +25,12 @@ DeferredWorkItemQueue::DeferredWorkItemQueue(
 	ImmediateWorkItemQueue* immediateWorkItemQueue)
 	: m_queue()
 	, m_maxCount(0)
+	, m_coalescingSlack(TimeSpan::createFromMilliseconds(0))
+	, m_timerArmCount(0)
+	, m_timerFireCount(0)
+	, m_itemsFired(0)
+	, m_totalFireJitterMs(0)
+	, m_maxFireJitterMs(0)
 	, m_workItemQueueSemaphore(workItemQueueSemaphore)
 	, m_immediateQueue(immediateWorkItemQueue)
 	, m_timer(TimerCallback, this)
@@ -59,22 +65,26 @@ std::shared_ptr<DeferredWorkItem> DeferredWorkItemQueue::dequeue(void)
 	// Returns the first item in the queue if it the work item time is >= the current time.
 	EsifMutexHelper esifMutexHelper(&m_mutex);
 	esifMutexHelper.lock();
-	auto firstReadyWorkItem = getFirstReadyWorkItemFromQueue();
+	auto firstReadyWorkItem = getFirstReadyWorkItemFromQueue(EsifTime().getTimeStamp());
 	setTimer();
 	esifMutexHelper.unlock();
 	return firstReadyWorkItem;
 }
 
+void DeferredWorkItemQueue::setCoalescingSlack(const TimeSpan& slack)
+{
+	EsifMutexHelper esifMutexHelper(&m_mutex);
+	esifMutexHelper.lock();
+	m_coalescingSlack = slack;
+	esifMutexHelper.unlock();
+}
+
 void DeferredWorkItemQueue::makeEmtpy(void)
 {
 	EsifMutexHelper esifMutexHelper(&m_mutex);
 	esifMutexHelper.lock();
 	m_timer.cancelTimer();
-	while (m_queue.empty() == false)
-	{
-		auto currentWorkItem = m_queue.front();
-		m_queue.pop_front();
-	}
+	m_queue.clear();
 	esifMutexHelper.unlock();
 }
 
@@ -108,9 +118,9 @@ UIntN DeferredWorkItemQueue::removeIfMatches(const WorkItemMatchCriteria& matchC
 	auto it = m_queue.begin();
 	while (it != m_queue.end())
 	{
-		if ((*it)->matches(matchCriteria) == true)
+		if (it->second->matches(matchCriteria) == true)
 		{
-			(*it)->signal();
+			it->second->signal();
 			it = m_queue.erase(it);
 			numRemoved++;
 		}
@@ -135,6 +145,21 @@ std::shared_ptr<XmlNode> DeferredWorkItemQueue::getXml(void) const
 	auto deferredQueueStastics = XmlNode::createWrapperElement("deferred_queue_statistics");
 	deferredQueueStastics->addChild(XmlNode::createDataElement("current_count", std::to_string(m_queue.size())));
 	deferredQueueStastics->addChild(XmlNode::createDataElement("max_count", std::to_string(m_maxCount)));
+	deferredQueueStastics->addChild(
+		XmlNode::createDataElement("coalescing_slack_ms", std::to_string(m_coalescingSlack.asMillisecondsInt())));
+	deferredQueueStastics->addChild(XmlNode::createDataElement("timer_arm_count", std::to_string(m_timerArmCount)));
+	deferredQueueStastics->addChild(XmlNode::createDataElement("timer_fire_count", std::to_string(m_timerFireCount)));
+	deferredQueueStastics->addChild(XmlNode::createDataElement("items_fired", std::to_string(m_itemsFired)));
+
+	Int64 averageFireJitterMs = 0;
+	if (m_itemsFired > 0)
+	{
+		averageFireJitterMs = m_totalFireJitterMs / (Int64)m_itemsFired;
+	}
+	deferredQueueStastics->addChild(
+		XmlNode::createDataElement("average_fire_jitter_ms", std::to_string(averageFireJitterMs)));
+	deferredQueueStastics->addChild(
+		XmlNode::createDataElement("max_fire_jitter_ms", std::to_string(m_maxFireJitterMs)));
 
 	esifMutexHelper.unlock();
 
@@ -148,32 +173,49 @@ std::shared_ptr<XmlNode> DeferredWorkItemQueue::getXml(void) const
 
 void DeferredWorkItemQueue::setTimer(void)
 {
-	// Set the timer to expire when the first item in the queue is ready to process
+	// Set the timer to expire when the first item in the queue is ready to process.  The timer is left alone if it
+	// is already set to expire within the coalescing slack of the first item.
 
 	if (m_queue.empty() == false)
 	{
-		auto firstWorkItem = m_queue.front();
-		auto firstWorkItemTime = firstWorkItem->getDeferredProcessingTime();
+		auto firstWorkItemTime = m_queue.begin()->first;
+		if (isTimerArmedFor(firstWorkItemTime) == false)
+		{
+			m_timer.startTimer(firstWorkItemTime);
+			m_timerArmCount++;
+		}
+	}
+}
+
+Bool DeferredWorkItemQueue::isTimerArmedFor(const TimeSpan& expirationTime) const
+{
+	if (m_timer.isExpirationTimeValid() == false)
+	{
+		return false;
+	}
 
-		m_timer.startTimer(firstWorkItemTime);
+	auto timerExpirationTime = m_timer.getExpirationTime();
+	if (timerExpirationTime <= EsifTime().getTimeStamp())
+	{
+		// the timer has already fired
+		return false;
 	}
+
+	// A timer that fires early finds nothing ready and is set again, so only a timer that would fire later than
+	// the slack allows needs to be moved.
+	return (timerExpirationTime <= (expirationTime + m_coalescingSlack));
 }
 
-std::shared_ptr<DeferredWorkItem> DeferredWorkItemQueue::getFirstReadyWorkItemFromQueue(void)
+std::shared_ptr<DeferredWorkItem> DeferredWorkItemQueue::getFirstReadyWorkItemFromQueue(const TimeSpan& readyTime)
 {
 	std::shared_ptr<DeferredWorkItem> firstReadyWorkItem;
 	if (m_queue.empty() == false)
 	{
-		auto currentTime = EsifTime().getTimeStamp();
-		firstReadyWorkItem = m_queue.front();
-
-		if (firstReadyWorkItem->getDeferredProcessingTime() <= currentTime)
-		{
-			m_queue.pop_front();
-		}
-		else
+		auto firstItem = m_queue.begin();
+		if (firstItem->first <= readyTime)
 		{
-			firstReadyWorkItem = nullptr;
+			firstReadyWorkItem = firstItem->second;
+			m_queue.erase(firstItem);
 		}
 	}
 	return firstReadyWorkItem;
@@ -181,21 +223,7 @@ std::shared_ptr<DeferredWorkItem> DeferredWorkItemQueue::getFirstReadyWorkItemFr
 
 void DeferredWorkItemQueue::insertSortedByDeferredProcessingTime(std::shared_ptr<DeferredWorkItem> newWorkItem)
 {
-	auto it = m_queue.begin();
-	for (; it != m_queue.end(); it++)
-	{
-		auto currentWorkItem = *it;
-		if (currentWorkItem->getDeferredProcessingTime() > newWorkItem->getDeferredProcessingTime())
-		{
-			m_queue.insert(it, newWorkItem);
-			break;
-		}
-	}
-
-	if (it == m_queue.end())
-	{
-		m_queue.push_back(newWorkItem);
-	}
+	m_queue.insert(std::make_pair(newWorkItem->getDeferredProcessingTime(), newWorkItem));
 }
 
 void DeferredWorkItemQueue::updateMaxCount()
@@ -214,14 +242,20 @@ void DeferredWorkItemQueue::updateMaxCount()
 void DeferredWorkItemQueue::timerCallback(void)
 {
 	// The WorkItemQueueManager is not locked while this executes.
-	// Move the ready items to the immediate queue and signal the semaphore.
+	// Move the ready items to the immediate queue and signal the semaphore.  Items that are due within the
+	// coalescing slack are moved now as well so the timer doesn't have to be set again for them.
 
-	auto readyWorkItem = dequeue();
 	EsifMutexHelper esifMutexHelper(&m_mutex);
 	esifMutexHelper.lock();
 
+	m_timerFireCount++;
+	auto currentTime = EsifTime().getTimeStamp();
+	auto readyWorkItem = getFirstReadyWorkItemFromQueue(currentTime + m_coalescingSlack);
+
 	while (readyWorkItem != nullptr)
 	{
+		updateFireJitter(readyWorkItem->getDeferredProcessingTime(), currentTime);
+
 		try
 		{
 			auto immediateWorkItem = std::make_shared<ImmediateWorkItem>(readyWorkItem, 0);
@@ -230,13 +264,31 @@ void DeferredWorkItemQueue::timerCallback(void)
 		catch (...)
 		{
 		}
-		readyWorkItem = dequeue();
+		readyWorkItem = getFirstReadyWorkItemFromQueue(currentTime + m_coalescingSlack);
 	}
 
+	setTimer();
+
 	esifMutexHelper.unlock();
 	m_workItemQueueSemaphore->signal();
 }
 
+void DeferredWorkItemQueue::updateFireJitter(const TimeSpan& deferredProcessingTime, const TimeSpan& currentTime)
+{
+	Int64 jitterMs = (currentTime - deferredProcessingTime).asMillisecondsInt();
+	if (jitterMs < 0)
+	{
+		jitterMs = -jitterMs;
+	}
+
+	m_itemsFired++;
+	m_totalFireJitterMs += jitterMs;
+	if (jitterMs > m_maxFireJitterMs)
+	{
+		m_maxFireJitterMs = jitterMs;
+	}
+}
+
 void TimerCallback(void* context_ptr)
 {
 	DeferredWorkItemQueue* deferredWorkItemQueue = static_cast<DeferredWorkItemQueue*>(context_ptr);
@@ -36,6 +36,10 @@ public:
 	void enqueue(std::shared_ptr<DeferredWorkItem> newWorkItem);
 	std::shared_ptr<DeferredWorkItem> dequeue(void);
 
+	// Work items that are due within the slack of the timer expiring are moved to the immediate queue together
+	// instead of arming the timer again for each of them.  The default slack is 0.
+	void setCoalescingSlack(const TimeSpan& slack);
+
 	// implement WorkItemQueueInterface
 	virtual void makeEmtpy(void) override final;
 	virtual UInt64 getCount(void) const override final;
@@ -48,17 +52,28 @@ private:
 	DeferredWorkItemQueue(const DeferredWorkItemQueue& rhs);
 	DeferredWorkItemQueue& operator=(const DeferredWorkItemQueue& rhs);
 
-	std::list<std::shared_ptr<DeferredWorkItem>> m_queue;
+	// sorted by deferred processing time.  Items with the same time stay in the order they were inserted.
+	std::multimap<TimeSpan, std::shared_ptr<DeferredWorkItem>> m_queue;
 	UInt64 m_maxCount; // stores the maximum number of items in the queue at any one time
+	TimeSpan m_coalescingSlack;
+
+	// timer statistics
+	UInt64 m_timerArmCount;
+	UInt64 m_timerFireCount;
+	UInt64 m_itemsFired;
+	Int64 m_totalFireJitterMs; // absolute difference between when items were due and when they were moved
+	Int64 m_maxFireJitterMs;
 	mutable EsifMutex m_mutex;
 	EsifSemaphore* m_workItemQueueSemaphore;
 	ImmediateWorkItemQueue* m_immediateQueue;
 	EsifTimer m_timer;
 
 	void setTimer(void);
-	std::shared_ptr<DeferredWorkItem> getFirstReadyWorkItemFromQueue(void);
+	Bool isTimerArmedFor(const TimeSpan& expirationTime) const;
+	std::shared_ptr<DeferredWorkItem> getFirstReadyWorkItemFromQueue(const TimeSpan& readyTime);
 	void insertSortedByDeferredProcessingTime(std::shared_ptr<DeferredWorkItem> newWorkItem);
 	void updateMaxCount(void);
+	void updateFireJitter(const TimeSpan& deferredProcessingTime, const TimeSpan& currentTime);
 
 	// The timer will call a 'C' function which will need to forward the call to our private
 	// timerCallback method.  We set it up as a friend so it has access.
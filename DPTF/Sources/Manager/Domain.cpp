@@ -66,6 +66,8 @@ Domain::Domain(DptfManagerInterface* dptfManager)
 	, m_rfProfileCapabilities(nullptr)
 	, m_rfProfileData(nullptr)
 	, m_utilizationStatus(nullptr)
+	, m_cacheHitCount(DomainCachedDataType::MAX, 0)
+	, m_cacheMissCount(DomainCachedDataType::MAX, 0)
 {
 }
 
@@ -179,6 +181,72 @@ void Domain::clearDomainCachedData(void)
 	clearDomainCachedRequestData();
 }
 
+void Domain::clearDomainCachedData(DomainCachedDataType::Type cachedDataType)
+{
+	switch (cachedDataType)
+	{
+	case DomainCachedDataType::CoreControl:
+		clearDomainCachedDataCoreControl();
+		break;
+	case DomainCachedDataType::DisplayControl:
+		clearDomainCachedDataDisplayControl();
+		break;
+	case DomainCachedDataType::PerformanceControl:
+		clearDomainCachedDataPerformanceControl();
+		break;
+	case DomainCachedDataType::PowerControl:
+		clearDomainCachedDataPowerControl();
+		break;
+	case DomainCachedDataType::PowerStatus:
+		clearDomainCachedDataPowerStatus();
+		break;
+	case DomainCachedDataType::SystemPowerControl:
+		clearDomainCachedDataSystemPowerControl();
+		break;
+	case DomainCachedDataType::Priority:
+		clearDomainCachedDataPriority();
+		break;
+	case DomainCachedDataType::RfProfileControl:
+		clearDomainCachedDataRfProfileControl();
+		break;
+	case DomainCachedDataType::RfProfileStatus:
+		clearDomainCachedDataRfProfileStatus();
+		break;
+	case DomainCachedDataType::UtilizationStatus:
+		clearDomainCachedDataUtilizationStatus();
+		break;
+	case DomainCachedDataType::PlatformPowerStatus:
+		clearDomainCachedDataPlatformPowerStatus();
+		break;
+	default:
+		throw dptf_exception("Invalid domain cached data type.");
+	}
+}
+
+void Domain::clearDomainVolatileCachedData(void)
+{
+	m_dptfManager->getDptfStatus()->clearCache();
+	for (auto typeIndex = (UIntN)DomainCachedDataType::FIRST; typeIndex < DomainCachedDataType::MAX; typeIndex++)
+	{
+		auto cachedDataType = (DomainCachedDataType::Type)typeIndex;
+		if (DomainCachedDataType::isVolatile(cachedDataType))
+		{
+			clearDomainCachedData(cachedDataType);
+		}
+	}
+	clearDomainCachedRequestData();
+}
+
+UInt64 Domain::getCacheHitCount(DomainCachedDataType::Type cachedDataType) const
+{
+	return m_cacheHitCount.at(cachedDataType);
+}
+
+UInt64 Domain::getCacheMissCount(DomainCachedDataType::Type cachedDataType) const
+{
+	return m_cacheMissCount.at(cachedDataType);
+}
+
 void Domain::clearDomainCachedRequestData(void)
 {
 	DptfRequest clearCachedDataRequest(DptfRequestType::ClearCachedData, m_participantIndex, m_domainIndex);
@@ -221,8 +289,11 @@ std::shared_ptr<XmlNode> Domain::getDiagnosticsAsXml() const
 //}
 //
 // return *m_activeControlStaticCaps;
+//
+// It also counts the cache hits and misses for the cached data type (dt).
 
-#define FILL_CACHE_AND_RETURN(mv, ct, fn)                                                                              \
+#define FILL_CACHE_AND_RETURN(mv, ct, fn, dt)                                                                          \
+	updateCacheStatistics(dt, (mv != nullptr));                                                                        \
 	if (mv == nullptr)                                                                                                 \
 	{                                                                                                                  \
 		ct var = m_theRealParticipant->fn(m_participantIndex, m_domainIndex);                                          \
@@ -267,22 +338,29 @@ void Domain::setPowerShareEffectiveBias(UInt32 powerShareEffectiveBias)
 
 CoreControlStaticCaps Domain::getCoreControlStaticCaps(void)
 {
-	FILL_CACHE_AND_RETURN(m_coreControlStaticCaps, CoreControlStaticCaps, getCoreControlStaticCaps);
+	FILL_CACHE_AND_RETURN(
+		m_coreControlStaticCaps, CoreControlStaticCaps, getCoreControlStaticCaps, DomainCachedDataType::CoreControl);
 }
 
 CoreControlDynamicCaps Domain::getCoreControlDynamicCaps(void)
 {
-	FILL_CACHE_AND_RETURN(m_coreControlDynamicCaps, CoreControlDynamicCaps, getCoreControlDynamicCaps);
+	FILL_CACHE_AND_RETURN(
+		m_coreControlDynamicCaps, CoreControlDynamicCaps, getCoreControlDynamicCaps, DomainCachedDataType::CoreControl);
 }
 
 CoreControlLpoPreference Domain::getCoreControlLpoPreference(void)
 {
-	FILL_CACHE_AND_RETURN(m_coreControlLpoPreference, CoreControlLpoPreference, getCoreControlLpoPreference);
+	FILL_CACHE_AND_RETURN(
+		m_coreControlLpoPreference,
+		CoreControlLpoPreference,
+		getCoreControlLpoPreference,
+		DomainCachedDataType::CoreControl);
 }
 
 CoreControlStatus Domain::getCoreControlStatus(void)
 {
-	FILL_CACHE_AND_RETURN(m_coreControlStatus, CoreControlStatus, getCoreControlStatus);
+	FILL_CACHE_AND_RETURN(
+		m_coreControlStatus, CoreControlStatus, getCoreControlStatus, DomainCachedDataType::CoreControl);
 }
 
 void Domain::setActiveCoreControl(UIntN policyIndex, const CoreControlStatus& coreControlStatus)
@@ -316,7 +394,11 @@ void Domain::setActiveCoreControl(UIntN policyIndex, const CoreControlStatus& co
 
 DisplayControlDynamicCaps Domain::getDisplayControlDynamicCaps(void)
 {
-	FILL_CACHE_AND_RETURN(m_displayControlDynamicCaps, DisplayControlDynamicCaps, getDisplayControlDynamicCaps);
+	FILL_CACHE_AND_RETURN(
+		m_displayControlDynamicCaps,
+		DisplayControlDynamicCaps,
+		getDisplayControlDynamicCaps,
+		DomainCachedDataType::DisplayControl);
 }
 
 UIntN Domain::getUserPreferredDisplayIndex(void)
@@ -331,12 +413,14 @@ Bool Domain::isUserPreferredIndexModified()
 
 DisplayControlStatus Domain::getDisplayControlStatus(void)
 {
-	FILL_CACHE_AND_RETURN(m_displayControlStatus, DisplayControlStatus, getDisplayControlStatus);
+	FILL_CACHE_AND_RETURN(
+		m_displayControlStatus, DisplayControlStatus, getDisplayControlStatus, DomainCachedDataType::DisplayControl);
 }
 
 DisplayControlSet Domain::getDisplayControlSet(void)
 {
-	FILL_CACHE_AND_RETURN(m_displayControlSet, DisplayControlSet, getDisplayControlSet);
+	FILL_CACHE_AND_RETURN(
+		m_displayControlSet, DisplayControlSet, getDisplayControlSet, DomainCachedDataType::DisplayControl);
 }
 
 void Domain::setDisplayControl(UIntN policyIndex, UIntN displayControlIndex)
@@ -492,23 +576,37 @@ void Domain::setDCPeakPower(UIntN policyIndex, const Power& dcPeakPower)
 PerformanceControlStaticCaps Domain::getPerformanceControlStaticCaps(void)
 {
 	FILL_CACHE_AND_RETURN(
-		m_performanceControlStaticCaps, PerformanceControlStaticCaps, getPerformanceControlStaticCaps);
+		m_performanceControlStaticCaps,
+		PerformanceControlStaticCaps,
+		getPerformanceControlStaticCaps,
+		DomainCachedDataType::PerformanceControl);
 }
 
 PerformanceControlDynamicCaps Domain::getPerformanceControlDynamicCaps(void)
 {
 	FILL_CACHE_AND_RETURN(
-		m_performanceControlDynamicCaps, PerformanceControlDynamicCaps, getPerformanceControlDynamicCaps);
+		m_performanceControlDynamicCaps,
+		PerformanceControlDynamicCaps,
+		getPerformanceControlDynamicCaps,
+		DomainCachedDataType::PerformanceControl);
 }
 
 PerformanceControlStatus Domain::getPerformanceControlStatus(void)
 {
-	FILL_CACHE_AND_RETURN(m_performanceControlStatus, PerformanceControlStatus, getPerformanceControlStatus);
+	FILL_CACHE_AND_RETURN(
+		m_performanceControlStatus,
+		PerformanceControlStatus,
+		getPerformanceControlStatus,
+		DomainCachedDataType::PerformanceControl);
 }
 
 PerformanceControlSet Domain::getPerformanceControlSet(void)
 {
-	FILL_CACHE_AND_RETURN(m_performanceControlSet, PerformanceControlSet, getPerformanceControlSet);
+	FILL_CACHE_AND_RETURN(
+		m_performanceControlSet,
+		PerformanceControlSet,
+		getPerformanceControlSet,
+		DomainCachedDataType::PerformanceControl);
 }
 
 void Domain::setPerformanceControl(UIntN policyIndex, UIntN performanceControlIndex)
@@ -583,7 +681,11 @@ void Domain::setPerformanceCapsLock(UIntN policyIndex, Bool lock)
 
 PowerControlDynamicCapsSet Domain::getPowerControlDynamicCapsSet(void)
 {
-	FILL_CACHE_AND_RETURN(m_powerControlDynamicCapsSet, PowerControlDynamicCapsSet, getPowerControlDynamicCapsSet);
+	FILL_CACHE_AND_RETURN(
+		m_powerControlDynamicCapsSet,
+		PowerControlDynamicCapsSet,
+		getPowerControlDynamicCapsSet,
+		DomainCachedDataType::PowerControl);
 }
 
 void Domain::setPowerControlDynamicCapsSet(UIntN policyIndex, PowerControlDynamicCapsSet capsSet)
@@ -619,6 +721,7 @@ void Domain::setPowerControlDynamicCapsSet(UIntN policyIndex, PowerControlDynami
 Bool Domain::isPowerLimitEnabled(PowerControlType::Type controlType)
 {
 	auto enabled = m_powerLimitEnabled.find(controlType);
+	updateCacheStatistics(DomainCachedDataType::PowerControl, (enabled != m_powerLimitEnabled.end()));
 	if (enabled == m_powerLimitEnabled.end())
 	{
 		m_powerLimitEnabled[controlType] =
@@ -630,6 +733,7 @@ Bool Domain::isPowerLimitEnabled(PowerControlType::Type controlType)
 Power Domain::getPowerLimit(PowerControlType::Type controlType)
 {
 	auto limit = m_powerLimit.find(controlType);
+	updateCacheStatistics(DomainCachedDataType::PowerControl, (limit != m_powerLimit.end()));
 	if (limit == m_powerLimit.end())
 	{
 		m_powerLimit[controlType] = m_theRealParticipant->getPowerLimit(m_participantIndex, m_domainIndex, controlType);
@@ -689,6 +793,7 @@ void Domain::setPowerLimitIgnoringCaps(UIntN policyIndex, PowerControlType::Type
 TimeSpan Domain::getPowerLimitTimeWindow(PowerControlType::Type controlType)
 {
 	auto limit = m_powerLimitTimeWindow.find(controlType);
+	updateCacheStatistics(DomainCachedDataType::PowerControl, (limit != m_powerLimitTimeWindow.end()));
 	if (limit == m_powerLimitTimeWindow.end())
 	{
 		m_powerLimitTimeWindow[controlType] =
@@ -738,6 +843,7 @@ void Domain::setPowerLimitTimeWindowIgnoringCaps(
 Percentage Domain::getPowerLimitDutyCycle(PowerControlType::Type controlType)
 {
 	auto limit = m_powerLimitDutyCycle.find(controlType);
+	updateCacheStatistics(DomainCachedDataType::PowerControl, (limit != m_powerLimitDutyCycle.end()));
 	if (limit == m_powerLimitDutyCycle.end())
 	{
 		m_powerLimitDutyCycle[controlType] =
@@ -792,7 +898,7 @@ void Domain::setPowerCapsLock(UIntN policyIndex, Bool lock)
 
 Bool Domain::isPowerShareControl()
 {
-	FILL_CACHE_AND_RETURN(m_isPowerShareControl, Bool, isPowerShareControl);
+	FILL_CACHE_AND_RETURN(m_isPowerShareControl, Bool, isPowerShareControl, DomainCachedDataType::PowerControl);
 }
 
 double Domain::getPidKpTerm()
@@ -869,7 +975,7 @@ void Domain::removePowerLimitPolicyRequest(UIntN policyIndex, PowerControlType::
 
 PowerStatus Domain::getPowerStatus(void)
 {
-	FILL_CACHE_AND_RETURN(m_powerStatus, PowerStatus, getPowerStatus);
+	FILL_CACHE_AND_RETURN(m_powerStatus, PowerStatus, getPowerStatus, DomainCachedDataType::PowerStatus);
 }
 
 Power Domain::getAveragePower(const PowerControlDynamicCaps& capabilities)
@@ -885,6 +991,7 @@ void Domain::setCalculatedAveragePower(Power powerValue)
 Bool Domain::isSystemPowerLimitEnabled(PsysPowerLimitType::Type limitType)
 {
 	auto enabled = m_systemPowerLimitEnabled.find(limitType);
+	updateCacheStatistics(DomainCachedDataType::SystemPowerControl, (enabled != m_systemPowerLimitEnabled.end()));
 	if (enabled == m_systemPowerLimitEnabled.end())
 	{
 		m_systemPowerLimitEnabled[limitType] =
@@ -896,6 +1003,7 @@ Bool Domain::isSystemPowerLimitEnabled(PsysPowerLimitType::Type limitType)
 Power Domain::getSystemPowerLimit(PsysPowerLimitType::Type limitType)
 {
 	auto limit = m_systemPowerLimit.find(limitType);
+	updateCacheStatistics(DomainCachedDataType::SystemPowerControl, (limit != m_systemPowerLimit.end()));
 	if (limit == m_systemPowerLimit.end())
 	{
 		m_systemPowerLimit[limitType] =
@@ -936,6 +1044,7 @@ void Domain::setSystemPowerLimit(UIntN policyIndex, PsysPowerLimitType::Type lim
 TimeSpan Domain::getSystemPowerLimitTimeWindow(PsysPowerLimitType::Type limitType)
 {
 	auto timeWindow = m_systemPowerLimitTimeWindow.find(limitType);
+	updateCacheStatistics(DomainCachedDataType::SystemPowerControl, (timeWindow != m_systemPowerLimitTimeWindow.end()));
 	if (timeWindow == m_systemPowerLimitTimeWindow.end())
 	{
 		m_systemPowerLimitTimeWindow[limitType] =
@@ -980,6 +1089,7 @@ void Domain::setSystemPowerLimitTimeWindow(
 Percentage Domain::getSystemPowerLimitDutyCycle(PsysPowerLimitType::Type limitType)
 {
 	auto dutyCycle = m_systemPowerLimitDutyCycle.find(limitType);
+	updateCacheStatistics(DomainCachedDataType::SystemPowerControl, (dutyCycle != m_systemPowerLimitDutyCycle.end()));
 	if (dutyCycle == m_systemPowerLimitDutyCycle.end())
 	{
 		m_systemPowerLimitDutyCycle[limitType] =
@@ -1027,42 +1137,51 @@ void Domain::setPowerSharePolicyPower(const Power& powerSharePolicyPower)
 
 Power Domain::getPlatformRestOfPower(void)
 {
-	FILL_CACHE_AND_RETURN(m_platformRestOfPower, Power, getPlatformRestOfPower);
+	FILL_CACHE_AND_RETURN(
+		m_platformRestOfPower, Power, getPlatformRestOfPower, DomainCachedDataType::PlatformPowerStatus);
 }
 
 Power Domain::getAdapterPowerRating(void)
 {
-	FILL_CACHE_AND_RETURN(m_adapterRating, Power, getAdapterPowerRating);
+	FILL_CACHE_AND_RETURN(m_adapterRating, Power, getAdapterPowerRating, DomainCachedDataType::PlatformPowerStatus);
 }
 
 PlatformPowerSource::Type Domain::getPlatformPowerSource(void)
 {
-	FILL_CACHE_AND_RETURN(m_platformPowerSource, PlatformPowerSource::Type, getPlatformPowerSource);
+	FILL_CACHE_AND_RETURN(
+		m_platformPowerSource,
+		PlatformPowerSource::Type,
+		getPlatformPowerSource,
+		DomainCachedDataType::PlatformPowerStatus);
 }
 
 UInt32 Domain::getACNominalVoltage(void)
 {
-	FILL_CACHE_AND_RETURN(m_acNominalVoltage, UInt32, getACNominalVoltage);
+	FILL_CACHE_AND_RETURN(m_acNominalVoltage, UInt32, getACNominalVoltage, DomainCachedDataType::PlatformPowerStatus);
 }
 
 UInt32 Domain::getACOperationalCurrent(void)
 {
-	FILL_CACHE_AND_RETURN(m_acOperationalCurrent, UInt32, getACOperationalCurrent);
+	FILL_CACHE_AND_RETURN(
+		m_acOperationalCurrent, UInt32, getACOperationalCurrent, DomainCachedDataType::PlatformPowerStatus);
 }
 
 Percentage Domain::getAC1msPercentageOverload(void)
 {
-	FILL_CACHE_AND_RETURN(m_ac1msPercentageOverload, Percentage, getAC1msPercentageOverload);
+	FILL_CACHE_AND_RETURN(
+		m_ac1msPercentageOverload, Percentage, getAC1msPercentageOverload, DomainCachedDataType::PlatformPowerStatus);
 }
 
 Percentage Domain::getAC2msPercentageOverload(void)
 {
-	FILL_CACHE_AND_RETURN(m_ac2msPercentageOverload, Percentage, getAC2msPercentageOverload);
+	FILL_CACHE_AND_RETURN(
+		m_ac2msPercentageOverload, Percentage, getAC2msPercentageOverload, DomainCachedDataType::PlatformPowerStatus);
 }
 
 Percentage Domain::getAC10msPercentageOverload(void)
 {
-	FILL_CACHE_AND_RETURN(m_ac10msPercentageOverload, Percentage, getAC10msPercentageOverload);
+	FILL_CACHE_AND_RETURN(
+		m_ac10msPercentageOverload, Percentage, getAC10msPercentageOverload, DomainCachedDataType::PlatformPowerStatus);
 }
 
 void Domain::notifyForProchotDeassertion(void)
@@ -1072,12 +1191,16 @@ void Domain::notifyForProchotDeassertion(void)
 
 DomainPriority Domain::getDomainPriority(void)
 {
-	FILL_CACHE_AND_RETURN(m_domainPriority, DomainPriority, getDomainPriority);
+	FILL_CACHE_AND_RETURN(m_domainPriority, DomainPriority, getDomainPriority, DomainCachedDataType::Priority);
 }
 
 RfProfileCapabilities Domain::getRfProfileCapabilities(void)
 {
-	FILL_CACHE_AND_RETURN(m_rfProfileCapabilities, RfProfileCapabilities, getRfProfileCapabilities);
+	FILL_CACHE_AND_RETURN(
+		m_rfProfileCapabilities,
+		RfProfileCapabilities,
+		getRfProfileCapabilities,
+		DomainCachedDataType::RfProfileControl);
 }
 
 void Domain::setRfProfileCenterFrequency(UIntN policyIndex, const Frequency& centerFrequency)
@@ -1106,12 +1229,14 @@ Percentage Domain::getSscBaselineGuardBand()
 
 RfProfileDataSet Domain::getRfProfileDataSet(void)
 {
-	FILL_CACHE_AND_RETURN(m_rfProfileData, RfProfileDataSet, getRfProfileDataSet);
+	FILL_CACHE_AND_RETURN(
+		m_rfProfileData, RfProfileDataSet, getRfProfileDataSet, DomainCachedDataType::RfProfileStatus);
 }
 
 UtilizationStatus Domain::getUtilizationStatus(void)
 {
-	FILL_CACHE_AND_RETURN(m_utilizationStatus, UtilizationStatus, getUtilizationStatus);
+	FILL_CACHE_AND_RETURN(
+		m_utilizationStatus, UtilizationStatus, getUtilizationStatus, DomainCachedDataType::UtilizationStatus);
 }
 
 void Domain::clearDomainCachedDataCoreControl()
@@ -1191,3 +1316,15 @@ void Domain::clearDomainCachedDataSystemPowerControl()
 	m_systemPowerLimitTimeWindow.clear();
 	m_systemPowerLimitDutyCycle.clear();
 }
+
+void Domain::updateCacheStatistics(DomainCachedDataType::Type cachedDataType, Bool cacheHit)
+{
+	if (cacheHit)
+	{
+		m_cacheHitCount[cachedDataType]++;
+	}
+	else
+	{
+		m_cacheMissCount[cachedDataType]++;
+	}
+}
@@ -25,6 +25,7 @@
 #include "PsysPowerLimitType.h"
 #include "RfProfileDataSet.h"
 #include "DptfManagerInterface.h"
+#include "DomainCachedDataType.h"
 
 class Domain
 {
@@ -50,7 +51,11 @@ public:
 	// This will clear the cached data stored within this class in the framework.  It will not ask the
 	// actual domain to clear its cache.
 	void clearDomainCachedData(void);
+	void clearDomainCachedData(DomainCachedDataType::Type cachedDataType);
+	void clearDomainVolatileCachedData(void);
 	void clearDomainCachedRequestData(void);
+	UInt64 getCacheHitCount(DomainCachedDataType::Type cachedDataType) const;
+	UInt64 getCacheMissCount(DomainCachedDataType::Type cachedDataType) const;
 	void clearArbitrationDataForPolicy(UIntN policyIndex);
 	std::shared_ptr<XmlNode> getArbitrationXmlForPolicy(UIntN policyIndex, ControlFactoryType::Type type) const;
 
@@ -210,8 +215,7 @@ private:
 	Arbitrator* m_arbitrator;
 
 	//
-	// Cached data.
-	// FIXME:  consider adding a dirty bit to speed up clearing the cache.
+	// Cached data.  See DomainCachedDataType for which groups are cleared after every work item.
 	//
 
 	// Core controls
@@ -282,4 +286,8 @@ private:
 	void clearDomainCachedDataRfProfileStatus();
 	void clearDomainCachedDataUtilizationStatus();
 	void clearDomainCachedDataPlatformPowerStatus();
+
+	std::vector<UInt64> m_cacheHitCount;
+	std::vector<UInt64> m_cacheMissCount;
+	void updateCacheStatistics(DomainCachedDataType::Type cachedDataType, Bool cacheHit);
 };
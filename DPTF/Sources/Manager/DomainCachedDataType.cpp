@@ -0,0 +1,65 @@
+/******************************************************************************
+** Copyright (c) 2013-2020 Intel Corporation All Rights Reserved
+**
+** Licensed under the Apache License, Version 2.0 (the "License"); you may not
+** use this file except in compliance with the License.
+**
+** You may obtain a copy of the License at
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+** WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+******************************************************************************/
+
+
+#include "DomainCachedDataType.h"
+
+Bool DomainCachedDataType::isVolatile(Type cachedDataType)
+{
+	switch (cachedDataType)
+	{
+	case DomainCachedDataType::CoreControl:
+	case DomainCachedDataType::PerformanceControl:
+	case DomainCachedDataType::Priority:
+	case DomainCachedDataType::RfProfileControl:
+		return false;
+	default:
+		return true;
+	}
+}
+
+std::string DomainCachedDataType::toString(Type cachedDataType)
+{
+	switch (cachedDataType)
+	{
+	case DomainCachedDataType::CoreControl:
+		return "CoreControl";
+	case DomainCachedDataType::DisplayControl:
+		return "DisplayControl";
+	case DomainCachedDataType::PerformanceControl:
+		return "PerformanceControl";
+	case DomainCachedDataType::PowerControl:
+		return "PowerControl";
+	case DomainCachedDataType::PowerStatus:
+		return "PowerStatus";
+	case DomainCachedDataType::SystemPowerControl:
+		return "SystemPowerControl";
+	case DomainCachedDataType::Priority:
+		return "Priority";
+	case DomainCachedDataType::RfProfileControl:
+		return "RfProfileControl";
+	case DomainCachedDataType::RfProfileStatus:
+		return "RfProfileStatus";
+	case DomainCachedDataType::UtilizationStatus:
+		return "UtilizationStatus";
+	case DomainCachedDataType::PlatformPowerStatus:
+		return "PlatformPowerStatus";
+	default:
+		throw dptf_exception("Invalid domain cached data type.");
+	}
+}
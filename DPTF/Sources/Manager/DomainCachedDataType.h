@@ -0,0 +1,48 @@
+/******************************************************************************
+** Copyright (c) 2013-2020 Intel Corporation All Rights Reserved
+**
+** Licensed under the Apache License, Version 2.0 (the "License"); you may not
+** use this file except in compliance with the License.
+**
+** You may obtain a copy of the License at
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+** WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+******************************************************************************/
+
+
+#pragma once
+
+#include "Dptf.h"
+
+// Groups of data cached by Domain in the framework.  Volatile groups can change without the participant sending an
+// event, so they are cleared after every work item.  The other groups are only cleared when a work item declares
+// that it may have changed them or when a policy changes the control.
+namespace DomainCachedDataType
+{
+	enum Type
+	{
+		FIRST,
+		CoreControl = FIRST,
+		DisplayControl,
+		PerformanceControl,
+		PowerControl,
+		PowerStatus,
+		SystemPowerControl,
+		Priority,
+		RfProfileControl,
+		RfProfileStatus,
+		UtilizationStatus,
+		PlatformPowerStatus,
+		MAX
+	};
+
+	Bool isVolatile(Type cachedDataType);
+	std::string toString(Type cachedDataType);
+}
@@ -117,6 +117,7 @@ void DptfManager::createDptfManager(
 
 		m_eventCache = std::make_shared<EventCache>();
 		m_userPreferredCache = std::make_shared<UserPreferredCache>();
+		m_platformTableCache = std::make_shared<PlatformTableCache>();
 		m_indexContainer = new IndexContainer();
 		m_esifAppServices = new EsifAppServices(esifInterfacePtr);
 		m_esifServices = new EsifServices(this, esifHandle, m_esifAppServices, currentLogVerbosityLevel);
@@ -559,6 +560,11 @@ std::shared_ptr<UserPreferredCache> DptfManager::getUserPreferredCache(void) con
 	return m_userPreferredCache;
 }
 
+std::shared_ptr<PlatformTableCache> DptfManager::getPlatformTableCache(void) const
+{
+	return m_platformTableCache;
+}
+
 void DptfManager::bindDomainsToPolicies(UIntN participantIndex) const
 {
 	UIntN domainCount = m_participantManager->getParticipantPtr(participantIndex)->getDomainCount();
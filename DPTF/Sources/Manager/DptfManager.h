@@ -22,6 +22,7 @@
 #include "EsifAppServicesInterface.h"
 #include "EventCache.h"
 #include "UserPreferredCache.h"
+#include "PlatformTableCache.h"
 #include "CommandDispatcher.h"
 #include "FileIO.h"
 
@@ -59,6 +60,7 @@ public:
 	virtual EsifServicesInterface* getEsifServices(void) const override;
 	virtual std::shared_ptr<EventCache> getEventCache(void) const override;
 	virtual std::shared_ptr<UserPreferredCache> getUserPreferredCache(void) const override;
+	virtual std::shared_ptr<PlatformTableCache> getPlatformTableCache(void) const override;
 	virtual WorkItemQueueManagerInterface* getWorkItemQueueManager(void) const override;
 	virtual PolicyManagerInterface* getPolicyManager(void) const override;
 	virtual ParticipantManagerInterface* getParticipantManager(void) const override;
@@ -118,6 +120,7 @@ private:
 
 	std::shared_ptr<EventCache> m_eventCache;
 	std::shared_ptr<UserPreferredCache> m_userPreferredCache;
+	std::shared_ptr<PlatformTableCache> m_platformTableCache;
 
 	// Creates XML needed for requests from the UI
 	DptfStatusInterface* m_dptfStatus;
@@ -25,6 +25,7 @@
 #include "IndexContainerInterface.h"
 #include "EventCache.h"
 #include "UserPreferredCache.h"
+#include "PlatformTableCache.h"
 #include "CommandDispatcher.h"
 #include "RequestDispatcher.h"
 
@@ -51,6 +52,7 @@ public:
 	virtual EsifServicesInterface* getEsifServices(void) const = 0;
 	virtual std::shared_ptr<EventCache> getEventCache(void) const = 0;
 	virtual std::shared_ptr<UserPreferredCache> getUserPreferredCache(void) const = 0;
+	virtual std::shared_ptr<PlatformTableCache> getPlatformTableCache(void) const = 0;
 	virtual WorkItemQueueManagerInterface* getWorkItemQueueManager(void) const = 0;
 	virtual PolicyManagerInterface* getPolicyManager(void) const = 0;
 	virtual ParticipantManagerInterface* getParticipantManager(void) const = 0;
@@ -561,15 +561,14 @@ extern "C"
 		}
 		catch (...)
 		{
-			ManagerMessage message =
-				ManagerMessage(dptfManager, FLF, "Error while trying to convert event guid to DPTF framework event.");
-			if (guid.isValid())
-			{
-				message.setEsifEventGuid(guid);
-			}
-
 			if (dptfManager->getEsifServices()->getLoggingLevel() >= eLogTypeWarning)
 			{
+				ManagerMessage message = ManagerMessage(
+					dptfManager, FLF, "Error while trying to convert event guid to DPTF framework event.");
+				if (guid.isValid())
+				{
+					message.setEsifEventGuid(guid);
+				}
 				dptfManager->getEsifServices()->writeMessageWarning(message);
 			}
 			return ESIF_E_UNSPECIFIED;
@@ -583,23 +582,24 @@ extern "C"
 		// Added to help debug issue with missing temperature threshold events
 		if (frameworkEvent == FrameworkEvent::DomainTemperatureThresholdCrossed)
 		{
-			ManagerMessage temperatureMessage =
-				ManagerMessage(dptfManager, FLF, "Received temperature threshold crossed event");
-			temperatureMessage.setParticipantAndDomainIndex(participantIndex, domainIndex);
-			temperatureMessage.setFrameworkEvent(frameworkEvent);
 			if (dptfManager->getEsifServices()->getLoggingLevel() >= eLogTypeDebug)
 			{
+				ManagerMessage temperatureMessage =
+					ManagerMessage(dptfManager, FLF, "Received temperature threshold crossed event");
+				temperatureMessage.setParticipantAndDomainIndex(participantIndex, domainIndex);
+				temperatureMessage.setFrameworkEvent(frameworkEvent);
 				dptfManager->getEsifServices()->writeMessageDebug(
 					temperatureMessage, MessageCategory::TemperatureThresholds);
 			}
 		}
 #endif
 
-		ManagerMessage startMessage = ManagerMessage(dptfManager, FLF, "Received event notification from ESIF");
-		startMessage.setParticipantAndDomainIndex(participantIndex, domainIndex);
-		startMessage.setFrameworkEvent(frameworkEvent);
+		// Messages are only built once the logging level says they will be written
 		if (dptfManager->getEsifServices()->getLoggingLevel() >= eLogTypeInfo)
 		{
+			ManagerMessage startMessage = ManagerMessage(dptfManager, FLF, "Received event notification from ESIF");
+			startMessage.setParticipantAndDomainIndex(participantIndex, domainIndex);
+			startMessage.setFrameworkEvent(frameworkEvent);
 			dptfManager->getEsifServices()->writeMessageInfo(startMessage);
 		}
 
@@ -1099,11 +1099,11 @@ extern "C"
 				break;
 			default:
 			{
-				ManagerMessage message = ManagerMessage(dptfManager, FLF, "Received unexpected event");
-				message.setParticipantAndDomainIndex(participantIndex, domainIndex);
-				message.setFrameworkEvent(frameworkEvent);
 				if (dptfManager->getEsifServices()->getLoggingLevel() >= eLogTypeWarning)
 				{
+					ManagerMessage message = ManagerMessage(dptfManager, FLF, "Received unexpected event");
+					message.setParticipantAndDomainIndex(participantIndex, domainIndex);
+					message.setFrameworkEvent(frameworkEvent);
 					dptfManager->getEsifServices()->writeMessageWarning(message);
 				}
 				rc = ESIF_E_NOT_SUPPORTED;
@@ -1125,26 +1125,26 @@ extern "C"
 		}
 		catch (duplicate_work_item& ex)
 		{
-			ManagerMessage message =
-				ManagerMessage(dptfManager, FLF, "Discarding duplicate event.  Already in immediate queue.");
-			message.setParticipantAndDomainIndex(participantIndex, domainIndex);
-			message.setFrameworkEvent(frameworkEvent);
-			message.setExceptionCaught("WorkItemQueueManager::enqueueImmediateWorkItemAndReturn", ex.what());
 			if (dptfManager->getEsifServices()->getLoggingLevel() >= eLogTypeDebug)
 			{
+				ManagerMessage message =
+					ManagerMessage(dptfManager, FLF, "Discarding duplicate event.  Already in immediate queue.");
+				message.setParticipantAndDomainIndex(participantIndex, domainIndex);
+				message.setFrameworkEvent(frameworkEvent);
+				message.setExceptionCaught("WorkItemQueueManager::enqueueImmediateWorkItemAndReturn", ex.what());
 				dptfManager->getEsifServices()->writeMessageDebug(message);
 			}
 			rc = ESIF_OK;
 		}
 		catch (std::exception& ex)
 		{
-			ManagerMessage message = ManagerMessage(
-				dptfManager, FLF, "Error while trying to create work item for event received from ESIF.");
-			message.setParticipantAndDomainIndex(participantIndex, domainIndex);
-			message.setFrameworkEvent(frameworkEvent);
-			message.setExceptionCaught("DptfEvent", ex.what());
 			if (dptfManager->getEsifServices()->getLoggingLevel() >= eLogTypeWarning)
 			{
+				ManagerMessage message = ManagerMessage(
+					dptfManager, FLF, "Error while trying to create work item for event received from ESIF.");
+				message.setParticipantAndDomainIndex(participantIndex, domainIndex);
+				message.setFrameworkEvent(frameworkEvent);
+				message.setExceptionCaught("DptfEvent", ex.what());
 				dptfManager->getEsifServices()->writeMessageWarning(message);
 			}
 			rc = ESIF_E_UNSPECIFIED;
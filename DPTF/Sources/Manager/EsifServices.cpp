@@ -34,6 +34,8 @@
 #include "ManagerMessage.h"
 #include "ManagerLogger.h"
 #include "EsifDataTime.h"
+#include "EsifMutexHelper.h"
+#include <algorithm>
 
 using namespace std;
 
@@ -46,6 +48,10 @@ EsifServices::EsifServices(
 	, m_esifHandle(esifHandle)
 	, m_appServices(appServices)
 	, m_currentLogVerbosityLevel(currentLogVerbosityLevel)
+	, m_primitiveSizeHints()
+	, m_messagesWritten(0)
+	, m_totalMessageWriteTime(0)
+	, m_maxMessageWriteTime(0)
 {
 }
 
@@ -643,7 +649,8 @@ DptfBuffer EsifServices::primitiveExecuteGet(
 {
 	throwIfParticipantDomainCombinationInvalid(FLF, participantIndex, domainIndex);
 
-	DptfBuffer buffer(Constants::DefaultBufferSize);
+	UInt32 sizeHint = getPrimitiveSizeHint(primitive, participantIndex, domainIndex, instance);
+	DptfBuffer buffer(std::max((UInt32)Constants::DefaultBufferSize, sizeHint));
 	EsifDataContainer esifData(esifDataType, buffer.get(), buffer.size(), 0);
 	eEsifError rc = m_appServices->executePrimitive(
 		m_esifHandle,
@@ -656,6 +663,7 @@ DptfBuffer EsifServices::primitiveExecuteGet(
 		instance);
 	if (rc == ESIF_E_NEED_LARGER_BUFFER)
 	{
+		setPrimitiveSizeHint(primitive, participantIndex, domainIndex, instance, esifData.getDataLength());
 		buffer.allocate(esifData.getDataLength());
 		EsifDataContainer esifDataTryAgain(esifDataType, buffer.get(), buffer.size(), 0);
 		rc = m_appServices->executePrimitive(
@@ -675,6 +683,37 @@ DptfBuffer EsifServices::primitiveExecuteGet(
 	return buffer;
 }
 
+UInt32 EsifServices::getPrimitiveSizeHint(
+	esif_primitive_type primitive,
+	UIntN participantIndex,
+	UIntN domainIndex,
+	UInt8 instance)
+{
+	UInt32 sizeHint = 0;
+	EsifMutexHelper esifMutexHelper(&m_primitiveSizeHintsMutex);
+	esifMutexHelper.lock();
+	auto hint = m_primitiveSizeHints.find(std::make_tuple(primitive, participantIndex, domainIndex, instance));
+	if (hint != m_primitiveSizeHints.end())
+	{
+		sizeHint = hint->second;
+	}
+	esifMutexHelper.unlock();
+	return sizeHint;
+}
+
+void EsifServices::setPrimitiveSizeHint(
+	esif_primitive_type primitive,
+	UIntN participantIndex,
+	UIntN domainIndex,
+	UInt8 instance,
+	UInt32 size)
+{
+	EsifMutexHelper esifMutexHelper(&m_primitiveSizeHintsMutex);
+	esifMutexHelper.lock();
+	m_primitiveSizeHints[std::make_tuple(primitive, participantIndex, domainIndex, instance)] = size;
+	esifMutexHelper.unlock();
+}
+
 void EsifServices::primitiveExecuteSet(
 	esif_primitive_type primitive,
 	esif_data_type esifDataType,
@@ -744,6 +783,32 @@ eLogType EsifServices::getLoggingLevel(void)
 	return m_currentLogVerbosityLevel;
 }
 
+std::shared_ptr<XmlNode> EsifServices::getMessageLoggingStatisticsAsXml(void)
+{
+	EsifMutexHelper esifMutexHelper(&m_messageLoggingStatisticsMutex);
+	esifMutexHelper.lock();
+
+	auto loggingStatistics = XmlNode::createWrapperElement("message_logging_statistics");
+	loggingStatistics->addChild(XmlNode::createDataElement("messages_written", std::to_string(m_messagesWritten)));
+
+	UInt64 averageWriteTime = 0;
+	if (m_messagesWritten > 0)
+	{
+		averageWriteTime =
+			(UInt64)std::chrono::duration_cast<std::chrono::microseconds>(m_totalMessageWriteTime).count()
+			/ m_messagesWritten;
+	}
+	loggingStatistics->addChild(
+		XmlNode::createDataElement("average_write_time_us", std::to_string(averageWriteTime)));
+	loggingStatistics->addChild(XmlNode::createDataElement(
+		"max_write_time_us",
+		std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(m_maxMessageWriteTime).count())));
+
+	esifMutexHelper.unlock();
+
+	return loggingStatistics;
+}
+
 void EsifServices::registerEvent(FrameworkEvent::Type frameworkEvent, UIntN participantIndex, UIntN domainIndex)
 {
 	throwIfParticipantDomainCombinationInvalid(FLF, participantIndex, domainIndex);
@@ -818,6 +883,7 @@ void EsifServices::writeMessage(
 	{
 #endif
 
+		auto startTime = std::chrono::steady_clock::now();
 		m_appServices->writeLog(
 			m_esifHandle,
 			(const esif_handle_t)(UInt64)m_dptfManager,
@@ -825,6 +891,7 @@ void EsifServices::writeMessage(
 			ESIF_INVALID_HANDLE,
 			EsifDataString(message),
 			messageLevel);
+		updateMessageWriteTime(startTime);
 
 #ifdef ONLY_LOG_TEMPERATURE_THRESHOLDS
 	}
@@ -833,9 +900,9 @@ void EsifServices::writeMessage(
 }
 
 void EsifServices::throwIfNotSuccessful(
-	const std::string& fileName,
+	const char* fileName,
 	UIntN lineNumber,
-	const std::string& executingFunctionName,
+	const char* executingFunctionName,
 	eEsifError returnCode,
 	UIntN participantIndex,
 	UIntN domainIndex)
@@ -860,9 +927,9 @@ void EsifServices::throwIfNotSuccessful(
 }
 
 void EsifServices::throwIfNotSuccessful(
-	const std::string& fileName,
+	const char* fileName,
 	UIntN lineNumber,
-	const std::string& executingFunctionName,
+	const char* executingFunctionName,
 	eEsifError returnCode,
 	esif_primitive_type primitive,
 	UIntN participantIndex,
@@ -919,9 +986,9 @@ void EsifServices::throwIfNotSuccessful(
 }
 
 void EsifServices::throwIfNotSuccessful(
-	const std::string& fileName,
+	const char* fileName,
 	UIntN lineNumber,
-	const std::string& executingFunctionName,
+	const char* executingFunctionName,
 	eEsifError returnCode,
 	const std::string& messageText)
 {
@@ -945,9 +1012,9 @@ void EsifServices::throwIfNotSuccessful(
 }
 
 void EsifServices::throwIfParticipantDomainCombinationInvalid(
-	const std::string& fileName,
+	const char* fileName,
 	UIntN lineNumber,
-	const std::string& executingFunctionName,
+	const char* executingFunctionName,
 	UIntN participantIndex,
 	UIntN domainIndex)
 {
@@ -1003,3 +1070,18 @@ eEsifError EsifServices::sendCommand(UInt32 argc, EsifDataArray argv, EsifDataPt
 {
 	return m_appServices->sendCommand(m_esifHandle, (const esif_handle_t)(UInt64)m_dptfManager, argc, argv, response);
 }
+
+void EsifServices::updateMessageWriteTime(const std::chrono::steady_clock::time_point& startTime)
+{
+	auto writeTime = std::chrono::steady_clock::now() - startTime;
+
+	EsifMutexHelper esifMutexHelper(&m_messageLoggingStatisticsMutex);
+	esifMutexHelper.lock();
+	m_messagesWritten++;
+	m_totalMessageWriteTime += writeTime;
+	if (writeTime > m_maxMessageWriteTime)
+	{
+		m_maxMessageWriteTime = writeTime;
+	}
+	esifMutexHelper.unlock();
+}
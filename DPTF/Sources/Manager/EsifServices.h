@@ -19,6 +19,10 @@
 #pragma once
 
 #include "EsifServicesInterface.h"
+#include "EsifMutex.h"
+#include <map>
+#include <tuple>
+#include <chrono>
 
 class dptf_export EsifServices : public EsifServicesInterface
 {
@@ -193,6 +197,7 @@ public:
 		const std::string& message,
 		MessageCategory::Type messageCategory = MessageCategory::Default) override;
 	virtual eLogType getLoggingLevel(void) override;
+	virtual std::shared_ptr<XmlNode> getMessageLoggingStatisticsAsXml(void) override;
 
 	// Event registration
 
@@ -224,37 +229,61 @@ private:
 	EsifAppServicesInterface* m_appServices;
 	eLogType m_currentLogVerbosityLevel;
 
+	// Result size learned from ESIF_E_NEED_LARGER_BUFFER, keyed by primitive, participant, domain and instance, so
+	// the next call allocates a large enough buffer and the primitive is only executed once.
+	typedef std::tuple<esif_primitive_type, UIntN, UIntN, UInt8> PrimitiveSizeHintKey;
+	std::map<PrimitiveSizeHintKey, UInt32> m_primitiveSizeHints;
+	EsifMutex m_primitiveSizeHintsMutex;
+	UInt32 getPrimitiveSizeHint(
+		esif_primitive_type primitive,
+		UIntN participantIndex,
+		UIntN domainIndex,
+		UInt8 instance);
+	void setPrimitiveSizeHint(
+		esif_primitive_type primitive,
+		UIntN participantIndex,
+		UIntN domainIndex,
+		UInt8 instance,
+		UInt32 size);
+
+	// Cost of handing messages to ESIF, reported with the work item queue manager status
+	UInt64 m_messagesWritten;
+	std::chrono::nanoseconds m_totalMessageWriteTime;
+	std::chrono::nanoseconds m_maxMessageWriteTime;
+	EsifMutex m_messageLoggingStatisticsMutex;
+
 	void writeMessage(eLogType messageLevel, MessageCategory::Type messageCategory, const std::string& message);
+	void updateMessageWriteTime(const std::chrono::steady_clock::time_point& startTime);
 
 	std::string getParticipantName(UIntN participantIndex);
 	std::string getDomainName(UIntN participantIndex, UIntN domainIndex);
 
 	void throwIfNotSuccessful(
-		const std::string& fileName,
+		const char* fileName,
 		UIntN lineNumber,
-		const std::string& executingFunctionName,
+		const char* executingFunctionName,
 		eEsifError returnCode,
 		UIntN participantIndex,
 		UIntN domainIndex);
 	void throwIfNotSuccessful(
-		const std::string& fileName,
+		const char* fileName,
 		UIntN lineNumber,
-		const std::string& executingFunctionName,
+		const char* executingFunctionName,
 		eEsifError returnCode,
 		esif_primitive_type primitive,
 		UIntN participantIndex,
 		UIntN domainIndex,
 		UInt8 instance);
 	void throwIfNotSuccessful(
-		const std::string& fileName,
+		const char* fileName,
 		UIntN lineNumber,
-		const std::string& executingFunctionName,
+		const char* executingFunctionName,
 		eEsifError returnCode,
 		const std::string& messageText);
 	void throwIfParticipantDomainCombinationInvalid(
-		const std::string& fileName,
+		const char* fileName,
 		UIntN lineNumber,
-		const std::string& executingFunctionName,
+		const char* executingFunctionName,
 		UIntN participantIndex,
 		UIntN domainIndex);
 
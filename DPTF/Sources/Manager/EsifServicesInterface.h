@@ -28,6 +28,7 @@
 #include "MessageCategory.h"
 #include "DptfBuffer.h"
 #include "TimeSpan.h"
+#include "XmlNode.h"
 
 //
 // Implements the ESIF services interface which allows the framework to call into ESIF.  See the ESIF HLD for a
@@ -204,6 +205,7 @@ public:
 		const std::string& message,
 		MessageCategory::Type messageCategory = MessageCategory::Default) = 0;
 	virtual eLogType getLoggingLevel(void) = 0;
+	virtual std::shared_ptr<XmlNode> getMessageLoggingStatisticsAsXml(void) = 0;
 
 	// Event registration
 
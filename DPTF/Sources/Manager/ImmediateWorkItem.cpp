@@ -69,6 +69,11 @@ std::string ImmediateWorkItem::toXml(void) const
 	return m_workItem->toXml();
 }
 
+CachedDataScope ImmediateWorkItem::getDirtiedCachedData(void) const
+{
+	return m_workItem->getDirtiedCachedData();
+}
+
 void ImmediateWorkItem::execute(void)
 {
 	m_workItem->execute();
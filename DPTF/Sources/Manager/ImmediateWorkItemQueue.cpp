@@ -24,7 +24,13 @@ using namespace std;
 
 ImmediateWorkItemQueue::ImmediateWorkItemQueue(EsifSemaphore* workItemQueueSemaphore)
 	: m_queue()
+	, m_count(0)
 	, m_maxCount(0)
+	, m_participantsWithThresholdCrossedEvent()
+	, m_totalEnqueued(0)
+	, m_duplicatesRejected(0)
+	, m_totalEnqueueTime(0)
+	, m_maxEnqueueTime(0)
 	, m_workItemQueueSemaphore(workItemQueueSemaphore)
 {
 }
@@ -37,6 +43,8 @@ ImmediateWorkItemQueue::~ImmediateWorkItemQueue(void)
 
 void ImmediateWorkItemQueue::enqueue(std::shared_ptr<ImmediateWorkItem> newWorkItem)
 {
+	auto startTime = std::chrono::steady_clock::now();
+
 	EsifMutexHelper esifMutexHelper(&m_mutex);
 	esifMutexHelper.lock();
 
@@ -46,6 +54,7 @@ void ImmediateWorkItemQueue::enqueue(std::shared_ptr<ImmediateWorkItem> newWorkI
 
 	insertSortedByPriority(newWorkItem);
 	updateMaxCount();
+	updateEnqueueTime(startTime);
 
 	esifMutexHelper.unlock();
 }
@@ -57,10 +66,15 @@ std::shared_ptr<ImmediateWorkItem> ImmediateWorkItemQueue::dequeue(void)
 	EsifMutexHelper esifMutexHelper(&m_mutex);
 	esifMutexHelper.lock();
 
-	if (m_queue.empty() == false)
+	auto bucket = m_queue.begin();
+	if (bucket != m_queue.end())
 	{
-		firstItemInQueue = m_queue.front();
-		m_queue.pop_front();
+		firstItemInQueue = bucket->second.front();
+		removeFromQueue(bucket->second, bucket->second.begin());
+		if (bucket->second.empty() == true)
+		{
+			m_queue.erase(bucket);
+		}
 	}
 
 	esifMutexHelper.unlock();
@@ -73,10 +87,9 @@ void ImmediateWorkItemQueue::makeEmtpy(void)
 	EsifMutexHelper esifMutexHelper(&m_mutex);
 	esifMutexHelper.lock();
 
-	while (m_queue.empty() == false)
-	{
-		m_queue.pop_front();
-	}
+	m_queue.clear();
+	m_count = 0;
+	m_participantsWithThresholdCrossedEvent.clear();
 
 	esifMutexHelper.unlock();
 }
@@ -87,7 +100,7 @@ UInt64 ImmediateWorkItemQueue::getCount(void) const
 	EsifMutexHelper esifMutexHelper(&m_mutex);
 
 	esifMutexHelper.lock();
-	count = m_queue.size();
+	count = m_count;
 	esifMutexHelper.unlock();
 
 	return count;
@@ -112,20 +125,24 @@ UIntN ImmediateWorkItemQueue::removeIfMatches(const WorkItemMatchCriteria& match
 
 	UIntN numRemoved = 0;
 
-	auto it = m_queue.begin();
-	while (it != m_queue.end())
+	for (auto bucket = m_queue.begin(); bucket != m_queue.end(); bucket++)
 	{
-		if ((*it)->matches(matchCriteria) == true)
-		{
-			(*it)->getWorkItem()->signal();
-			it = m_queue.erase(it);
-			numRemoved++;
-		}
-		else
+		auto it = bucket->second.begin();
+		while (it != bucket->second.end())
 		{
-			it++;
+			if ((*it)->matches(matchCriteria) == true)
+			{
+				(*it)->getWorkItem()->signal();
+				it = removeFromQueue(bucket->second, it);
+				numRemoved++;
+			}
+			else
+			{
+				it++;
+			}
 		}
 	}
+	removeEmptyBuckets();
 
 	esifMutexHelper.unlock();
 
@@ -138,8 +155,24 @@ std::shared_ptr<XmlNode> ImmediateWorkItemQueue::getXml(void) const
 	esifMutexHelper.lock();
 
 	auto immediateQueueStastics = XmlNode::createWrapperElement("immediate_queue_statistics");
-	immediateQueueStastics->addChild(XmlNode::createDataElement("current_count", std::to_string(m_queue.size())));
+	immediateQueueStastics->addChild(XmlNode::createDataElement("current_count", std::to_string(m_count)));
 	immediateQueueStastics->addChild(XmlNode::createDataElement("max_count", std::to_string(m_maxCount)));
+	immediateQueueStastics->addChild(XmlNode::createDataElement("priority_levels", std::to_string(m_queue.size())));
+	immediateQueueStastics->addChild(XmlNode::createDataElement("total_enqueued", std::to_string(m_totalEnqueued)));
+	immediateQueueStastics->addChild(
+		XmlNode::createDataElement("duplicates_rejected", std::to_string(m_duplicatesRejected)));
+
+	UInt64 averageEnqueueTime = 0;
+	if (m_totalEnqueued > 0)
+	{
+		averageEnqueueTime =
+			(UInt64)std::chrono::duration_cast<std::chrono::microseconds>(m_totalEnqueueTime).count() / m_totalEnqueued;
+	}
+	immediateQueueStastics->addChild(
+		XmlNode::createDataElement("average_enqueue_time_us", std::to_string(averageEnqueueTime)));
+	immediateQueueStastics->addChild(XmlNode::createDataElement(
+		"max_enqueue_time_us",
+		std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(m_maxEnqueueTime).count())));
 
 	esifMutexHelper.unlock();
 
@@ -157,63 +190,87 @@ void ImmediateWorkItemQueue::throwIfDuplicateThermalThresholdCrossedEvent(
 	// FIXME: need to update once domain support has been added.  In that case we should
 	// check the domain field as well.
 
-	if (newWorkItem->getFrameworkEventType() == FrameworkEvent::DomainTemperatureThresholdCrossed)
+	if (isThresholdCrossedEvent(newWorkItem) == true)
 	{
-		auto workItem = newWorkItem->getWorkItem();
-		auto participantWorkItem = static_pointer_cast<ParticipantWorkItem>(workItem);
-
-		WorkItemMatchCriteria matchCriteria;
-		matchCriteria.addFrameworkEventTypeToMatchList(participantWorkItem->getFrameworkEventType());
-		matchCriteria.addParticipantIndexToMatchList(participantWorkItem->getParticipantIndex());
-
-		for (auto it = m_queue.begin(); it != m_queue.end(); it++)
+		auto participantIndex = getParticipantIndex(newWorkItem);
+		if (m_participantsWithThresholdCrossedEvent.find(participantIndex)
+			!= m_participantsWithThresholdCrossedEvent.end())
 		{
-			auto currentWorkItem = *it;
-			Bool foundDuplicate = currentWorkItem->matches(matchCriteria);
-			if (foundDuplicate == true)
-			{
-				throw duplicate_work_item(
-					"Attempted to insert duplicate thermal threshold crossed event into immediate queue.");
-			}
+			m_duplicatesRejected++;
+			throw duplicate_work_item(
+				"Attempted to insert duplicate thermal threshold crossed event into immediate queue.");
 		}
 	}
 }
 
 void ImmediateWorkItemQueue::insertSortedByPriority(std::shared_ptr<ImmediateWorkItem> newWorkItem)
 {
-	// To improve performance we check for the common cases first and skip the queue
-	// iteration when we can.
-	if (m_queue.empty() == true || newWorkItem->getPriority() == 0)
+	// Work items with the same priority are processed in the order they were inserted.
+	m_queue[newWorkItem->getPriority()].push_back(newWorkItem);
+	m_count++;
+	m_totalEnqueued++;
+
+	if (isThresholdCrossedEvent(newWorkItem) == true)
 	{
-		m_queue.push_back(newWorkItem);
+		m_participantsWithThresholdCrossedEvent.insert(getParticipantIndex(newWorkItem));
 	}
-	else
+
+	m_workItemQueueSemaphore->signal();
+}
+
+ImmediateWorkItemQueue::PriorityBucket::iterator ImmediateWorkItemQueue::removeFromQueue(
+	PriorityBucket& bucket,
+	PriorityBucket::iterator item)
+{
+	if (isThresholdCrossedEvent(*item) == true)
 	{
-		auto it = m_queue.begin();
+		m_participantsWithThresholdCrossedEvent.erase(getParticipantIndex(*item));
+	}
+
+	m_count--;
+	return bucket.erase(item);
+}
 
-		for (; it != m_queue.end(); it++)
+void ImmediateWorkItemQueue::removeEmptyBuckets(void)
+{
+	auto bucket = m_queue.begin();
+	while (bucket != m_queue.end())
+	{
+		if (bucket->second.empty() == true)
 		{
-			auto currentWorkItem = *it;
-			if (newWorkItem->getPriority() > currentWorkItem->getPriority())
-			{
-				m_queue.insert(it, newWorkItem);
-				break;
-			}
+			bucket = m_queue.erase(bucket);
 		}
-
-		if (it == m_queue.end())
+		else
 		{
-			m_queue.push_back(newWorkItem);
+			bucket++;
 		}
 	}
-
-	m_workItemQueueSemaphore->signal();
 }
 
 void ImmediateWorkItemQueue::updateMaxCount()
 {
-	if (m_queue.size() > m_maxCount)
+	if (m_count > m_maxCount)
 	{
-		m_maxCount = m_queue.size();
+		m_maxCount = m_count;
 	}
 }
+
+void ImmediateWorkItemQueue::updateEnqueueTime(const std::chrono::steady_clock::time_point& startTime)
+{
+	auto enqueueTime = std::chrono::steady_clock::now() - startTime;
+	m_totalEnqueueTime += enqueueTime;
+	if (enqueueTime > m_maxEnqueueTime)
+	{
+		m_maxEnqueueTime = enqueueTime;
+	}
+}
+
+Bool ImmediateWorkItemQueue::isThresholdCrossedEvent(std::shared_ptr<ImmediateWorkItem> workItem)
+{
+	return (workItem->getFrameworkEventType() == FrameworkEvent::DomainTemperatureThresholdCrossed);
+}
+
+UIntN ImmediateWorkItemQueue::getParticipantIndex(std::shared_ptr<ImmediateWorkItem> workItem)
+{
+	return static_pointer_cast<ParticipantWorkItem>(workItem->getWorkItem())->getParticipantIndex();
+}
@@ -23,6 +23,7 @@
 #include "ImmediateWorkItem.h"
 #include "EsifMutex.h"
 #include "EsifSemaphore.h"
+#include <chrono>
 
 class ImmediateWorkItemQueue : public WorkItemQueueInterface
 {
@@ -45,12 +46,30 @@ private:
 	ImmediateWorkItemQueue(const ImmediateWorkItemQueue& rhs);
 	ImmediateWorkItemQueue& operator=(const ImmediateWorkItemQueue& rhs);
 
-	std::list<std::shared_ptr<ImmediateWorkItem>> m_queue;
+	// Work items are kept in one FIFO bucket per priority and the buckets are ordered highest priority first.
+	// Inserting a work item only has to find its bucket instead of walking every item in the queue.
+	typedef std::list<std::shared_ptr<ImmediateWorkItem>> PriorityBucket;
+	std::map<UIntN, PriorityBucket, std::greater<UIntN>> m_queue;
+	UInt64 m_count;
 	UInt64 m_maxCount; // stores the maximum number of items in the queue at any one time
+
+	// participants that already have a temperature threshold crossed event in the queue
+	std::set<UIntN> m_participantsWithThresholdCrossedEvent;
+
+	UInt64 m_totalEnqueued;
+	UInt64 m_duplicatesRejected;
+	std::chrono::nanoseconds m_totalEnqueueTime;
+	std::chrono::nanoseconds m_maxEnqueueTime;
+
 	mutable EsifMutex m_mutex;
 	EsifSemaphore* m_workItemQueueSemaphore;
 
 	void throwIfDuplicateThermalThresholdCrossedEvent(std::shared_ptr<ImmediateWorkItem> newWorkItem);
 	void insertSortedByPriority(std::shared_ptr<ImmediateWorkItem> newWorkItem);
+	PriorityBucket::iterator removeFromQueue(PriorityBucket& bucket, PriorityBucket::iterator item);
+	void removeEmptyBuckets(void);
 	void updateMaxCount(void);
+	void updateEnqueueTime(const std::chrono::steady_clock::time_point& startTime);
+	static Bool isThresholdCrossedEvent(std::shared_ptr<ImmediateWorkItem> workItem);
+	static UIntN getParticipantIndex(std::shared_ptr<ImmediateWorkItem> workItem);
 };
@@ -22,7 +22,13 @@
 // Do not throw exceptions from within this file
 
 IndexContainer::IndexContainer()
+	: m_indexes()
+	, m_snapshot(nullptr)
+	, m_readerEpoch(0)
 {
+	m_activeReaders[0].store(0);
+	m_activeReaders[1].store(0);
+	m_snapshot = new IndexSnapshot;
 }
 
 IndexContainer::~IndexContainer(void)
@@ -30,12 +36,9 @@ IndexContainer::~IndexContainer(void)
 	EsifMutexHelper esifMutexHelper(&m_mutex);
 	esifMutexHelper.lock();
 
-	for (UIntN i = 0; i < m_vectorIndexStructPtr.size(); i++)
-	{
-		DELETE_MEMORY_TC(m_vectorIndexStructPtr[i]);
-	}
+	m_indexes.clear();
 
-	m_vectorIndexStructPtr.clear();
+	delete m_snapshot.exchange(nullptr);
 
 	esifMutexHelper.unlock();
 }
@@ -49,14 +52,15 @@ void IndexContainer::insertHandle(UIntN participantIndex,
 	EsifMutexHelper esifMutexHelper(&m_mutex);
 	esifMutexHelper.lock();
 
-	IndexStructPtr indexStructPtr = new IndexStruct;
+	IndexStruct indexStruct;
 
-	indexStructPtr->participantIndex = participantIndex;
-	indexStructPtr->domainIndex = domainIndex;
-	indexStructPtr->participantHandle = participantHandle;
-	indexStructPtr->domainHandle = domainHandle;
+	indexStruct.participantIndex = participantIndex;
+	indexStruct.domainIndex = domainIndex;
+	indexStruct.participantHandle = participantHandle;
+	indexStruct.domainHandle = domainHandle;
 
-	m_vectorIndexStructPtr.push_back(indexStructPtr);
+	m_indexes.push_back(indexStruct);
+	publishSnapshot();
 
 	esifMutexHelper.unlock();
 }
@@ -66,13 +70,13 @@ void IndexContainer::removeHandle(esif_handle_t participantHandle, esif_handle_t
 	EsifMutexHelper esifMutexHelper(&m_mutex);
 	esifMutexHelper.lock();
 
-	for (UIntN i = 0; i < m_vectorIndexStructPtr.size(); i++)
+	for (UIntN i = 0; i < m_indexes.size(); i++)
 	{
-		if ((m_vectorIndexStructPtr[i]->participantHandle == participantHandle) &&
-			(m_vectorIndexStructPtr[i]->domainHandle == domainHandle))
+		if ((m_indexes[i].participantHandle == participantHandle) &&
+			(m_indexes[i].domainHandle == domainHandle))
 		{
-			DELETE_MEMORY_TC(m_vectorIndexStructPtr[i]);
-			m_vectorIndexStructPtr.erase(m_vectorIndexStructPtr.begin() + i);
+			m_indexes.erase(m_indexes.begin() + i);
+			publishSnapshot();
 			break;
 		}
 	}
@@ -83,21 +87,14 @@ void IndexContainer::removeHandle(esif_handle_t participantHandle, esif_handle_t
 esif_handle_t IndexContainer::getParticipantHandle(UIntN participantIndex)
 {
 	esif_handle_t participantHandle = ESIF_INVALID_HANDLE;
-	UInt64 currentVectorSize = 0;
 
-	EsifMutexHelper esifMutexHelper(&m_mutex);
-	esifMutexHelper.lock();
-
-	currentVectorSize = m_vectorIndexStructPtr.size();
-	for (UIntN i = 0; i < currentVectorSize; i++)
+	UInt32 readerEpoch = 0;
+	auto snapshot = acquireSnapshot(readerEpoch);
+	if (participantIndex < snapshot->participantHandles.size())
 	{
-		if (m_vectorIndexStructPtr[i]->participantIndex == participantIndex)
-		{
-			participantHandle = m_vectorIndexStructPtr[i]->participantHandle;
-			break;
-		}
+		participantHandle = snapshot->participantHandles[participantIndex];
 	}
-	esifMutexHelper.unlock();
+	releaseSnapshot(readerEpoch);
 
 	return participantHandle;
 }
@@ -105,23 +102,15 @@ esif_handle_t IndexContainer::getParticipantHandle(UIntN participantIndex)
 esif_handle_t IndexContainer::getDomainHandle(UIntN participantIndex, UIntN domainIndex)
 {
 	esif_handle_t domainHandle = ESIF_INVALID_HANDLE;
-	UInt64 currentVectorSize = 0;
-
-	EsifMutexHelper esifMutexHelper(&m_mutex);
-	esifMutexHelper.lock();
-
-	currentVectorSize = m_vectorIndexStructPtr.size();
 
-	for (UIntN i = 0; i < currentVectorSize; i++)
+	UInt32 readerEpoch = 0;
+	auto snapshot = acquireSnapshot(readerEpoch);
+	if ((participantIndex < snapshot->domainHandles.size()) &&
+		(domainIndex < snapshot->domainHandles[participantIndex].size()))
 	{
-		if ((m_vectorIndexStructPtr[i]->participantIndex == participantIndex) &&
-			(m_vectorIndexStructPtr[i]->domainIndex == domainIndex))
-		{
-			domainHandle = m_vectorIndexStructPtr[i]->domainHandle;
-			break;
-		}
+		domainHandle = snapshot->domainHandles[participantIndex][domainIndex];
 	}
-	esifMutexHelper.unlock();
+	releaseSnapshot(readerEpoch);
 
 	return domainHandle;
 }
@@ -129,22 +118,15 @@ esif_handle_t IndexContainer::getDomainHandle(UIntN participantIndex, UIntN doma
 UIntN IndexContainer::getParticipantIndex(esif_handle_t participantHandle)
 {
 	UIntN participantIndex = Constants::Invalid;
-	UInt64 currentVectorSize = 0;
-
-	EsifMutexHelper esifMutexHelper(&m_mutex);
-	esifMutexHelper.lock();
 
-	currentVectorSize = m_vectorIndexStructPtr.size();
-
-	for (UIntN i = 0; i < currentVectorSize; i++)
+	UInt32 readerEpoch = 0;
+	auto snapshot = acquireSnapshot(readerEpoch);
+	auto index = snapshot->participantIndexes.find(participantHandle);
+	if (index != snapshot->participantIndexes.end())
 	{
-		if (m_vectorIndexStructPtr[i]->participantHandle == participantHandle)
-		{
-			participantIndex = m_vectorIndexStructPtr[i]->participantIndex;
-			break;
-		}
+		participantIndex = index->second;
 	}
-	esifMutexHelper.unlock();
+	releaseSnapshot(readerEpoch);
 
 	return participantIndex;
 }
@@ -152,23 +134,98 @@ UIntN IndexContainer::getParticipantIndex(esif_handle_t participantHandle)
 UIntN IndexContainer::getDomainIndex(esif_handle_t participantHandle, esif_handle_t domainHandle)
 {
 	UIntN domainIndex = Constants::Invalid;
-	UInt64 currentVectorSize = 0;
 
-	EsifMutexHelper esifMutexHelper(&m_mutex);
-	esifMutexHelper.lock();
+	UInt32 readerEpoch = 0;
+	auto snapshot = acquireSnapshot(readerEpoch);
+	auto index = snapshot->domainIndexes.find(std::make_pair(participantHandle, domainHandle));
+	if (index != snapshot->domainIndexes.end())
+	{
+		domainIndex = index->second;
+	}
+	releaseSnapshot(readerEpoch);
+
+	return domainIndex;
+}
+
+//
+// The following *private* methods that change the snapshot do not lock the mutex.  The caller is responsible for
+// locking and unlocking.
+//
+
+void IndexContainer::publishSnapshot(void)
+{
+	// Entries are applied in insertion order and only the first match is kept, which gives the same answers as
+	// searching m_indexes front to back.  Participant and domain indexes are allocated densely by the manager, so
+	// they are used directly as array positions.
+	IndexSnapshot* snapshot = new IndexSnapshot;
+
+	for (auto entry = m_indexes.begin(); entry != m_indexes.end(); ++entry)
+	{
+		if (entry->participantIndex != Constants::Invalid)
+		{
+			if (entry->participantIndex >= snapshot->participantHandles.size())
+			{
+				snapshot->participantHandles.resize(entry->participantIndex + 1, ESIF_INVALID_HANDLE);
+				snapshot->domainHandles.resize(entry->participantIndex + 1);
+			}
+			if (snapshot->participantHandles[entry->participantIndex] == ESIF_INVALID_HANDLE)
+			{
+				snapshot->participantHandles[entry->participantIndex] = entry->participantHandle;
+			}
+
+			if (entry->domainIndex != Constants::Invalid)
+			{
+				auto& domainHandles = snapshot->domainHandles[entry->participantIndex];
+				if (entry->domainIndex >= domainHandles.size())
+				{
+					domainHandles.resize(entry->domainIndex + 1, ESIF_INVALID_HANDLE);
+				}
+				if (domainHandles[entry->domainIndex] == ESIF_INVALID_HANDLE)
+				{
+					domainHandles[entry->domainIndex] = entry->domainHandle;
+				}
+			}
+		}
 
-	currentVectorSize = m_vectorIndexStructPtr.size();
+		snapshot->participantIndexes.insert(std::make_pair(entry->participantHandle, entry->participantIndex));
+		snapshot->domainIndexes.insert(
+			std::make_pair(std::make_pair(entry->participantHandle, entry->domainHandle), entry->domainIndex));
+	}
+
+	const IndexSnapshot* retiredSnapshot = m_snapshot.exchange(snapshot);
+	waitForReaders();
+	delete retiredSnapshot;
+}
 
-	for (UIntN i = 0; i < currentVectorSize; i++)
+void IndexContainer::waitForReaders(void)
+{
+	// Readers that can still hold the retired snapshot registered in the current epoch's slot; a reader registered
+	// in an earlier epoch was waited for by the change that ended that epoch.  New readers register in the next
+	// slot, so the wait only covers lookups already in progress.
+	UInt32 epoch = m_readerEpoch.fetch_add(1);
+	while (m_activeReaders[epoch % 2].load() != 0)
 	{
-		if ((m_vectorIndexStructPtr[i]->participantHandle == participantHandle) &&
-			(m_vectorIndexStructPtr[i]->domainHandle == domainHandle))
+		std::this_thread::yield();
+	}
+}
+
+const IndexContainer::IndexSnapshot* IndexContainer::acquireSnapshot(UInt32& readerEpoch)
+{
+	// Retry if a change ended the epoch before the registration was visible, since it may not wait for this reader
+	while (true)
+	{
+		readerEpoch = m_readerEpoch.load();
+		m_activeReaders[readerEpoch % 2].fetch_add(1);
+		if (m_readerEpoch.load() == readerEpoch)
 		{
-			domainIndex = m_vectorIndexStructPtr[i]->domainIndex;
 			break;
 		}
+		m_activeReaders[readerEpoch % 2].fetch_sub(1);
 	}
-	esifMutexHelper.unlock();
+	return m_snapshot.load();
+}
 
-	return domainIndex;
+void IndexContainer::releaseSnapshot(UInt32 readerEpoch)
+{
+	m_activeReaders[readerEpoch % 2].fetch_sub(1);
 }
\ No newline at end of file
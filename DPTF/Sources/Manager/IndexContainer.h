@@ -21,6 +21,9 @@
 #include "Dptf.h"
 #include "EsifMutex.h"
 #include "IndexContainerInterface.h"
+#include <atomic>
+#include <map>
+#include <thread>
 
 class IndexContainer : public IndexContainerInterface
 {
@@ -45,7 +48,28 @@ private:
 	IndexContainer(const IndexContainer& rhs);
 	IndexContainer& operator=(const IndexContainer& rhs);
 
+	// Read-only view of m_indexes that the lookups use without taking the mutex.  A new snapshot is published each
+	// time a handle is inserted or removed.
+	struct IndexSnapshot
+	{
+		std::vector<esif_handle_t> participantHandles;
+		std::vector<std::vector<esif_handle_t>> domainHandles;
+		std::map<esif_handle_t, UIntN> participantIndexes;
+		std::map<std::pair<esif_handle_t, esif_handle_t>, UIntN> domainIndexes;
+	};
+
 	EsifMutex m_mutex;
 
-	std::vector<IndexStructPtr> m_vectorIndexStructPtr;
+	std::vector<IndexStruct> m_indexes;
+
+	// Readers register in the slot of the current reader epoch.  Each change moves to the next epoch and waits for
+	// the previous slot to drain before freeing the snapshot it replaced, so readers arriving meanwhile never delay it.
+	std::atomic<const IndexSnapshot*> m_snapshot;
+	std::atomic<UInt32> m_readerEpoch;
+	std::atomic<UInt32> m_activeReaders[2];
+
+	void publishSnapshot(void);
+	void waitForReaders(void);
+	const IndexSnapshot* acquireSnapshot(UInt32& readerEpoch);
+	void releaseSnapshot(UInt32 readerEpoch);
 };
@@ -21,12 +21,12 @@
 // clang-format off
 #define _MANAGER_LOG_MESSAGE(logLevel, logFunction, content) \
 	do { \
-		unsigned int __line = __LINE__; \
-		const std::string& __file = __FILE__; \
-		const std::string& __function = ESIF_FUNC; \
 		if (getEsifServices()->getLoggingLevel() >= logLevel) \
 		{ \
-			auto _message = [=](const std::string& _file, unsigned int _line, const std::string& _function) {content}; \
+			unsigned int __line = __LINE__; \
+			const char* __file = __FILE__; \
+			const char* __function = ESIF_FUNC; \
+			auto _message = [=](const char* _file, unsigned int _line, const char* _function) {content}; \
 			getEsifServices()->logFunction(_message(__file, __line, __function)); \
 		} \
 	} while (0)
@@ -34,12 +34,12 @@
 #define _MANAGER_LOG_MESSAGE_EX(logLevel, logFunction, content) \
 	do { \
 		ex; \
-		unsigned int __line = __LINE__; \
-		const std::string& __file = __FILE__; \
-		const std::string& __function = ESIF_FUNC; \
 		if (getEsifServices()->getLoggingLevel() >= logLevel) \
 		{ \
-			auto _message = [=](const std::string& _file, unsigned int _line, const std::string& _function) {content}; \
+			unsigned int __line = __LINE__; \
+			const char* __file = __FILE__; \
+			const char* __function = ESIF_FUNC; \
+			auto _message = [=](const char* _file, unsigned int _line, const char* _function) {content}; \
 			getEsifServices()->logFunction(_message(__file, __line, __function)); \
 		} \
 	} while (0)
@@ -25,9 +25,9 @@
 
 ManagerMessage::ManagerMessage(
 	const DptfManagerInterface* dptfManager,
-	const std::string& fileName,
+	const char* fileName,
 	UIntN lineNumber,
-	const std::string& executingFunctionName)
+	const char* executingFunctionName)
 	: DptfMessage(fileName, lineNumber, executingFunctionName)
 	, m_dptfManager(dptfManager)
 	, m_outputMessageStringCreated(false)
@@ -37,9 +37,9 @@ ManagerMessage::ManagerMessage(
 
 ManagerMessage::ManagerMessage(
 	const DptfManagerInterface* dptfManager,
-	const std::string& fileName,
+	const char* fileName,
 	UIntN lineNumber,
-	const std::string& executingFunctionName,
+	const char* executingFunctionName,
 	const std::string& message)
 	: DptfMessage(fileName, lineNumber, executingFunctionName)
 	, m_dptfManager(dptfManager)
@@ -27,14 +27,14 @@ class ManagerMessage : public DptfMessage
 public:
 	ManagerMessage(
 		const DptfManagerInterface* dptfManager,
-		const std::string& fileName,
+		const char* fileName,
 		UIntN lineNumber,
-		const std::string& executingFunctionName);
+		const char* executingFunctionName);
 	ManagerMessage(
 		const DptfManagerInterface* dptfManager,
-		const std::string& fileName,
+		const char* fileName,
 		UIntN lineNumber,
-		const std::string& executingFunctionName,
+		const char* executingFunctionName,
 		const std::string& message);
 	ManagerMessage(const DptfManagerInterface* dptfManager, const DptfMessage& dptfMessage);
 	virtual ~ManagerMessage(void);
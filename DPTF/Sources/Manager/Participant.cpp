@@ -36,6 +36,7 @@ Participant::Participant(DptfManagerInterface* dptfManager)
 	, m_participantGuid(Guid())
 	, m_participantName(Constants::EmptyString)
 	, m_domains()
+	, m_controlWriteShadow()
 {
 }
 
@@ -182,6 +183,7 @@ void Participant::createDomain(UIntN domainIndex, const AppDomainDataPtr domainD
 		// create an instance of the domain class and save it at the first available index
 		std::shared_ptr<Domain> domain = std::make_shared<Domain>(m_dptfManager);
 		m_domains[domainIndex] = domain;
+		m_controlWriteShadow.invalidateDomain(domainIndex);
 
 		m_domains[domainIndex]->createDomain(
 			m_participantIndex, domainIndex, m_theRealParticipant, domainDataPtr, domainEnabled);
@@ -215,6 +217,7 @@ void Participant::destroyDomain(UIntN domainIndex)
 		}
 
 		m_domains.erase(domainIndex);
+		m_controlWriteShadow.invalidateDomain(domainIndex);
 	}
 }
 
@@ -267,6 +270,83 @@ void Participant::clearParticipantCachedData(void)
 		}
 	}
 	m_theRealParticipant->clearCachedResults();
+	m_controlWriteShadow.invalidateAll();
+}
+
+void Participant::clearParticipantCachedData(const CachedDataScope& scope)
+{
+	for (auto domain = m_domains.begin(); domain != m_domains.end(); ++domain)
+	{
+		if ((domain->second != nullptr) && scope.includesDomain(domain->first))
+		{
+			for (auto typeIndex = (UIntN)DomainCachedDataType::FIRST; typeIndex < DomainCachedDataType::MAX; typeIndex++)
+			{
+				auto cachedDataType = (DomainCachedDataType::Type)typeIndex;
+				if (scope.includesCachedDataType(cachedDataType))
+				{
+					domain->second->clearDomainCachedData(cachedDataType);
+				}
+			}
+		}
+	}
+}
+
+void Participant::clearParticipantVolatileCachedData(void)
+{
+	for (auto domain = m_domains.begin(); domain != m_domains.end(); ++domain)
+	{
+		if (domain->second != nullptr)
+		{
+			domain->second->clearDomainVolatileCachedData();
+		}
+	}
+	m_theRealParticipant->clearCachedResults();
+}
+
+ControlWriteShadow& Participant::getControlWriteShadow(void)
+{
+	return m_controlWriteShadow;
+}
+
+void Participant::invalidateControlWrites(const CachedDataScope& scope)
+{
+	m_controlWriteShadow.invalidate(scope);
+}
+
+UInt64 Participant::getControlWriteIssuedCount(void) const
+{
+	return m_controlWriteShadow.getIssuedWriteCount();
+}
+
+UInt64 Participant::getControlWriteSuppressedCount(void) const
+{
+	return m_controlWriteShadow.getSuppressedWriteCount();
+}
+
+UInt64 Participant::getCacheHitCount(DomainCachedDataType::Type cachedDataType) const
+{
+	UInt64 count = 0;
+	for (auto domain = m_domains.begin(); domain != m_domains.end(); ++domain)
+	{
+		if (domain->second != nullptr)
+		{
+			count += domain->second->getCacheHitCount(cachedDataType);
+		}
+	}
+	return count;
+}
+
+UInt64 Participant::getCacheMissCount(DomainCachedDataType::Type cachedDataType) const
+{
+	UInt64 count = 0;
+	for (auto domain = m_domains.begin(); domain != m_domains.end(); ++domain)
+	{
+		if (domain->second != nullptr)
+		{
+			count += domain->second->getCacheMissCount(cachedDataType);
+		}
+	}
+	return count;
 }
 
 void Participant::clearArbitrationDataForPolicy(UIntN policyIndex)
@@ -24,6 +24,8 @@
 #include "ParticipantServices.h"
 #include "PsysPowerLimitType.h"
 #include "RfProfileDataSet.h"
+#include "CachedDataScope.h"
+#include "ControlWriteShadow.h"
 class XmlNode;
 
 // TODO: add remaining methods to the interface and then use IParticipant everywhere
@@ -66,6 +68,16 @@ public:
 	// This will clear the cached data stored within the participant and associated domains within the framework.
 	// It will not ask the actual participant to clear any of its data.
 	void clearParticipantCachedData(void);
+	void clearParticipantCachedData(const CachedDataScope& scope);
+	void clearParticipantVolatileCachedData(void);
+	UInt64 getCacheHitCount(DomainCachedDataType::Type cachedDataType) const;
+	UInt64 getCacheMissCount(DomainCachedDataType::Type cachedDataType) const;
+
+	// Tracks the control values last written through the participant services so repeated writes can be skipped.
+	ControlWriteShadow& getControlWriteShadow(void);
+	void invalidateControlWrites(const CachedDataScope& scope);
+	UInt64 getControlWriteIssuedCount(void) const;
+	UInt64 getControlWriteSuppressedCount(void) const;
 
 	void clearArbitrationDataForPolicy(UIntN policyIndex);
 
@@ -313,6 +325,8 @@ private:
 
 	std::map<UIntN, std::shared_ptr<Domain>> m_domains;
 
+	ControlWriteShadow m_controlWriteShadow;
+
 	void throwIfDomainInvalid(UIntN domainIndex) const;
 	void throwIfRealParticipantIsInvalid() const;
 	EsifServicesInterface* getEsifServices() const;
@@ -24,10 +24,15 @@
 #include "MapOps.h"
 #include "Utility.h"
 #include "ManagerLogger.h"
+#include "XmlNode.h"
+#include "StatusFormat.h"
 
 ParticipantManager::ParticipantManager(DptfManagerInterface* dptfManager)
 	: m_dptfManager(dptfManager)
 	, m_participants()
+	, m_allDataClearCount(0)
+	, m_scopedDataClearCount(0)
+	, m_volatileDataClearCount(0)
 {
 }
 
@@ -144,6 +149,7 @@ Participant* ParticipantManager::getParticipantPtr(UIntN participantIndex) const
 
 void ParticipantManager::clearAllParticipantCachedData()
 {
+	m_allDataClearCount++;
 	m_dptfManager->getDptfStatus()->clearCache();
 	for (auto p = m_participants.begin(); p != m_participants.end(); p++)
 	{
@@ -154,11 +160,117 @@ void ParticipantManager::clearAllParticipantCachedData()
 	}
 }
 
+void ParticipantManager::clearParticipantCachedData(const CachedDataScope& scope)
+{
+	if (scope.includesAllData())
+	{
+		clearAllParticipantCachedData();
+		return;
+	}
+
+	// control writes are remembered across work items even for volatile data types
+	for (auto p = m_participants.begin(); p != m_participants.end(); p++)
+	{
+		if ((p->second != nullptr) && scope.includesParticipant(p->first))
+		{
+			p->second->invalidateControlWrites(scope);
+		}
+	}
+
+	if (scope.hasNonVolatileData() == false)
+	{
+		// volatile data is cleared after every work item anyway
+		return;
+	}
+
+	m_scopedDataClearCount++;
+	for (auto p = m_participants.begin(); p != m_participants.end(); p++)
+	{
+		if ((p->second != nullptr) && scope.includesParticipant(p->first))
+		{
+			p->second->clearParticipantCachedData(scope);
+		}
+	}
+}
+
+void ParticipantManager::clearVolatileParticipantCachedData(void)
+{
+	m_volatileDataClearCount++;
+	m_dptfManager->getDptfStatus()->clearCache();
+	for (auto p = m_participants.begin(); p != m_participants.end(); p++)
+	{
+		if (p->second != nullptr)
+		{
+			p->second->clearParticipantVolatileCachedData();
+		}
+	}
+}
+
 std::string ParticipantManager::GetStatusAsXml(void)
 {
 	throw implement_me();
 }
 
+std::shared_ptr<XmlNode> ParticipantManager::getCachedDataStatisticsAsXml(void) const
+{
+	auto cachedDataStatistics = XmlNode::createWrapperElement("cached_data_statistics");
+	cachedDataStatistics->addChild(
+		XmlNode::createDataElement("all_data_clear_count", std::to_string(m_allDataClearCount)));
+	cachedDataStatistics->addChild(
+		XmlNode::createDataElement("scoped_data_clear_count", std::to_string(m_scopedDataClearCount)));
+	cachedDataStatistics->addChild(
+		XmlNode::createDataElement("volatile_data_clear_count", std::to_string(m_volatileDataClearCount)));
+
+	UInt64 controlWriteIssuedCount = 0;
+	UInt64 controlWriteSuppressedCount = 0;
+	for (auto p = m_participants.begin(); p != m_participants.end(); p++)
+	{
+		if (p->second != nullptr)
+		{
+			controlWriteIssuedCount += p->second->getControlWriteIssuedCount();
+			controlWriteSuppressedCount += p->second->getControlWriteSuppressedCount();
+		}
+	}
+	cachedDataStatistics->addChild(
+		XmlNode::createDataElement("control_write_issued_count", std::to_string(controlWriteIssuedCount)));
+	cachedDataStatistics->addChild(
+		XmlNode::createDataElement("control_write_suppressed_count", std::to_string(controlWriteSuppressedCount)));
+
+	for (auto typeIndex = (UIntN)DomainCachedDataType::FIRST; typeIndex < DomainCachedDataType::MAX; typeIndex++)
+	{
+		auto cachedDataType = (DomainCachedDataType::Type)typeIndex;
+		UInt64 hitCount = 0;
+		UInt64 missCount = 0;
+		for (auto p = m_participants.begin(); p != m_participants.end(); p++)
+		{
+			if (p->second != nullptr)
+			{
+				hitCount += p->second->getCacheHitCount(cachedDataType);
+				missCount += p->second->getCacheMissCount(cachedDataType);
+			}
+		}
+
+		UInt64 hitRatioPercent = 0;
+		if ((hitCount + missCount) > 0)
+		{
+			hitRatioPercent = (hitCount * 100) / (hitCount + missCount);
+		}
+
+		auto cachedDataTypeStatistics = XmlNode::createWrapperElement("cached_data_type");
+		cachedDataTypeStatistics->addChild(
+			XmlNode::createDataElement("name", DomainCachedDataType::toString(cachedDataType)));
+		cachedDataTypeStatistics->addChild(XmlNode::createDataElement(
+			"volatile", StatusFormat::friendlyValue(DomainCachedDataType::isVolatile(cachedDataType))));
+		cachedDataTypeStatistics->addChild(XmlNode::createDataElement("hit_count", std::to_string(hitCount)));
+		cachedDataTypeStatistics->addChild(XmlNode::createDataElement("miss_count", std::to_string(missCount)));
+		cachedDataTypeStatistics->addChild(
+			XmlNode::createDataElement("hit_ratio_percent", std::to_string(hitRatioPercent)));
+		cachedDataStatistics->addChild(cachedDataTypeStatistics);
+	}
+
+	return cachedDataStatistics;
+}
+
 std::shared_ptr<IParticipant> ParticipantManager::getParticipant(const std::string& participantName) const
 {
 	for (auto p = m_participants.begin(); p != m_participants.end(); p++)
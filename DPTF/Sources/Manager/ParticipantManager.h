@@ -41,9 +41,14 @@ public:
 	// This will clear the cached data stored within all participants *within* the framework.  It will not ask the
 	// actual participants to clear their caches.
 	virtual void clearAllParticipantCachedData() override;
+
+	// Clears only the data in the scope.  Volatile data is cleared by clearVolatileParticipantCachedData.
+	virtual void clearParticipantCachedData(const CachedDataScope& scope) override;
+	virtual void clearVolatileParticipantCachedData(void) override;
 	virtual Bool participantExists(const std::string& participantName) const override;
 	virtual std::shared_ptr<IParticipant> getParticipant(const std::string& participantName) const override;
 	virtual std::string GetStatusAsXml(void) override;
+	virtual std::shared_ptr<XmlNode> getCachedDataStatisticsAsXml(void) const override;
 
 private:
 	// hide the copy constructor and assignment operator.
@@ -53,4 +58,8 @@ private:
 	DptfManagerInterface* m_dptfManager;
 	EsifServicesInterface* getEsifServices();
 	std::map<UIntN, std::shared_ptr<Participant>> m_participants;
+
+	UInt64 m_allDataClearCount;
+	UInt64 m_scopedDataClearCount;
+	UInt64 m_volatileDataClearCount;
 };
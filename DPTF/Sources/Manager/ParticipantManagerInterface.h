@@ -39,8 +39,11 @@ public:
 	virtual std::set<UIntN> getParticipantIndexes(void) const = 0;
 	virtual Participant* getParticipantPtr(UIntN participantIndex) const = 0;
 	virtual void clearAllParticipantCachedData() = 0;
+	virtual void clearParticipantCachedData(const CachedDataScope& scope) = 0;
+	virtual void clearVolatileParticipantCachedData(void) = 0;
 	virtual Bool participantExists(const std::string& participantName) const = 0;
 	virtual std::shared_ptr<IParticipant> getParticipant(const std::string& participantName) const = 0;
 
 	virtual std::string GetStatusAsXml(void) = 0;
+	virtual std::shared_ptr<XmlNode> getCachedDataStatisticsAsXml(void) const = 0;
 };
@@ -50,7 +50,12 @@ void ParticipantServices::primitiveExecuteSetAsUInt8(
 	UInt8 instance)
 {
 	throwIfNotWorkItemThread();
+	if (isRedundantControlWrite(primitive, value, domainIndex, instance))
+	{
+		return;
+	}
 	m_esifServices->primitiveExecuteSetAsUInt8(primitive, value, m_participantIndex, domainIndex, instance);
+	recordControlWrite(primitive, value, domainIndex, instance);
 }
 
 UInt32 ParticipantServices::primitiveExecuteGetAsUInt32(
@@ -69,7 +74,12 @@ void ParticipantServices::primitiveExecuteSetAsUInt32(
 	UInt8 instance)
 {
 	throwIfNotWorkItemThread();
+	if (isRedundantControlWrite(primitive, value, domainIndex, instance))
+	{
+		return;
+	}
 	m_esifServices->primitiveExecuteSetAsUInt32(primitive, value, m_participantIndex, domainIndex, instance);
+	recordControlWrite(primitive, value, domainIndex, instance);
 }
 
 UInt64 ParticipantServices::primitiveExecuteGetAsUInt64(
@@ -88,7 +98,12 @@ void ParticipantServices::primitiveExecuteSetAsUInt64(
 	UInt8 instance)
 {
 	throwIfNotWorkItemThread();
+	if (isRedundantControlWrite(primitive, value, domainIndex, instance))
+	{
+		return;
+	}
 	m_esifServices->primitiveExecuteSetAsUInt64(primitive, value, m_participantIndex, domainIndex, instance);
+	recordControlWrite(primitive, value, domainIndex, instance);
 }
 
 Temperature ParticipantServices::primitiveExecuteGetAsTemperatureTenthK(
@@ -127,7 +142,12 @@ void ParticipantServices::primitiveExecuteSetAsPercentage(
 	UInt8 instance)
 {
 	throwIfNotWorkItemThread();
+	if (percentage.isValid() && isRedundantControlWrite(primitive, percentage.toCentiPercent(), domainIndex, instance))
+	{
+		return;
+	}
 	m_esifServices->primitiveExecuteSetAsPercentage(primitive, percentage, m_participantIndex, domainIndex, instance);
+	recordControlWrite(primitive, percentage.toCentiPercent(), domainIndex, instance);
 }
 
 Frequency ParticipantServices::primitiveExecuteGetAsFrequency(
@@ -162,7 +182,12 @@ void ParticipantServices::primitiveExecuteSetAsPower(
 	UInt8 instance)
 {
 	throwIfNotWorkItemThread();
+	if (power.isValid() && isRedundantControlWrite(primitive, (UInt32)power, domainIndex, instance))
+	{
+		return;
+	}
 	m_esifServices->primitiveExecuteSetAsPower(primitive, power, m_participantIndex, domainIndex, instance);
+	recordControlWrite(primitive, (UInt32)power, domainIndex, instance);
 }
 
 TimeSpan ParticipantServices::primitiveExecuteGetAsTimeInMilliseconds(
@@ -182,7 +207,12 @@ void ParticipantServices::primitiveExecuteSetAsTimeInMilliseconds(
 	UInt8 instance /*= Constants::Esif::NoInstance*/)
 {
 	throwIfNotWorkItemThread();
+	if (time.isValid() && isRedundantControlWrite(primitive, (UInt64)time.asMillisecondsInt(), domainIndex, instance))
+	{
+		return;
+	}
 	m_esifServices->primitiveExecuteSetAsTimeInMilliseconds(primitive, time, m_participantIndex, domainIndex, instance);
+	recordControlWrite(primitive, (UInt64)time.asMillisecondsInt(), domainIndex, instance);
 }
 
 std::string ParticipantServices::primitiveExecuteGetAsString(
@@ -228,6 +258,32 @@ void ParticipantServices::primitiveExecuteSet(
 		primitive, esifDataType, bufferPtr, bufferLength, dataLength, m_participantIndex, domainIndex, instance);
 }
 
+Bool ParticipantServices::isRedundantControlWrite(
+	esif_primitive_type primitive,
+	UInt64 value,
+	UIntN domainIndex,
+	UInt8 instance)
+{
+	auto& controlWrites = m_participant->getControlWriteShadow();
+	if (controlWrites.isRedundantWrite(primitive, domainIndex, instance, value))
+	{
+		return true;
+	}
+
+	// forget the last value until this write succeeds
+	controlWrites.invalidate(primitive, domainIndex, instance);
+	return false;
+}
+
+void ParticipantServices::recordControlWrite(
+	esif_primitive_type primitive,
+	UInt64 value,
+	UIntN domainIndex,
+	UInt8 instance)
+{
+	m_participant->getControlWriteShadow().recordWrite(primitive, domainIndex, instance, value);
+}
+
 void ParticipantServices::writeMessageFatal(const DptfMessage& message)
 {
 	throwIfNotWorkItemThread();
@@ -192,5 +192,7 @@ private:
 	UIntN m_participantIndex;
 
 	void throwIfNotWorkItemThread(void);
+	Bool isRedundantControlWrite(esif_primitive_type primitive, UInt64 value, UIntN domainIndex, UInt8 instance);
+	void recordControlWrite(esif_primitive_type primitive, UInt64 value, UIntN domainIndex, UInt8 instance);
 	EsifServicesInterface* getEsifServices();
 };
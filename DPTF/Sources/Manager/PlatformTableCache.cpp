@@ -0,0 +1,94 @@
+/******************************************************************************
+** Copyright (c) 2013-2020 Intel Corporation All Rights Reserved
+**
+** Licensed under the Apache License, Version 2.0 (the "License"); you may not
+** use this file except in compliance with the License.
+**
+** You may obtain a copy of the License at
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+** WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+******************************************************************************/
+#include "PlatformTableCache.h"
+#include "EsifMutexHelper.h"
+
+// 64-bit FNV-1a
+static const UInt64 FnvOffsetBasis = 0xcbf29ce484222325ULL;
+static const UInt64 FnvPrime = 0x100000001b3ULL;
+
+PlatformTableCache::PlatformTableCache()
+	: m_tables()
+	, m_mutex()
+{
+}
+
+PlatformTableCache::~PlatformTableCache()
+{
+}
+
+Bool PlatformTableCache::get(esif_primitive_type primitive, DptfBuffer& table, UInt64& hash) const
+{
+	Bool found = false;
+	EsifMutexHelper esifMutexHelper(&m_mutex);
+	esifMutexHelper.lock();
+
+	auto cachedTable = m_tables.find(primitive);
+	if (cachedTable != m_tables.end())
+	{
+		table = cachedTable->second.table;
+		hash = cachedTable->second.hash;
+		found = true;
+	}
+
+	esifMutexHelper.unlock();
+	return found;
+}
+
+UInt64 PlatformTableCache::set(esif_primitive_type primitive, const DptfBuffer& table)
+{
+	CachedTable cachedTable;
+	cachedTable.table = table;
+	cachedTable.hash = calculateHash(table);
+
+	EsifMutexHelper esifMutexHelper(&m_mutex);
+	esifMutexHelper.lock();
+	m_tables[primitive] = cachedTable;
+	esifMutexHelper.unlock();
+
+	return cachedTable.hash;
+}
+
+void PlatformTableCache::invalidate(esif_primitive_type primitive)
+{
+	EsifMutexHelper esifMutexHelper(&m_mutex);
+	esifMutexHelper.lock();
+	m_tables.erase(primitive);
+	esifMutexHelper.unlock();
+}
+
+void PlatformTableCache::invalidateAll(void)
+{
+	EsifMutexHelper esifMutexHelper(&m_mutex);
+	esifMutexHelper.lock();
+	m_tables.clear();
+	esifMutexHelper.unlock();
+}
+
+UInt64 PlatformTableCache::calculateHash(const DptfBuffer& table)
+{
+	UInt64 hash = FnvOffsetBasis;
+	const UInt8* data = table.get();
+	UInt32 size = table.size();
+	for (UInt32 i = 0; i < size; i++)
+	{
+		hash ^= data[i];
+		hash *= FnvPrime;
+	}
+	return hash;
+}
@@ -0,0 +1,54 @@
+/******************************************************************************
+** Copyright (c) 2013-2020 Intel Corporation All Rights Reserved
+**
+** Licensed under the Apache License, Version 2.0 (the "License"); you may not
+** use this file except in compliance with the License.
+**
+** You may obtain a copy of the License at
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+** WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+******************************************************************************/
+#pragma once
+
+#include "Dptf.h"
+#include "esif_sdk_primitive_type.h"
+#include "DptfBuffer.h"
+#include "EsifMutex.h"
+#include <map>
+
+//
+// Holds the most recently read copy of each platform table (TRT, ART, PSVT) along with a hash of its contents.  The
+// cache is invalidated when the table changed event arrives or the table is written, so policies only pay for the
+// ESIF read when the table actually may have changed and can compare hashes to skip re-parsing identical tables.
+//
+
+class dptf_export PlatformTableCache
+{
+public:
+	PlatformTableCache();
+	~PlatformTableCache();
+
+	Bool get(esif_primitive_type primitive, DptfBuffer& table, UInt64& hash) const;
+	UInt64 set(esif_primitive_type primitive, const DptfBuffer& table);
+	void invalidate(esif_primitive_type primitive);
+	void invalidateAll(void);
+
+	static UInt64 calculateHash(const DptfBuffer& table);
+
+private:
+	struct CachedTable
+	{
+		DptfBuffer table;
+		UInt64 hash;
+	};
+
+	std::map<esif_primitive_type, CachedTable> m_tables;
+	mutable EsifMutex m_mutex;
+};
@@ -72,7 +72,8 @@ DptfBuffer PolicyServicesPlatformConfigurationData::getActiveRelationshipTable(v
 {
 	throwIfNotWorkItemThread();
 
-	return getEsifServices()->primitiveExecuteGet(esif_primitive_type::GET_ACTIVE_RELATIONSHIP_TABLE, ESIF_DATA_BINARY);
+	UInt64 hash = 0;
+	return getCachedPlatformTable(esif_primitive_type::GET_ACTIVE_RELATIONSHIP_TABLE, hash);
 }
 
 void PolicyServicesPlatformConfigurationData::setActiveRelationshipTable(DptfBuffer data)
@@ -88,14 +89,24 @@ void PolicyServicesPlatformConfigurationData::setActiveRelationshipTable(DptfBuf
 		Constants::Esif::NoParticipant,
 		Constants::Esif::NoDomain,
 		Constants::Esif::NoPersistInstance);
+	invalidateCachedPlatformTable(esif_primitive_type::GET_ACTIVE_RELATIONSHIP_TABLE);
+}
+
+UInt64 PolicyServicesPlatformConfigurationData::getActiveRelationshipTableHash(void)
+{
+	throwIfNotWorkItemThread();
+
+	UInt64 hash = 0;
+	getCachedPlatformTable(esif_primitive_type::GET_ACTIVE_RELATIONSHIP_TABLE, hash);
+	return hash;
 }
 
 DptfBuffer PolicyServicesPlatformConfigurationData::getThermalRelationshipTable(void)
 {
 	throwIfNotWorkItemThread();
 
-	return getEsifServices()->primitiveExecuteGet(
-		esif_primitive_type::GET_THERMAL_RELATIONSHIP_TABLE, ESIF_DATA_BINARY);
+	UInt64 hash = 0;
+	return getCachedPlatformTable(esif_primitive_type::GET_THERMAL_RELATIONSHIP_TABLE, hash);
 }
 
 void PolicyServicesPlatformConfigurationData::setThermalRelationshipTable(DptfBuffer data)
@@ -111,14 +122,24 @@ void PolicyServicesPlatformConfigurationData::setThermalRelationshipTable(DptfBu
 		Constants::Esif::NoParticipant,
 		Constants::Esif::NoDomain,
 		Constants::Esif::NoPersistInstance);
+	invalidateCachedPlatformTable(esif_primitive_type::GET_THERMAL_RELATIONSHIP_TABLE);
+}
+
+UInt64 PolicyServicesPlatformConfigurationData::getThermalRelationshipTableHash(void)
+{
+	throwIfNotWorkItemThread();
+
+	UInt64 hash = 0;
+	getCachedPlatformTable(esif_primitive_type::GET_THERMAL_RELATIONSHIP_TABLE, hash);
+	return hash;
 }
 
 DptfBuffer PolicyServicesPlatformConfigurationData::getPassiveTable(void)
 {
 	throwIfNotWorkItemThread();
 
-	return getEsifServices()->primitiveExecuteGet(
-		esif_primitive_type::GET_PASSIVE_RELATIONSHIP_TABLE, ESIF_DATA_BINARY);
+	UInt64 hash = 0;
+	return getCachedPlatformTable(esif_primitive_type::GET_PASSIVE_RELATIONSHIP_TABLE, hash);
 }
 
 void PolicyServicesPlatformConfigurationData::setPassiveTable(DptfBuffer data)
@@ -134,6 +155,16 @@ void PolicyServicesPlatformConfigurationData::setPassiveTable(DptfBuffer data)
 		Constants::Esif::NoParticipant,
 		Constants::Esif::NoDomain,
 		Constants::Esif::NoPersistInstance);
+	invalidateCachedPlatformTable(esif_primitive_type::GET_PASSIVE_RELATIONSHIP_TABLE);
+}
+
+UInt64 PolicyServicesPlatformConfigurationData::getPassiveTableHash(void)
+{
+	throwIfNotWorkItemThread();
+
+	UInt64 hash = 0;
+	getCachedPlatformTable(esif_primitive_type::GET_PASSIVE_RELATIONSHIP_TABLE, hash);
+	return hash;
 }
 
 DptfBuffer PolicyServicesPlatformConfigurationData::getAdaptiveUserPresenceTable(void)
@@ -413,6 +444,8 @@ void PolicyServicesPlatformConfigurationData::resetActiveRelationshipTable(void)
 	{
 		// best effort
 	}
+
+	invalidateCachedPlatformTable(esif_primitive_type::GET_ACTIVE_RELATIONSHIP_TABLE);
 }
 
 void PolicyServicesPlatformConfigurationData::resetThermalRelationshipTable(void)
@@ -436,6 +469,8 @@ void PolicyServicesPlatformConfigurationData::resetThermalRelationshipTable(void
 	{
 		// best effort
 	}
+
+	invalidateCachedPlatformTable(esif_primitive_type::GET_THERMAL_RELATIONSHIP_TABLE);
 }
 
 void PolicyServicesPlatformConfigurationData::resetPassiveTable(void)
@@ -459,6 +494,8 @@ void PolicyServicesPlatformConfigurationData::resetPassiveTable(void)
 	{
 		// best effort
 	}
+
+	invalidateCachedPlatformTable(esif_primitive_type::GET_PASSIVE_RELATIONSHIP_TABLE);
 }
 
 void PolicyServicesPlatformConfigurationData::resetPidAlgorithmTable(void)
@@ -1331,4 +1368,24 @@ void PolicyServicesPlatformConfigurationData::setUserDisengagedDimWaitTime(UInt3
 	catch (...)
 	{
 	}
+}
+
+DptfBuffer PolicyServicesPlatformConfigurationData::getCachedPlatformTable(esif_primitive_type primitive, UInt64& hash)
+{
+	// The table is only read from ESIF after the cache was invalidated by a table changed event or a write, so
+	// repeated reads between changes are served from the copy held by the manager.
+	auto platformTableCache = getDptfManager()->getPlatformTableCache();
+
+	DptfBuffer table;
+	if (platformTableCache->get(primitive, table, hash) == false)
+	{
+		table = getEsifServices()->primitiveExecuteGet(primitive, ESIF_DATA_BINARY);
+		hash = platformTableCache->set(primitive, table);
+	}
+	return table;
+}
+
+void PolicyServicesPlatformConfigurationData::invalidateCachedPlatformTable(esif_primitive_type primitive)
+{
+	getDptfManager()->getPlatformTableCache()->invalidate(primitive);
 }
\ No newline at end of file
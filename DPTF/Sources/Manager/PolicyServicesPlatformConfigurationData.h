@@ -40,6 +40,9 @@ public:
 	virtual void setThermalRelationshipTable(DptfBuffer data) override final;
 	virtual DptfBuffer getPassiveTable(void) override final;
 	virtual void setPassiveTable(DptfBuffer data) override final;
+	virtual UInt64 getActiveRelationshipTableHash(void) override final;
+	virtual UInt64 getThermalRelationshipTableHash(void) override final;
+	virtual UInt64 getPassiveTableHash(void) override final;
 	virtual DptfBuffer getAdaptiveUserPresenceTable(void) override final;
 	virtual void setAdaptiveUserPresenceTable(DptfBuffer data) override final;
 	virtual DptfBuffer getAdaptivePerformanceConditionsTable(void) override final;
@@ -113,6 +116,8 @@ private:
 	TimeSpan m_defaultSamplePeriod;
 	DptfBuffer createResetPrimitiveTupleBinary(esif_primitive_type primitive, UInt8 instance) const;
 	UInt16 createTupleDomain() const;
+	DptfBuffer getCachedPlatformTable(esif_primitive_type primitive, UInt64& hash);
+	void invalidateCachedPlatformTable(esif_primitive_type primitive);
 
 	void resetAllTables(void);
 	void resetActiveRelationshipTable(void);
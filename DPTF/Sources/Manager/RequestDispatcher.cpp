@@ -17,10 +17,11 @@
 ******************************************************************************/
 
 #include "RequestDispatcher.h"
+#include <algorithm>
 using namespace std;
 
 RequestDispatcher::RequestDispatcher()
-	: m_handlers()
+	: m_handlers(DptfRequestType::END)
 {
 }
 
@@ -31,7 +32,8 @@ RequestDispatcher::~RequestDispatcher()
 void RequestDispatcher::dispatchForAllControls(const PolicyRequest& policyRequest)
 {
 	auto& request = policyRequest.getRequest();
-	auto handlers = m_handlers[request.getRequestType()];
+	// copied since every handler is called and one could register or unregister handlers while processing
+	auto handlers = getHandlers(request.getRequestType());
 	for (auto handler = handlers.begin(); handler != handlers.end(); ++handler)
 	{
 		if ((*handler)->canProcessRequest(policyRequest))
@@ -44,7 +46,7 @@ void RequestDispatcher::dispatchForAllControls(const PolicyRequest& policyReques
 DptfRequestResult RequestDispatcher::dispatch(const PolicyRequest& policyRequest)
 {
 	auto& request = policyRequest.getRequest();
-	auto handlers = m_handlers[request.getRequestType()];
+	auto& handlers = getHandlers(request.getRequestType());
 	for (auto handler = handlers.begin(); handler != handlers.end(); ++handler)
 	{
 		if ((*handler)->canProcessRequest(policyRequest))
@@ -57,18 +59,37 @@ DptfRequestResult RequestDispatcher::dispatch(const PolicyRequest& policyRequest
 
 void RequestDispatcher::registerHandler(DptfRequestType::Enum requestType, RequestHandlerInterface* handler)
 {
-	m_handlers[requestType].insert(handler);
+	if ((UIntN)requestType >= m_handlers.size())
+	{
+		throw dptf_exception("Invalid request type for request handler.");
+	}
+
+	auto& handlers = m_handlers[requestType];
+	if (std::find(handlers.begin(), handlers.end(), handler) == handlers.end())
+	{
+		handlers.push_back(handler);
+	}
 }
 
 void RequestDispatcher::unregisterHandler(DptfRequestType::Enum requestType, RequestHandlerInterface* handler)
 {
-	auto request = m_handlers.find(requestType);
-	if (request != m_handlers.end())
+	if ((UIntN)requestType < m_handlers.size())
 	{
-		auto handlerIterator = request->second.find(handler);
-		if (handlerIterator != request->second.end())
+		auto& handlers = m_handlers[requestType];
+		auto handlerIterator = std::find(handlers.begin(), handlers.end(), handler);
+		if (handlerIterator != handlers.end())
 		{
-			request->second.erase(handlerIterator);
+			handlers.erase(handlerIterator);
 		}
 	}
 }
+
+const std::vector<RequestHandlerInterface*>& RequestDispatcher::getHandlers(DptfRequestType::Enum requestType) const
+{
+	static const std::vector<RequestHandlerInterface*> noHandlers;
+	if ((UIntN)requestType < m_handlers.size())
+	{
+		return m_handlers[requestType];
+	}
+	return noHandlers;
+}
@@ -46,5 +46,8 @@ public:
 	virtual void unregisterHandler(DptfRequestType::Enum requestType, RequestHandlerInterface* handler) override;
 
 private:
-	std::map<DptfRequestType::Enum, std::set<RequestHandlerInterface*>> m_handlers;
+	// indexed by request type
+	std::vector<std::vector<RequestHandlerInterface*>> m_handlers;
+
+	const std::vector<RequestHandlerInterface*>& getHandlers(DptfRequestType::Enum requestType) const;
 };
@@ -33,6 +33,11 @@ WIDomainAdapterPowerRatingChanged::~WIDomainAdapterPowerRatingChanged(void)
 {
 }
 
+CachedDataScope WIDomainAdapterPowerRatingChanged::getDirtiedCachedData(void) const
+{
+	return CachedDataScope::createForVolatileData();
+}
+
 void WIDomainAdapterPowerRatingChanged::onExecute(void)
 {
 	writeDomainWorkItemStartingInfoMessage();
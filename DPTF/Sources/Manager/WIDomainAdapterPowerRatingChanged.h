@@ -27,5 +27,6 @@ public:
 	WIDomainAdapterPowerRatingChanged(DptfManagerInterface* dptfManager, UIntN participantIndex, UIntN domainIndex);
 	virtual ~WIDomainAdapterPowerRatingChanged(void);
 
+	virtual CachedDataScope getDirtiedCachedData(void) const override;
 	virtual void onExecute(void) override final;
 };
@@ -33,6 +33,11 @@ WIDomainBatteryStatusChanged::~WIDomainBatteryStatusChanged(void)
 {
 }
 
+CachedDataScope WIDomainBatteryStatusChanged::getDirtiedCachedData(void) const
+{
+	return CachedDataScope::createForVolatileData();
+}
+
 void WIDomainBatteryStatusChanged::onExecute(void)
 {
 	writeDomainWorkItemStartingInfoMessage();
@@ -27,5 +27,6 @@ public:
 	WIDomainBatteryStatusChanged(DptfManagerInterface* dptfManager, UIntN participantIndex, UIntN domainIndex);
 	virtual ~WIDomainBatteryStatusChanged(void);
 
+	virtual CachedDataScope getDirtiedCachedData(void) const override;
 	virtual void onExecute(void) override final;
 };
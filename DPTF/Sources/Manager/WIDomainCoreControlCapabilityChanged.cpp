@@ -37,6 +37,11 @@ WIDomainCoreControlCapabilityChanged::~WIDomainCoreControlCapabilityChanged(void
 {
 }
 
+CachedDataScope WIDomainCoreControlCapabilityChanged::getDirtiedCachedData(void) const
+{
+	return CachedDataScope::createForDomain(getParticipantIndex(), getDomainIndex(), DomainCachedDataType::CoreControl);
+}
+
 void WIDomainCoreControlCapabilityChanged::onExecute(void)
 {
 	writeDomainWorkItemStartingInfoMessage();
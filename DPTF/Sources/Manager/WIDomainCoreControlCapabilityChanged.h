@@ -27,5 +27,6 @@ public:
 	WIDomainCoreControlCapabilityChanged(DptfManagerInterface* dptfManager, UIntN participantIndex, UIntN domainIndex);
 	virtual ~WIDomainCoreControlCapabilityChanged(void);
 
+	virtual CachedDataScope getDirtiedCachedData(void) const override;
 	virtual void onExecute(void) override final;
 };
@@ -37,6 +37,12 @@ WIDomainDisplayControlCapabilityChanged::~WIDomainDisplayControlCapabilityChange
 {
 }
 
+CachedDataScope WIDomainDisplayControlCapabilityChanged::getDirtiedCachedData(void) const
+{
+	return CachedDataScope::createForDomain(
+		getParticipantIndex(), getDomainIndex(), DomainCachedDataType::DisplayControl);
+}
+
 void WIDomainDisplayControlCapabilityChanged::onExecute(void)
 {
 	writeDomainWorkItemStartingInfoMessage();
@@ -33,6 +33,12 @@ WIDomainDisplayStatusChanged::~WIDomainDisplayStatusChanged(void)
 {
 }
 
+CachedDataScope WIDomainDisplayStatusChanged::getDirtiedCachedData(void) const
+{
+	return CachedDataScope::createForDomain(
+		getParticipantIndex(), getDomainIndex(), DomainCachedDataType::DisplayControl);
+}
+
 void WIDomainDisplayStatusChanged::onExecute(void)
 {
 	writeDomainWorkItemStartingInfoMessage();
@@ -27,5 +27,6 @@ public:
 	WIDomainDisplayStatusChanged(DptfManagerInterface* dptfManager, UIntN participantIndex, UIntN domainIndex);
 	virtual ~WIDomainDisplayStatusChanged(void);
 
+	virtual CachedDataScope getDirtiedCachedData(void) const override;
 	virtual void onExecute(void) override final;
 };
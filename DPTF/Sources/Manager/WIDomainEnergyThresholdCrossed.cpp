@@ -33,6 +33,11 @@ WIDomainEnergyThresholdCrossed::~WIDomainEnergyThresholdCrossed(void)
 {
 }
 
+CachedDataScope WIDomainEnergyThresholdCrossed::getDirtiedCachedData(void) const
+{
+	return CachedDataScope::createForVolatileData();
+}
+
 void WIDomainEnergyThresholdCrossed::onExecute(void)
 {
 	writeDomainWorkItemStartingInfoMessage();
@@ -27,5 +27,6 @@ public:
 	WIDomainEnergyThresholdCrossed(DptfManagerInterface* dptfManager, UIntN participantIndex, UIntN domainIndex);
 	virtual ~WIDomainEnergyThresholdCrossed(void);
 
+	virtual CachedDataScope getDirtiedCachedData(void) const override;
 	virtual void onExecute(void) override final;
 };
@@ -37,6 +37,12 @@ WIDomainPerformanceControlCapabilityChanged::~WIDomainPerformanceControlCapabili
 {
 }
 
+CachedDataScope WIDomainPerformanceControlCapabilityChanged::getDirtiedCachedData(void) const
+{
+	return CachedDataScope::createForDomain(
+		getParticipantIndex(), getDomainIndex(), DomainCachedDataType::PerformanceControl);
+}
+
 void WIDomainPerformanceControlCapabilityChanged::onExecute(void)
 {
 	writeDomainWorkItemStartingInfoMessage();
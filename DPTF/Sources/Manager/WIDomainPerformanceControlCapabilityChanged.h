@@ -30,5 +30,6 @@ public:
 		UIntN domainIndex);
 	virtual ~WIDomainPerformanceControlCapabilityChanged(void);
 
+	virtual CachedDataScope getDirtiedCachedData(void) const override;
 	virtual void onExecute(void) override final;
 };
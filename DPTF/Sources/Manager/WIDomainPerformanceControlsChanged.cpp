@@ -33,6 +33,12 @@ WIDomainPerformanceControlsChanged::~WIDomainPerformanceControlsChanged(void)
 {
 }
 
+CachedDataScope WIDomainPerformanceControlsChanged::getDirtiedCachedData(void) const
+{
+	return CachedDataScope::createForDomain(
+		getParticipantIndex(), getDomainIndex(), DomainCachedDataType::PerformanceControl);
+}
+
 void WIDomainPerformanceControlsChanged::onExecute(void)
 {
 	writeDomainWorkItemStartingInfoMessage();
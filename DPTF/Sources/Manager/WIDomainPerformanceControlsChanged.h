@@ -27,5 +27,6 @@ public:
 	WIDomainPerformanceControlsChanged(DptfManagerInterface* dptfManager, UIntN participantIndex, UIntN domainIndex);
 	virtual ~WIDomainPerformanceControlsChanged(void);
 
+	virtual CachedDataScope getDirtiedCachedData(void) const override;
 	virtual void onExecute(void) override final;
 };
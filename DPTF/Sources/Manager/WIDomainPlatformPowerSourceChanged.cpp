@@ -33,6 +33,11 @@ WIDomainPlatformPowerSourceChanged::~WIDomainPlatformPowerSourceChanged(void)
 {
 }
 
+CachedDataScope WIDomainPlatformPowerSourceChanged::getDirtiedCachedData(void) const
+{
+	return CachedDataScope::createForVolatileData();
+}
+
 void WIDomainPlatformPowerSourceChanged::onExecute(void)
 {
 	writeDomainWorkItemStartingInfoMessage();
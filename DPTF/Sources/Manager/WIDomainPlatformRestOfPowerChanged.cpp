@@ -33,6 +33,11 @@ WIDomainPlatformRestOfPowerChanged::~WIDomainPlatformRestOfPowerChanged(void)
 {
 }
 
+CachedDataScope WIDomainPlatformRestOfPowerChanged::getDirtiedCachedData(void) const
+{
+	return CachedDataScope::createForVolatileData();
+}
+
 void WIDomainPlatformRestOfPowerChanged::onExecute(void)
 {
 	writeDomainWorkItemStartingInfoMessage();
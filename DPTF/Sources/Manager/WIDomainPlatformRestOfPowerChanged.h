@@ -27,5 +27,6 @@ public:
 	WIDomainPlatformRestOfPowerChanged(DptfManagerInterface* dptfManager, UIntN participantIndex, UIntN domainIndex);
 	virtual ~WIDomainPlatformRestOfPowerChanged(void);
 
+	virtual CachedDataScope getDirtiedCachedData(void) const override;
 	virtual void onExecute(void) override final;
 };
@@ -37,6 +37,12 @@ WIDomainPowerControlCapabilityChanged::~WIDomainPowerControlCapabilityChanged(vo
 {
 }
 
+CachedDataScope WIDomainPowerControlCapabilityChanged::getDirtiedCachedData(void) const
+{
+	return CachedDataScope::createForDomain(
+		getParticipantIndex(), getDomainIndex(), DomainCachedDataType::PowerControl);
+}
+
 void WIDomainPowerControlCapabilityChanged::onExecute(void)
 {
 	writeDomainWorkItemStartingInfoMessage();
@@ -33,6 +33,11 @@ WIDomainPriorityChanged::~WIDomainPriorityChanged(void)
 {
 }
 
+CachedDataScope WIDomainPriorityChanged::getDirtiedCachedData(void) const
+{
+	return CachedDataScope::createForDomain(getParticipantIndex(), getDomainIndex(), DomainCachedDataType::Priority);
+}
+
 void WIDomainPriorityChanged::onExecute(void)
 {
 	writeDomainWorkItemStartingInfoMessage();
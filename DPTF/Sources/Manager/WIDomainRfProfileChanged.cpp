@@ -33,6 +33,14 @@ WIDomainRfProfileChanged::~WIDomainRfProfileChanged(void)
 {
 }
 
+CachedDataScope WIDomainRfProfileChanged::getDirtiedCachedData(void) const
+{
+	auto dirtiedCachedData = CachedDataScope::createForDomain(
+		getParticipantIndex(), getDomainIndex(), DomainCachedDataType::RfProfileControl);
+	dirtiedCachedData.addCachedDataType(DomainCachedDataType::RfProfileStatus);
+	return dirtiedCachedData;
+}
+
 void WIDomainRfProfileChanged::onExecute(void)
 {
 	writeDomainWorkItemStartingInfoMessage();
@@ -33,6 +33,11 @@ WIDomainTemperatureThresholdCrossed::~WIDomainTemperatureThresholdCrossed(void)
 {
 }
 
+CachedDataScope WIDomainTemperatureThresholdCrossed::getDirtiedCachedData(void) const
+{
+	return CachedDataScope::createForVolatileData();
+}
+
 void WIDomainTemperatureThresholdCrossed::onExecute(void)
 {
 	writeDomainWorkItemStartingInfoMessage();
@@ -27,5 +27,6 @@ public:
 	WIDomainTemperatureThresholdCrossed(DptfManagerInterface* dptfManager, UIntN participantIndex, UIntN domainIndex);
 	virtual ~WIDomainTemperatureThresholdCrossed(void);
 
+	virtual CachedDataScope getDirtiedCachedData(void) const override;
 	virtual void onExecute(void) override final;
 };
@@ -37,6 +37,9 @@ void WIDptfResume::onExecute(void)
 
 	writeWorkItemStartingInfoMessage();
 
+	// platform tables are read again after resume in case they were updated while suspended
+	getDptfManager()->getPlatformTableCache()->invalidateAll();
+
 	// notify all participants
 
 	auto participantManager = getParticipantManager();
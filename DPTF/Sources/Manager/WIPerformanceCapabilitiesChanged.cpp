@@ -30,6 +30,12 @@ WIPerformanceCapabilitiesChanged::~WIPerformanceCapabilitiesChanged(void)
 {
 }
 
+CachedDataScope WIPerformanceCapabilitiesChanged::getDirtiedCachedData(void) const
+{
+	return CachedDataScope::createForDomain(
+		m_participantIndex, Constants::Invalid, DomainCachedDataType::PerformanceControl);
+}
+
 void WIPerformanceCapabilitiesChanged::onExecute(void)
 {
 	writeWorkItemStartingInfoMessage();
@@ -28,6 +28,7 @@ public:
 	WIPerformanceCapabilitiesChanged(DptfManagerInterface* dptfManager, UIntN participantIndex);
 	virtual ~WIPerformanceCapabilitiesChanged(void);
 
+	virtual CachedDataScope getDirtiedCachedData(void) const override;
 	virtual void onExecute(void) override final;
 
 private:
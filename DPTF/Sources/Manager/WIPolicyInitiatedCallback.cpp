@@ -38,6 +38,11 @@ WIPolicyInitiatedCallback::~WIPolicyInitiatedCallback(void)
 {
 }
 
+CachedDataScope WIPolicyInitiatedCallback::getDirtiedCachedData(void) const
+{
+	return CachedDataScope::createForVolatileData();
+}
+
 void WIPolicyInitiatedCallback::onExecute(void)
 {
 	writeWorkItemStartingInfoMessage();
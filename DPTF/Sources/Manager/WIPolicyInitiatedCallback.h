@@ -33,6 +33,7 @@ public:
 	virtual ~WIPolicyInitiatedCallback(void);
 
 	virtual Bool matches(const WorkItemMatchCriteria& matchCriteria) const override;
+	virtual CachedDataScope getDirtiedCachedData(void) const override;
 	virtual void onExecute(void) override final;
 
 private:
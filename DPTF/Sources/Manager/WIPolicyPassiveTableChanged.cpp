@@ -33,6 +33,9 @@ void WIPolicyPassiveTableChanged::onExecute(void)
 {
 	writeWorkItemStartingInfoMessage();
 
+	// the platform table may have changed so the next read must go to ESIF
+	getDptfManager()->getPlatformTableCache()->invalidate(esif_primitive_type::GET_PASSIVE_RELATIONSHIP_TABLE);
+
 	auto policyManager = getPolicyManager();
 	auto policyIndexes = policyManager->getPolicyIndexes();
 
@@ -33,6 +33,9 @@ void WIPolicyThermalRelationshipTableChanged::onExecute(void)
 {
 	writeWorkItemStartingInfoMessage();
 
+	// the platform table may have changed so the next read must go to ESIF
+	getDptfManager()->getPlatformTableCache()->invalidate(esif_primitive_type::GET_THERMAL_RELATIONSHIP_TABLE);
+
 	auto policyManager = getPolicyManager();
 	auto policyIndexes = policyManager->getPolicyIndexes();
 
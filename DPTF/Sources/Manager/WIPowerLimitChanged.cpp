@@ -29,6 +29,11 @@ WIPowerLimitChanged::~WIPowerLimitChanged(void)
 {
 }
 
+CachedDataScope WIPowerLimitChanged::getDirtiedCachedData(void) const
+{
+	return CachedDataScope::createForVolatileData();
+}
+
 void WIPowerLimitChanged::onExecute(void)
 {
 	writeWorkItemStartingInfoMessage();
@@ -28,5 +28,6 @@ public:
 	WIPowerLimitChanged(DptfManagerInterface* dptfManager);
 	virtual ~WIPowerLimitChanged(void);
 
+	virtual CachedDataScope getDirtiedCachedData(void) const override;
 	virtual void onExecute(void) override final;
 };
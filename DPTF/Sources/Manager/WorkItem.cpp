@@ -129,6 +129,12 @@ std::string WorkItem::toXml(void) const
 	throw implement_me();
 }
 
+CachedDataScope WorkItem::getDirtiedCachedData(void) const
+{
+	// Unless the work item says otherwise, assume that anything could have changed.
+	return CachedDataScope::createForAllData();
+}
+
 void WorkItem::writeWorkItemStartingInfoMessage() const
 {
 	MANAGER_LOG_MESSAGE_INFO({
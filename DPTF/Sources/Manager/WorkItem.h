@@ -56,6 +56,7 @@ public:
 	// the following are implemented in the WorkItem class and *can* be overridden
 	virtual Bool matches(const WorkItemMatchCriteria& matchCriteria) const override;
 	virtual std::string toXml(void) const override;
+	virtual CachedDataScope getDirtiedCachedData(void) const override;
 
 protected:
 	void writeWorkItemStartingInfoMessage() const;
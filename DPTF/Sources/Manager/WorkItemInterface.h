@@ -23,6 +23,7 @@
 #include "WorkItemMatchCriteria.h"
 #include "EsifSemaphore.h"
 #include "EsifTime.h"
+#include "CachedDataScope.h"
 
 class WorkItemInterface
 {
@@ -37,6 +38,10 @@ public:
 	virtual void signalAtCompletion(EsifSemaphore* semaphore) = 0;
 	virtual Bool matches(const WorkItemMatchCriteria& matchCriteria) const = 0;
 	virtual std::string toXml(void) const = 0;
+
+	// Returns the framework cached data that may be stale when this work item runs.  It is cleared before the work
+	// item executes.
+	virtual CachedDataScope getDirtiedCachedData(void) const = 0;
 	virtual void execute(void) = 0;
 	virtual void signal() = 0;
 };
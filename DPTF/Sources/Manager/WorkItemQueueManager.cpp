@@ -22,8 +22,12 @@
 #include "EsifThreadId.h"
 #include "XmlNode.h"
 #include "ManagerLogger.h"
+#include "DataVaultPath.h"
+#include "ParticipantManagerInterface.h"
 #include <memory>
 
+static const UInt32 MaxDeferredWorkItemSlackMs = 1000;
+
 WorkItemQueueManager::WorkItemQueueManager(DptfManagerInterface* dptfManager)
 	: m_dptfManager(dptfManager)
 	, m_enqueueingEnabled(true)
@@ -39,6 +43,7 @@ WorkItemQueueManager::WorkItemQueueManager(DptfManagerInterface* dptfManager)
 		m_workItemQueueSemaphore = new EsifSemaphore();
 		m_immediateQueue = new ImmediateWorkItemQueue(m_workItemQueueSemaphore);
 		m_deferredQueue = new DeferredWorkItemQueue(m_workItemQueueSemaphore, m_immediateQueue);
+		m_deferredQueue->setCoalescingSlack(readDeferredWorkItemSlack());
 		m_workItemQueueThread = new WorkItemQueueThread(
 			m_dptfManager, m_immediateQueue, m_deferredQueue, m_workItemQueueSemaphore, m_workItemStatistics);
 	}
@@ -70,6 +75,27 @@ void WorkItemQueueManager::deleteAllObjects(void)
 	DELETE_MEMORY_TC(m_workItemStatistics);
 }
 
+TimeSpan WorkItemQueueManager::readDeferredWorkItemSlack(void) const
+{
+	UInt32 slackMs = 0;
+
+	try
+	{
+		slackMs = getEsifServices()->readConfigurationUInt32(DataVaultPath::Features::DeferredWorkItemSlack);
+	}
+	catch (...)
+	{
+		// not configured.  Deferred work items run at their exact time.
+	}
+
+	if (slackMs > MaxDeferredWorkItemSlackMs)
+	{
+		slackMs = MaxDeferredWorkItemSlackMs;
+	}
+
+	return TimeSpan::createFromMilliseconds(slackMs);
+}
+
 void WorkItemQueueManager::disableAndEmptyAllQueues(void)
 {
 	// This has to be atomic while holding the lock.  So, both items (disable and empty) are within the same function.
@@ -228,6 +254,8 @@ std::shared_ptr<XmlNode> WorkItemQueueManager::getStatusAsXml(void)
 	workItemQueueManagerStatus->addChild(m_immediateQueue->getXml());
 	workItemQueueManagerStatus->addChild(m_deferredQueue->getXml());
 	workItemQueueManagerStatus->addChild(m_workItemStatistics->getXml());
+	workItemQueueManagerStatus->addChild(m_dptfManager->getParticipantManager()->getCachedDataStatisticsAsXml());
+	workItemQueueManagerStatus->addChild(m_dptfManager->getEsifServices()->getMessageLoggingStatisticsAsXml());
 
 	esifMutexHelper.unlock();
 
@@ -68,6 +68,7 @@ private:
 	EsifSemaphore* m_workItemQueueSemaphore;
 
 	void deleteAllObjects(void);
+	TimeSpan readDeferredWorkItemSlack(void) const;
 	Bool canEnqueueImmediateWorkItem(std::shared_ptr<WorkItemInterface> workItem) const;
 	EsifServicesInterface* getEsifServices() const;
 };
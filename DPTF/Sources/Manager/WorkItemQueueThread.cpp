@@ -102,6 +102,14 @@ void WorkItemQueueThread::processImmediateQueue(void)
 		}
 #endif
 
+		try
+		{
+			clearDirtiedCachedData(immediateWorkItem);
+		}
+		catch (...)
+		{
+		}
+
 		try
 		{
 			immediateWorkItem->execute();
@@ -112,7 +120,7 @@ void WorkItemQueueThread::processImmediateQueue(void)
 
 		try
 		{
-			m_participantManager->clearAllParticipantCachedData();
+			clearVolatileCachedData();
 		}
 		catch (...)
 		{
@@ -131,6 +139,18 @@ void WorkItemQueueThread::processImmediateQueue(void)
 	}
 }
 
+void WorkItemQueueThread::clearDirtiedCachedData(std::shared_ptr<ImmediateWorkItem> immediateWorkItem)
+{
+	// Clear whatever the work item says may be stale before it runs so the policies see the new values.  Cached data
+	// outside of the scope is left alone and is reused across work items.
+	m_participantManager->clearParticipantCachedData(immediateWorkItem->getDirtiedCachedData());
+}
+
+void WorkItemQueueThread::clearVolatileCachedData(void)
+{
+	m_participantManager->clearVolatileParticipantCachedData();
+}
+
 void* ThreadStart(void* contextPtr)
 {
 	WorkItemQueueThread* workItemQueueThread = static_cast<WorkItemQueueThread*>(contextPtr);
@@ -60,6 +60,8 @@ private:
 	friend void* ThreadStart(void* contextPtr);
 	void executeThread(void);
 	void processImmediateQueue(void);
+	void clearDirtiedCachedData(std::shared_ptr<ImmediateWorkItem> immediateWorkItem);
+	void clearVolatileCachedData(void);
 };
 
 void* ThreadStart(void* contextPtr);
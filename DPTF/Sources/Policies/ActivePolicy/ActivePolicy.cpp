@@ -26,6 +26,7 @@ const string MyName("Active Policy");
 
 ActivePolicy::ActivePolicy(void)
 	: PolicyBase()
+	, m_artHash(0)
 {
 }
 
@@ -39,6 +40,7 @@ void ActivePolicy::onCreate(void)
 	{
 		m_art = std::make_shared<ActiveRelationshipTable>(ActiveRelationshipTable::createArtFromDptfBuffer(
 			getPolicyServices().platformConfigurationData->getActiveRelationshipTable()));
+		m_artHash = getArtHash();
 	}
 	catch (std::exception& ex)
 	{
@@ -274,6 +276,12 @@ void ActivePolicy::onDomainFanCapabilityChanged(UIntN participantIndex)
 
 void ActivePolicy::onActiveRelationshipTableChanged(void)
 {
+	if (isArtUnchanged())
+	{
+		POLICY_LOG_MESSAGE_DEBUG({ return "Active relationship table contents are unchanged.  Ignoring event."; });
+		return;
+	}
+
 	vector<UIntN> indexes = m_art->getAllTargets();
 	for (auto participantIndex = indexes.begin(); participantIndex != indexes.end(); participantIndex++)
 	{
@@ -306,6 +314,7 @@ void ActivePolicy::onActiveRelationshipTableChanged(void)
 	}
 	m_art.reset(new ActiveRelationshipTable(ActiveRelationshipTable::createArtFromDptfBuffer(
 		getPolicyServices().platformConfigurationData->getActiveRelationshipTable())));
+	m_artHash = getArtHash();
 	associateAllParticipantsInArt();
 
 	auto targetIndexes = m_art->getAllTargets();
@@ -460,11 +469,33 @@ void ActivePolicy::refreshArtAndTargetsAndTakeCoolingAction()
 
 void ActivePolicy::reloadArt()
 {
-	m_art.reset(new ActiveRelationshipTable(ActiveRelationshipTable::createArtFromDptfBuffer(
-		getPolicyServices().platformConfigurationData->getActiveRelationshipTable())));
+	if (isArtUnchanged() == false)
+	{
+		m_art.reset(new ActiveRelationshipTable(ActiveRelationshipTable::createArtFromDptfBuffer(
+			getPolicyServices().platformConfigurationData->getActiveRelationshipTable())));
+		m_artHash = getArtHash();
+	}
 	associateAllParticipantsInArt();
 }
 
+UInt64 ActivePolicy::getArtHash()
+{
+	try
+	{
+		return getPolicyServices().platformConfigurationData->getActiveRelationshipTableHash();
+	}
+	catch (...)
+	{
+		return 0;
+	}
+}
+
+Bool ActivePolicy::isArtUnchanged()
+{
+	// the platform table cache hashes the raw ART so a re-read of identical contents doesn't need to be parsed
+	return (m_artHash != 0) && (getArtHash() == m_artHash);
+}
+
 void ActivePolicy::takeCoolingActionsForAllParticipants()
 {
 	vector<UIntN> targets = m_art->getAllTargets();
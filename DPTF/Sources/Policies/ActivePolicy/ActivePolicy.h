@@ -59,6 +59,7 @@ public:
 
 private:
 	std::shared_ptr<ActiveRelationshipTable> m_art;
+	UInt64 m_artHash;
 
 	// cooling targets
 	Temperature getCurrentTemperature(ParticipantProxyInterface* participant);
@@ -72,6 +73,8 @@ private:
 	void turnOffAllFans();
 	void refreshArtAndTargetsAndTakeCoolingAction();
 	void reloadArt();
+	UInt64 getArtHash();
+	Bool isArtUnchanged();
 	void takeCoolingActionsForAllParticipants();
 
 	// setting target trip point notification
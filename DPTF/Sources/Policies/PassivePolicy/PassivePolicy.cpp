@@ -32,6 +32,7 @@ const string MyName("Passive Policy");
 
 PassivePolicy::PassivePolicy(void)
 	: PolicyBase()
+	, m_trtHash(0)
 	, m_utilizationBiasThreshold(Percentage(0.0))
 {
 }
@@ -46,6 +47,7 @@ void PassivePolicy::onCreate(void)
 	{
 		m_trt = std::make_shared<ThermalRelationshipTable>(ThermalRelationshipTable::createTrtFromDptfBuffer(
 			getPolicyServices().platformConfigurationData->getThermalRelationshipTable()));
+		m_trtHash = getTrtHash();
 	}
 	catch (std::exception& ex)
 	{
@@ -546,6 +548,14 @@ void PassivePolicy::associateParticipantInTrt(
 
 void PassivePolicy::reloadTrtIfDifferent()
 {
+	// the platform table cache hashes the raw TRT so identical contents don't need to be parsed and compared.
+	// participants are associated with m_trt as they are bound, so it is still current when the hash matches.
+	UInt64 newTrtHash = getTrtHash();
+	if ((m_trtHash != 0) && (newTrtHash == m_trtHash))
+	{
+		return;
+	}
+
 	std::shared_ptr<ThermalRelationshipTable> newTrt;
 	try
 	{
@@ -556,6 +566,7 @@ void PassivePolicy::reloadTrtIfDifferent()
 	{
 		newTrt.reset(new ThermalRelationshipTable());
 	}
+	m_trtHash = newTrtHash;
 
 	associateAllParticipantsInTrt(newTrt);
 	if (*m_trt != *newTrt)
@@ -580,6 +591,18 @@ void PassivePolicy::reloadTrtIfDifferent()
 	}
 }
 
+UInt64 PassivePolicy::getTrtHash()
+{
+	try
+	{
+		return getPolicyServices().platformConfigurationData->getThermalRelationshipTableHash();
+	}
+	catch (...)
+	{
+		return 0;
+	}
+}
+
 void PassivePolicy::removeAllRequestsForTarget(UIntN target)
 {
 	if (participantIsTargetDevice(target))
@@ -70,6 +70,7 @@ public:
 private:
 	// policy state
 	std::shared_ptr<ThermalRelationshipTable> m_trt;
+	UInt64 m_trtHash;
 	std::shared_ptr<CallbackScheduler> m_callbackScheduler;
 	TargetMonitor m_targetMonitor;
 	UtilizationStatus m_utilizationBiasThreshold;
@@ -88,6 +89,7 @@ private:
 		ParticipantProxyInterface* participant,
 		std::shared_ptr<ThermalRelationshipTable> trt);
 	void reloadTrtIfDifferent();
+	UInt64 getTrtHash();
 	void associateAllParticipantsInTrt(std::shared_ptr<ThermalRelationshipTable> trt);
 
 	// temperature notification actions
@@ -92,6 +92,17 @@ Bool Guid::operator!=(const Guid& rhs) const
 	return !(*this == rhs);
 }
 
+UInt64 Guid::getHash(void) const
+{
+	// FNV-1a over the bytes compared by operator==
+	UInt64 hash = 0xcbf29ce484222325ULL;
+	for (UIntN i = 0; i < GuidSize; i++)
+	{
+		hash = (hash ^ m_guid[i]) * 0x100000001b3ULL;
+	}
+	return hash;
+}
+
 std::ostream& operator<<(std::ostream& os, const Guid& guid)
 {
 	os << guid.toString();
@@ -55,9 +55,21 @@ public:
 	Bool isValid() const;
 	std::string toString() const;
 	void copyToBuffer(UInt8 buffer[GuidSize]) const;
+	UInt64 getHash(void) const;
 
 private:
 	Bool m_valid;
 	UInt8 m_guid[GuidSize];
 	void throwIfInvalid(const Guid& guid) const;
 };
+
+namespace std
+{
+	template <> struct hash<Guid>
+	{
+		size_t operator()(const Guid& guid) const
+		{
+			return (size_t)guid.getHash();
+		}
+	};
+}
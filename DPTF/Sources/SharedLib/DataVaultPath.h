@@ -60,5 +60,7 @@ namespace DataVaultPath
 		static const std::string SocWorkload = DataVaultPathBasePaths::FeaturesRoot + "/soc_workload";
 		static const std::string Pl2Sharing = DataVaultPathBasePaths::FeaturesRoot + "/pl2_sharing";
 		static const std::string Pl4Sharing = DataVaultPathBasePaths::FeaturesRoot + "/pl4_sharing";
+		static const std::string DeferredWorkItemSlack =
+			DataVaultPathBasePaths::FeaturesRoot + "/deferred_work_item_slack_ms";
 	};
 };
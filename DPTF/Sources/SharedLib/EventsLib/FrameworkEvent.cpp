@@ -75,17 +75,12 @@ Guid FrameworkEventInfo::getGuid(FrameworkEvent::Type frameworkEvent) const
 
 FrameworkEvent::Type FrameworkEventInfo::getFrameworkEventType(const Guid& guid) const
 {
-	// FIXME:  convert to map or hash table to improve performance
-
-	for (UIntN i = 0; i < FrameworkEvent::Max; i++)
+	auto match = m_guidMap.find(guid);
+	if (match == m_guidMap.end())
 	{
-		if (m_events[i].guid == guid)
-		{
-			return FrameworkEvent::Type(i);
-		}
+		throw dptf_exception("GUID is not a framework event known to DPTF.");
 	}
-
-	throw dptf_exception("GUID is not a framework event known to DPTF.");
+	return match->second;
 }
 
 FrameworkEventInfo::FrameworkEventInfo(void)
@@ -93,6 +88,7 @@ FrameworkEventInfo::FrameworkEventInfo(void)
 	initializeAllEventsToInvalid();
 	initializeEvents();
 	verifyAllEventsCorrectlyInitialized();
+	initializeGuidMap();
 }
 
 FrameworkEventInfo::~FrameworkEventInfo(void)
@@ -306,6 +302,15 @@ void FrameworkEventInfo::verifyAllEventsCorrectlyInitialized() const
 	}
 }
 
+void FrameworkEventInfo::initializeGuidMap()
+{
+	// Internal events share an empty guid.  The first event with a given guid wins, the same as a search of m_events.
+	for (UIntN i = 0; i < FrameworkEvent::Max; i++)
+	{
+		m_guidMap.insert(std::make_pair(m_events[i].guid, FrameworkEvent::Type(i)));
+	}
+}
+
 void FrameworkEventInfo::throwIfFrameworkEventIsInvalid(FrameworkEvent::Type frameworkEvent) const
 {
 	if (frameworkEvent >= FrameworkEvent::Max)
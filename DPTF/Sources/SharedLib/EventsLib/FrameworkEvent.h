@@ -27,6 +27,7 @@
 //
 
 #include "Dptf.h"
+#include <unordered_map>
 
 namespace FrameworkEvent
 {
@@ -214,9 +215,7 @@ private:
 	static const UIntN m_maxPriority = 32;
 
 	FrameworkEventData m_events[FrameworkEvent::Max];
-
-	// FIXME:  use map or hash table for converting guid to FrameworkEvent::Type
-	// std::map<Guid, FrameworkEvent::Type> m_guidMap;
+	std::unordered_map<Guid, FrameworkEvent::Type> m_guidMap;
 
 	void initializeAllEventsToInvalid();
 	void initializeEvents();
@@ -226,6 +225,7 @@ private:
 		const std::string& name,
 		const Guid& guid);
 	void verifyAllEventsCorrectlyInitialized() const;
+	void initializeGuidMap();
 
 	void throwIfFrameworkEventIsInvalid(FrameworkEvent::Type frameworkEvent) const;
 };
@@ -19,12 +19,13 @@
 #include "DptfMessage.h"
 #include "DptfVer.h"
 
-DptfMessage::DptfMessage(const std::string& fileName, UIntN lineNumber, const std::string& executingFunctionName)
+DptfMessage::DptfMessage(const char* fileName, UIntN lineNumber, const char* executingFunctionName)
 	: m_dptfVersion(VERSION_STR)
 	, m_dptfBuildDate(__DATE__)
 	, m_dptfBuildTime(__TIME__)
-	, m_fileName(fileName)
-	, m_executingFunctionName(executingFunctionName)
+	, m_fileName((fileName != nullptr) ? fileName : "")
+	, m_lineNumber(lineNumber)
+	, m_executingFunctionName((executingFunctionName != nullptr) ? executingFunctionName : "")
 	, m_frameworkEventValid(false)
 	, m_frameworkEvent()
 	, m_participantIndex(Constants::Invalid)
@@ -39,14 +40,6 @@ DptfMessage::DptfMessage(const std::string& fileName, UIntN lineNumber, const st
 	, m_exceptionFunctionName(Constants::EmptyString)
 	, m_exceptionText(Constants::EmptyString)
 {
-	try
-	{
-		m_lineNumber = std::to_string(lineNumber);
-	}
-	catch (...)
-	{
-		m_lineNumber = "Unknown";
-	}
 }
 
 DptfMessage::~DptfMessage(void)
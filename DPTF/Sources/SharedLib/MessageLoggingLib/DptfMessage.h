@@ -41,7 +41,8 @@ struct MessageKeyValuePair
 class DptfMessage
 {
 public:
-	DptfMessage(const std::string& fileName, UIntN lineNumber, const std::string& executingFunctionName);
+	// fileName and executingFunctionName must outlive the message.  They are normally __FILE__ and ESIF_FUNC from FLF.
+	DptfMessage(const char* fileName, UIntN lineNumber, const char* executingFunctionName);
 	virtual ~DptfMessage(void);
 
 	void addMessage(const std::string& messageValue);
@@ -54,13 +55,15 @@ public:
 	void setExceptionCaught(const std::string& exceptionFunctionName, const std::string& exceptionText);
 
 protected:
-	std::string m_dptfVersion;
-	std::string m_dptfBuildDate;
-	std::string m_dptfBuildTime;
-
-	std::string m_fileName;
-	std::string m_lineNumber;
-	std::string m_executingFunctionName;
+	// File, function and build strings are string literals, so only the pointers are kept.  Nothing is formatted
+	// until the message is converted to a string.
+	const char* m_dptfVersion;
+	const char* m_dptfBuildDate;
+	const char* m_dptfBuildTime;
+
+	const char* m_fileName;
+	UIntN m_lineNumber;
+	const char* m_executingFunctionName;
 
 	std::vector<MessageKeyValuePair> m_messageKeyValuePair;
 
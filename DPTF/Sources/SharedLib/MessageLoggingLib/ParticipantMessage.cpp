@@ -19,17 +19,17 @@
 #include "ParticipantMessage.h"
 
 ParticipantMessage::ParticipantMessage(
-	const std::string& fileName,
+	const char* fileName,
 	UIntN lineNumber,
-	const std::string& executingFunctionName)
+	const char* executingFunctionName)
 	: DptfMessage(fileName, lineNumber, executingFunctionName)
 {
 }
 
 ParticipantMessage::ParticipantMessage(
-	const std::string& fileName,
+	const char* fileName,
 	UIntN lineNumber,
-	const std::string& executingFunctionName,
+	const char* executingFunctionName,
 	const std::string& message,
 	UIntN domainIndex)
 	: DptfMessage(fileName, lineNumber, executingFunctionName)
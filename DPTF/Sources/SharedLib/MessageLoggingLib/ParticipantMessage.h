@@ -25,11 +25,11 @@
 class ParticipantMessage : public DptfMessage
 {
 public:
-	ParticipantMessage(const std::string& fileName, UIntN lineNumber, const std::string& executingFunctionName);
+	ParticipantMessage(const char* fileName, UIntN lineNumber, const char* executingFunctionName);
 	ParticipantMessage(
-		const std::string& fileName,
+		const char* fileName,
 		UIntN lineNumber,
-		const std::string& executingFunctionName,
+		const char* executingFunctionName,
 		const std::string& message,
 		UIntN domainIndex = Constants::Invalid);
 	virtual ~ParticipantMessage(void);
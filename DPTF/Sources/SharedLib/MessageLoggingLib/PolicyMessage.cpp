@@ -18,15 +18,15 @@
 
 #include "PolicyMessage.h"
 
-PolicyMessage::PolicyMessage(const std::string& fileName, UIntN lineNumber, const std::string& executingFunctionName)
+PolicyMessage::PolicyMessage(const char* fileName, UIntN lineNumber, const char* executingFunctionName)
 	: DptfMessage(fileName, lineNumber, executingFunctionName)
 {
 }
 
 PolicyMessage::PolicyMessage(
-	const std::string& fileName,
+	const char* fileName,
 	UIntN lineNumber,
-	const std::string& executingFunctionName,
+	const char* executingFunctionName,
 	const std::string& message,
 	UIntN participantIndex,
 	UIntN domainIndex)
@@ -24,11 +24,11 @@
 class PolicyMessage : public DptfMessage
 {
 public:
-	PolicyMessage(const std::string& fileName, UIntN lineNumber, const std::string& executingFunctionName);
+	PolicyMessage(const char* fileName, UIntN lineNumber, const char* executingFunctionName);
 	PolicyMessage(
-		const std::string& fileName,
+		const char* fileName,
 		UIntN lineNumber,
-		const std::string& executingFunctionName,
+		const char* executingFunctionName,
 		const std::string& message,
 		UIntN participantIndex = Constants::Invalid,
 		UIntN domainIndex = Constants::Invalid);
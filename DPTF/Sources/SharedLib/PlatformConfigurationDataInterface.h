@@ -41,6 +41,9 @@ public:
 	virtual DptfBuffer getThermalRelationshipTable(void) = 0;
 	virtual void setThermalRelationshipTable(DptfBuffer data) = 0;
 	virtual DptfBuffer getPassiveTable(void) = 0;
+	virtual UInt64 getActiveRelationshipTableHash(void) = 0;
+	virtual UInt64 getThermalRelationshipTableHash(void) = 0;
+	virtual UInt64 getPassiveTableHash(void) = 0;
 	virtual DptfBuffer getAdaptivePerformanceConditionsTable(void) = 0;
 	virtual DptfBuffer getAdaptivePerformanceParticipantConditionTable(void) = 0;
 	virtual void setPassiveTable(DptfBuffer data) = 0;
@@ -30,7 +30,7 @@ ControlBase::ControlBase(
 	, m_domainIndex(domainIndex)
 	, m_participantServices(participantServices)
 	, m_activityLoggingEnabled(false)
-	, m_requestHandlers()
+	, m_requestHandlers(DptfRequestType::END)
 	, m_requestCache()
 {
 }
@@ -93,8 +93,7 @@ Bool ControlBase::canProcessRequest(const PolicyRequest& policyRequest)
 	auto participantIndex = request.getParticipantIndex();
 	auto domainIndex = request.getDomainIndex();
 	auto requestType = request.getRequestType();
-	auto handler = m_requestHandlers.find(requestType);
-	Bool hasHandlerForRequestType = (handler != m_requestHandlers.end());
+	Bool hasHandlerForRequestType = hasRequestHandler(requestType);
 	Bool requestTargetsThisControl = isMe(participantIndex, domainIndex);
 	return hasHandlerForRequestType && requestTargetsThisControl;
 }
@@ -103,8 +102,7 @@ DptfRequestResult ControlBase::callHandler(const PolicyRequest& policyRequest)
 {
 	auto& request = policyRequest.getRequest();
 	auto requestType = request.getRequestType();
-	auto handler = m_requestHandlers.find(requestType);
-	if (handler == m_requestHandlers.end())
+	if (hasRequestHandler(requestType) == false)
 	{
 		return DptfRequestResult(false, "Handler not found for request.", request);
 	}
@@ -112,7 +110,7 @@ DptfRequestResult ControlBase::callHandler(const PolicyRequest& policyRequest)
 	{
 		try
 		{
-			return handler->second(policyRequest);
+			return m_requestHandlers[requestType](policyRequest);
 		}
 		catch (const std::exception& ex)
 		{
@@ -121,20 +119,30 @@ DptfRequestResult ControlBase::callHandler(const PolicyRequest& policyRequest)
 	}
 }
 
+Bool ControlBase::hasRequestHandler(DptfRequestType::Enum requestType) const
+{
+	return ((UIntN)requestType < m_requestHandlers.size()) && (m_requestHandlers[requestType] != nullptr);
+}
+
 void ControlBase::unbindRequestHandlers()
 {
-	for (auto handler = m_requestHandlers.begin(); handler != m_requestHandlers.end(); ++handler)
+	for (UIntN requestType = 0; requestType < m_requestHandlers.size(); ++requestType)
 	{
+		if (m_requestHandlers[requestType] == nullptr)
+		{
+			continue;
+		}
+
 		try
 		{
-			getParticipantServices()->unregisterRequestHandler(handler->first, this);
+			getParticipantServices()->unregisterRequestHandler((DptfRequestType::Enum)requestType, this);
 		}
 		catch (...)
 		{
 			// ignore
 		}
+		m_requestHandlers[requestType] = nullptr;
 	}
-	m_requestHandlers.clear();
 }
 
 std::shared_ptr<ParticipantServicesInterface> ControlBase::getParticipantServices() const
@@ -168,6 +176,11 @@ void ControlBase::bindRequestHandler(
 	DptfRequestType::Enum requestType,
 	std::function<DptfRequestResult(const PolicyRequest&)> functionObj)
 {
+	if ((UIntN)requestType >= m_requestHandlers.size())
+	{
+		throw dptf_exception("Invalid request type for request handler.");
+	}
+
 	m_requestHandlers[requestType] = functionObj;
 	getParticipantServices()->registerRequestHandler(requestType, this);
 }
@@ -187,44 +200,27 @@ void ControlBase::clearCachedData()
 
 Bool ControlBase::requestResultIsCached(const DptfRequest& request)
 {
-	auto cachedItem = m_requestCache.find(tuple<DptfRequestType::Enum, UInt32, UInt32>(
-		request.getRequestType(), request.getParticipantIndex(), request.getDomainIndex()));
-	return (cachedItem != m_requestCache.end());
+	return m_requestCache.contains(request.getRequestType(), request.getParticipantIndex(), request.getDomainIndex());
 }
 
 const DptfRequestResult& ControlBase::getCachedResult(const DptfRequest& request) const
 {
-	auto cachedItem = m_requestCache.find(tuple<DptfRequestType::Enum, UInt32, UInt32>(
-		request.getRequestType(), request.getParticipantIndex(), request.getDomainIndex()));
-	if (cachedItem == m_requestCache.end())
-	{
-		throw dptf_exception("No cached result for request.");
-	}
-	else
-	{
-		return cachedItem->second;
-	}
+	return m_requestCache.get(request.getRequestType(), request.getParticipantIndex(), request.getDomainIndex());
 }
 
 void ControlBase::clearCachedResult(const DptfRequest& request)
 {
-	tuple<DptfRequestType::Enum, UInt32, UInt32> key(
-		request.getRequestType(), request.getParticipantIndex(), request.getDomainIndex());
-	m_requestCache.erase(key);
+	m_requestCache.remove(request.getRequestType(), request.getParticipantIndex(), request.getDomainIndex());
 }
 
 void ControlBase::clearCachedResult(DptfRequestType::Enum requestType, UInt32 participantIndex, UInt32 domainIndex)
 {
-	tuple<DptfRequestType::Enum, UInt32, UInt32> key(requestType, participantIndex, domainIndex);
-	m_requestCache.erase(key);
+	m_requestCache.remove(requestType, participantIndex, domainIndex);
 }
 
 void ControlBase::updateCachedResult(const DptfRequestResult& requestResult)
 {
-	auto& request = requestResult.getRequest();
-	tuple<DptfRequestType::Enum, UInt32, UInt32> key(
-		request.getRequestType(), request.getParticipantIndex(), request.getDomainIndex());
-	m_requestCache[key] = requestResult;
+	m_requestCache.set(requestResult);
 }
 
 void ControlBase::clearAllCachedResults()
@@ -22,6 +22,7 @@
 #include "ParticipantServicesInterface.h"
 #include "PolicyRequest.h"
 #include "ParticipantLogger.h"
+#include "RequestResultCache.h"
 #include <functional>
 
 class XmlNode;
@@ -62,7 +63,7 @@ protected:
 		DptfRequestType::Enum requestType,
 		std::function<DptfRequestResult(const PolicyRequest&)> functionObj);
 
-	// request cache.  TODO: put this in its own class
+	// request cache
 	Bool requestResultIsCached(const DptfRequest& request);
 	const DptfRequestResult& getCachedResult(const DptfRequest& request) const;
 	void clearCachedResult(const DptfRequest& request);
@@ -76,7 +77,10 @@ private:
 	Bool m_activityLoggingEnabled;
 	UInt16 createTupleDomain() const;
 	DptfRequestResult callHandler(const PolicyRequest& policyRequest);
+	Bool hasRequestHandler(DptfRequestType::Enum requestType) const;
 	void unbindRequestHandlers();
-	std::map<DptfRequestType::Enum, std::function<DptfRequestResult(const PolicyRequest&)>> m_requestHandlers;
-	std::map<std::tuple<DptfRequestType::Enum, UInt32, UInt32>, DptfRequestResult> m_requestCache;
+
+	// indexed by request type
+	std::vector<std::function<DptfRequestResult(const PolicyRequest&)>> m_requestHandlers;
+	RequestResultCache m_requestCache;
 };
@@ -32,6 +32,25 @@ DomainControlList::DomainControlList(
 	, m_controlFactoryList(controlFactoryList)
 	, m_participantServices(participantServices)
 	, m_controlList()
+	, m_activeControl()
+	, m_activityStatusControl()
+	, m_coreControl()
+	, m_displayControl()
+	, m_energyControl()
+	, m_peakPowerControl()
+	, m_performanceControl()
+	, m_powerControl()
+	, m_powerStatusControl()
+	, m_systemPowerControl()
+	, m_platformPowerStatusControl()
+	, m_priorityControl()
+	, m_rfProfileControl()
+	, m_rfProfileStatusControl()
+	, m_temperatureControl()
+	, m_processorControl()
+	, m_utilizationControl()
+	, m_batteryStatusControl()
+	, m_socWorkloadClassificationControl()
 {
 	makeAllControls();
 }
@@ -43,85 +62,71 @@ DomainControlList::~DomainControlList(void)
 void DomainControlList::makeAllControls()
 {
 	// if an error is thrown we don't want to catch it as the domain can't be created anyway.
-	m_controlList.insert(pair<ControlFactoryType::Type, std::shared_ptr<ControlBase>>(
-		ControlFactoryType::Active,
-		makeControl<DomainActiveControlBase>(
-			ControlFactoryType::Active, m_domainFunctionalityVersions.activeControlVersion)));
-	m_controlList.insert(pair<ControlFactoryType::Type, std::shared_ptr<ControlBase>>(
-		ControlFactoryType::Core,
-		makeControl<DomainCoreControlBase>(
-			ControlFactoryType::Core, m_domainFunctionalityVersions.coreControlVersion)));
-	m_controlList.insert(pair<ControlFactoryType::Type, std::shared_ptr<ControlBase>>(
-		ControlFactoryType::Display,
-		makeControl<DomainDisplayControlBase>(
-			ControlFactoryType::Display, m_domainFunctionalityVersions.displayControlVersion)));
-	m_controlList.insert(pair<ControlFactoryType::Type, std::shared_ptr<ControlBase>>(
-		ControlFactoryType::EnergyControl,
-		makeControl<DomainEnergyControlBase>(
-			ControlFactoryType::EnergyControl, m_domainFunctionalityVersions.energyControlVersion)));
-	m_controlList.insert(pair<ControlFactoryType::Type, std::shared_ptr<ControlBase>>(
-		ControlFactoryType::PeakPowerControl,
-		makeControl<DomainPeakPowerControlBase>(
-			ControlFactoryType::PeakPowerControl, m_domainFunctionalityVersions.peakPowerControlVersion)));
-	m_controlList.insert(pair<ControlFactoryType::Type, std::shared_ptr<ControlBase>>(
-		ControlFactoryType::Performance,
-		makeControl<DomainPerformanceControlBase>(
-			ControlFactoryType::Performance, m_domainFunctionalityVersions.performanceControlVersion)));
-	m_controlList.insert(pair<ControlFactoryType::Type, std::shared_ptr<ControlBase>>(
-		ControlFactoryType::PowerControl,
-		makeControl<DomainPowerControlBase>(
-			ControlFactoryType::PowerControl, m_domainFunctionalityVersions.powerControlVersion)));
-	m_controlList.insert(pair<ControlFactoryType::Type, std::shared_ptr<ControlBase>>(
-		ControlFactoryType::PowerStatus,
-		makeControl<DomainPowerStatusBase>(
-			ControlFactoryType::PowerStatus, m_domainFunctionalityVersions.powerStatusVersion)));
-	m_controlList.insert(pair<ControlFactoryType::Type, std::shared_ptr<ControlBase>>(
-		ControlFactoryType::Priority,
-		makeControl<DomainPriorityBase>(
-			ControlFactoryType::Priority, m_domainFunctionalityVersions.domainPriorityVersion)));
-	m_controlList.insert(pair<ControlFactoryType::Type, std::shared_ptr<ControlBase>>(
-		ControlFactoryType::RfProfileControl,
-		makeControl<DomainRfProfileControlBase>(
-			ControlFactoryType::RfProfileControl, m_domainFunctionalityVersions.rfProfileControlVersion)));
-	m_controlList.insert(pair<ControlFactoryType::Type, std::shared_ptr<ControlBase>>(
-		ControlFactoryType::RfProfileStatus,
-		makeControl<DomainRfProfileStatusBase>(
-			ControlFactoryType::RfProfileStatus, m_domainFunctionalityVersions.rfProfileStatusVersion)));
-	m_controlList.insert(pair<ControlFactoryType::Type, std::shared_ptr<ControlBase>>(
+	m_activeControl = makeControl<DomainActiveControlBase>(
+		ControlFactoryType::Active, m_domainFunctionalityVersions.activeControlVersion);
+	addControl(ControlFactoryType::Active, m_activeControl);
+	m_coreControl = makeControl<DomainCoreControlBase>(
+		ControlFactoryType::Core, m_domainFunctionalityVersions.coreControlVersion);
+	addControl(ControlFactoryType::Core, m_coreControl);
+	m_displayControl = makeControl<DomainDisplayControlBase>(
+		ControlFactoryType::Display, m_domainFunctionalityVersions.displayControlVersion);
+	addControl(ControlFactoryType::Display, m_displayControl);
+	m_energyControl = makeControl<DomainEnergyControlBase>(
+		ControlFactoryType::EnergyControl, m_domainFunctionalityVersions.energyControlVersion);
+	addControl(ControlFactoryType::EnergyControl, m_energyControl);
+	m_peakPowerControl = makeControl<DomainPeakPowerControlBase>(
+		ControlFactoryType::PeakPowerControl, m_domainFunctionalityVersions.peakPowerControlVersion);
+	addControl(ControlFactoryType::PeakPowerControl, m_peakPowerControl);
+	m_performanceControl = makeControl<DomainPerformanceControlBase>(
+		ControlFactoryType::Performance, m_domainFunctionalityVersions.performanceControlVersion);
+	addControl(ControlFactoryType::Performance, m_performanceControl);
+	m_powerControl = makeControl<DomainPowerControlBase>(
+		ControlFactoryType::PowerControl, m_domainFunctionalityVersions.powerControlVersion);
+	addControl(ControlFactoryType::PowerControl, m_powerControl);
+	m_powerStatusControl = makeControl<DomainPowerStatusBase>(
+		ControlFactoryType::PowerStatus, m_domainFunctionalityVersions.powerStatusVersion);
+	addControl(ControlFactoryType::PowerStatus, m_powerStatusControl);
+	m_priorityControl = makeControl<DomainPriorityBase>(
+		ControlFactoryType::Priority, m_domainFunctionalityVersions.domainPriorityVersion);
+	addControl(ControlFactoryType::Priority, m_priorityControl);
+	m_rfProfileControl = makeControl<DomainRfProfileControlBase>(
+		ControlFactoryType::RfProfileControl, m_domainFunctionalityVersions.rfProfileControlVersion);
+	addControl(ControlFactoryType::RfProfileControl, m_rfProfileControl);
+	m_rfProfileStatusControl = makeControl<DomainRfProfileStatusBase>(
+		ControlFactoryType::RfProfileStatus, m_domainFunctionalityVersions.rfProfileStatusVersion);
+	addControl(ControlFactoryType::RfProfileStatus, m_rfProfileStatusControl);
+	m_temperatureControl = makeControl<DomainTemperatureBase>(
 		ControlFactoryType::Temperature,
-		makeControl<DomainTemperatureBase>(
-			ControlFactoryType::Temperature,
-			m_domainFunctionalityVersions.temperatureVersion,
-			m_domainFunctionalityVersions.temperatureThresholdVersion)));
-	m_controlList.insert(pair<ControlFactoryType::Type, std::shared_ptr<ControlBase>>(
-		ControlFactoryType::ProcessorControl,
-		makeControl<DomainProcessorControlBase>(
-			ControlFactoryType::ProcessorControl, m_domainFunctionalityVersions.processorControlVersion)));
-	m_controlList.insert(pair<ControlFactoryType::Type, std::shared_ptr<ControlBase>>(
-		ControlFactoryType::Utilization,
-		makeControl<DomainUtilizationBase>(
-			ControlFactoryType::Utilization, m_domainFunctionalityVersions.utilizationVersion)));
-	m_controlList.insert(pair<ControlFactoryType::Type, std::shared_ptr<ControlBase>>(
-		ControlFactoryType::SystemPower,
-		makeControl<DomainSystemPowerControlBase>(
-			ControlFactoryType::SystemPower, m_domainFunctionalityVersions.systemPowerControlVersion)));
-	m_controlList.insert(pair<ControlFactoryType::Type, std::shared_ptr<ControlBase>>(
-		ControlFactoryType::PlatformPowerStatus,
-		makeControl<DomainPlatformPowerStatusBase>(
-			ControlFactoryType::PlatformPowerStatus, m_domainFunctionalityVersions.platformPowerStatusVersion)));
-	m_controlList.insert(pair<ControlFactoryType::Type, std::shared_ptr<ControlBase>>(
-		ControlFactoryType::ActivityStatus,
-		makeControl<DomainActivityStatusBase>(
-			ControlFactoryType::ActivityStatus, m_domainFunctionalityVersions.activityStatusVersion)));
-	m_controlList.insert(pair<ControlFactoryType::Type, std::shared_ptr<ControlBase>>(
-		ControlFactoryType::BatteryStatus,
-		makeControl<DomainBatteryStatusBase>(
-			ControlFactoryType::BatteryStatus, m_domainFunctionalityVersions.batteryStatusVersion)));
-	m_controlList.insert(pair<ControlFactoryType::Type, std::shared_ptr<ControlBase>>(
-		ControlFactoryType::SocWorkloadClassification,
-		makeControl<DomainSocWorkloadClassificationBase>(
-			ControlFactoryType::SocWorkloadClassification,
-			m_domainFunctionalityVersions.socWorkloadClassificationVersion)));
+		m_domainFunctionalityVersions.temperatureVersion,
+		m_domainFunctionalityVersions.temperatureThresholdVersion);
+	addControl(ControlFactoryType::Temperature, m_temperatureControl);
+	m_processorControl = makeControl<DomainProcessorControlBase>(
+		ControlFactoryType::ProcessorControl, m_domainFunctionalityVersions.processorControlVersion);
+	addControl(ControlFactoryType::ProcessorControl, m_processorControl);
+	m_utilizationControl = makeControl<DomainUtilizationBase>(
+		ControlFactoryType::Utilization, m_domainFunctionalityVersions.utilizationVersion);
+	addControl(ControlFactoryType::Utilization, m_utilizationControl);
+	m_systemPowerControl = makeControl<DomainSystemPowerControlBase>(
+		ControlFactoryType::SystemPower, m_domainFunctionalityVersions.systemPowerControlVersion);
+	addControl(ControlFactoryType::SystemPower, m_systemPowerControl);
+	m_platformPowerStatusControl = makeControl<DomainPlatformPowerStatusBase>(
+		ControlFactoryType::PlatformPowerStatus, m_domainFunctionalityVersions.platformPowerStatusVersion);
+	addControl(ControlFactoryType::PlatformPowerStatus, m_platformPowerStatusControl);
+	m_activityStatusControl = makeControl<DomainActivityStatusBase>(
+		ControlFactoryType::ActivityStatus, m_domainFunctionalityVersions.activityStatusVersion);
+	addControl(ControlFactoryType::ActivityStatus, m_activityStatusControl);
+	m_batteryStatusControl = makeControl<DomainBatteryStatusBase>(
+		ControlFactoryType::BatteryStatus, m_domainFunctionalityVersions.batteryStatusVersion);
+	addControl(ControlFactoryType::BatteryStatus, m_batteryStatusControl);
+	m_socWorkloadClassificationControl = makeControl<DomainSocWorkloadClassificationBase>(
+		ControlFactoryType::SocWorkloadClassification, m_domainFunctionalityVersions.socWorkloadClassificationVersion);
+	addControl(ControlFactoryType::SocWorkloadClassification, m_socWorkloadClassificationControl);
+}
+
+template <typename T>
+void DomainControlList::addControl(ControlFactoryType::Type factoryType, const std::shared_ptr<T>& control)
+{
+	m_controlList.insert(pair<ControlFactoryType::Type, std::shared_ptr<ControlBase>>(factoryType, control));
 }
 
 template <typename T>
@@ -223,101 +228,99 @@ void DomainControlList::clearAllCachedResults(void)
 	}
 }
 
-std::shared_ptr<DomainActiveControlBase> DomainControlList::getActiveControl(void)
+const std::shared_ptr<DomainActiveControlBase>& DomainControlList::getActiveControl(void) const
 {
-	return dynamic_pointer_cast<DomainActiveControlBase>(m_controlList.at(ControlFactoryType::Active));
+	return m_activeControl;
 }
 
-std::shared_ptr<DomainActivityStatusBase> DomainControlList::getActivityStatusControl(void)
+const std::shared_ptr<DomainActivityStatusBase>& DomainControlList::getActivityStatusControl(void) const
 {
-	return dynamic_pointer_cast<DomainActivityStatusBase>(m_controlList.at(ControlFactoryType::ActivityStatus));
+	return m_activityStatusControl;
 }
 
-std::shared_ptr<DomainCoreControlBase> DomainControlList::getCoreControl(void)
+const std::shared_ptr<DomainCoreControlBase>& DomainControlList::getCoreControl(void) const
 {
-	return dynamic_pointer_cast<DomainCoreControlBase>(m_controlList.at(ControlFactoryType::Core));
+	return m_coreControl;
 }
 
-std::shared_ptr<DomainDisplayControlBase> DomainControlList::getDisplayControl(void)
+const std::shared_ptr<DomainDisplayControlBase>& DomainControlList::getDisplayControl(void) const
 {
-	return dynamic_pointer_cast<DomainDisplayControlBase>(m_controlList.at(ControlFactoryType::Display));
+	return m_displayControl;
 }
 
-std::shared_ptr<DomainEnergyControlBase> DomainControlList::getEnergyControl(void)
+const std::shared_ptr<DomainEnergyControlBase>& DomainControlList::getEnergyControl(void) const
 {
-	return dynamic_pointer_cast<DomainEnergyControlBase>(m_controlList.at(ControlFactoryType::EnergyControl));
+	return m_energyControl;
 }
 
-std::shared_ptr<DomainPeakPowerControlBase> DomainControlList::getPeakPowerControl(void)
+const std::shared_ptr<DomainPeakPowerControlBase>& DomainControlList::getPeakPowerControl(void) const
 {
-	return dynamic_pointer_cast<DomainPeakPowerControlBase>(m_controlList.at(ControlFactoryType::PeakPowerControl));
+	return m_peakPowerControl;
 }
 
-std::shared_ptr<DomainPerformanceControlBase> DomainControlList::getPerformanceControl(void)
+const std::shared_ptr<DomainPerformanceControlBase>& DomainControlList::getPerformanceControl(void) const
 {
-	return dynamic_pointer_cast<DomainPerformanceControlBase>(m_controlList.at(ControlFactoryType::Performance));
+	return m_performanceControl;
 }
 
-std::shared_ptr<DomainPowerControlBase> DomainControlList::getPowerControl(void)
+const std::shared_ptr<DomainPowerControlBase>& DomainControlList::getPowerControl(void) const
 {
-	return dynamic_pointer_cast<DomainPowerControlBase>(m_controlList.at(ControlFactoryType::PowerControl));
+	return m_powerControl;
 }
 
-std::shared_ptr<DomainPowerStatusBase> DomainControlList::getPowerStatusControl(void)
+const std::shared_ptr<DomainPowerStatusBase>& DomainControlList::getPowerStatusControl(void) const
 {
-	return dynamic_pointer_cast<DomainPowerStatusBase>(m_controlList.at(ControlFactoryType::PowerStatus));
+	return m_powerStatusControl;
 }
 
-std::shared_ptr<DomainSystemPowerControlBase> DomainControlList::getSystemPowerControl(void)
+const std::shared_ptr<DomainSystemPowerControlBase>& DomainControlList::getSystemPowerControl(void) const
 {
-	return dynamic_pointer_cast<DomainSystemPowerControlBase>(m_controlList.at(ControlFactoryType::SystemPower));
+	return m_systemPowerControl;
 }
 
-std::shared_ptr<DomainPlatformPowerStatusBase> DomainControlList::getPlatformPowerStatusControl(void)
+const std::shared_ptr<DomainPlatformPowerStatusBase>& DomainControlList::getPlatformPowerStatusControl(void) const
 {
-	return dynamic_pointer_cast<DomainPlatformPowerStatusBase>(
-		m_controlList.at(ControlFactoryType::PlatformPowerStatus));
+	return m_platformPowerStatusControl;
 }
 
-std::shared_ptr<DomainPriorityBase> DomainControlList::getDomainPriorityControl(void)
+const std::shared_ptr<DomainPriorityBase>& DomainControlList::getDomainPriorityControl(void) const
 {
-	return dynamic_pointer_cast<DomainPriorityBase>(m_controlList.at(ControlFactoryType::Priority));
+	return m_priorityControl;
 }
 
-std::shared_ptr<DomainRfProfileControlBase> DomainControlList::getRfProfileControl(void)
+const std::shared_ptr<DomainRfProfileControlBase>& DomainControlList::getRfProfileControl(void) const
 {
-	return dynamic_pointer_cast<DomainRfProfileControlBase>(m_controlList.at(ControlFactoryType::RfProfileControl));
+	return m_rfProfileControl;
 }
 
-std::shared_ptr<DomainRfProfileStatusBase> DomainControlList::getRfProfileStatusControl(void)
+const std::shared_ptr<DomainRfProfileStatusBase>& DomainControlList::getRfProfileStatusControl(void) const
 {
-	return dynamic_pointer_cast<DomainRfProfileStatusBase>(m_controlList.at(ControlFactoryType::RfProfileStatus));
+	return m_rfProfileStatusControl;
 }
 
-std::shared_ptr<DomainTemperatureBase> DomainControlList::getTemperatureControl(void)
+const std::shared_ptr<DomainTemperatureBase>& DomainControlList::getTemperatureControl(void) const
 {
-	return dynamic_pointer_cast<DomainTemperatureBase>(m_controlList.at(ControlFactoryType::Temperature));
+	return m_temperatureControl;
 }
 
-std::shared_ptr<DomainProcessorControlBase> DomainControlList::getProcessorControl(void)
+const std::shared_ptr<DomainProcessorControlBase>& DomainControlList::getProcessorControl(void) const
 {
-	return dynamic_pointer_cast<DomainProcessorControlBase>(m_controlList.at(ControlFactoryType::ProcessorControl));
+	return m_processorControl;
 }
 
-std::shared_ptr<DomainUtilizationBase> DomainControlList::getUtilizationControl(void)
+const std::shared_ptr<DomainUtilizationBase>& DomainControlList::getUtilizationControl(void) const
 {
-	return dynamic_pointer_cast<DomainUtilizationBase>(m_controlList.at(ControlFactoryType::Utilization));
+	return m_utilizationControl;
 }
 
-std::shared_ptr<DomainBatteryStatusBase> DomainControlList::getBatteryStatusControl(void)
+const std::shared_ptr<DomainBatteryStatusBase>& DomainControlList::getBatteryStatusControl(void) const
 {
-	return dynamic_pointer_cast<DomainBatteryStatusBase>(m_controlList.at(ControlFactoryType::BatteryStatus));
+	return m_batteryStatusControl;
 }
 
-std::shared_ptr<DomainSocWorkloadClassificationBase> DomainControlList::getSocWorkloadClassificationControl(void)
+const std::shared_ptr<DomainSocWorkloadClassificationBase>& DomainControlList::getSocWorkloadClassificationControl(void) const
 {
-	return dynamic_pointer_cast<DomainSocWorkloadClassificationBase>(
-		m_controlList.at(ControlFactoryType::SocWorkloadClassification));
+	return m_socWorkloadClassificationControl;
 }
 
 std::shared_ptr<ParticipantServicesInterface> DomainControlList::getParticipantServices() const
@@ -75,25 +75,25 @@ public:
 		std::shared_ptr<ParticipantServicesInterface> participantServices);
 	~DomainControlList(void);
 
-	std::shared_ptr<DomainActiveControlBase> getActiveControl(void);
-	std::shared_ptr<DomainActivityStatusBase> getActivityStatusControl(void);
-	std::shared_ptr<DomainCoreControlBase> getCoreControl(void);
-	std::shared_ptr<DomainDisplayControlBase> getDisplayControl(void);
-	std::shared_ptr<DomainEnergyControlBase> getEnergyControl(void);
-	std::shared_ptr<DomainPeakPowerControlBase> getPeakPowerControl(void);
-	std::shared_ptr<DomainPerformanceControlBase> getPerformanceControl(void);
-	std::shared_ptr<DomainPowerControlBase> getPowerControl(void);
-	std::shared_ptr<DomainPowerStatusBase> getPowerStatusControl(void);
-	std::shared_ptr<DomainSystemPowerControlBase> getSystemPowerControl(void);
-	std::shared_ptr<DomainPlatformPowerStatusBase> getPlatformPowerStatusControl(void);
-	std::shared_ptr<DomainPriorityBase> getDomainPriorityControl(void);
-	std::shared_ptr<DomainRfProfileControlBase> getRfProfileControl(void);
-	std::shared_ptr<DomainRfProfileStatusBase> getRfProfileStatusControl(void);
-	std::shared_ptr<DomainTemperatureBase> getTemperatureControl(void);
-	std::shared_ptr<DomainProcessorControlBase> getProcessorControl(void);
-	std::shared_ptr<DomainUtilizationBase> getUtilizationControl(void);
-	std::shared_ptr<DomainBatteryStatusBase> getBatteryStatusControl(void);
-	std::shared_ptr<DomainSocWorkloadClassificationBase> getSocWorkloadClassificationControl(void);
+	const std::shared_ptr<DomainActiveControlBase>& getActiveControl(void) const;
+	const std::shared_ptr<DomainActivityStatusBase>& getActivityStatusControl(void) const;
+	const std::shared_ptr<DomainCoreControlBase>& getCoreControl(void) const;
+	const std::shared_ptr<DomainDisplayControlBase>& getDisplayControl(void) const;
+	const std::shared_ptr<DomainEnergyControlBase>& getEnergyControl(void) const;
+	const std::shared_ptr<DomainPeakPowerControlBase>& getPeakPowerControl(void) const;
+	const std::shared_ptr<DomainPerformanceControlBase>& getPerformanceControl(void) const;
+	const std::shared_ptr<DomainPowerControlBase>& getPowerControl(void) const;
+	const std::shared_ptr<DomainPowerStatusBase>& getPowerStatusControl(void) const;
+	const std::shared_ptr<DomainSystemPowerControlBase>& getSystemPowerControl(void) const;
+	const std::shared_ptr<DomainPlatformPowerStatusBase>& getPlatformPowerStatusControl(void) const;
+	const std::shared_ptr<DomainPriorityBase>& getDomainPriorityControl(void) const;
+	const std::shared_ptr<DomainRfProfileControlBase>& getRfProfileControl(void) const;
+	const std::shared_ptr<DomainRfProfileStatusBase>& getRfProfileStatusControl(void) const;
+	const std::shared_ptr<DomainTemperatureBase>& getTemperatureControl(void) const;
+	const std::shared_ptr<DomainProcessorControlBase>& getProcessorControl(void) const;
+	const std::shared_ptr<DomainUtilizationBase>& getUtilizationControl(void) const;
+	const std::shared_ptr<DomainBatteryStatusBase>& getBatteryStatusControl(void) const;
+	const std::shared_ptr<DomainSocWorkloadClassificationBase>& getSocWorkloadClassificationControl(void) const;
 
 	void clearAllCachedData(void);
 	void clearAllCachedResults(void);
@@ -112,7 +112,29 @@ private:
 	std::shared_ptr<ParticipantServicesInterface> m_participantServices;
 	std::map<ControlFactoryType::Type, std::shared_ptr<ControlBase>> m_controlList;
 
+	// typed copies of the controls in m_controlList so the getters don't need a lookup or a cast
+	std::shared_ptr<DomainActiveControlBase> m_activeControl;
+	std::shared_ptr<DomainActivityStatusBase> m_activityStatusControl;
+	std::shared_ptr<DomainCoreControlBase> m_coreControl;
+	std::shared_ptr<DomainDisplayControlBase> m_displayControl;
+	std::shared_ptr<DomainEnergyControlBase> m_energyControl;
+	std::shared_ptr<DomainPeakPowerControlBase> m_peakPowerControl;
+	std::shared_ptr<DomainPerformanceControlBase> m_performanceControl;
+	std::shared_ptr<DomainPowerControlBase> m_powerControl;
+	std::shared_ptr<DomainPowerStatusBase> m_powerStatusControl;
+	std::shared_ptr<DomainSystemPowerControlBase> m_systemPowerControl;
+	std::shared_ptr<DomainPlatformPowerStatusBase> m_platformPowerStatusControl;
+	std::shared_ptr<DomainPriorityBase> m_priorityControl;
+	std::shared_ptr<DomainRfProfileControlBase> m_rfProfileControl;
+	std::shared_ptr<DomainRfProfileStatusBase> m_rfProfileStatusControl;
+	std::shared_ptr<DomainTemperatureBase> m_temperatureControl;
+	std::shared_ptr<DomainProcessorControlBase> m_processorControl;
+	std::shared_ptr<DomainUtilizationBase> m_utilizationControl;
+	std::shared_ptr<DomainBatteryStatusBase> m_batteryStatusControl;
+	std::shared_ptr<DomainSocWorkloadClassificationBase> m_socWorkloadClassificationControl;
+
 	void makeAllControls();
+	template <typename T> void addControl(ControlFactoryType::Type factoryType, const std::shared_ptr<T>& control);
 	template <typename T> std::shared_ptr<T> makeControl(ControlFactoryType::Type factoryType, UInt8& controlVersion);
 	template <typename T>
 	std::shared_ptr<T> makeControl(
@@ -36,8 +36,8 @@ DomainPowerStatus_001::~DomainPowerStatus_001()
 
 PowerStatus DomainPowerStatus_001::getPowerStatus(UIntN participantIndex, UIntN domainIndex)
 {
-	getPower(domainIndex);
-	esif_ccb_sleep_msec(250);
+	// Power is normally calculated from energy samples taken in the background, so getPower only waits when there
+	// is no earlier sample to calculate it from yet
 	return PowerStatus(getPower(domainIndex));
 }
 
@@ -58,8 +58,9 @@ Power DomainPowerStatus_001::getPower(UIntN domainIndex)
 
 	//
 	// We attempt twice for a condition where primitive_try_again is thrown as
-	// in this case it may take two attempts to calculate power.  After two
-	// tries, it is considered a failure and we don't try again.
+	// in this case it may take two attempts to calculate power.  The first
+	// attempt only recorded an energy sample, so wait before reading again.
+	// After two tries, it is considered a failure and we don't try again.
 	//
 	try
 	{
@@ -67,6 +68,7 @@ Power DomainPowerStatus_001::getPower(UIntN domainIndex)
 	}
 	catch (primitive_try_again&)
 	{
+		esif_ccb_sleep_msec(250);
 		try
 		{
 			power = getParticipantServices()->primitiveExecuteGetAsPower(esif_primitive_type::GET_RAPL_POWER, domainIndex);
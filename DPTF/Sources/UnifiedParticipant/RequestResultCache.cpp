@@ -0,0 +1,201 @@
+/******************************************************************************
+** Copyright (c) 2013-2020 Intel Corporation All Rights Reserved
+**
+** Licensed under the Apache License, Version 2.0 (the "License"); you may not
+** use this file except in compliance with the License.
+**
+** You may obtain a copy of the License at
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+** WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+******************************************************************************/
+#include "RequestResultCache.h"
+
+static const UInt32 InitialSlotCount = 16; // must be a power of 2
+
+RequestResultCache::Slot::Slot()
+	: isOccupied(false)
+	, requestType(DptfRequestType::END)
+	, participantIndex(Constants::Invalid)
+	, domainIndex(Constants::Invalid)
+	, result()
+{
+}
+
+RequestResultCache::RequestResultCache()
+	: m_slots()
+	, m_count(0)
+{
+}
+
+RequestResultCache::~RequestResultCache()
+{
+}
+
+Bool RequestResultCache::contains(
+	DptfRequestType::Enum requestType,
+	UInt32 participantIndex,
+	UInt32 domainIndex) const
+{
+	return (findSlot(requestType, participantIndex, domainIndex) != Constants::Invalid);
+}
+
+const DptfRequestResult& RequestResultCache::get(
+	DptfRequestType::Enum requestType,
+	UInt32 participantIndex,
+	UInt32 domainIndex) const
+{
+	auto slot = findSlot(requestType, participantIndex, domainIndex);
+	if (slot == Constants::Invalid)
+	{
+		throw dptf_exception("No cached result for request.");
+	}
+	return m_slots[slot].result;
+}
+
+void RequestResultCache::set(const DptfRequestResult& requestResult)
+{
+	auto& request = requestResult.getRequest();
+	auto requestType = request.getRequestType();
+	auto participantIndex = request.getParticipantIndex();
+	auto domainIndex = request.getDomainIndex();
+
+	auto slot = findSlot(requestType, participantIndex, domainIndex);
+	if (slot != Constants::Invalid)
+	{
+		m_slots[slot].result = requestResult;
+		return;
+	}
+
+	// keep the table at most half full so probe sequences stay short
+	if ((m_count + 1) * 2 > m_slots.size())
+	{
+		grow();
+	}
+
+	UInt32 mask = (UInt32)m_slots.size() - 1;
+	slot = getHomeSlot(requestType, participantIndex, domainIndex);
+	while (m_slots[slot].isOccupied)
+	{
+		slot = (slot + 1) & mask;
+	}
+
+	m_slots[slot].isOccupied = true;
+	m_slots[slot].requestType = requestType;
+	m_slots[slot].participantIndex = participantIndex;
+	m_slots[slot].domainIndex = domainIndex;
+	m_slots[slot].result = requestResult;
+	m_count++;
+}
+
+void RequestResultCache::remove(DptfRequestType::Enum requestType, UInt32 participantIndex, UInt32 domainIndex)
+{
+	auto slot = findSlot(requestType, participantIndex, domainIndex);
+	if (slot == Constants::Invalid)
+	{
+		return;
+	}
+
+	// Shift later entries of the probe sequence back into the hole so lookups never stop early at an empty slot
+	UInt32 mask = (UInt32)m_slots.size() - 1;
+	UInt32 hole = slot;
+	UInt32 next = (hole + 1) & mask;
+	while (m_slots[next].isOccupied)
+	{
+		UInt32 home =
+			getHomeSlot(m_slots[next].requestType, m_slots[next].participantIndex, m_slots[next].domainIndex);
+		UInt32 distanceToHole = (hole - home) & mask;
+		UInt32 distanceToNext = (next - home) & mask;
+		if (distanceToHole < distanceToNext)
+		{
+			m_slots[hole] = m_slots[next];
+			hole = next;
+		}
+		next = (next + 1) & mask;
+	}
+
+	m_slots[hole] = Slot();
+	m_count--;
+}
+
+void RequestResultCache::clear(void)
+{
+	if (m_count > 0)
+	{
+		for (auto slot = m_slots.begin(); slot != m_slots.end(); ++slot)
+		{
+			*slot = Slot();
+		}
+		m_count = 0;
+	}
+}
+
+UInt32 RequestResultCache::getHomeSlot(
+	DptfRequestType::Enum requestType,
+	UInt32 participantIndex,
+	UInt32 domainIndex) const
+{
+	UInt32 hash = ((UInt32)requestType * 0x9E3779B1U) ^ (participantIndex * 0x85EBCA77U) ^ (domainIndex * 0xC2B2AE3DU);
+	hash ^= (hash >> 16);
+	return hash & ((UInt32)m_slots.size() - 1);
+}
+
+UInt32 RequestResultCache::findSlot(
+	DptfRequestType::Enum requestType,
+	UInt32 participantIndex,
+	UInt32 domainIndex) const
+{
+	if (m_count == 0)
+	{
+		return Constants::Invalid;
+	}
+
+	UInt32 mask = (UInt32)m_slots.size() - 1;
+	UInt32 slot = getHomeSlot(requestType, participantIndex, domainIndex);
+	while (m_slots[slot].isOccupied)
+	{
+		if (slotMatches(m_slots[slot], requestType, participantIndex, domainIndex))
+		{
+			return slot;
+		}
+		slot = (slot + 1) & mask;
+	}
+	return Constants::Invalid;
+}
+
+Bool RequestResultCache::slotMatches(
+	const Slot& slot,
+	DptfRequestType::Enum requestType,
+	UInt32 participantIndex,
+	UInt32 domainIndex) const
+{
+	return (slot.requestType == requestType) && (slot.participantIndex == participantIndex)
+		   && (slot.domainIndex == domainIndex);
+}
+
+void RequestResultCache::grow(void)
+{
+	std::vector<Slot> oldSlots;
+	oldSlots.swap(m_slots);
+	m_slots.resize(oldSlots.empty() ? InitialSlotCount : oldSlots.size() * 2);
+
+	UInt32 mask = (UInt32)m_slots.size() - 1;
+	for (auto oldSlot = oldSlots.begin(); oldSlot != oldSlots.end(); ++oldSlot)
+	{
+		if (oldSlot->isOccupied)
+		{
+			UInt32 slot = getHomeSlot(oldSlot->requestType, oldSlot->participantIndex, oldSlot->domainIndex);
+			while (m_slots[slot].isOccupied)
+			{
+				slot = (slot + 1) & mask;
+			}
+			m_slots[slot] = *oldSlot;
+		}
+	}
+}
@@ -0,0 +1,63 @@
+/******************************************************************************
+** Copyright (c) 2013-2020 Intel Corporation All Rights Reserved
+**
+** Licensed under the Apache License, Version 2.0 (the "License"); you may not
+** use this file except in compliance with the License.
+**
+** You may obtain a copy of the License at
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+** WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+******************************************************************************/
+#pragma once
+
+#include "Dptf.h"
+#include "DptfRequestResult.h"
+
+//
+// Caches request results per (request type, participant, domain) in an open-addressed table with linear probing.
+// Controls look up a cached result on every request they handle, so the slots are kept in one flat array.
+//
+
+class RequestResultCache
+{
+public:
+	RequestResultCache();
+	~RequestResultCache();
+
+	Bool contains(DptfRequestType::Enum requestType, UInt32 participantIndex, UInt32 domainIndex) const;
+	const DptfRequestResult& get(DptfRequestType::Enum requestType, UInt32 participantIndex, UInt32 domainIndex) const;
+	void set(const DptfRequestResult& requestResult);
+	void remove(DptfRequestType::Enum requestType, UInt32 participantIndex, UInt32 domainIndex);
+	void clear(void);
+
+private:
+	struct Slot
+	{
+		Slot();
+
+		Bool isOccupied;
+		DptfRequestType::Enum requestType;
+		UInt32 participantIndex;
+		UInt32 domainIndex;
+		DptfRequestResult result;
+	};
+
+	std::vector<Slot> m_slots;
+	UInt32 m_count;
+
+	UInt32 getHomeSlot(DptfRequestType::Enum requestType, UInt32 participantIndex, UInt32 domainIndex) const;
+	UInt32 findSlot(DptfRequestType::Enum requestType, UInt32 participantIndex, UInt32 domainIndex) const;
+	Bool slotMatches(
+		const Slot& slot,
+		DptfRequestType::Enum requestType,
+		UInt32 participantIndex,
+		UInt32 domainIndex) const;
+	void grow(void);
+};
@@ -117,213 +117,213 @@ void UnifiedDomain::clearAllCachedResults(void)
 	m_domainControls->clearAllCachedResults();
 }
 
-std::shared_ptr<DomainActiveControlBase> UnifiedDomain::getActiveControl(void)
+const std::shared_ptr<DomainActiveControlBase>& UnifiedDomain::getActiveControl(void)
 {
 	throwIfDomainNotEnabled();
-	std::shared_ptr<DomainActiveControlBase> ptr = m_domainControls->getActiveControl();
-	if (!ptr)
+	auto& control = m_domainControls->getActiveControl();
+	if (!control)
 	{
 		throw domain_control_nullptr();
 	}
-	return ptr;
+	return control;
 }
 
-std::shared_ptr<DomainActivityStatusBase> UnifiedDomain::getActivityStatusControl(void)
+const std::shared_ptr<DomainActivityStatusBase>& UnifiedDomain::getActivityStatusControl(void)
 {
 	throwIfDomainNotEnabled();
-	std::shared_ptr<DomainActivityStatusBase> ptr = m_domainControls->getActivityStatusControl();
-	if (!ptr)
+	auto& control = m_domainControls->getActivityStatusControl();
+	if (!control)
 	{
 		throw domain_control_nullptr();
 	}
-	return ptr;
+	return control;
 }
 
-std::shared_ptr<DomainCoreControlBase> UnifiedDomain::getCoreControl(void)
+const std::shared_ptr<DomainCoreControlBase>& UnifiedDomain::getCoreControl(void)
 {
 	throwIfDomainNotEnabled();
-	std::shared_ptr<DomainCoreControlBase> ptr = m_domainControls->getCoreControl();
-	if (!ptr)
+	auto& control = m_domainControls->getCoreControl();
+	if (!control)
 	{
 		throw domain_control_nullptr();
 	}
-	return ptr;
+	return control;
 }
 
-std::shared_ptr<DomainDisplayControlBase> UnifiedDomain::getDisplayControl(void)
+const std::shared_ptr<DomainDisplayControlBase>& UnifiedDomain::getDisplayControl(void)
 {
 	throwIfDomainNotEnabled();
-	std::shared_ptr<DomainDisplayControlBase> ptr = m_domainControls->getDisplayControl();
-	if (!ptr)
+	auto& control = m_domainControls->getDisplayControl();
+	if (!control)
 	{
 		throw domain_control_nullptr();
 	}
-	return ptr;
+	return control;
 }
 
-std::shared_ptr<DomainPeakPowerControlBase> UnifiedDomain::getPeakPowerControl(void)
+const std::shared_ptr<DomainPeakPowerControlBase>& UnifiedDomain::getPeakPowerControl(void)
 {
 	throwIfDomainNotEnabled();
-	std::shared_ptr<DomainPeakPowerControlBase> ptr = m_domainControls->getPeakPowerControl();
-	if (!ptr)
+	auto& control = m_domainControls->getPeakPowerControl();
+	if (!control)
 	{
 		throw domain_control_nullptr();
 	}
-	return ptr;
+	return control;
 }
 
-std::shared_ptr<DomainPerformanceControlBase> UnifiedDomain::getPerformanceControl(void)
+const std::shared_ptr<DomainPerformanceControlBase>& UnifiedDomain::getPerformanceControl(void)
 {
 	throwIfDomainNotEnabled();
-	std::shared_ptr<DomainPerformanceControlBase> ptr = m_domainControls->getPerformanceControl();
-	if (!ptr)
+	auto& control = m_domainControls->getPerformanceControl();
+	if (!control)
 	{
 		throw domain_control_nullptr();
 	}
-	return ptr;
+	return control;
 }
 
-std::shared_ptr<DomainPowerControlBase> UnifiedDomain::getPowerControl(void)
+const std::shared_ptr<DomainPowerControlBase>& UnifiedDomain::getPowerControl(void)
 {
 	throwIfDomainNotEnabled();
-	std::shared_ptr<DomainPowerControlBase> ptr = m_domainControls->getPowerControl();
-	if (!ptr)
+	auto& control = m_domainControls->getPowerControl();
+	if (!control)
 	{
 		throw domain_control_nullptr();
 	}
-	return ptr;
+	return control;
 }
 
-std::shared_ptr<DomainPowerStatusBase> UnifiedDomain::getPowerStatusControl(void)
+const std::shared_ptr<DomainPowerStatusBase>& UnifiedDomain::getPowerStatusControl(void)
 {
 	throwIfDomainNotEnabled();
-	std::shared_ptr<DomainPowerStatusBase> ptr = m_domainControls->getPowerStatusControl();
-	if (!ptr)
+	auto& control = m_domainControls->getPowerStatusControl();
+	if (!control)
 	{
 		throw domain_control_nullptr();
 	}
-	return ptr;
+	return control;
 }
 
-std::shared_ptr<DomainSystemPowerControlBase> UnifiedDomain::getSystemPowerControl(void)
+const std::shared_ptr<DomainSystemPowerControlBase>& UnifiedDomain::getSystemPowerControl(void)
 {
 	throwIfDomainNotEnabled();
-	std::shared_ptr<DomainSystemPowerControlBase> ptr = m_domainControls->getSystemPowerControl();
-	if (!ptr)
+	auto& control = m_domainControls->getSystemPowerControl();
+	if (!control)
 	{
 		throw domain_control_nullptr();
 	}
-	return ptr;
+	return control;
 }
 
-std::shared_ptr<DomainPlatformPowerStatusBase> UnifiedDomain::getPlatformPowerStatusControl(void)
+const std::shared_ptr<DomainPlatformPowerStatusBase>& UnifiedDomain::getPlatformPowerStatusControl(void)
 {
 	throwIfDomainNotEnabled();
-	std::shared_ptr<DomainPlatformPowerStatusBase> ptr = m_domainControls->getPlatformPowerStatusControl();
-	if (!ptr)
+	auto& control = m_domainControls->getPlatformPowerStatusControl();
+	if (!control)
 	{
 		throw domain_control_nullptr();
 	}
-	return ptr;
+	return control;
 }
 
-std::shared_ptr<DomainPriorityBase> UnifiedDomain::getDomainPriorityControl(void)
+const std::shared_ptr<DomainPriorityBase>& UnifiedDomain::getDomainPriorityControl(void)
 {
 	throwIfDomainNotEnabled();
-	std::shared_ptr<DomainPriorityBase> ptr = m_domainControls->getDomainPriorityControl();
-	if (!ptr)
+	auto& control = m_domainControls->getDomainPriorityControl();
+	if (!control)
 	{
 		throw domain_control_nullptr();
 	}
-	return ptr;
+	return control;
 }
 
-std::shared_ptr<DomainRfProfileControlBase> UnifiedDomain::getRfProfileControl(void)
+const std::shared_ptr<DomainRfProfileControlBase>& UnifiedDomain::getRfProfileControl(void)
 {
 	throwIfDomainNotEnabled();
-	std::shared_ptr<DomainRfProfileControlBase> ptr = m_domainControls->getRfProfileControl();
-	if (!ptr)
+	auto& control = m_domainControls->getRfProfileControl();
+	if (!control)
 	{
 		throw domain_control_nullptr();
 	}
-	return ptr;
+	return control;
 }
 
-std::shared_ptr<DomainRfProfileStatusBase> UnifiedDomain::getRfProfileStatusControl(void)
+const std::shared_ptr<DomainRfProfileStatusBase>& UnifiedDomain::getRfProfileStatusControl(void)
 {
 	throwIfDomainNotEnabled();
-	std::shared_ptr<DomainRfProfileStatusBase> ptr = m_domainControls->getRfProfileStatusControl();
-	if (!ptr)
+	auto& control = m_domainControls->getRfProfileStatusControl();
+	if (!control)
 	{
 		throw domain_control_nullptr();
 	}
-	return ptr;
+	return control;
 }
 
-std::shared_ptr<DomainTemperatureBase> UnifiedDomain::getTemperatureControl(void)
+const std::shared_ptr<DomainTemperatureBase>& UnifiedDomain::getTemperatureControl(void)
 {
 	throwIfDomainNotEnabled();
-	std::shared_ptr<DomainTemperatureBase> ptr = m_domainControls->getTemperatureControl();
-	if (!ptr)
+	auto& control = m_domainControls->getTemperatureControl();
+	if (!control)
 	{
 		throw domain_control_nullptr();
 	}
-	return ptr;
+	return control;
 }
 
-std::shared_ptr<DomainProcessorControlBase> UnifiedDomain::getProcessorControl(void)
+const std::shared_ptr<DomainProcessorControlBase>& UnifiedDomain::getProcessorControl(void)
 {
 	throwIfDomainNotEnabled();
-	std::shared_ptr<DomainProcessorControlBase> ptr = m_domainControls->getProcessorControl();
-	if (!ptr)
+	auto& control = m_domainControls->getProcessorControl();
+	if (!control)
 	{
 		throw domain_control_nullptr();
 	}
-	return ptr;
+	return control;
 }
 
-std::shared_ptr<DomainUtilizationBase> UnifiedDomain::getUtilizationControl(void)
+const std::shared_ptr<DomainUtilizationBase>& UnifiedDomain::getUtilizationControl(void)
 {
 	throwIfDomainNotEnabled();
-	std::shared_ptr<DomainUtilizationBase> ptr = m_domainControls->getUtilizationControl();
-	if (!ptr)
+	auto& control = m_domainControls->getUtilizationControl();
+	if (!control)
 	{
 		throw domain_control_nullptr();
 	}
-	return ptr;
+	return control;
 }
 
-std::shared_ptr<DomainEnergyControlBase> UnifiedDomain::getEnergyControl(void)
+const std::shared_ptr<DomainEnergyControlBase>& UnifiedDomain::getEnergyControl(void)
 {
 	throwIfDomainNotEnabled();
-	std::shared_ptr<DomainEnergyControlBase> ptr = m_domainControls->getEnergyControl();
-	if (!ptr)
+	auto& control = m_domainControls->getEnergyControl();
+	if (!control)
 	{
 		throw domain_control_nullptr();
 	}
-	return ptr;
+	return control;
 }
 
-std::shared_ptr<DomainBatteryStatusBase> UnifiedDomain::getBatteryStatusControl(void)
+const std::shared_ptr<DomainBatteryStatusBase>& UnifiedDomain::getBatteryStatusControl(void)
 {
 	throwIfDomainNotEnabled();
-	std::shared_ptr<DomainBatteryStatusBase> ptr = m_domainControls->getBatteryStatusControl();
-	if (!ptr)
+	auto& control = m_domainControls->getBatteryStatusControl();
+	if (!control)
 	{
 		throw domain_control_nullptr();
 	}
-	return ptr;
+	return control;
 }
 
-std::shared_ptr<DomainSocWorkloadClassificationBase> UnifiedDomain::getSocWorkloadClassificationControl(void)
+const std::shared_ptr<DomainSocWorkloadClassificationBase>& UnifiedDomain::getSocWorkloadClassificationControl(void)
 {
 	throwIfDomainNotEnabled();
-	std::shared_ptr<DomainSocWorkloadClassificationBase> ptr = m_domainControls->getSocWorkloadClassificationControl();
-	if (!ptr)
+	auto& control = m_domainControls->getSocWorkloadClassificationControl();
+	if (!control)
 	{
 		throw domain_control_nullptr();
 	}
-	return ptr;
+	return control;
 }
 
 std::shared_ptr<ParticipantServicesInterface> UnifiedDomain::getParticipantServices()
@@ -57,25 +57,25 @@ public:
 	void clearAllCachedData(void);
 	void clearAllCachedResults(void);
 
-	std::shared_ptr<DomainActiveControlBase> getActiveControl(void);
-	std::shared_ptr<DomainActivityStatusBase> getActivityStatusControl(void);
-	std::shared_ptr<DomainCoreControlBase> getCoreControl(void);
-	std::shared_ptr<DomainDisplayControlBase> getDisplayControl(void);
-	std::shared_ptr<DomainEnergyControlBase> getEnergyControl(void);
-	std::shared_ptr<DomainPeakPowerControlBase> getPeakPowerControl(void);
-	std::shared_ptr<DomainPerformanceControlBase> getPerformanceControl(void);
-	std::shared_ptr<DomainPowerControlBase> getPowerControl(void);
-	std::shared_ptr<DomainPowerStatusBase> getPowerStatusControl(void);
-	std::shared_ptr<DomainSystemPowerControlBase> getSystemPowerControl(void);
-	std::shared_ptr<DomainPlatformPowerStatusBase> getPlatformPowerStatusControl(void);
-	std::shared_ptr<DomainPriorityBase> getDomainPriorityControl(void);
-	std::shared_ptr<DomainRfProfileControlBase> getRfProfileControl(void);
-	std::shared_ptr<DomainRfProfileStatusBase> getRfProfileStatusControl(void);
-	std::shared_ptr<DomainTemperatureBase> getTemperatureControl(void);
-	std::shared_ptr<DomainProcessorControlBase> getProcessorControl(void);
-	std::shared_ptr<DomainUtilizationBase> getUtilizationControl(void);
-	std::shared_ptr<DomainBatteryStatusBase> getBatteryStatusControl(void);
-	std::shared_ptr<DomainSocWorkloadClassificationBase> getSocWorkloadClassificationControl(void);
+	const std::shared_ptr<DomainActiveControlBase>& getActiveControl(void);
+	const std::shared_ptr<DomainActivityStatusBase>& getActivityStatusControl(void);
+	const std::shared_ptr<DomainCoreControlBase>& getCoreControl(void);
+	const std::shared_ptr<DomainDisplayControlBase>& getDisplayControl(void);
+	const std::shared_ptr<DomainEnergyControlBase>& getEnergyControl(void);
+	const std::shared_ptr<DomainPeakPowerControlBase>& getPeakPowerControl(void);
+	const std::shared_ptr<DomainPerformanceControlBase>& getPerformanceControl(void);
+	const std::shared_ptr<DomainPowerControlBase>& getPowerControl(void);
+	const std::shared_ptr<DomainPowerStatusBase>& getPowerStatusControl(void);
+	const std::shared_ptr<DomainSystemPowerControlBase>& getSystemPowerControl(void);
+	const std::shared_ptr<DomainPlatformPowerStatusBase>& getPlatformPowerStatusControl(void);
+	const std::shared_ptr<DomainPriorityBase>& getDomainPriorityControl(void);
+	const std::shared_ptr<DomainRfProfileControlBase>& getRfProfileControl(void);
+	const std::shared_ptr<DomainRfProfileStatusBase>& getRfProfileStatusControl(void);
+	const std::shared_ptr<DomainTemperatureBase>& getTemperatureControl(void);
+	const std::shared_ptr<DomainProcessorControlBase>& getProcessorControl(void);
+	const std::shared_ptr<DomainUtilizationBase>& getUtilizationControl(void);
+	const std::shared_ptr<DomainBatteryStatusBase>& getBatteryStatusControl(void);
+	const std::shared_ptr<DomainSocWorkloadClassificationBase>& getSocWorkloadClassificationControl(void);
 
 private:
 	// hide the copy constructor and = operator
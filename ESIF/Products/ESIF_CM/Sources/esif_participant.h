@@ -327,6 +327,24 @@ typedef struct _t_EsifUpData {
 	UInt8   fPciProgIf;	/* Program Interface */
 } EsifUpData, *EsifUpDataPtr, **EsifUpDataPtrLocation;
 
+#define ESIF_UP_RESULT_CACHE_SIZE 8		/* Variable-size GET results tracked per participant */
+#define ESIF_UP_RESULT_CACHE_TIMEOUT 1000	/* ms an oversize result is held for the caller's retry */
+
+/*
+ * Size learned from ESIF_E_NEED_LARGER_BUFFER for a GET primitive and, if the caller's
+ * buffer was too small, the result already computed for it
+ */
+typedef struct EsifUpResultCacheEntry_s {
+	EsifPrimitiveTuple tuple;
+	UInt32 sizeHint;			/* 0 = Unused Entry */
+	enum esif_data_type resultType;
+	void *resultPtr;			/* Oversize Result If Any */
+	UInt32 resultLen;
+	void *requestPtr;			/* Request Data The Result Was Computed For */
+	UInt32 requestLen;
+	esif_ccb_time_t resultTime;	/* msec */
+} EsifUpResultCacheEntry, *EsifUpResultCacheEntryPtr;
+
 /* Upper Participant */
 typedef struct _t_EsifUp {
 	/*
@@ -353,6 +371,11 @@ typedef struct _t_EsifUp {
 	UInt8 markedForDelete;
 	esif_ccb_event_t deleteEvent;
 	esif_ccb_lock_t objLock;
+
+	/* Variable-size results */
+	EsifUpResultCacheEntry resultCache[ESIF_UP_RESULT_CACHE_SIZE];
+	UInt32 resultCacheNext;		/* Next entry to replace */
+	esif_ccb_lock_t resultCacheLock;
 } EsifUp, *EsifUpPtr, **EsifUpPtrLocation;
 
 /*
@@ -45,6 +45,8 @@
 
 #include "esif_lib_databank.h"
 #include "esif_ccb_timer.h"
+#include "esif_ccb_atomic.h"
+#include "esif_ccb_sem.h"
 #include "esif_uf_ccb_imp_spec.h"
 
 #ifdef ESIF_ATTR_WEBSOCKET
@@ -101,17 +103,57 @@ esif_ccb_lock_t g_mempool_lock;
 struct memtrace_s g_memtrace;
 #endif
 
+// ESIF Log File Ring Buffer
+// Lines are formatted by the calling thread and copied into a per-log ring buffer without taking a lock.
+// The log writer thread writes queued lines to the log file in batches.
+// Lines too long for a record, or that arrive while the ring is full, are written synchronously instead.
+#define ESIF_LOG_RING_SIZE			(64 * 1024)					// Bytes per log; must be a power of 2
+#define ESIF_LOG_RING_MASK			(ESIF_LOG_RING_SIZE - 1)
+#define ESIF_LOG_RECORD_MAX			(ESIF_LOG_RING_SIZE / 4)	// Longer lines bypass the ring
+#define ESIF_LOG_LINE_BUFSIZE		1024						// Lines up to this length are formatted on the stack
+
+#define ESIF_LOG_RECORD_FREE		0
+#define ESIF_LOG_RECORD_READY		1
+#define ESIF_LOG_RECORD_PADDING		2	// Unused space at the end of the ring
+
+// Record Header, followed by the line. Records are 8-byte aligned and never wrap around the end of the ring.
+typedef struct EsifLogRecord_s {
+	u32			length;		// Line length
+	atomic32_t	state;		// ESIF_LOG_RECORD_*
+} EsifLogRecord;
+
+#define ESIF_LOG_RECORD_SIZE(len)	((sizeof(EsifLogRecord) + (len) + 7) & ~((size_t)7))
+
+typedef struct EsifLogRing_s {
+	char		*buffer;	// Allocated when the log is first opened
+	atomic64_t	reserved;	// Total bytes reserved by writing threads
+	atomic64_t	consumed;	// Total bytes released by the log writer
+	atomic64_t	dropped;	// Lines dropped because they could not be formatted
+} EsifLogRing;
+
 // ESIF Log File object
 typedef struct EsifLogFile_s {
-	esif_ccb_lock_t lock;		// Thread Lock
+	esif_ccb_lock_t lock;		// Thread Lock; held while queued lines are written to the file
 	esif_string		name;		// Log Name
 	esif_string		filename;	// Log file name
 	FILE			*handle;	// Log file handle or NULL if not open
-	Bool			autoflush;	// Automatically Flush File after every EsifLogFile_Write? (off by default)
+	Bool			autoflush;	// Automatically Flush File after every batch of lines? (off by default)
+	EsifLogRing		ring;		// Lines waiting to be written
 } EsifLogFile;
 
 static EsifLogFile g_EsifLogFile[MAX_ESIFLOG] = {0};
 
+// ESIF Log Writer Thread
+typedef struct EsifLogWriter_s {
+	esif_thread_t		thread;
+	esif_ccb_event_t	wakeEvent;
+	atomic_t			idle;		// Writer is waiting for lines; the next line queued sets wakeEvent
+	atomic_t			exitFlag;
+	Bool				started;
+} EsifLogWriter;
+
+static EsifLogWriter g_EsifLogWriter = {0};
+
 enum esif_rc esif_pathlist_init(esif_string path_list);
 void esif_pathlist_exit(void);
 int esif_pathlist_count(void);
@@ -136,6 +178,243 @@ void DCfg_Set(DCfgOptions opt)
 	g_DCfg = opt;
 }
 
+// Copy a line into the ring buffer. Returns the number of bytes queued or 0 if the line is too long or the ring is full.
+static int EsifLogRing_Enqueue(EsifLogRing *ring, const char *line, size_t length)
+{
+	atomic64_basetype reserved = 0;
+	atomic64_basetype consumed = 0;
+	size_t offset = 0;
+	size_t padding = 0;
+	size_t recsize = 0;
+	EsifLogRecord *record = NULL;
+
+	if (length > ESIF_LOG_RECORD_MAX - sizeof(EsifLogRecord)) {
+		return 0;
+	}
+	recsize = ESIF_LOG_RECORD_SIZE(length);
+
+	// Reserve space for the record, plus padding to the end of the ring if it does not fit there
+	do {
+		reserved = atomic64_read(&ring->reserved);
+		consumed = atomic64_read(&ring->consumed);
+		offset = (size_t)(reserved & ESIF_LOG_RING_MASK);
+		padding = (recsize > ESIF_LOG_RING_SIZE - offset ? ESIF_LOG_RING_SIZE - offset : 0);
+		if ((reserved - consumed) + (atomic64_basetype)(padding + recsize) > ESIF_LOG_RING_SIZE) {
+			return 0;
+		}
+	} while (atomic64_cmpxchg(&ring->reserved, reserved, reserved + (atomic64_basetype)(padding + recsize)) != reserved);
+
+	if (padding) {
+		record = (EsifLogRecord *)(ring->buffer + offset);
+		record->length = (u32)(padding - sizeof(EsifLogRecord));
+		atomic32_set(&record->state, ESIF_LOG_RECORD_PADDING);
+		offset = 0;
+	}
+	record = (EsifLogRecord *)(ring->buffer + offset);
+	record->length = (u32)length;
+	esif_ccb_memcpy(record + 1, line, length);
+	atomic32_set(&record->state, ESIF_LOG_RECORD_READY);
+	return (int)length;
+}
+
+// Returns whether the oldest record in the ring is ready to be written
+static Bool EsifLogRing_IsReady(EsifLogRing *ring)
+{
+	atomic64_basetype consumed = atomic64_read(&ring->consumed);
+	EsifLogRecord *record = NULL;
+
+	if ((ring->buffer == NULL) || (consumed == atomic64_read(&ring->reserved))) {
+		return ESIF_FALSE;
+	}
+	record = (EsifLogRecord *)(ring->buffer + (consumed & ESIF_LOG_RING_MASK));
+	return (atomic32_read(&record->state) != ESIF_LOG_RECORD_FREE);
+}
+
+// Write queued lines to the log file. Caller must hold the log's write lock.
+// Returns the number of records released from the ring.
+static int EsifLogFile_DrainLocked(EsifLogFile *log)
+{
+	EsifLogRing *ring = &log->ring;
+	atomic64_basetype consumed = 0;
+	atomic64_basetype reserved = 0;
+	int records = 0;
+	int lines = 0;
+
+	if (ring->buffer == NULL) {
+		return 0;
+	}
+
+	consumed = atomic64_read(&ring->consumed);
+	reserved = atomic64_read(&ring->reserved);
+	while (consumed < reserved) {
+		EsifLogRecord *record = (EsifLogRecord *)(ring->buffer + (consumed & ESIF_LOG_RING_MASK));
+		int state = atomic32_read(&record->state);
+		size_t recsize = 0;
+
+		// Stop at a record that is still being copied; it is written on the next pass
+		if (state == ESIF_LOG_RECORD_FREE) {
+			break;
+		}
+		recsize = ESIF_LOG_RECORD_SIZE(record->length);
+		if ((state == ESIF_LOG_RECORD_READY) && (log->handle != NULL)) {
+			esif_ccb_fwrite(record + 1, sizeof(char), record->length, log->handle);
+			lines++;
+		}
+		// Clear the whole record so a later record header cannot land on stale data
+		esif_ccb_memset(record, 0, recsize);
+		consumed += (atomic64_basetype)recsize;
+		records++;
+	}
+	if (records) {
+		atomic64_set(&ring->consumed, consumed);
+	}
+	if (lines && log->autoflush) {
+		fflush(log->handle);
+	}
+	return records;
+}
+
+static int EsifLogFile_DrainAll(void)
+{
+	int records = 0;
+	int j;
+
+	for (j = 0; j < MAX_ESIFLOG; j++) {
+		if (EsifLogRing_IsReady(&g_EsifLogFile[j].ring)) {
+			esif_ccb_write_lock(&g_EsifLogFile[j].lock);
+			records += EsifLogFile_DrainLocked(&g_EsifLogFile[j]);
+			esif_ccb_write_unlock(&g_EsifLogFile[j].lock);
+		}
+	}
+	return records;
+}
+
+static Bool EsifLogFile_IsAnyReady(void)
+{
+	int j;
+
+	for (j = 0; j < MAX_ESIFLOG; j++) {
+		if (EsifLogRing_IsReady(&g_EsifLogFile[j].ring)) {
+			return ESIF_TRUE;
+		}
+	}
+	return ESIF_FALSE;
+}
+
+static void *ESIF_CALLCONV EsifLogWriter_Thread(void *ctxPtr)
+{
+	UNREFERENCED_PARAMETER(ctxPtr);
+
+	while (!atomic_read(&g_EsifLogWriter.exitFlag)) {
+		if (EsifLogFile_DrainAll() > 0) {
+			continue;
+		}
+
+		// Reset the event before going idle so a line queued after the check below always wakes the writer.
+		// A line still being copied when it is checked wakes the writer once its record is ready, so there is
+		// nothing to poll for while no log is open or every ring is empty.
+		esif_ccb_event_reset(&g_EsifLogWriter.wakeEvent);
+		atomic_set(&g_EsifLogWriter.idle, 1);
+		if (!EsifLogFile_IsAnyReady() && !atomic_read(&g_EsifLogWriter.exitFlag)) {
+			esif_ccb_event_wait(&g_EsifLogWriter.wakeEvent);
+		}
+		atomic_set(&g_EsifLogWriter.idle, 0);
+	}
+	return 0;
+}
+
+static void EsifLogWriter_Wake(EsifLogFile *log)
+{
+	if (g_EsifLogWriter.started) {
+		if (atomic_read(&g_EsifLogWriter.idle) && (atomic_cmpxchg(&g_EsifLogWriter.idle, 1, 0) == 1)) {
+			esif_ccb_event_set(&g_EsifLogWriter.wakeEvent);
+		}
+	}
+	else {
+		// No writer thread (not started or already stopped), so write the line now
+		esif_ccb_write_lock(&log->lock);
+		EsifLogFile_DrainLocked(log);
+		esif_ccb_write_unlock(&log->lock);
+	}
+}
+
+// Write a line that could not be queued. Lines already queued are written first to keep them in order.
+static int EsifLogFile_WriteLineNow(EsifLogFile *log, const char *line, size_t length)
+{
+	int rc = 0;
+
+	esif_ccb_write_lock(&log->lock);
+	EsifLogFile_DrainLocked(log);
+	if (log->handle != NULL) {
+		rc = (int)esif_ccb_fwrite(line, sizeof(char), length, log->handle);
+		if (log->autoflush) {
+			fflush(log->handle);
+		}
+	}
+	esif_ccb_write_unlock(&log->lock);
+	return rc;
+}
+
+// Format a line once and queue it for the log writer
+static int EsifLogFile_WriteLine(EsifLogType type, const char *append, Bool tabify, const char *fmt, va_list args)
+{
+	EsifLogFile *log = &g_EsifLogFile[type];
+	char linebuf[ESIF_LOG_LINE_BUFSIZE] = {0};
+	char *buffer = linebuf;
+	int buflen = sizeof(linebuf) - 2;	// Leave room for the appended string
+	int appendlen = (append ? (int)esif_ccb_strlen(append, MAX_PATH) : 0);
+	int rc = 0;
+	va_list argcopy;
+
+	if ((log->handle == NULL) || (log->ring.buffer == NULL)) {
+		return 0;
+	}
+
+	va_copy(argcopy, args);
+	rc = esif_ccb_vsprintf(buflen, buffer, fmt, argcopy);
+	va_end(argcopy);
+
+	// Only lines that may have been truncated are measured and formatted again
+	if (rc >= buflen - 1) {
+		buflen = esif_ccb_vscprintf(fmt, args) + 1;
+		buffer = esif_ccb_malloc(buflen + 2);
+		if (buffer == NULL) {
+			atomic64_inc(&log->ring.dropped);
+			return 0;
+		}
+		va_copy(argcopy, args);
+		rc = esif_ccb_vsprintf(buflen, buffer, fmt, argcopy);
+		va_end(argcopy);
+	}
+	buflen += 2;
+
+	if (tabify) {
+		// Convert all Newlines to Tabs when logging to a file (except trailing newline)
+		char *ch = NULL;
+		for (ch = buffer; ch[0] && ch[1]; ch++) {
+			if (*ch == '\n')
+				*ch = '\t';
+		}
+	}
+	// Auto-append string (i.e. newline) if necessary
+	if (append && rc > appendlen && rc + appendlen < buflen && esif_ccb_strcmp(buffer + rc - appendlen, append) != 0) {
+		esif_ccb_strcat(buffer, append, buflen);
+		rc += appendlen;
+	}
+
+	if (EsifLogRing_Enqueue(&log->ring, buffer, rc) > 0) {
+		EsifLogWriter_Wake(log);
+	}
+	else {
+		rc = EsifLogFile_WriteLineNow(log, buffer, rc);
+	}
+
+	if (buffer != linebuf) {
+		esif_ccb_free(buffer);
+	}
+	return rc;
+}
+
 eEsifError EsifLogsInit(void)
 {
 	eEsifError rc = ESIF_OK;
@@ -154,6 +433,13 @@ eEsifError EsifLogsInit(void)
 	g_EsifLogFile[ESIF_LOG_UI].name          = esif_ccb_strdup("ui");
 	g_EsifLogFile[ESIF_LOG_PARTICIPANT].name = esif_ccb_strdup("participant");
 
+	// Lines are written synchronously if the writer thread cannot be started
+	esif_ccb_memset(&g_EsifLogWriter, 0, sizeof(g_EsifLogWriter));
+	esif_ccb_event_init(&g_EsifLogWriter.wakeEvent);
+	if (esif_ccb_thread_create(&g_EsifLogWriter.thread, EsifLogWriter_Thread, NULL) == ESIF_OK) {
+		g_EsifLogWriter.started = ESIF_TRUE;
+	}
+
 	ESIF_TRACE_EXIT_INFO_W_STATUS(rc);
 	return rc;
 }
@@ -164,12 +450,25 @@ void EsifLogsExit(void)
 
 	ESIF_TRACE_ENTRY_INFO();
 
+	// Stop the writer thread, then write any lines still queued before closing the files
+	if (g_EsifLogWriter.started) {
+		atomic_set(&g_EsifLogWriter.exitFlag, 1);
+		esif_ccb_event_set(&g_EsifLogWriter.wakeEvent);
+		esif_ccb_thread_join(&g_EsifLogWriter.thread);
+		g_EsifLogWriter.started = ESIF_FALSE;
+	}
+	esif_ccb_event_uninit(&g_EsifLogWriter.wakeEvent);
+
 	for (j=0; j < MAX_ESIFLOG; j++) {
+		esif_ccb_write_lock(&g_EsifLogFile[j].lock);
+		EsifLogFile_DrainLocked(&g_EsifLogFile[j]);
+		esif_ccb_write_unlock(&g_EsifLogFile[j].lock);
 		if (g_EsifLogFile[j].handle != NULL) {
 			esif_ccb_fclose(g_EsifLogFile[j].handle);
 		}
 		esif_ccb_free(g_EsifLogFile[j].name);
 		esif_ccb_free(g_EsifLogFile[j].filename);
+		esif_ccb_free(g_EsifLogFile[j].ring.buffer);
 		esif_ccb_lock_uninit(&g_EsifLogFile[j].lock);
 	}
 	esif_ccb_memset(g_EsifLogFile, 0, sizeof(g_EsifLogFile));
@@ -177,19 +476,24 @@ void EsifLogsExit(void)
 	ESIF_TRACE_EXIT_INFO();
 }
 
-int EsifLogFile_Open(EsifLogType type, const char *filename, int append)
+static int EsifLogFile_OpenMode(EsifLogType type, const char *filename, int append, Bool binary)
 {
 	int rc=0;
 	char fullpath[MAX_PATH]={0};
-	char mode[3] = {(append ? 'a' : 'w'), 0, 0};
+	char mode[4] = {(append ? 'a' : 'w'), (binary ? 'b' : 0), 0, 0};
 
 	esif_ccb_write_lock(&g_EsifLogFile[type].lock);
-	if (g_EsifLogFile[type].handle != NULL)
+	if (g_EsifLogFile[type].handle != NULL) {
+		EsifLogFile_DrainLocked(&g_EsifLogFile[type]);
 		esif_ccb_fclose(g_EsifLogFile[type].handle);
+	}
+	if (g_EsifLogFile[type].ring.buffer == NULL) {
+		g_EsifLogFile[type].ring.buffer = esif_ccb_malloc(ESIF_LOG_RING_SIZE);
+	}
 
 	EsifLogFile_GetFullPath(fullpath, sizeof(fullpath), filename);
 #ifdef ESIF_ATTR_OS_WINDOWS
-	mode[1] = 'c';
+	mode[esif_ccb_strlen(mode, sizeof(mode))] = 'c';
 	g_EsifLogFile[type].handle = _fsopen(fullpath, mode, _SH_DENYWR);
 	if (g_EsifLogFile[type].handle == NULL)
 		rc = errno;
@@ -204,13 +508,25 @@ int EsifLogFile_Open(EsifLogType type, const char *filename, int append)
 	return rc;
 }
 
+int EsifLogFile_Open(EsifLogType type, const char *filename, int append)
+{
+	return EsifLogFile_OpenMode(type, filename, append, ESIF_FALSE);
+}
+
+int EsifLogFile_OpenBinary(EsifLogType type, const char *filename, int append)
+{
+	return EsifLogFile_OpenMode(type, filename, append, ESIF_TRUE);
+}
+
 int EsifLogFile_Close(EsifLogType type)
 {
 	int rc = EOF;
 
 	esif_ccb_write_lock(&g_EsifLogFile[type].lock);
-	if (g_EsifLogFile[type].handle != NULL)
+	if (g_EsifLogFile[type].handle != NULL) {
+		EsifLogFile_DrainLocked(&g_EsifLogFile[type]);
 		rc = esif_ccb_fclose(g_EsifLogFile[type].handle);
+	}
 	g_EsifLogFile[type].handle = NULL;
 	esif_ccb_write_unlock(&g_EsifLogFile[type].lock);
 	return rc;
@@ -250,32 +566,21 @@ int EsifLogFile_WriteArgs(EsifLogType type, const char *fmt, va_list args)
 }
 
 int EsifLogFile_WriteArgsAppend(EsifLogType type, const char *append, const char *fmt, va_list args)
+{
+	return EsifLogFile_WriteLine(type, append, ESIF_TRUE, fmt, args);
+}
+
+// Write a block of binary data directly to the log file, after any lines that are still queued
+int EsifLogFile_WriteBinary(EsifLogType type, const void *buffer, size_t length)
 {
 	int rc = 0;
-	int appendlen = (append ? (int)esif_ccb_strlen(append, MAX_PATH) : 0);
 
 	esif_ccb_write_lock(&g_EsifLogFile[type].lock);
 	if (g_EsifLogFile[type].handle != NULL) {
-		// Convert all Newlines to Tabs when logging to a file (except trailing newline)
-		int  buflen = esif_ccb_vscprintf(fmt, args) + 2;
-		char *buffer = esif_ccb_malloc(buflen);
-		if (buffer) {
-			char *ch = NULL;
-			rc = esif_ccb_vsprintf(buflen, buffer, fmt, args);
-			for (ch = buffer; ch[0] && ch[1]; ch++) {
-				if (*ch == '\n')
-					*ch = '\t';
-			}
-			// Auto-append string (i.e. newline) if necessary
-			if (append && rc > appendlen && rc + appendlen < buflen && esif_ccb_strcmp(buffer + rc - appendlen, append) != 0) {
-				esif_ccb_strcat(buffer, append, buflen);
-				rc += appendlen;
-			}
-			rc = (int)esif_ccb_fwrite(buffer, sizeof(char), rc, g_EsifLogFile[type].handle);
-			if (g_EsifLogFile[type].autoflush) {
-				fflush(g_EsifLogFile[type].handle);
-			}
-			esif_ccb_free(buffer);
+		EsifLogFile_DrainLocked(&g_EsifLogFile[type]);
+		rc = (int)esif_ccb_fwrite(buffer, sizeof(char), length, g_EsifLogFile[type].handle);
+		if (g_EsifLogFile[type].autoflush) {
+			fflush(g_EsifLogFile[type].handle);
 		}
 	}
 	esif_ccb_write_unlock(&g_EsifLogFile[type].lock);
@@ -309,6 +614,9 @@ void EsifLogFile_DisplayList(void)
 	for (j = 0; j < MAX_ESIFLOG; j++) {
 		if (g_EsifLogFile[j].handle != NULL && g_EsifLogFile[j].name != NULL) {
 			CMD_OUT("%s log: %s\n", g_EsifLogFile[j].name, (g_EsifLogFile[j].filename ? g_EsifLogFile[j].filename : "NA"));
+			if (atomic64_read(&g_EsifLogFile[j].ring.dropped) > 0) {
+				CMD_OUT("%s log: " ATOMIC64_FMT " lines dropped\n", g_EsifLogFile[j].name, atomic64_read(&g_EsifLogFile[j].ring.dropped));
+			}
 		}
 	}
 }
@@ -353,9 +661,7 @@ int EsifConsole_WriteTo(u32 writeto, const char *format, ...)
 	if ((writeto & CMD_WRITETO_LOGFILE) && (g_EsifLogFile[ESIF_LOG_SHELL].handle != NULL)) {
 		va_list args;
 		va_start(args, format);
-		esif_ccb_write_lock(&g_EsifLogFile[ESIF_LOG_SHELL].lock);
-		rc = esif_ccb_vfprintf(g_EsifLogFile[ESIF_LOG_SHELL].handle, format, args);
-		esif_ccb_write_unlock(&g_EsifLogFile[ESIF_LOG_SHELL].lock);
+		rc = EsifLogFile_WriteLine(ESIF_LOG_SHELL, NULL, ESIF_FALSE, format, args);
 		va_end(args);
 	}
 	return rc;
@@ -368,11 +674,7 @@ int EsifConsole_WriteConsole(const char *format, va_list args)
 
 int EsifConsole_WriteLogFile(const char *format, va_list args)
 {
-	int rc=0;
-	esif_ccb_write_lock(&g_EsifLogFile[ESIF_LOG_SHELL].lock);
-	rc = esif_ccb_vfprintf(g_EsifLogFile[ESIF_LOG_SHELL].handle, format, args);
-	esif_ccb_write_unlock(&g_EsifLogFile[ESIF_LOG_SHELL].lock);
-	return rc;
+	return EsifLogFile_WriteLine(ESIF_LOG_SHELL, NULL, ESIF_FALSE, format, args);
 }
 
 /* Work Around */
@@ -1106,7 +1408,7 @@ EsifInitTableEntry g_esifUfInitTable[] = {
 	{ EsifUpsm_Start,					EsifUpsm_Stop,						ESIF_INIT_FLAG_IGNORE_ERROR },
 	{ EsifCnjMgrInit,					EsifCnjMgrExit,						ESIF_INIT_FLAG_NONE },
 	{ EsifAppMgr_Start,					EsifAppMgr_Stop,					ESIF_INIT_FLAG_NONE },
-	{ esif_ccb_participants_initialize,	NULL,								ESIF_INIT_FLAG_NONE },
+	{ esif_ccb_participants_initialize,	esif_ccb_participants_exit,			ESIF_INIT_FLAG_NONE },
 	// Next NULL init items may or may not be running and are only started once ESIF is fully initialized
 	{ NULL,								EsifUFPollStop,						ESIF_INIT_FLAG_NONE },
 	{ NULL,								EsifLogMgr_Exit,					ESIF_INIT_FLAG_NONE },
@@ -72,12 +72,14 @@ typedef enum eEsifLogType {
 
 // Log File API
 extern int EsifLogFile_Open(EsifLogType type, const char *filename, int append);
+extern int EsifLogFile_OpenBinary(EsifLogType type, const char *filename, int append);
 extern int EsifLogFile_Close(EsifLogType type);
 extern int EsifLogFile_IsOpen(EsifLogType type);
 extern int EsifLogFile_AutoFlush(EsifLogType type, Bool option);
 extern int EsifLogFile_Write(EsifLogType type, const char *fmt, ...);
 extern int EsifLogFile_WriteArgs(EsifLogType type, const char *fmt, va_list args);
 extern int EsifLogFile_WriteArgsAppend(EsifLogType type, const char *append, const char *fmt, va_list args);
+extern int EsifLogFile_WriteBinary(EsifLogType type, const void *buffer, size_t length);
 extern esif_string EsifLogFile_GetFullPath(esif_string buffer, size_t buf_len, const char *filename);
 extern void EsifLogFile_DisplayList(void);
 extern esif_string EsifLogFile_GetFileNameFromType(EsifLogType logType);
@@ -113,10 +113,45 @@ static AppParticipantDataMapPtr EsifApp_FindEmptyDataMap(
 	const EsifAppPtr self
 	);
 
+static AppParticipantDataMapPtr EsifApp_MapParticipant(
+	EsifAppPtr self,
+	const esif_handle_t participantId
+	);
+
+static void EsifApp_UnmapParticipant(
+	EsifAppPtr self,
+	AppParticipantDataMapPtr participantDataMapPtr
+	);
+
+static AppParticipantDataMapPtr EsifApp_FindParticipantDataMapLocked(
+	const EsifAppPtr self,
+	const esif_handle_t participantId,
+	UInt32 *probesPtr
+	);
+
+static AppDomainDataMapPtr EsifApp_FindDomainDataMapLocked(
+	const AppParticipantDataMapPtr upMapPtr,
+	const esif_handle_t domainHandle,
+	UInt32 *probesPtr
+	);
+
+static void EsifApp_RecordTranslation(
+	EsifAppPtr self,
+	UInt32 probes,
+	Bool found
+	);
+
 static void EsifApp_WaitForAccessCompletion(EsifAppPtr self);
 
 static void EsifApp_ClearParticipantDataMap(AppParticipantDataMapPtr participantDataMapPtr);
 
+static void EsifApp_HandleIndexInit(AppHandleIndexEntryPtr indexPtr, size_t indexSize);
+static void EsifApp_HandleIndexInsert(AppHandleIndexEntryPtr indexPtr, size_t indexSize, esif_handle_t handle, UInt8 slot);
+static void EsifApp_HandleIndexRemove(AppHandleIndexEntryPtr indexPtr, size_t indexSize, esif_handle_t handle);
+static UInt8 EsifApp_HandleIndexLookup(AppHandleIndexEntryPtr indexPtr, size_t indexSize, esif_handle_t handle, UInt32 *probesPtr);
+
+#define ESIF_APP_INDEX_NO_SLOT 0xFF
+
 static void EsifApp_StripInvalid(EsifString buffer, size_t buf_len)
 {
 	const EsifString banned = "\r\n\t,|";
@@ -181,7 +216,13 @@ eEsifError EsifApp_Create(
 		for (j = 0; j < (sizeof(self->fParticipantData[i].fDomainData) / sizeof(*self->fParticipantData[i].fDomainData)); j++) {
 			self->fParticipantData[i].fDomainData[j].fAppDomainHandle = ESIF_INVALID_HANDLE;
 		}
+		EsifApp_HandleIndexInit(self->fParticipantData[i].fDomainIndex, ESIF_APP_DOMAIN_INDEX_SIZE);
+
+		/* Free slots are used from the end of the list; so list them in descending order */
+		self->fFreeParticipantSlots[i] = (UInt8)(MAX_PARTICIPANT_ENTRY - 1 - i);
 	}
+	self->fFreeParticipantSlotCount = MAX_PARTICIPANT_ENTRY;
+	EsifApp_HandleIndexInit(self->fParticipantIndex, ESIF_APP_PART_INDEX_SIZE);
 	*appPtr = self;
 exit:
 	if (rc != ESIF_OK) {
@@ -613,6 +654,10 @@ static eEsifError EsifApp_CreateDomain(
 		participantDataMapPtr->fDomainData[domainId].fQualifier = g_qualifiers[domainId];
 		participantDataMapPtr->fDomainData[domainId].fQualifierId      = *(u16 *)g_qualifiers[domainId];
 
+		esif_ccb_write_lock(&self->objLock);
+		EsifApp_HandleIndexInsert(participantDataMapPtr->fDomainIndex, ESIF_APP_DOMAIN_INDEX_SIZE, domainHandle, domainId);
+		esif_ccb_write_unlock(&self->objLock);
+
 		ESIF_TRACE_DEBUG("DomainMap(%u): Name %s Esif(%s) %p Mapped To Handle 0x%p\n",
 						 domainId,
 						 (esif_string)domain_data_ptr->fName.buf_ptr,
@@ -784,12 +829,16 @@ eEsifError EsifApp_CreateParticipant(
 		goto exit;
 	}
 
-	participantDataMapPtr->fAppParticipantHandle = participantId;
+	participantDataMapPtr = EsifApp_MapParticipant(self, participantId);
+	if (NULL == participantDataMapPtr) {
+		rc = ESIF_E_NO_CREATE;
+		goto exit;
+	}
 
 	/* get reference on participant since we save a copy of pointer for later use*/
 	rc = EsifUp_GetRef(upPtr);
 	if (ESIF_OK != rc) {
-		participantDataMapPtr->fUpPtr = NULL;
+		EsifApp_UnmapParticipant(self, participantDataMapPtr);
 		goto exit;
 	}
 
@@ -809,8 +858,7 @@ eEsifError EsifApp_CreateParticipant(
 
 	if ((ESIF_OK != rc) || (NULL == participantDataMapPtr->fUpPtr)) {
 		EsifUp_PutRef(participantDataMapPtr->fUpPtr);
-		participantDataMapPtr->fAppParticipantHandle = ESIF_INVALID_HANDLE;	/* Application Participant */
-		participantDataMapPtr->fUpPtr = NULL;					/* ESIF Participant */
+		EsifApp_UnmapParticipant(self, participantDataMapPtr);
 		goto exit;
 	}
 
@@ -858,6 +906,10 @@ static eEsifError EsifApp_DestroyDomain(
 						 esif_rc_str(rc), rc);
 	}
 
+	esif_ccb_write_lock(&self->objLock);
+	EsifApp_HandleIndexRemove(participantDataMapPtr->fDomainIndex, ESIF_APP_DOMAIN_INDEX_SIZE, domainDataMapPtr->fAppDomainHandle);
+	esif_ccb_write_unlock(&self->objLock);
+
 	EsifHandleMgr_PutHandle(domainDataMapPtr->fAppDomainHandle);
 	esif_ccb_memset(domainDataMapPtr, 0, sizeof(*domainDataMapPtr));
 	domainDataMapPtr->fAppDomainHandle = ESIF_INVALID_HANDLE;
@@ -929,7 +981,7 @@ exit:
 		if ((participant_data_map_ptr != NULL) && isValid) {
 			/* release reference on participant since we get reference on it in EsifApp_CreateParticipant */
 			EsifUp_PutRef(participant_data_map_ptr->fUpPtr);
-			EsifApp_ClearParticipantDataMap(participant_data_map_ptr);
+			EsifApp_UnmapParticipant(self, participant_data_map_ptr);
 		}
 	}
 
@@ -949,6 +1001,7 @@ static void EsifApp_ClearParticipantDataMap(AppParticipantDataMapPtr participant
 	for (i = 0; i < (sizeof(participantDataMapPtr->fDomainData) / sizeof(*participantDataMapPtr->fDomainData)); i++) {
 		participantDataMapPtr->fDomainData[i].fAppDomainHandle = ESIF_INVALID_HANDLE;
 	}
+	EsifApp_HandleIndexInit(participantDataMapPtr->fDomainIndex, ESIF_APP_DOMAIN_INDEX_SIZE);
 }
 
 // Enable or Disable Policy Ativity Logging
@@ -1278,21 +1331,13 @@ AppParticipantDataMapPtr EsifApp_GetParticipantDataMapFromInstance(
 	const esif_handle_t participantId
 )
 {
-	UInt8 i = 0;
 	AppParticipantDataMapPtr upDataMapPtr = NULL;
 
-	if (EsifUpPm_IsPrimaryParticipantId(participantId) || (ESIF_INVALID_HANDLE == participantId)) {
-		return upDataMapPtr;
-	}
-
-	for (i = 0; i < MAX_PARTICIPANT_ENTRY; i++) {
-		if (self->fParticipantData[i].fAppParticipantHandle == participantId) {
-			upDataMapPtr = &self->fParticipantData[i];
-			break;
-		}
-	}
+	esif_ccb_read_lock(&self->objLock);
+	upDataMapPtr = EsifApp_FindParticipantDataMapLocked(self, participantId, NULL);
+	esif_ccb_read_unlock(&self->objLock);
 
-	if (NULL == upDataMapPtr) {
+	if ((NULL == upDataMapPtr) && !EsifUpPm_IsPrimaryParticipantId(participantId) && (ESIF_INVALID_HANDLE != participantId)) {
 		ESIF_TRACE_DEBUG("Unable to find participant data map for participant handle\n");
 	}
 
@@ -1305,15 +1350,13 @@ static AppParticipantDataMapPtr EsifApp_FindEmptyDataMap(
 	const EsifAppPtr self
 	)
 {
-	size_t i = 0;
 	AppParticipantDataMapPtr upDataMapPtr = NULL;
 
-	for (i = 0; i < MAX_PARTICIPANT_ENTRY; i++) {
-		if (ESIF_INVALID_HANDLE == self->fParticipantData[i].fAppParticipantHandle) {
-			upDataMapPtr = &self->fParticipantData[i];
-			break;
-		}
+	esif_ccb_read_lock(&self->objLock);
+	if (self->fFreeParticipantSlotCount > 0) {
+		upDataMapPtr = &self->fParticipantData[self->fFreeParticipantSlots[self->fFreeParticipantSlotCount - 1]];
 	}
+	esif_ccb_read_unlock(&self->objLock);
 
 	if (NULL == upDataMapPtr) {
 		ESIF_TRACE_DEBUG("Unable to find empty participant data map\n");
@@ -1323,20 +1366,111 @@ static AppParticipantDataMapPtr EsifApp_FindEmptyDataMap(
 }
 
 
-AppDomainDataMapPtr EsifApp_GetDomainDataMapFromHandle(
+/* Take an empty participant data map slot for the participant and add it to the participant index */
+static AppParticipantDataMapPtr EsifApp_MapParticipant(
+	EsifAppPtr self,
+	const esif_handle_t participantId
+	)
+{
+	AppParticipantDataMapPtr upDataMapPtr = NULL;
+	UInt8 slot = 0;
+
+	esif_ccb_write_lock(&self->objLock);
+	if (self->fFreeParticipantSlotCount > 0) {
+		slot = self->fFreeParticipantSlots[--self->fFreeParticipantSlotCount];
+		upDataMapPtr = &self->fParticipantData[slot];
+		upDataMapPtr->fAppParticipantHandle = participantId;
+		EsifApp_HandleIndexInsert(self->fParticipantIndex, ESIF_APP_PART_INDEX_SIZE, participantId, slot);
+	}
+	esif_ccb_write_unlock(&self->objLock);
+
+	if (NULL == upDataMapPtr) {
+		ESIF_TRACE_DEBUG("Unable to find empty participant data map\n");
+	}
+
+	return upDataMapPtr;
+}
+
+
+/* Remove the participant from the participant index and return its slot to the empty list */
+static void EsifApp_UnmapParticipant(
+	EsifAppPtr self,
+	AppParticipantDataMapPtr participantDataMapPtr
+	)
+{
+	ESIF_ASSERT(self != NULL);
+	ESIF_ASSERT(participantDataMapPtr != NULL);
+
+	esif_ccb_write_lock(&self->objLock);
+	if (participantDataMapPtr->fAppParticipantHandle != ESIF_INVALID_HANDLE) {
+		EsifApp_HandleIndexRemove(self->fParticipantIndex, ESIF_APP_PART_INDEX_SIZE, participantDataMapPtr->fAppParticipantHandle);
+		self->fFreeParticipantSlots[self->fFreeParticipantSlotCount++] = (UInt8)(participantDataMapPtr - self->fParticipantData);
+	}
+	EsifApp_ClearParticipantDataMap(participantDataMapPtr);
+	esif_ccb_write_unlock(&self->objLock);
+}
+
+
+/* Lookup participant data for a handle (objLock must be held) */
+static AppParticipantDataMapPtr EsifApp_FindParticipantDataMapLocked(
+	const EsifAppPtr self,
+	const esif_handle_t participantId,
+	UInt32 *probesPtr
+	)
+{
+	AppParticipantDataMapPtr upDataMapPtr = NULL;
+	UInt8 slot = ESIF_APP_INDEX_NO_SLOT;
+
+	if (EsifUpPm_IsPrimaryParticipantId(participantId) || (ESIF_INVALID_HANDLE == participantId)) {
+		return upDataMapPtr;
+	}
+
+	slot = EsifApp_HandleIndexLookup(self->fParticipantIndex, ESIF_APP_PART_INDEX_SIZE, participantId, probesPtr);
+	if (slot < MAX_PARTICIPANT_ENTRY) {
+		upDataMapPtr = &self->fParticipantData[slot];
+	}
+	return upDataMapPtr;
+}
+
+
+/* Lookup domain data for a handle (objLock must be held) */
+static AppDomainDataMapPtr EsifApp_FindDomainDataMapLocked(
 	const AppParticipantDataMapPtr upMapPtr,
-	const esif_handle_t domainHandle
+	const esif_handle_t domainHandle,
+	UInt32 *probesPtr
 	)
 {
-	UInt8 i = 0;
 	AppDomainDataMapPtr domainDataMapPtr = NULL;
+	UInt8 slot = ESIF_APP_INDEX_NO_SLOT;
 
-	for (i = 0; i < MAX_DOMAIN_ENTRY; i++) {
-		if (upMapPtr->fDomainData[i].fAppDomainHandle == domainHandle) {
-			domainDataMapPtr = &upMapPtr->fDomainData[i];
-			break;
-		}
+	slot = EsifApp_HandleIndexLookup(upMapPtr->fDomainIndex, ESIF_APP_DOMAIN_INDEX_SIZE, domainHandle, probesPtr);
+	if (slot < MAX_DOMAIN_ENTRY) {
+		domainDataMapPtr = &upMapPtr->fDomainData[slot];
 	}
+	return domainDataMapPtr;
+}
+
+
+static void EsifApp_RecordTranslation(
+	EsifAppPtr self,
+	UInt32 probes,
+	Bool found
+	)
+{
+	atomic64_inc(&self->translationCount);
+	atomic64_add(probes, &self->translationProbes);
+	if (!found) {
+		atomic64_inc(&self->translationMisses);
+	}
+}
+
+
+AppDomainDataMapPtr EsifApp_GetDomainDataMapFromHandle(
+	const AppParticipantDataMapPtr upMapPtr,
+	const esif_handle_t domainHandle
+	)
+{
+	AppDomainDataMapPtr domainDataMapPtr = EsifApp_FindDomainDataMapLocked(upMapPtr, domainHandle, NULL);
 
 	if (NULL == domainDataMapPtr) {
 		ESIF_TRACE_DEBUG("Unable to find domain data map for participant handle\n");
@@ -1356,25 +1490,27 @@ eEsifError EsifApp_GetDomainIdByHandle(
 	eEsifError rc = ESIF_OK;
 	AppParticipantDataMapPtr upMapPtr = NULL;
 	AppDomainDataMapPtr domainPtr = NULL;
+	UInt32 probes = 0;
 
 	if ((NULL == self) || (NULL == domainIdPtr)) {
 		rc = ESIF_E_PARAMETER_IS_NULL;
 		goto exit;
 	}
 
-	upMapPtr = EsifApp_GetParticipantDataMapFromInstance(self, upHandle);
-	if (NULL == upMapPtr) {
-		rc = ESIF_E_INVALID_HANDLE;
-		goto exit;
+	esif_ccb_read_lock(&self->objLock);
+	upMapPtr = EsifApp_FindParticipantDataMapLocked(self, upHandle, &probes);
+	if (upMapPtr != NULL) {
+		domainPtr = EsifApp_FindDomainDataMapLocked(upMapPtr, domainHandle, &probes);
 	}
+	if (domainPtr != NULL) {
+		*domainIdPtr = domainPtr->fQualifierId;
+	}
+	esif_ccb_read_unlock(&self->objLock);
 
-	domainPtr = EsifApp_GetDomainDataMapFromHandle(upMapPtr, domainHandle);
+	EsifApp_RecordTranslation(self, probes, (domainPtr != NULL));
 	if (NULL == domainPtr) {
 		rc = ESIF_E_INVALID_HANDLE;
-		goto exit;
 	}
-
-	*domainIdPtr = domainPtr->fQualifierId;
 exit:
 	return rc;
 }
@@ -1389,22 +1525,23 @@ char *EsifApp_GetDomainQalifierByHandle(
 	char *qualifier = NULL;
 	AppParticipantDataMapPtr upMapPtr = NULL;
 	AppDomainDataMapPtr domainPtr = NULL;
+	UInt32 probes = 0;
 
 	if (NULL == self) {
 		goto exit;
 	}
 
-	upMapPtr = EsifApp_GetParticipantDataMapFromInstance(self, upHandle);
-	if (NULL == upMapPtr) {
-		goto exit;
+	esif_ccb_read_lock(&self->objLock);
+	upMapPtr = EsifApp_FindParticipantDataMapLocked(self, upHandle, &probes);
+	if (upMapPtr != NULL) {
+		domainPtr = EsifApp_FindDomainDataMapLocked(upMapPtr, domainHandle, &probes);
 	}
-
-	domainPtr = EsifApp_GetDomainDataMapFromHandle(upMapPtr, domainHandle);
-	if (NULL == domainPtr) {
-		goto exit;
+	if (domainPtr != NULL) {
+		qualifier = domainPtr->fQualifier;
 	}
+	esif_ccb_read_unlock(&self->objLock);
 
-	qualifier = domainPtr->fQualifier;
+	EsifApp_RecordTranslation(self, probes, (domainPtr != NULL));
 exit:
 	return qualifier;
 }
@@ -1421,26 +1558,149 @@ eEsifError EsifApp_GetHandlesByIds(
 	eEsifError rc = ESIF_OK;
 	AppParticipantDataMapPtr upDataMapPtr = NULL;
 	UInt8 domainIndex = 0;
+	UInt32 probes = 0;
 
 	if ((NULL == self) || (NULL == upHandlePtr) || (NULL == domainHandlePtr)) {
 		rc = ESIF_E_PARAMETER_IS_NULL;
 		goto exit;
 	}
 
-	upDataMapPtr = EsifApp_GetParticipantDataMapFromInstance(self, participantId);
+	esif_ccb_read_lock(&self->objLock);
+	upDataMapPtr = EsifApp_FindParticipantDataMapLocked(self, participantId, &probes);
+	if (upDataMapPtr != NULL) {
+		/* Domain IDs map directly to their fDomainData index */
+		EsifDomainIdToIndex(domainId, &domainIndex);
+		if (domainIndex < MAX_DOMAIN_ENTRY) {
+			*domainHandlePtr = upDataMapPtr->fDomainData[domainIndex].fAppDomainHandle;
+		}
+		*upHandlePtr = upDataMapPtr->fAppParticipantHandle;
+	}
+	esif_ccb_read_unlock(&self->objLock);
+
+	EsifApp_RecordTranslation(self, probes, (upDataMapPtr != NULL));
 	if (NULL == upDataMapPtr) {
 		rc = ESIF_E_PARTICIPANT_NOT_FOUND;
-		goto exit;
 	}
+exit:
+	return rc;
+}
 
-	EsifDomainIdToIndex(domainId, &domainIndex);
-	if (domainIndex < MAX_DOMAIN_ENTRY) {
-		*domainHandlePtr = upDataMapPtr->fDomainData[domainIndex].fAppDomainHandle;
+
+void EsifApp_GetTranslationStats(
+	EsifAppPtr self,
+	EsifAppTranslationStatsPtr statsPtr
+	)
+{
+	if (NULL == statsPtr) {
+		return;
 	}
 
-	*upHandlePtr = upDataMapPtr->fAppParticipantHandle;
+	esif_ccb_memset(statsPtr, 0, sizeof(*statsPtr));
+	if (NULL == self) {
+		return;
+	}
+
+	statsPtr->translationCount = (UInt64)atomic64_read(&self->translationCount);
+	statsPtr->translationProbes = (UInt64)atomic64_read(&self->translationProbes);
+	statsPtr->translationMisses = (UInt64)atomic64_read(&self->translationMisses);
+}
+
+
+/*
+** Handle Index
+** Open addressing with linear probing, keyed by the low bits of the handle. The
+** handle manager allocates those bits in sequence, so they spread well. Entries
+** are removed by shifting later entries of the probe sequence back, so lookups
+** never need to probe past a removed entry.
+*/
+static size_t EsifApp_HandleIndexHome(esif_handle_t handle, size_t indexSize)
+{
+	return (size_t)((UInt64)(size_t)handle & (UInt64)(indexSize - 1));
+}
+
+
+static void EsifApp_HandleIndexInit(AppHandleIndexEntryPtr indexPtr, size_t indexSize)
+{
+	size_t i = 0;
+
+	for (i = 0; i < indexSize; i++) {
+		indexPtr[i].fHandle = ESIF_INVALID_HANDLE;
+		indexPtr[i].fSlot = ESIF_APP_INDEX_NO_SLOT;
+	}
+}
+
+
+static void EsifApp_HandleIndexInsert(AppHandleIndexEntryPtr indexPtr, size_t indexSize, esif_handle_t handle, UInt8 slot)
+{
+	size_t pos = EsifApp_HandleIndexHome(handle, indexSize);
+
+	if (ESIF_INVALID_HANDLE == handle) {
+		return;
+	}
+
+	/* The index is larger than the number of entries, so there is always an empty entry */
+	while ((indexPtr[pos].fHandle != ESIF_INVALID_HANDLE) && (indexPtr[pos].fHandle != handle)) {
+		pos = (pos + 1) & (indexSize - 1);
+	}
+	indexPtr[pos].fHandle = handle;
+	indexPtr[pos].fSlot = slot;
+}
+
+
+static void EsifApp_HandleIndexRemove(AppHandleIndexEntryPtr indexPtr, size_t indexSize, esif_handle_t handle)
+{
+	size_t mask = indexSize - 1;
+	size_t pos = EsifApp_HandleIndexHome(handle, indexSize);
+	size_t next = 0;
+	size_t nextHome = 0;
+
+	if (ESIF_INVALID_HANDLE == handle) {
+		return;
+	}
+
+	while (indexPtr[pos].fHandle != handle) {
+		if (ESIF_INVALID_HANDLE == indexPtr[pos].fHandle) {
+			return;
+		}
+		pos = (pos + 1) & mask;
+	}
+
+	/* Move back each following entry whose probe sequence passes through the hole */
+	for (next = (pos + 1) & mask; indexPtr[next].fHandle != ESIF_INVALID_HANDLE; next = (next + 1) & mask) {
+		nextHome = EsifApp_HandleIndexHome(indexPtr[next].fHandle, indexSize);
+		if (((next - nextHome) & mask) >= ((next - pos) & mask)) {
+			indexPtr[pos] = indexPtr[next];
+			pos = next;
+		}
+	}
+	indexPtr[pos].fHandle = ESIF_INVALID_HANDLE;
+	indexPtr[pos].fSlot = ESIF_APP_INDEX_NO_SLOT;
+}
+
+
+static UInt8 EsifApp_HandleIndexLookup(AppHandleIndexEntryPtr indexPtr, size_t indexSize, esif_handle_t handle, UInt32 *probesPtr)
+{
+	UInt8 slot = ESIF_APP_INDEX_NO_SLOT;
+	size_t pos = EsifApp_HandleIndexHome(handle, indexSize);
+	UInt32 probes = 0;
+
+	if (ESIF_INVALID_HANDLE == handle) {
+		goto exit;
+	}
+
+	do {
+		probes++;
+		if (indexPtr[pos].fHandle == handle) {
+			slot = indexPtr[pos].fSlot;
+			break;
+		}
+		pos = (pos + 1) & (indexSize - 1);
+	} while ((indexPtr[pos].fHandle != ESIF_INVALID_HANDLE) && (probes < indexSize));
 exit:
-	return rc;
+	if (probesPtr != NULL) {
+		*probesPtr += probes;
+	}
+	return slot;
 }
 
 
@@ -32,6 +32,14 @@
 #define	APPNAME_MAXLEN		MAX_PATH
 #define	APPNAME_SEPARATOR	'='
 
+/*
+** Handle indexes used to translate ESIF handles to app data map slots without
+** scanning the maps. Sizes must be powers of two and larger than the number of
+** entries they index so that probing always finds an empty entry.
+*/
+#define ESIF_APP_PART_INDEX_SIZE	64	/* > MAX_PARTICIPANT_ENTRY */
+#define ESIF_APP_DOMAIN_INDEX_SIZE	16	/* > MAX_DOMAIN_ENTRY */
+
 /*
 ** Hierchary
 ** Application
@@ -48,6 +56,12 @@ typedef struct _t_AppDomainDataMap {
 	UInt16  fQualifierId;
 } AppDomainDataMap, *AppDomainDataMapPtr, **AppDomainDataMapPtrLocation;
 
+/* Handle Index Entry; fHandle is ESIF_INVALID_HANDLE when the entry is empty */
+typedef struct _t_AppHandleIndexEntry {
+	esif_handle_t fHandle;
+	UInt8 fSlot;
+} AppHandleIndexEntry, *AppHandleIndexEntryPtr;
+
 /* Map App Domain Handle To ESIF Participant Data */
 typedef struct _t_AppParticipantDataMap {
 	EsifUpPtr  fUpPtr;
@@ -61,6 +75,9 @@ typedef struct _t_AppParticipantDataMap {
 
 	/* Each Participant May Have Many Domains */
 	AppDomainDataMap  fDomainData[MAX_DOMAIN_ENTRY];
+
+	/* Domain Handle To fDomainData Index */
+	AppHandleIndexEntry fDomainIndex[ESIF_APP_DOMAIN_INDEX_SIZE];
 } AppParticipantDataMap, *AppParticipantDataMapPtr, *AppParticipantDataMapPtrLocation;
 
 /* Map App Data To ESIF Prticipants */
@@ -77,6 +94,16 @@ typedef struct _t_EsifApp {
 	/* Each Application May Have Many Participants */
 	AppParticipantDataMap  fParticipantData[MAX_PARTICIPANT_ENTRY];
 
+	/* Participant Handle To fParticipantData Index and the unused fParticipantData slots */
+	AppHandleIndexEntry fParticipantIndex[ESIF_APP_PART_INDEX_SIZE];
+	UInt8 fFreeParticipantSlots[MAX_PARTICIPANT_ENTRY];
+	UInt8 fFreeParticipantSlotCount;
+
+	/* Handle translation statistics */
+	atomic64_t translationCount;
+	atomic64_t translationProbes;
+	atomic64_t translationMisses;
+
 	/* State information for pausing initialization */
 	Bool appCreationDone;
 	Bool partRegDone;
@@ -97,6 +124,12 @@ typedef struct _t_EsifApp {
 
 } EsifApp, *EsifAppPtr, **EsifAppPtrLocation;
 
+typedef struct EsifAppTranslationStats_s {
+	UInt64 translationCount;	/* Handle translations across the app boundary */
+	UInt64 translationProbes;	/* Handle index entries examined by those translations */
+	UInt64 translationMisses;	/* Translations for handles not known to the app */
+} EsifAppTranslationStats, *EsifAppTranslationStatsPtr;
+
 typedef struct EsifAppPartDataIterator_s {
 	UInt32 marker;
 	size_t index;
@@ -257,6 +290,11 @@ eEsifError EsifApp_GetHandlesByIds(
 	esif_handle_t *domainHandlePtr
 	);
 
+void EsifApp_GetTranslationStats(
+	EsifAppPtr self,
+	EsifAppTranslationStatsPtr statsPtr
+	);
+
 eEsifError EsifApp_SuspendApp(
 	EsifAppPtr self
 );
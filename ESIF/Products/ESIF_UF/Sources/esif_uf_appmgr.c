@@ -37,6 +37,7 @@
 #define ESIF_UF_APPMGR_QUEUE_TIMEOUT ESIF_QUEUE_TIMEOUT_INFINITE /* No timeout */
 #define ESIF_UF_APPMGR_QUEUE_SIZE 0xFFFFFFFF
 #define ESIF_UF_APPMGR_QUEUE_NAME "UfAppMgrPartQueue"
+#define ESIF_UF_APPMGR_PART_BATCH_SIZE 32 /* Max participant changes published to the apps at once */
 
 
 //
@@ -45,6 +46,7 @@
 typedef struct EsifAppMgrPartQueueItem_s {
 	EsifUpPtr upPtr;
 	Bool isCreate;
+	esif_ccb_time_t queuedTime; /* msec */
 } EsifAppMgrPartQueueItem, *EsifAppMgrPartQueueItemPtr;
 
 
@@ -126,6 +128,14 @@ static eEsifError EsifAppMgr_GetRefLocked(
 	Bool isSvcRef
 );
 
+//
+// Participant changes are held while any app is being created; the app
+// registers the existing participants itself once creation completes.
+// Must be called with fLock held.
+//
+static void EsifAppMgr_BeginAppCreationLocked(void);
+static void EsifAppMgr_EndAppCreationLocked(void);
+
 //
 // IMPLEMENTATION FUNCTIONS
 //
@@ -464,6 +474,7 @@ static eEsifError EsifAppMgr_EnquePartChange(
 
 	queueItemPtr->upPtr = upPtr;
 	queueItemPtr->isCreate = isCreate;
+	esif_ccb_system_time(&queueItemPtr->queuedTime);
 
 	esif_ccb_write_lock(&g_appMgr.fLock);
 
@@ -473,6 +484,9 @@ static eEsifError EsifAppMgr_EnquePartChange(
 	}
 
 	rc = esif_queue_enqueue(g_appMgr.partQueuePtr, queueItemPtr);
+	if (ESIF_OK == rc) {
+		g_appMgr.partChangesQueued++;
+	}
 lockExit:
 	esif_ccb_write_unlock(&g_appMgr.fLock);
 exit:
@@ -493,33 +507,6 @@ eEsifError EsifAppMgr_CreateParticipantInAllApps(const EsifUpPtr upPtr)
 }
 
 
-/* Creates the participant in each running application */
-static eEsifError EsifAppMgr_CreateParticipantInAllAppsPriv(const EsifUpPtr upPtr)
-{
-	eEsifError rc = ESIF_OK;
-	EsifAppPtr appPtr = NULL;
-	UInt8 i;
-
-	if (NULL == upPtr) {
-		ESIF_TRACE_ERROR("The prticipant data pointer is NULL\n");
-		rc = ESIF_E_PARAMETER_IS_NULL;
-		goto exit;
-	}
-
-	/* Now offer this participant to each running application */
-	for (i = 0; i < ESIF_MAX_APPS; i++) {
-		appPtr = EsifAppMgr_GetAppN(i, ESIF_FALSE);
-
-		if ((appPtr != NULL) && !EsifUp_IsPrimaryParticipant(upPtr)) {
-			EsifApp_CreateParticipant(appPtr, upPtr);
-		}
-		EsifAppMgr_PutRef(appPtr);
-	}
-exit:
-	return rc;
-}
-
-
 /* Removes a participant from each running application */
 eEsifError EsifAppMgr_DestroyParticipantInAllApps(const EsifUpPtr upPtr)
 {
@@ -527,31 +514,6 @@ eEsifError EsifAppMgr_DestroyParticipantInAllApps(const EsifUpPtr upPtr)
 }
 
 
-/* Removes a participant from each running application */
-static eEsifError EsifAppMgr_DestroyParticipantInAllAppsPriv(const EsifUpPtr upPtr)
-{
-	eEsifError rc = ESIF_OK;
-	EsifAppPtr appPtr = NULL;
-	UInt8 i;
-
-	if (NULL == upPtr) {
-		ESIF_TRACE_ERROR("The participant data pointer is NULL\n");
-		rc = ESIF_E_PARAMETER_IS_NULL;
-		goto exit;
-	}
-
-	for (i = 0; i < ESIF_MAX_APPS; i++) {
-		appPtr = EsifAppMgr_GetAppN(i, ESIF_FALSE);
-
-		EsifApp_DestroyParticipant(appPtr, upPtr);
-
-		EsifAppMgr_PutRef(appPtr);
-	}
-exit:
-	return rc;
-}
-
-
 eEsifError EsifAppMgr_AppStart(const EsifString appName)
 {
 	eEsifError rc = ESIF_E_UNSPECIFIED;
@@ -572,7 +534,7 @@ eEsifError EsifAppMgr_AppStart(const EsifString appName)
 	}
 
 	esif_ccb_write_lock(&g_appMgr.fLock);
-	g_appMgr.creationRefCount++;
+	EsifAppMgr_BeginAppCreationLocked();
 
 	/*
 	* Keep Entries sorted by name and Search for an available slot and verify an app with the same name is not already running
@@ -638,16 +600,15 @@ eEsifError EsifAppMgr_AppStart(const EsifString appName)
 		if (g_appMgr.fEntries[availableIndex] == newEntryPtr) {
 			g_appMgr.fEntries[availableIndex] = NULL;
 			g_appMgr.fEntryCount--;
-			g_appMgr.creationRefCount--;
+			EsifAppMgr_EndAppCreationLocked();
 			esif_ccb_write_unlock(&g_appMgr.fLock);
 			EsifAppMgr_DestroyEntry(newEntryPtr);
 			goto exit;
 		}
 	}
 lockExit:
-	g_appMgr.creationRefCount--;
+	EsifAppMgr_EndAppCreationLocked();
 	esif_ccb_write_unlock(&g_appMgr.fLock);
-	esif_queue_signal_event(g_appMgr.partQueuePtr);
 exit:
 	return rc;
 }
@@ -846,14 +807,145 @@ exit:
 }
 
 
+static void EsifAppMgr_BeginAppCreationLocked(void)
+{
+	if (0 == g_appMgr.creationRefCount++) {
+		esif_ccb_event_reset(&g_appMgr.creationDoneEvent);
+	}
+}
+
+
+static void EsifAppMgr_EndAppCreationLocked(void)
+{
+	if ((g_appMgr.creationRefCount > 0) && (0 == --g_appMgr.creationRefCount)) {
+		esif_ccb_event_set(&g_appMgr.creationDoneEvent);
+	}
+}
+
+
+static void EsifAppMgr_QueueDestroyCallback(void *ctxPtr)
+{
+	EsifAppMgrPartQueueItemPtr queueItemPtr = (EsifAppMgrPartQueueItemPtr)ctxPtr;
+
+	if (queueItemPtr != NULL) {
+		EsifUp_PutRef(queueItemPtr->upPtr);
+		esif_ccb_free(queueItemPtr);
+	}
+}
+
+
+/*
+* Adds a participant change to the batch, dropping changes which the apps
+* would not act on.  A repeated create or destroy is a no-op in the apps, and a
+* destroy makes a create of the same participant still in the batch redundant.
+* Returns the new number of changes in the batch.
+*/
+static size_t EsifAppMgr_AddPartChangeToBatch(
+	EsifAppMgrPartQueueItemPtr *batchPtr,
+	size_t batchCount,
+	EsifAppMgrPartQueueItemPtr queueItemPtr
+	)
+{
+	size_t i = batchCount;
+	size_t coalesced = 0;
+
+	/* Find the latest change already in the batch for the same participant */
+	while (i > 0) {
+		i--;
+		if (batchPtr[i]->upPtr != queueItemPtr->upPtr) {
+			continue;
+		}
+		if (batchPtr[i]->isCreate == queueItemPtr->isCreate) {
+			EsifAppMgr_QueueDestroyCallback(queueItemPtr);
+			queueItemPtr = NULL;
+			coalesced++;
+			break;
+		}
+		if (!batchPtr[i]->isCreate) {
+			break;
+		}
+		EsifAppMgr_QueueDestroyCallback(batchPtr[i]);
+		esif_ccb_memmove(&batchPtr[i], &batchPtr[i + 1], (batchCount - i - 1) * sizeof(*batchPtr));
+		batchCount--;
+		coalesced++;
+	}
+
+	if (queueItemPtr != NULL) {
+		batchPtr[batchCount++] = queueItemPtr;
+	}
+
+	if (coalesced) {
+		esif_ccb_write_lock(&g_appMgr.fLock);
+		g_appMgr.partChangesCoalesced += coalesced;
+		esif_ccb_write_unlock(&g_appMgr.fLock);
+	}
+	return batchCount;
+}
+
+
+/*
+* Publishes a batch of participant changes to each running application.  Each
+* app receives the changes in the order they were queued.
+*/
+static void EsifAppMgr_PublishPartChanges(
+	EsifAppMgrPartQueueItemPtr *batchPtr,
+	size_t batchCount
+	)
+{
+	EsifAppPtr appPtr = NULL;
+	esif_ccb_time_t now = 0;
+	UInt64 latency = 0;
+	size_t i = 0;
+	size_t j = 0;
+
+	for (i = 0; i < ESIF_MAX_APPS; i++) {
+		appPtr = EsifAppMgr_GetAppN(i, ESIF_FALSE);
+
+		for (j = 0; (appPtr != NULL) && (j < batchCount); j++) {
+			if (!batchPtr[j]->isCreate) {
+				EsifApp_DestroyParticipant(appPtr, batchPtr[j]->upPtr);
+			}
+			else if (!EsifUp_IsPrimaryParticipant(batchPtr[j]->upPtr)) {
+				EsifApp_CreateParticipant(appPtr, batchPtr[j]->upPtr);
+			}
+		}
+		EsifAppMgr_PutRef(appPtr);
+	}
+
+	esif_ccb_system_time(&now);
+
+	esif_ccb_write_lock(&g_appMgr.fLock);
+	for (j = 0; j < batchCount; j++) {
+		latency = (now > batchPtr[j]->queuedTime) ? (UInt64)(now - batchPtr[j]->queuedTime) : 0;
+		g_appMgr.partTotalLatencyMs += latency;
+		if (latency > g_appMgr.partMaxLatencyMs) {
+			g_appMgr.partMaxLatencyMs = latency;
+		}
+	}
+	g_appMgr.partChangesPublished += batchCount;
+	g_appMgr.partBatchesPublished++;
+	esif_ccb_write_unlock(&g_appMgr.fLock);
+
+	for (j = 0; j < batchCount; j++) {
+		EsifAppMgr_QueueDestroyCallback(batchPtr[j]);
+		batchPtr[j] = NULL;
+	}
+}
+
+
 static void *ESIF_CALLCONV EsifAppMgr_PartQueueThread(void *ctxPtr)
 {
+	EsifAppMgrPartQueueItemPtr batch[ESIF_UF_APPMGR_PART_BATCH_SIZE] = { 0 };
 	EsifAppMgrPartQueueItemPtr queueItemPtr = NULL;
+	size_t batchCount = 0;
 	Bool isProcessing = ESIF_FALSE;
 
 	UNREFERENCED_PARAMETER(ctxPtr);
 
 	while (!g_appMgr.partQueueExitFlag) {
+		/* Sleep until no app is being created */
+		esif_ccb_event_wait(&g_appMgr.creationDoneEvent);
+
 		queueItemPtr = esif_queue_pull(g_appMgr.partQueuePtr);
 
 		if (NULL == queueItemPtr) {
@@ -862,39 +954,63 @@ static void *ESIF_CALLCONV EsifAppMgr_PartQueueThread(void *ctxPtr)
 
 		esif_ccb_write_lock(&g_appMgr.fLock);
 		isProcessing = (g_appMgr.creationRefCount != 0) ? ESIF_TRUE : ESIF_FALSE;
+		if (isProcessing) {
+			g_appMgr.partCreationWaits++;
+		}
 		esif_ccb_write_unlock(&g_appMgr.fLock);
 
 		/*
-		* If and app is being created, re-queue the participant change until
-		* after it is done creating the app
+		* If an app started being created while waiting for the change, put it
+		* back until the app is created.  Requeue does not wake the queue, so
+		* signal it to be pulled again once the creation done event is set.
 		*/
 		if (isProcessing) {
 			esif_queue_requeue(g_appMgr.partQueuePtr, queueItemPtr);
+			esif_queue_signal_event(g_appMgr.partQueuePtr);
 			continue;
 		}
 
-		if (queueItemPtr->isCreate) {
-			EsifAppMgr_CreateParticipantInAllAppsPriv(queueItemPtr->upPtr);
-		}
-		else {
-			EsifAppMgr_DestroyParticipantInAllAppsPriv(queueItemPtr->upPtr);
+		/* Publish every change already queued along with this one */
+		batchCount = EsifAppMgr_AddPartChangeToBatch(batch, 0, queueItemPtr);
+		while (batchCount < ESIF_UF_APPMGR_PART_BATCH_SIZE) {
+			queueItemPtr = esif_queue_dequeue(g_appMgr.partQueuePtr);
+			if (NULL == queueItemPtr) {
+				break;
+			}
+			batchCount = EsifAppMgr_AddPartChangeToBatch(batch, batchCount, queueItemPtr);
 		}
 
-		EsifUp_PutRef(queueItemPtr->upPtr);
-		esif_ccb_free(queueItemPtr);
+		EsifAppMgr_PublishPartChanges(batch, batchCount);
+
+		/* The batch may have stopped short of the end of the queue */
+		if (esif_queue_size(g_appMgr.partQueuePtr) > 0) {
+			esif_queue_signal_event(g_appMgr.partQueuePtr);
+		}
 	}
 	return 0;
 }
 
 
-static void EsifAppMgr_QueueDestroyCallback(void *ctxPtr)
+void EsifAppMgr_GetPartQueueStats(EsifAppMgrPartQueueStatsPtr statsPtr)
 {
-	EsifAppMgrPartQueueItemPtr queueItemPtr = (EsifAppMgrPartQueueItemPtr)ctxPtr;
+	if (NULL == statsPtr) {
+		return;
+	}
 
-	if (queueItemPtr != NULL) {
-		EsifUp_PutRef(queueItemPtr->upPtr);
-		esif_ccb_free(queueItemPtr);
+	esif_ccb_memset(statsPtr, 0, sizeof(*statsPtr));
+
+	esif_ccb_read_lock(&g_appMgr.fLock);
+	statsPtr->queuedCount = esif_queue_size(g_appMgr.partQueuePtr);
+	statsPtr->totalQueued = g_appMgr.partChangesQueued;
+	statsPtr->coalescedCount = g_appMgr.partChangesCoalesced;
+	statsPtr->publishedCount = g_appMgr.partChangesPublished;
+	statsPtr->batchCount = g_appMgr.partBatchesPublished;
+	statsPtr->creationWaitCount = g_appMgr.partCreationWaits;
+	if (g_appMgr.partChangesPublished > 0) {
+		statsPtr->averageLatencyMs = g_appMgr.partTotalLatencyMs / g_appMgr.partChangesPublished;
 	}
+	statsPtr->maxLatencyMs = g_appMgr.partMaxLatencyMs;
+	esif_ccb_read_unlock(&g_appMgr.fLock);
 }
 
 
@@ -905,6 +1021,8 @@ eEsifError EsifAppMgr_Init(void)
 	ESIF_TRACE_ENTRY_INFO();
 
 	esif_ccb_lock_init(&g_appMgr.fLock);
+	esif_ccb_event_init(&g_appMgr.creationDoneEvent);
+	esif_ccb_event_set(&g_appMgr.creationDoneEvent);
 
 	g_appMgr.partQueuePtr = esif_queue_create(ESIF_UF_APPMGR_QUEUE_SIZE, ESIF_UF_APPMGR_QUEUE_NAME, ESIF_UF_APPMGR_QUEUE_TIMEOUT);
 	if (NULL == g_appMgr.partQueuePtr) {
@@ -954,6 +1072,7 @@ void EsifAppMgr_Stop(void)
 	EsifEventMgr_UnregisterEventByType(ESIF_EVENT_PRIMARY_PARTICIPANT_ARRIVED, EVENT_MGR_MATCH_ANY, EVENT_MGR_DOMAIN_D0, EsifAppMgr_EventCallback, 0);
 
 	g_appMgr.partQueueExitFlag = ESIF_TRUE;
+	esif_ccb_event_set(&g_appMgr.creationDoneEvent);
 	esif_queue_signal_event(g_appMgr.partQueuePtr);
 	esif_ccb_thread_join(&g_appMgr.partQueueThread);
 
@@ -985,6 +1104,7 @@ void EsifAppMgr_Exit(void)
 {
 	ESIF_TRACE_ENTRY_INFO();
 
+	esif_ccb_event_uninit(&g_appMgr.creationDoneEvent);
 	esif_ccb_lock_uninit(&g_appMgr.fLock);
 
 	ESIF_TRACE_EXIT_INFO();
@@ -40,10 +40,31 @@ typedef struct _t_EsifAppMgr {
 	esif_thread_t partQueueThread;
 	Bool partQueueExitFlag;
 	UInt32 creationRefCount;
+	esif_ccb_event_t creationDoneEvent;	/* Set while no app is being created */
+
+	/* Participant change statistics (protected by fLock) */
+	UInt64 partChangesQueued;
+	UInt64 partChangesCoalesced;
+	UInt64 partChangesPublished;
+	UInt64 partBatchesPublished;
+	UInt64 partCreationWaits;
+	UInt64 partTotalLatencyMs;
+	UInt64 partMaxLatencyMs;
 	
 	Bool	isInitialized;
 } EsifAppMgr, *EsifAppMgrPtr;
 
+typedef struct EsifAppMgrPartQueueStats_s {
+	UInt32 queuedCount;			/* Participant changes waiting to be published */
+	UInt64 totalQueued;			/* Participant changes queued */
+	UInt64 coalescedCount;		/* Changes dropped because another change for the participant made them redundant */
+	UInt64 publishedCount;		/* Changes published to the apps */
+	UInt64 batchCount;			/* Batches the changes were published in */
+	UInt64 creationWaitCount;	/* Times changes were held until app creation completed */
+	UInt64 averageLatencyMs;	/* Average time from queuing a change until it is published to all apps */
+	UInt64 maxLatencyMs;		/* Longest time from queuing a change until it is published to all apps */
+} EsifAppMgrPartQueueStats, *EsifAppMgrPartQueueStatsPtr;
+
 typedef struct AppMgrIterator_s {
 	UInt32 marker;
 	size_t index;
@@ -107,6 +128,7 @@ eEsifError AppMgr_GetNextApp(
 /* Participant State Reporting Functions */
 eEsifError EsifAppMgr_DestroyParticipantInAllApps(const EsifUpPtr upPtr);
 eEsifError EsifAppMgr_CreateParticipantInAllApps(const EsifUpPtr upPtr);
+void EsifAppMgr_GetPartQueueStats(EsifAppMgrPartQueueStatsPtr statsPtr);
 
 /* Start/Stop Apps using AppMgr */
 eEsifError EsifAppMgr_AppStart(const EsifString appName);
@@ -20,6 +20,7 @@
 
 #include "esif.h"
 #include "esif_uf_ipc.h"
+#include "esif_uf_primitive.h"
 
 typedef enum eEnumerableUFParticipants {
 	ENUMERABLE_ALL,
@@ -40,6 +41,12 @@ static ESIF_INLINE enum esif_rc esif_ccb_participants_initialize(void)
 	return ESIF_OK;
 }
 
+static ESIF_INLINE void esif_ccb_participants_exit(void)
+{
+	void SysfsWaitForParticipantRegistration();
+	SysfsWaitForParticipantRegistration();
+}
+
 static ESIF_INLINE void esif_ccb_imp_spec_actions_init()
 {
 	eEsifError EsifActSysfsInit(void);
@@ -51,6 +58,12 @@ static ESIF_INLINE void esif_ccb_imp_spec_actions_exit()
 	void EsifActSysfsExit(void);
 	EsifActSysfsExit();
 }
+
+static ESIF_INLINE void esif_ccb_imp_spec_sample_set(EsifPrimitiveSamplePtr samplesPtr, UInt32 count)
+{
+	void EsifActSysfsGetSampleSet(EsifPrimitiveSamplePtr samplesPtr, UInt32 count);
+	EsifActSysfsGetSampleSet(samplesPtr, count);
+}
 #else
 enum esif_rc sync_lf_participants();
 
@@ -61,6 +74,11 @@ static ESIF_INLINE enum esif_rc esif_ccb_participants_initialize(void)
 	return ESIF_OK;
 }
 
+static ESIF_INLINE void esif_ccb_participants_exit(void)
+{
+}
+
 #define esif_ccb_imp_spec_actions_init()
 #define esif_ccb_imp_spec_actions_exit()
+#define esif_ccb_imp_spec_sample_set(samplesPtr, count)
 #endif
@@ -23,7 +23,7 @@
 #include "esif_event.h"
 #include "esif_ccb_atomic.h"
 #include "esif_uf_eventmgr.h"
-#include "esif_queue.h"
+#include "esif_ccb_sem.h"
 #include "esif_uf_sensors.h"
 
 #ifdef ESIF_ATTR_OS_WINDOWS
@@ -39,13 +39,39 @@
 #define EVENT_MGR_FILTERED_EVENTS_PER_LINE 64
 #define EVENT_MGR_ITERATOR_MARKER 'UFEM'
 
+typedef struct EsifEventQueueItem_s {
+	esif_handle_t participantId;
+	UInt16 domainId;
+	eEsifEventType eventType;
+	EsifData eventData;
+	Bool isLfEvent;
+	Bool isUnfiltered;
+	Bool isDataInline;	/* eventData is held in inlineData instead of the heap */
+	UInt8 inlineData[ESIF_UF_EVENT_QUEUE_INLINE_DATA_SIZE];
+}EsifEventQueueItem, *EsifEventQueueItemPtr;
+
 typedef struct EsifEventMgr_s {
 	EsifLinkListPtr observerLists[NUM_EVENT_LISTS];
 	esif_ccb_lock_t listLock;
 
 	EsifLinkListPtr garbageList;
 
-	EsifQueuePtr eventQueuePtr;
+	/*
+	 * Event queue: events are copied into a ring of preallocated slots.  Once
+	 * the ring is full, events are allocated on the heap and queued on the
+	 * overflow list, and later events follow them there until the list drains
+	 * so that ordering is preserved.
+	 */
+	esif_ccb_lock_t queueLock;
+	esif_ccb_event_t queueEvent;
+	EsifEventQueueItem queueRing[ESIF_UF_EVENT_QUEUE_RING_SIZE];
+	UInt32 queueRingHead;
+	UInt32 queueRingCount;
+	EsifLinkListPtr queueOverflowList;
+	UInt32 queueOverflowCount;
+	UInt32 queueHighWaterMark;
+	UInt64 queueTotalOverflows;
+	UInt64 queueTotalDrops;
 
 	Bool eventQueueExitFlag;
 	Bool eventsDisabled;
@@ -70,15 +96,6 @@ typedef struct EventMgrEntry_s {
 	Bool markedForDelete;				/* Indicates the event is marked for deletion */
 } EventMgrEntry, *EventMgrEntryPtr;
 
-typedef struct EsifEventQueueItem_s {
-	esif_handle_t participantId;
-	UInt16 domainId;
-	eEsifEventType eventType;
-	EsifData eventData;
-	Bool isLfEvent;
-	Bool isUnfiltered;
-}EsifEventQueueItem, *EsifEventQueueItemPtr;
-
 
 /*
  * All event received are asynchronous and placed in an event queue to be handled by a worker thread.
@@ -140,6 +157,9 @@ static eEsifError EsifEventMgr_DisableEvent(EventMgrEntryPtr entryPtr);
 static eEsifError EsifEventMgr_MoveEntryToGarbage(EventMgrEntryPtr entryPtr);
 static eEsifError EsifEventMgr_DumpGarbage();
 static void EsifEventMgr_QueueDestroyCallback(void *ctxPtr);
+static eEsifError EsifEventMgr_EnqueueEvent(const EsifEventQueueItemPtr queueEventPtr);
+static Bool EsifEventMgr_DequeueEvent(EsifEventQueueItemPtr queueEventPtr);
+static void EsifEventMgr_DestroyQueue(void);
 static void EsifEventMgr_LLEntryDestroyCallback(void *dataPtr);
 
 static eEsifError ESIF_CALLCONV EsifEventMgr_SignalEvent_Local (
@@ -212,7 +232,7 @@ eEsifError ESIF_CALLCONV EsifEventMgr_SignalEvent_Local(
 	)
 {
 	eEsifError rc = ESIF_OK;
-	EsifEventQueueItemPtr queueEventPtr = NULL;
+	EsifEventQueueItem queueEvent = { 0 };
 	void *queueDataPtr = NULL;
 
 	/* Exit if filtered event */
@@ -221,75 +241,194 @@ eEsifError ESIF_CALLCONV EsifEventMgr_SignalEvent_Local(
 		goto exit;
 	}
 
-	if (NULL == g_EsifEventMgr.eventQueuePtr) { /* Should never happen */
+	if (NULL == g_EsifEventMgr.queueOverflowList) { /* Should never happen */
 		rc = ESIF_E_UNSPECIFIED;
 		goto exit;
 	}
 
-	queueEventPtr = esif_ccb_malloc(sizeof(*queueEventPtr));
-	if (NULL == queueEventPtr) {
-		rc = ESIF_E_NO_MEMORY;
-		goto exit;
-	}
-
 	if ((eventDataPtr != NULL) &&
 		(eventDataPtr->buf_ptr != NULL) &&
 		(eventDataPtr->buf_len > 0) &&
 		(eventDataPtr->data_len > 0) &&
 		(eventDataPtr->buf_len >= eventDataPtr->data_len)) {
 
-		queueDataPtr = esif_ccb_malloc(eventDataPtr->data_len);
-		if (NULL == queueDataPtr) {
-			rc = ESIF_E_NO_MEMORY;
-			goto exit;
+		/* Small payloads are copied into the slot; only larger ones are allocated */
+		if (eventDataPtr->data_len <= sizeof(queueEvent.inlineData)) {
+			esif_ccb_memcpy(queueEvent.inlineData, eventDataPtr->buf_ptr, eventDataPtr->data_len);
+			queueEvent.isDataInline = ESIF_TRUE;
+		}
+		else {
+			queueDataPtr = esif_ccb_malloc(eventDataPtr->data_len);
+			if (NULL == queueDataPtr) {
+				rc = ESIF_E_NO_MEMORY;
+				goto exit;
+			}
+			esif_ccb_memcpy(queueDataPtr, eventDataPtr->buf_ptr, eventDataPtr->data_len);
+			queueEvent.eventData.buf_ptr = queueDataPtr;
 		}
 
-		esif_ccb_memcpy(queueDataPtr, eventDataPtr->buf_ptr, eventDataPtr->data_len);
-
-		queueEventPtr->eventData.type = eventDataPtr->type;
-		queueEventPtr->eventData.buf_ptr = queueDataPtr;
-		queueEventPtr->eventData.buf_len = eventDataPtr->data_len;
-		queueEventPtr->eventData.data_len = eventDataPtr->data_len;
+		queueEvent.eventData.type = eventDataPtr->type;
+		queueEvent.eventData.buf_len = eventDataPtr->data_len;
+		queueEvent.eventData.data_len = eventDataPtr->data_len;
 	}
 
-	queueEventPtr->participantId = participantId;
-	queueEventPtr->domainId = domainId;
-	queueEventPtr->eventType = eventType;
-	queueEventPtr->isLfEvent = isLfEvent;
+	queueEvent.participantId = participantId;
+	queueEvent.domainId = domainId;
+	queueEvent.eventType = eventType;
+	queueEvent.isLfEvent = isLfEvent;
 
 	ESIF_TRACE_INFO("Queuing %s event for Part. %u Dom. 0x%04X\n",
 		esif_event_type_str(eventType),
 		participantId,
 		domainId);
 
-	rc = esif_queue_enqueue(g_EsifEventMgr.eventQueuePtr, queueEventPtr);
+	rc = EsifEventMgr_EnqueueEvent(&queueEvent);
 	if (rc != ESIF_OK) {
 		goto exit;
 	}
 
 exit:
 	if (rc != ESIF_OK) {
-		esif_ccb_free(queueEventPtr);
 		esif_ccb_free(queueDataPtr);
+	}
+	return rc;
+}
+
 
+static void EsifEventMgr_UpdateQueueHighWaterMarkLocked(void)
+{
+	UInt32 queuedCount = g_EsifEventMgr.queueRingCount + g_EsifEventMgr.queueOverflowCount;
+
+	if (queuedCount > g_EsifEventMgr.queueHighWaterMark) {
+		g_EsifEventMgr.queueHighWaterMark = queuedCount;
+	}
+}
+
+
+static eEsifError EsifEventMgr_EnqueueEvent(const EsifEventQueueItemPtr queueEventPtr)
+{
+	eEsifError rc = ESIF_OK;
+	EsifEventQueueItemPtr overflowEventPtr = NULL;
+	UInt32 slot = 0;
+
+	esif_ccb_write_lock(&g_EsifEventMgr.queueLock);
+	if ((g_EsifEventMgr.queueRingCount < ESIF_UF_EVENT_QUEUE_RING_SIZE) && (0 == g_EsifEventMgr.queueOverflowCount)) {
+		slot = (g_EsifEventMgr.queueRingHead + g_EsifEventMgr.queueRingCount) % ESIF_UF_EVENT_QUEUE_RING_SIZE;
+		g_EsifEventMgr.queueRing[slot] = *queueEventPtr;
+		g_EsifEventMgr.queueRingCount++;
+		EsifEventMgr_UpdateQueueHighWaterMarkLocked();
+		esif_ccb_event_set(&g_EsifEventMgr.queueEvent);
+		esif_ccb_write_unlock(&g_EsifEventMgr.queueLock);
+		goto exit;
 	}
+	esif_ccb_write_unlock(&g_EsifEventMgr.queueLock);
+
+	/* The ring is full (or already overflowed); allocate outside of the lock */
+	overflowEventPtr = esif_ccb_malloc(sizeof(*overflowEventPtr));
+
+	esif_ccb_write_lock(&g_EsifEventMgr.queueLock);
+	if (NULL == overflowEventPtr) {
+		rc = ESIF_E_NO_MEMORY;
+	}
+	else {
+		*overflowEventPtr = *queueEventPtr;
+		rc = esif_link_list_add_at_back(g_EsifEventMgr.queueOverflowList, overflowEventPtr);
+	}
+
+	if (ESIF_OK == rc) {
+		g_EsifEventMgr.queueOverflowCount++;
+		g_EsifEventMgr.queueTotalOverflows++;
+		EsifEventMgr_UpdateQueueHighWaterMarkLocked();
+		esif_ccb_event_set(&g_EsifEventMgr.queueEvent);
+	}
+	else {
+		g_EsifEventMgr.queueTotalDrops++;
+	}
+	esif_ccb_write_unlock(&g_EsifEventMgr.queueLock);
+
+	if (rc != ESIF_OK) {
+		esif_ccb_free(overflowEventPtr);
+	}
+exit:
 	return rc;
 }
 
 
+/*
+ * Copies the oldest queued event into the caller's item; returns ESIF_FALSE if
+ * the queue is empty.  Ring slots are always older than overflow items.
+ */
+static Bool EsifEventMgr_DequeueEvent(EsifEventQueueItemPtr queueEventPtr)
+{
+	Bool isDequeued = ESIF_FALSE;
+	EsifLinkListNodePtr nodePtr = NULL;
+	EsifEventQueueItemPtr overflowEventPtr = NULL;
+
+	esif_ccb_write_lock(&g_EsifEventMgr.queueLock);
+	if (g_EsifEventMgr.queueRingCount > 0) {
+		*queueEventPtr = g_EsifEventMgr.queueRing[g_EsifEventMgr.queueRingHead];
+		g_EsifEventMgr.queueRingHead = (g_EsifEventMgr.queueRingHead + 1) % ESIF_UF_EVENT_QUEUE_RING_SIZE;
+		g_EsifEventMgr.queueRingCount--;
+		isDequeued = ESIF_TRUE;
+	}
+	else if ((nodePtr = g_EsifEventMgr.queueOverflowList->head_ptr) != NULL) {
+		overflowEventPtr = (EsifEventQueueItemPtr)nodePtr->data_ptr;
+		esif_link_list_node_remove(g_EsifEventMgr.queueOverflowList, nodePtr);
+		g_EsifEventMgr.queueOverflowCount--;
+		isDequeued = ESIF_TRUE;
+	}
+
+	/* Leave the event set when exiting so the thread does not wait again */
+	if ((0 == g_EsifEventMgr.queueRingCount) && (0 == g_EsifEventMgr.queueOverflowCount) && !g_EsifEventMgr.eventQueueExitFlag) {
+		esif_ccb_event_reset(&g_EsifEventMgr.queueEvent);
+	}
+	esif_ccb_write_unlock(&g_EsifEventMgr.queueLock);
+
+	if (overflowEventPtr != NULL) {
+		*queueEventPtr = *overflowEventPtr;
+		esif_ccb_free(overflowEventPtr);
+	}
+	if (isDequeued && queueEventPtr->isDataInline) {
+		queueEventPtr->eventData.buf_ptr = queueEventPtr->inlineData;
+	}
+	return isDequeued;
+}
+
+
+void EsifEventMgr_GetQueueStats(EsifEventQueueStatsPtr statsPtr)
+{
+	if (NULL == statsPtr) {
+		return;
+	}
+
+	esif_ccb_memset(statsPtr, 0, sizeof(*statsPtr));
+	if (NULL == g_EsifEventMgr.queueOverflowList) {
+		return;
+	}
+
+	esif_ccb_read_lock(&g_EsifEventMgr.queueLock);
+	statsPtr->ringSize = ESIF_UF_EVENT_QUEUE_RING_SIZE;
+	statsPtr->queuedCount = g_EsifEventMgr.queueRingCount + g_EsifEventMgr.queueOverflowCount;
+	statsPtr->highWaterMark = g_EsifEventMgr.queueHighWaterMark;
+	statsPtr->overflowCount = g_EsifEventMgr.queueTotalOverflows;
+	statsPtr->droppedCount = g_EsifEventMgr.queueTotalDrops;
+	esif_ccb_read_unlock(&g_EsifEventMgr.queueLock);
+}
+
+
 static void *ESIF_CALLCONV EsifEventMgr_EventQueueThread(void *ctxPtr)
 {
 	esif_error_t rc = ESIF_OK;
-	EsifEventQueueItemPtr queueEventPtr = NULL;
+	EsifEventQueueItem queueEvent = { 0 };
+	EsifEventQueueItemPtr queueEventPtr = &queueEvent;
 	esif_handle_t participantId = ESIF_INVALID_HANDLE;
 
 	UNREFERENCED_PARAMETER(ctxPtr);
 
 	while(!g_EsifEventMgr.eventQueueExitFlag) {
 		rc = ESIF_OK;
-		queueEventPtr = esif_queue_pull(g_EsifEventMgr.eventQueuePtr);
-
-		if (NULL == queueEventPtr) {
+		if (!EsifEventMgr_DequeueEvent(queueEventPtr)) {
+			esif_ccb_event_wait(&g_EsifEventMgr.queueEvent);
 			continue;
 		}
 
@@ -315,8 +454,9 @@ static void *ESIF_CALLCONV EsifEventMgr_EventQueueThread(void *ctxPtr)
 				queueEventPtr->eventType,
 				&queueEventPtr->eventData);
 		}
-		esif_ccb_free(queueEventPtr->eventData.buf_ptr);
-		esif_ccb_free(queueEventPtr);
+		if (!queueEventPtr->isDataInline) {
+			esif_ccb_free(queueEventPtr->eventData.buf_ptr);
+		}
 	}
 	return 0;
 }
@@ -1030,6 +1170,8 @@ eEsifError EsifEventMgr_Init(void)
 	ESIF_TRACE_ENTRY_INFO();
 
 	esif_ccb_lock_init(&g_EsifEventMgr.listLock);
+	esif_ccb_lock_init(&g_EsifEventMgr.queueLock);
+	esif_ccb_event_init(&g_EsifEventMgr.queueEvent);
 
 	for (i = 0; i < NUM_EVENT_LISTS; i++) {
 		g_EsifEventMgr.observerLists[i] = esif_link_list_create();
@@ -1039,10 +1181,10 @@ eEsifError EsifEventMgr_Init(void)
 		}
 	}
 
-	g_EsifEventMgr.eventQueuePtr = esif_queue_create(ESIF_UF_EVENT_QUEUE_SIZE, ESIF_UF_EVENT_QUEUE_NAME, ESIF_UF_EVENT_QUEUE_TIMEOUT);
+	g_EsifEventMgr.queueOverflowList = esif_link_list_create();
 	g_EsifEventMgr.garbageList = esif_link_list_create();
 
-	if ((NULL == g_EsifEventMgr.eventQueuePtr) ||
+	if ((NULL == g_EsifEventMgr.queueOverflowList) ||
 		(NULL == g_EsifEventMgr.garbageList)) {
 		rc = ESIF_E_NO_MEMORY;
 		goto exit;
@@ -1086,8 +1228,7 @@ void EsifEventMgr_Exit(void)
 	/* Destroy the event thread */
 
 	/* Event thread should already be destroyed in the disable func. Destroy the queue */
-	esif_queue_destroy(g_EsifEventMgr.eventQueuePtr, EsifEventMgr_QueueDestroyCallback);
-	g_EsifEventMgr.eventQueuePtr = NULL;
+	EsifEventMgr_DestroyQueue();
 
 
 	/* Destroy the garbage list */
@@ -1105,9 +1246,15 @@ void EsifEventMgr_Disable(void)
 {
 	ESIF_TRACE_ENTRY_INFO();
 
-	/* Release and destroy the event thread */
+	/*
+	 * Release and destroy the event thread.  The flag and event are set under
+	 * the queue lock so a dequeue that has already checked the flag cannot
+	 * reset the event afterwards and leave the thread waiting forever.
+	 */
+	esif_ccb_write_lock(&g_EsifEventMgr.queueLock);
 	g_EsifEventMgr.eventQueueExitFlag = ESIF_TRUE;
-	esif_queue_signal_event(g_EsifEventMgr.eventQueuePtr);
+	esif_ccb_event_set(&g_EsifEventMgr.queueEvent);
+	esif_ccb_write_unlock(&g_EsifEventMgr.queueLock);
 	esif_ccb_thread_join(&g_EsifEventMgr.eventQueueThread);
 	g_EsifEventMgr.eventsDisabled = ESIF_TRUE;
 
@@ -1171,12 +1318,38 @@ static void EsifEventMgr_QueueDestroyCallback(void *ctxPtr)
 	EsifEventQueueItemPtr queueEventPtr = (EsifEventQueueItemPtr)ctxPtr;
 
 	if(queueEventPtr != NULL) {
-		esif_ccb_free(queueEventPtr->eventData.buf_ptr);
+		if (!queueEventPtr->isDataInline) {
+			esif_ccb_free(queueEventPtr->eventData.buf_ptr);
+		}
 		esif_ccb_free(queueEventPtr);
 	}
 }
 
 
+/* Releases the events left in the queue; the event thread must already be stopped */
+static void EsifEventMgr_DestroyQueue(void)
+{
+	EsifEventQueueItemPtr queueEventPtr = NULL;
+
+	esif_ccb_write_lock(&g_EsifEventMgr.queueLock);
+	while (g_EsifEventMgr.queueRingCount > 0) {
+		queueEventPtr = &g_EsifEventMgr.queueRing[g_EsifEventMgr.queueRingHead];
+		if (!queueEventPtr->isDataInline) {
+			esif_ccb_free(queueEventPtr->eventData.buf_ptr);
+		}
+		g_EsifEventMgr.queueRingHead = (g_EsifEventMgr.queueRingHead + 1) % ESIF_UF_EVENT_QUEUE_RING_SIZE;
+		g_EsifEventMgr.queueRingCount--;
+	}
+	esif_link_list_free_data_and_destroy(g_EsifEventMgr.queueOverflowList, EsifEventMgr_QueueDestroyCallback);
+	g_EsifEventMgr.queueOverflowList = NULL;
+	g_EsifEventMgr.queueOverflowCount = 0;
+	esif_ccb_write_unlock(&g_EsifEventMgr.queueLock);
+
+	esif_ccb_event_uninit(&g_EsifEventMgr.queueEvent);
+	esif_ccb_lock_uninit(&g_EsifEventMgr.queueLock);
+}
+
+
 static void EsifEventMgr_LLEntryDestroyCallback(
 	void *dataPtr
 	)
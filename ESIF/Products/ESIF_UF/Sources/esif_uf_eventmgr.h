@@ -77,9 +77,8 @@
 #define EVENT_MGR_MATCH_ANY ESIF_HANDLE_MATCH_ANY_EVENT
 
 
-#define ESIF_UF_EVENT_QUEUE_SIZE 0xFFFFFFFF
-#define ESIF_UF_EVENT_QUEUE_NAME "UfQueue"
-#define ESIF_UF_EVENT_QUEUE_TIMEOUT ESIF_QUEUE_TIMEOUT_INFINITE /* No timeout */
+#define ESIF_UF_EVENT_QUEUE_RING_SIZE 256 /* Preallocated event slots; further events are queued on the heap */
+#define ESIF_UF_EVENT_QUEUE_INLINE_DATA_SIZE 64 /* Largest event payload stored in a slot without allocating */
 
 #if defined(ESIF_ATTR_OS_WINDOWS)
 #include "win\dppe.h"
@@ -158,6 +157,14 @@ typedef struct EventMgr_IteratorData_s {
 
 #pragma pack(pop)
 
+typedef struct EsifEventQueueStats_s {
+	UInt32 ringSize;			/* Number of preallocated event slots */
+	UInt32 queuedCount;			/* Events waiting to be processed */
+	UInt32 highWaterMark;		/* Largest number of events waiting at once */
+	UInt64 overflowCount;		/* Events queued on the heap because the slots were in use */
+	UInt64 droppedCount;		/* Events lost because memory could not be allocated */
+} EsifEventQueueStats, *EsifEventQueueStatsPtr;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -221,6 +228,8 @@ eEsifError HandlePackagedEvent(
 	size_t dataLen
 	);
 
+void EsifEventMgr_GetQueueStats(EsifEventQueueStatsPtr statsPtr);
+
 /* Used with EsifEventMgr_GetNextEvent to iterate through the events present
 * in the Event Manager
 * Note(s):
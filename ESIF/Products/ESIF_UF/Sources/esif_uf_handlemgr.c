@@ -21,6 +21,10 @@
 #include "esif_uf_handlemgr.h"	/* Application Manager */
 #include "esif_link_list.h"
 
+#ifdef ESIF_ATTR_OS_WINDOWS
+#include <intrin.h>
+#endif
+
 #ifdef ESIF_ATTR_OS_WINDOWS
 //
 // The Windows banned-API check header must be included after all other headers, or issues can be identified
@@ -52,6 +56,10 @@ static eEsifError EsifHandleMgr_FindHandleInRegion(
 static EsifHandleMgrPtr EsifHandleMgr_Create();
 static void EsifHandleMgr_Destroy(EsifHandleMgrPtr self);
 static Bool EsifHandleMgr_IsReservedHandle(esif_handle_t handle);
+static eEsifError EsifHandleMgr_GrowFreeLineMap(EsifHandleMgrPtr self, size_t numLines);
+static void EsifHandleMgr_UpdateFreeLine(EsifHandleMgrPtr self, size_t lineNum);
+static Bool EsifHandleMgr_FindNextFreeLine(EsifHandleMgrPtr self, size_t startLineNum, size_t stopLineNum, size_t *lineNumPtr);
+static UInt32 EsifHandleMgr_LowestSetBit(UInt64 value);
 
 //
 // PUBLIC
@@ -93,6 +101,7 @@ eEsifError EsifHandleMgr_PutHandle(esif_handle_t handle) {
 			if (lineNum < (self->handleMapSize / ESIF_HNDLMGR_LINE_SIZE)) {
 				self->handleMapPtr[lineNum] &= ~((UInt64)1 << pos);
 				self->numAvailableHandles++;
+				EsifHandleMgr_UpdateFreeLine(self, lineNum);
 			}
 		}
 		esif_ccb_write_unlock(&self->lock);
@@ -203,6 +212,11 @@ static eEsifError EsifHandleMgr_AllocateAdditionalHandles(EsifHandleMgrPtr self)
 	/* Add a single line to the availability map */
 	newMapSize = self->handleMapSize + ESIF_HNDLMGR_LINE_SIZE;
 
+	rc = EsifHandleMgr_GrowFreeLineMap(self, newMapSize / ESIF_HNDLMGR_LINE_SIZE);
+	if (rc != ESIF_OK) {
+		goto exit;
+	}
+
 	handleMapPtr = esif_ccb_realloc(self->handleMapPtr, newMapSize);
 	if (NULL == handleMapPtr) {
 		rc = ESIF_E_NO_MEMORY;
@@ -214,6 +228,7 @@ static eEsifError EsifHandleMgr_AllocateAdditionalHandles(EsifHandleMgrPtr self)
 	self->handleMapPtr = handleMapPtr;
 	self->handleMapSize = newMapSize;
 	self->numAvailableHandles += ESIF_HNDLMGR_HANDLES_PER_LINE;
+	EsifHandleMgr_UpdateFreeLine(self, (newMapSize / ESIF_HNDLMGR_LINE_SIZE) - 1);
 exit:
 	return rc;
 }
@@ -255,6 +270,11 @@ static eEsifError EsifHandleMgr_FindHandle(
 }
 
 
+/*
+* Finds the first available handle from the start position through the stop
+* position (inclusive).  Lines without an available handle are skipped using
+* the free line map, and each line is searched a word at a time.
+*/
 static eEsifError EsifHandleMgr_FindHandleInRegion(
 	EsifHandleMgrPtr self,
 	size_t startLineNum,
@@ -266,52 +286,155 @@ static eEsifError EsifHandleMgr_FindHandleInRegion(
 {
 	eEsifError rc = ESIF_E_INVALID_HANDLE;
 	esif_handle_t handle = 0;
-	UInt64 line = 0;
+	UInt64 freeBits = 0;
 	size_t lineNum = 0;
 	UInt32 pos = 0;
-	UInt32 lastPos = 0;
 
 	ESIF_ASSERT(self);
 	ESIF_ASSERT(handlePtr);
 
+	lineNum = startLineNum;
+	while (EsifHandleMgr_FindNextFreeLine(self, lineNum, stopLineNum, &lineNum)) {
+		freeBits = ~self->handleMapPtr[lineNum];
 
-	pos = startPos;
-	for (lineNum = startLineNum; lineNum <= stopLineNum; lineNum++) {
-		line = self->handleMapPtr[lineNum];
+		if (lineNum == startLineNum) {
+			freeBits &= ((UInt64)-1) << startPos;
+		}
+		if ((lineNum == stopLineNum) && (stopPos < (ESIF_HNDLMGR_HANDLES_PER_LINE - 1))) {
+			freeBits &= ((UInt64)1 << (stopPos + 1)) - 1;
+		}
 
-		lastPos = ESIF_HNDLMGR_HANDLES_PER_LINE - 1;
-		if (lineNum == stopLineNum) {
-			lastPos = stopPos;
+		while (freeBits) {
+			pos = EsifHandleMgr_LowestSetBit(freeBits);
+			freeBits &= freeBits - 1;
+
+			handle = (esif_handle_t)(size_t)((lineNum * ESIF_HNDLMGR_HANDLES_PER_LINE + pos) | (self->instanceCounter << ESIF_HNDLMGR_NUM_HANDLE_BITS));
+
+			if (EsifHandleMgr_IsReservedHandle(handle)) {
+				continue;
+			}
+
+			self->handleMapPtr[lineNum] |= ((UInt64)1 << pos);
+			self->curLine = lineNum;
+			self->curPos = pos;
+			self->numAvailableHandles--;
+			EsifHandleMgr_UpdateFreeLine(self, lineNum);
+
+			*handlePtr = handle;
+
+			rc = ESIF_OK;
+			goto exit;
 		}
+		lineNum++;
+	}
+exit:
+	return rc;
+}
 
-		for (; pos <= lastPos; pos++) {
-			if (!(line & ((UInt64)1 << pos))) {
 
+/* Sets or clears the free line map bit for a line based on its availability */
+static void EsifHandleMgr_UpdateFreeLine(
+	EsifHandleMgrPtr self,
+	size_t lineNum
+	)
+{
+	size_t wordNum = lineNum / ESIF_HNDLMGR_LINES_PER_SUMMARY_WORD;
+	UInt64 lineBit = (UInt64)1 << (lineNum % ESIF_HNDLMGR_LINES_PER_SUMMARY_WORD);
 
-				handle = (esif_handle_t)(size_t)((lineNum * ESIF_HNDLMGR_HANDLES_PER_LINE + pos) | (self->instanceCounter << ESIF_HNDLMGR_NUM_HANDLE_BITS));
+	ESIF_ASSERT(wordNum < (self->freeLineMapSize / sizeof(*self->freeLineMapPtr)));
 
-				if (EsifHandleMgr_IsReservedHandle(handle)) {
-					continue;
-				}
+	if (self->handleMapPtr[lineNum] != (UInt64)-1) {
+		self->freeLineMapPtr[wordNum] |= lineBit;
+	}
+	else {
+		self->freeLineMapPtr[wordNum] &= ~lineBit;
+	}
+}
 
-				self->handleMapPtr[lineNum] |= ((UInt64)1 << pos);
-				self->curLine = lineNum;
-				self->curPos = pos;
-				self->numAvailableHandles--;
 
-				*handlePtr = handle;
+/*
+* Finds the first line from the start line through the stop line (inclusive)
+* which has an available handle.  Returns ESIF_FALSE if there is none.
+*/
+static Bool EsifHandleMgr_FindNextFreeLine(
+	EsifHandleMgrPtr self,
+	size_t startLineNum,
+	size_t stopLineNum,
+	size_t *lineNumPtr
+	)
+{
+	size_t wordNum = startLineNum / ESIF_HNDLMGR_LINES_PER_SUMMARY_WORD;
+	size_t numWords = self->freeLineMapSize / sizeof(*self->freeLineMapPtr);
+	UInt64 freeLines = 0;
+	size_t lineNum = 0;
 
-				rc = ESIF_OK;
-				goto exit;
-			}
+	if ((startLineNum > stopLineNum) || (wordNum >= numWords)) {
+		return ESIF_FALSE;
+	}
+
+	freeLines = self->freeLineMapPtr[wordNum] & (((UInt64)-1) << (startLineNum % ESIF_HNDLMGR_LINES_PER_SUMMARY_WORD));
+	while (!freeLines) {
+		if ((++wordNum >= numWords) || ((wordNum * ESIF_HNDLMGR_LINES_PER_SUMMARY_WORD) > stopLineNum)) {
+			return ESIF_FALSE;
 		}
-		pos = 0;
+		freeLines = self->freeLineMapPtr[wordNum];
+	}
+
+	lineNum = (wordNum * ESIF_HNDLMGR_LINES_PER_SUMMARY_WORD) + EsifHandleMgr_LowestSetBit(freeLines);
+	if (lineNum > stopLineNum) {
+		return ESIF_FALSE;
 	}
+	*lineNumPtr = lineNum;
+	return ESIF_TRUE;
+}
+
+
+/* Makes the free line map large enough for the given number of handle map lines */
+static eEsifError EsifHandleMgr_GrowFreeLineMap(
+	EsifHandleMgrPtr self,
+	size_t numLines
+	)
+{
+	eEsifError rc = ESIF_OK;
+	size_t newMapSize = 0;
+	UInt64 *freeLineMapPtr = NULL;
+
+	newMapSize = ((numLines + ESIF_HNDLMGR_LINES_PER_SUMMARY_WORD - 1) / ESIF_HNDLMGR_LINES_PER_SUMMARY_WORD) * sizeof(*freeLineMapPtr);
+	if (newMapSize <= self->freeLineMapSize) {
+		goto exit;
+	}
+
+	freeLineMapPtr = esif_ccb_realloc(self->freeLineMapPtr, newMapSize);
+	if (NULL == freeLineMapPtr) {
+		rc = ESIF_E_NO_MEMORY;
+		goto exit;
+	}
+	esif_ccb_memset((char *)freeLineMapPtr + self->freeLineMapSize, 0, newMapSize - self->freeLineMapSize);
+
+	self->freeLineMapPtr = freeLineMapPtr;
+	self->freeLineMapSize = newMapSize;
 exit:
 	return rc;
 }
 
 
+/* Returns the index of the lowest set bit; value must not be 0 */
+static UInt32 EsifHandleMgr_LowestSetBit(UInt64 value)
+{
+#ifdef ESIF_ATTR_OS_WINDOWS
+	unsigned long index = 0;
+
+	if (!_BitScanForward(&index, (unsigned long)value)) {
+		_BitScanForward(&index, (unsigned long)(value >> 32));
+		index += 32;
+	}
+	return (UInt32)index;
+#else
+	return (UInt32)__builtin_ctzll(value);
+#endif
+}
+
+
 static Bool EsifHandleMgr_IsReservedHandle(esif_handle_t handle)
 {
 	Bool isReserved = ESIF_FALSE;
@@ -329,6 +452,7 @@ static EsifHandleMgrPtr EsifHandleMgr_Create()
 {
 	EsifHandleMgrPtr self = (EsifHandleMgrPtr)esif_ccb_malloc(sizeof(*self));
 	size_t handleMapSize = 0;
+	size_t i = 0;
 
 	if (self) {
 		esif_ccb_lock_init(&self->lock);
@@ -344,6 +468,15 @@ static EsifHandleMgrPtr EsifHandleMgr_Create()
 
 		self->handleMapSize = handleMapSize;
 
+		if (EsifHandleMgr_GrowFreeLineMap(self, ESIF_HNDLMGR_MIN_HANDLE_LINES) != ESIF_OK) {
+			EsifHandleMgr_Destroy(self);
+			self = NULL;
+			goto exit;
+		}
+		for (i = 0; i < ESIF_HNDLMGR_MIN_HANDLE_LINES; i++) {
+			EsifHandleMgr_UpdateFreeLine(self, i);
+		}
+
 		self->curLine = 0;
 		self->curPos = 0;
 		self->instanceCounter = 0;
@@ -357,6 +490,7 @@ static void EsifHandleMgr_Destroy(EsifHandleMgrPtr self)
 {
 	if (self) {
 		esif_ccb_free(self->handleMapPtr);
+		esif_ccb_free(self->freeLineMapPtr);
 
 		esif_ccb_lock_uninit(&self->lock);
 	}
@@ -32,6 +32,8 @@
 #define ESIF_HNDLMGR_LINE_SIZE (ESIF_HNDLMGR_HANDLES_PER_LINE / 8) /* Bytes */
 #define ESIF_HNDLMGR_MIN_HANDLES (ESIF_HNDLMGR_MIN_HANDLE_LINES * ESIF_HNDLMGR_HANDLES_PER_LINE)
 
+#define ESIF_HNDLMGR_LINES_PER_SUMMARY_WORD 64 /* NOT configurable */
+
 #define ESIF_HNDLMGR_INSTANCE_MASK (((UInt64)-1) << ESIF_HNDLMGR_NUM_HANDLE_BITS)
 #define ESIF_HNDLMGR_HANDLE_MASK (~ESIF_HNDLMGR_INSTANCE_MASK)
 
@@ -41,6 +43,9 @@ typedef struct _t_EsifHandleManager {
 	size_t handleMapSize; /* Number of bytes currently allocated to the map */
 	UInt64 numAvailableHandles; /* Number of available handles in the map */
 
+	UInt64 *freeLineMapPtr; /* One bit per handle map line; set if the line has an available handle */
+	size_t freeLineMapSize; /* Number of bytes currently allocated to the free line map */
+
 	size_t curLine; /* Current line number in the handle availability map */
 	UInt32 curPos;	/* Current bit position in the current handle line */
 
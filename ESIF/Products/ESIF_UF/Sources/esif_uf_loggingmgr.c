@@ -20,9 +20,11 @@
 #include "esif_uf_loggingmgr.h"
 #include "esif_temp.h"
 #include "esif_sdk_fan.h"
+#include "esif_lib_esifdata.h"
 
 
 #define ESIF_INVALID_DATA        0xFFFFFFFF
+#define MAX_STATUS_SAMPLE_SET    8
 
 // Bounds checking
 #define MAX_SCHEDULER_MS	(24 * 60 * 60 * 1000)	// 24 hours; cannot exceed 2^31-1 (~24 days)
@@ -66,6 +68,14 @@ static eEsifError EsifLogMgr_ParseCmdSchedule(
 	EsifLoggingManagerPtr self,
 	EsifShellCmdPtr shell
 	);
+static eEsifError EsifLogMgr_ParseCmdFormat(
+	EsifLoggingManagerPtr self,
+	EsifShellCmdPtr shell
+	);
+static eEsifError EsifLogMgr_ParseCmdDecode(
+	EsifLoggingManagerPtr self,
+	EsifShellCmdPtr shell
+	);
 static void *ESIF_CALLCONV EsifLogMgr_ParticipantLogWorkerThread(void *ptr);
 static void EsifLogMgr_ParticipantLogWriteHeader(
 	EsifLoggingManagerPtr self
@@ -113,7 +123,10 @@ static void EsifLogMgr_UpdateCapabilityData(
 	EsifParticipantLogDataNodePtr capabilityEntryPtr,
 	EsifCapabilityDataPtr capabilityPtr
 	);
-static eEsifError EsifLogMgr_OpenParticipantLogFile(char *fileName);
+static eEsifError EsifLogMgr_OpenParticipantLogFile(
+	EsifLoggingManagerPtr self,
+	char *fileName
+	);
 static eEsifError ESIF_CALLCONV EsifLogMgr_EventCallback(
 	esif_context_t context,
 	esif_handle_t participantId,
@@ -136,6 +149,13 @@ static eEsifError EsifLogMgr_ParticipantLogAddDataNode(
 void EsifLogMgr_ParticipantLogStart(EsifLoggingManagerPtr self);
 void EsifLogMgr_ParticipantLogStop(EsifLoggingManagerPtr self);
 static void EsifLogMgr_UpdateStatusCapabilityData(EsifParticipantLogDataNodePtr dataNodePtr);
+static void EsifLogMgr_ExecuteStatusSampleSet(
+	EsifParticipantLogDataNodePtr dataNodePtr,
+	const UInt32 *primitiveIdsPtr,
+	const enum esif_data_type *dataTypesPtr,
+	UInt32 *valuesPtr,
+	UInt32 count
+	);
 static eEsifError EsifLogMgr_ParticipantLogAddHeaderData(
 	char *logString,
 	size_t dataLength,
@@ -190,6 +210,21 @@ static void EsifLogMgr_ScheduledStartThread(const void *contextPtr);
 static void EsifLogMgr_DestroyParticipantLogData(EsifLoggingManagerPtr self);
 static void EsifLogMgr_DestroyEntry(EsifParticipantLogDataNodePtr curEntryPtr);
 static void EsifLogMgr_DestroyArgv(EsifLoggingManagerPtr self);
+static Bool EsifLogMgr_IsBinaryFileLog(EsifLoggingManagerPtr self);
+static const char *EsifLogMgr_LogFormatStr(EsifParticipantLogFormat logFormat);
+static Bool EsifLogMgr_IsTextLogNeeded(EsifLoggingManagerPtr self);
+static eEsifError EsifLogMgr_BinaryLogWriteFileHeader(void);
+static void EsifLogMgr_BinaryLogWriteRecord(
+	EsifLoggingManagerPtr self,
+	time_t now
+	);
+static void EsifLogMgr_BinaryLogFlushFrame(EsifLoggingManagerPtr self);
+static void EsifLogMgr_BinaryLogDestroy(EsifLoggingManagerPtr self);
+static eEsifError EsifLogMgr_DecodeBinaryLog(
+	char *inPath,
+	char *outPath,
+	UInt32 *recordsPtr
+	);
 
 //
 // PUBLIC INTERFACE---------------------------------------------------------------------
@@ -254,6 +289,7 @@ static eEsifError EsifLogMgr_Init(EsifLoggingManagerPtr self)
 	self->isDefaultFile = ESIF_TRUE;
 	self->listenersMask = ESIF_LISTENER_NONE;
 	self->listenerHeadersWrittenMask = ESIF_LISTENER_NONE;
+	self->logFormat = ESIF_PARTICIPANTLOG_FORMAT_CSV;
 
 
 	self->argc = 0;
@@ -447,6 +483,13 @@ eEsifError EsifLogMgr_ParseCmdParticipantLog(
 	else if (esif_ccb_stricmp(argv[PARTICITPANTLOG_CMD_INDEX], PARTICIPANTLOG_CMD_SCHEDULE_STR) == 0) {
 		rc = EsifLogMgr_ParseCmdSchedule(self, shell);
 	}
+	else if (esif_ccb_stricmp(argv[PARTICITPANTLOG_CMD_INDEX], PARTICIPANTLOG_CMD_FORMAT_STR) == 0) {
+		rc = EsifLogMgr_ParseCmdFormat(self, shell);
+	}
+	else if (esif_ccb_stricmp(argv[PARTICITPANTLOG_CMD_INDEX], PARTICIPANTLOG_CMD_DECODE_STR) == 0) {
+		rc = EsifLogMgr_ParseCmdDecode(self, shell);
+		goto exit;
+	}
 	else {
 		esif_ccb_sprintf_concat(OUT_BUF_LEN, output, "Error:Invalid usage. See help for command usage.\n");
 		rc = ESIF_E_NOT_SUPPORTED;
@@ -762,6 +805,121 @@ exit:
 	return rc;
 }
 
+static eEsifError EsifLogMgr_ParseCmdFormat(
+	EsifLoggingManagerPtr self,
+	EsifShellCmdPtr shell
+	)
+{
+	eEsifError rc = ESIF_OK;
+	int argc = 0;
+	char **argv = NULL;
+	char *output = NULL;
+	UInt32 i = PARTICITPANTLOG_SUB_CMD_INDEX;
+
+	ESIF_ASSERT(self != NULL);
+	ESIF_ASSERT(shell != NULL);
+	ESIF_ASSERT(shell->outbuf != NULL);
+
+	argc = shell->argc;
+	argv = shell->argv;
+	output = shell->outbuf;
+
+	if ((UInt32)argc <= i) {
+		esif_ccb_sprintf_concat(OUT_BUF_LEN, output, "Log file format : %s\n", EsifLogMgr_LogFormatStr(self->logFormat));
+		goto exit;
+	}
+
+	// The format of an open log file cannot change
+	if (self->isLogStarted != ESIF_FALSE) {
+		esif_ccb_sprintf_concat(OUT_BUF_LEN, output, "Stop participant logging before changing the log file format\n");
+		rc = ESIF_E_NOT_SUPPORTED;
+		goto exit;
+	}
+
+	if (esif_ccb_stricmp(argv[i], PARTICIPANTLOG_FORMAT_CSV_STR) == 0) {
+		self->logFormat = ESIF_PARTICIPANTLOG_FORMAT_CSV;
+	}
+	else if (esif_ccb_stricmp(argv[i], PARTICIPANTLOG_FORMAT_BINARY_STR) == 0) {
+		self->logFormat = ESIF_PARTICIPANTLOG_FORMAT_BINARY;
+	}
+	else if (esif_ccb_stricmp(argv[i], PARTICIPANTLOG_FORMAT_COMPRESSED_STR) == 0) {
+		self->logFormat = ESIF_PARTICIPANTLOG_FORMAT_COMPRESSED;
+	}
+	else {
+		esif_ccb_sprintf_concat(OUT_BUF_LEN, output, "Error:Invalid log file format. See help for command usage.\n");
+		rc = ESIF_E_NOT_SUPPORTED;
+		goto exit;
+	}
+	esif_ccb_sprintf_concat(OUT_BUF_LEN, output, "Log file format set to : %s\n", EsifLogMgr_LogFormatStr(self->logFormat));
+
+exit:
+	return rc;
+}
+
+static eEsifError EsifLogMgr_ParseCmdDecode(
+	EsifLoggingManagerPtr self,
+	EsifShellCmdPtr shell
+	)
+{
+	eEsifError rc = ESIF_OK;
+	int argc = 0;
+	char **argv = NULL;
+	char *output = NULL;
+	char inPath[MAX_PATH] = { 0 };
+	char outPath[MAX_PATH] = { 0 };
+	char outName[MAX_PATH] = { 0 };
+	char *extPtr = NULL;
+	UInt32 records = 0;
+	UInt32 i = PARTICITPANTLOG_SUB_CMD_INDEX;
+
+	ESIF_ASSERT(self != NULL);
+	ESIF_ASSERT(shell != NULL);
+	ESIF_ASSERT(shell->outbuf != NULL);
+
+	UNREFERENCED_PARAMETER(self);
+
+	argc = shell->argc;
+	argv = shell->argv;
+	output = shell->outbuf;
+
+	if ((UInt32)argc <= i) {
+		esif_ccb_sprintf_concat(OUT_BUF_LEN, output, "Error:No input file specified. See help for command usage.\n");
+		rc = ESIF_E_PARAMETER_IS_NULL;
+		goto exit;
+	}
+	EsifLogFile_GetFullPath(inPath, sizeof(inPath), argv[i]);
+
+	// Default output file is the input file with a .csv extension
+	if ((UInt32)argc > i + 1) {
+		esif_ccb_strcpy(outName, argv[i + 1], sizeof(outName));
+	}
+	else {
+		esif_ccb_strcpy(outName, argv[i], sizeof(outName));
+		extPtr = esif_ccb_strrchr(outName, '.');
+		if (extPtr != NULL) {
+			*extPtr = '\0';
+		}
+		esif_ccb_strcat(outName, ".csv", sizeof(outName));
+	}
+	EsifLogFile_GetFullPath(outPath, sizeof(outPath), outName);
+
+	if (esif_ccb_stricmp(inPath, outPath) == 0) {
+		esif_ccb_sprintf_concat(OUT_BUF_LEN, output, "Error:Input and output file are the same\n");
+		rc = ESIF_E_NOT_SUPPORTED;
+		goto exit;
+	}
+
+	rc = EsifLogMgr_DecodeBinaryLog(inPath, outPath, &records);
+	if (rc != ESIF_OK) {
+		esif_ccb_sprintf_concat(OUT_BUF_LEN, output, "Error decoding %s : %s(%d)\n", inPath, esif_rc_str(rc), rc);
+		goto exit;
+	}
+	esif_ccb_sprintf_concat(OUT_BUF_LEN, output, "Decoded %u records to %s\n", records, outPath);
+
+exit:
+	return rc;
+}
+
 static eEsifError EsifLogMgr_GetInputParameters(
 	EsifLoggingManagerPtr self,
 	EsifShellCmdPtr shell,
@@ -1215,6 +1373,9 @@ void EsifLogMgr_ParticipantLogStop(EsifLoggingManagerPtr self)
 		esif_ccb_event_set(&self->pollingThread.pollStopEvent);
 		esif_ccb_thread_join(&self->pollingThread.thread);
 		esif_ccb_event_uninit(&self->pollingThread.pollStopEvent);
+
+		// Write out the partially filled frame while the log file is still open
+		EsifLogMgr_BinaryLogFlushFrame(self);
 	}
 
 	return;
@@ -1589,7 +1750,7 @@ static eEsifError EsifLogMgr_OpenRouteTargetLogFileIfRequired(EsifLoggingManager
 	if (self->listenersMask & ESIF_LISTENER_LOGFILE_MASK) {
 		if ((self->isDefaultFile == ESIF_FALSE) && (*self->filename != '\0')) {
 			//Pass input file name for creating new file
-			rc = EsifLogMgr_OpenParticipantLogFile(self->filename);
+			rc = EsifLogMgr_OpenParticipantLogFile(self, self->filename);
 			if (rc != ESIF_OK) {
 				goto exit;
 			}
@@ -1597,7 +1758,7 @@ static eEsifError EsifLogMgr_OpenRouteTargetLogFileIfRequired(EsifLoggingManager
 		else {
 			//if it is default file then create new file every time
 			//Pass NULL as file name for creating new file based on time stamp
-			rc = EsifLogMgr_OpenParticipantLogFile(NULL);
+			rc = EsifLogMgr_OpenParticipantLogFile(self, NULL);
 			if (rc != ESIF_OK) {
 				goto exit;
 			}
@@ -1954,6 +2115,11 @@ static void EsifLogMgr_ParticipantLogWriteHeader(
 		goto exit;
 	}
 
+	// Binary log frames carry their own column descriptions
+	if (EsifLogMgr_IsTextLogNeeded(self) == ESIF_FALSE) {
+		goto exit;
+	}
+
 	/*
 	 * Loop through the complete list
 	 */
@@ -2016,6 +2182,8 @@ static void EsifLogMgr_ParticipantLogWriteData(
 	size_t dataLength = MAX_LOG_DATA;
 	EsifUpPtr upPtr = NULL;
 	Bool printTimeInfo = ESIF_TRUE;
+	Bool isTextLogNeeded = ESIF_FALSE;
+	char *logString = NULL;
 
 	ESIF_ASSERT(self != NULL);
 	ESIF_ASSERT(self->logData != NULL);
@@ -2025,6 +2193,10 @@ static void EsifLogMgr_ParticipantLogWriteData(
 		goto exit;
 	}
 
+	// Skip text formatting when the only target is a binary log file
+	isTextLogNeeded = EsifLogMgr_IsTextLogNeeded(self);
+	logString = (isTextLogNeeded ? self->logData : NULL);
+
 	/*
 	 * Loop through the complete list
 	 */
@@ -2035,7 +2207,7 @@ static void EsifLogMgr_ParticipantLogWriteData(
 		if (curEntryPtr != NULL) {
 			if (printTimeInfo != ESIF_FALSE) {
 				esif_ccb_system_time(&msec);
-				if (esif_ccb_localtime(&time, &now) == 0) {
+				if (isTextLogNeeded && (esif_ccb_localtime(&time, &now) == 0)) {
 					esif_ccb_sprintf(dataLength, self->logData, " %04d-%02d-%02d, %02d:%02d:%02d, %llu,",
 						time.tm_year + TIME_BASE_YEAR, time.tm_mon + 1, time.tm_mday, time.tm_hour, time.tm_min, time.tm_sec, msec);
 				}
@@ -2056,18 +2228,21 @@ static void EsifLogMgr_ParticipantLogWriteData(
 							(1 << curEntryPtr->capabilityData.type)
 						);
 					}
-					esif_ccb_sprintf_concat(dataLength, self->logData, " %llu, %s, %d,", esif_ccb_handle2llu(curEntryPtr->participantId), EsifUp_GetName(upPtr), domainIndex);
+					if (isTextLogNeeded) {
+						esif_ccb_sprintf_concat(dataLength, self->logData, " %llu, %s, %d,", esif_ccb_handle2llu(curEntryPtr->participantId), EsifUp_GetName(upPtr), domainIndex);
+					}
 					EsifUp_PutRef(upPtr);
 				}
-				else {
+				else if (isTextLogNeeded) {
 					esif_ccb_sprintf_concat(dataLength, self->logData, " %llu, UNAVAIL, %d,", esif_ccb_handle2llu(curEntryPtr->participantId), domainIndex);
 				}
 			}
-			else if ((currentParticipantId == curEntryPtr->participantId) &&
+			else if (isTextLogNeeded &&
+				(currentParticipantId == curEntryPtr->participantId) &&
 				(currentDomainId != curEntryPtr->domainId)) {
 				esif_ccb_sprintf_concat(dataLength, self->logData, " %d,", domainIndex);
 			}
-			EsifLogMgr_ParticipantLogAddDataNode(self->logData, dataLength, curEntryPtr);
+			EsifLogMgr_ParticipantLogAddDataNode(logString, dataLength, curEntryPtr);
 
 			currentParticipantId = curEntryPtr->participantId;
 			currentDomainId = curEntryPtr->domainId;
@@ -2077,9 +2252,12 @@ static void EsifLogMgr_ParticipantLogWriteData(
 	esif_ccb_read_unlock(&self->participantLogData.listLock);
 
 	//Print the output only if PrintTimeInfo Flag has been switched off
-	if (printTimeInfo == ESIF_FALSE) {
+	if ((printTimeInfo == ESIF_FALSE) && isTextLogNeeded) {
 		EsifLogMgr_DataLogWrite(self, "%s \n", self->logData);
 	}
+	if (EsifLogMgr_IsBinaryFileLog(self)) {
+		EsifLogMgr_BinaryLogWriteRecord(self, now);
+	}
 exit:
 	return;
 }
@@ -2227,7 +2405,6 @@ static eEsifError EsifLogMgr_ParticipantLogAddDataNode(
 {
 	eEsifError rc = ESIF_OK;
 
-	ESIF_ASSERT(logString != NULL);
 	ESIF_ASSERT(dataNodePtr != NULL);
 
 	if (EsifLogMgr_IsStatusCapable(dataNodePtr->capabilityData.type)) {
@@ -2236,10 +2413,16 @@ static eEsifError EsifLogMgr_ParticipantLogAddDataNode(
 		esif_ccb_write_unlock(&dataNodePtr->capabilityDataLock);
 	}
 
+	// A NULL log string only refreshes the status data for the binary log
+	if (logString == NULL) {
+		goto exit;
+	}
+
 	esif_ccb_read_lock(&dataNodePtr->capabilityDataLock);
 	EsifLogMgr_ParticipantLogAddCapabilityData(logString, dataLength, dataNodePtr);
 	esif_ccb_read_unlock(&dataNodePtr->capabilityDataLock);
 
+exit:
 	return rc;
 }
 
@@ -2565,126 +2748,68 @@ static void EsifLogMgr_UpdateStatusCapabilityData(EsifParticipantLogDataNodePtr
 	}
 	case ESIF_CAPABILITY_TYPE_PLAT_POWER_STATUS:
 	{
-		UInt32 powerValue = 0;
-		struct esif_data power_response = { ESIF_DATA_POWER, &powerValue, sizeof(powerValue), sizeof(powerValue) };
-
-		rc = EsifExecutePrimitive(dataNodePtr->participantId, GET_PLATFORM_REST_OF_POWER, esif_primitive_domain_str((u16)dataNodePtr->domainId, qualifierStr, MAX_NAME_STRING_LENGTH), ESIF_INSTANCE_INVALID, NULL, &power_response);
-		if (ESIF_OK != rc) {
-			ESIF_TRACE_INFO("Error while executing GET_PLATFORM_REST_OF_POWER primitive for participant " ESIF_HANDLE_FMT " domain : %d", esif_ccb_handle2llu(dataNodePtr->participantId), dataNodePtr->domainId);
-			powerValue = 0;
-		}
-		dataNodePtr->capabilityData.data.platformPowerStatus.platformRestOfPower = powerValue;
-
-		powerValue = 0;
-		rc = EsifExecutePrimitive(dataNodePtr->participantId, GET_ADAPTER_POWER_RATING, esif_primitive_domain_str((u16)dataNodePtr->domainId, qualifierStr, MAX_NAME_STRING_LENGTH), ESIF_INSTANCE_INVALID, NULL, &power_response);
-		if (ESIF_OK != rc) {
-			ESIF_TRACE_INFO("Error while executing GET_ADAPTER_POWER_RATING primitive for participant " ESIF_HANDLE_FMT " domain : %d", esif_ccb_handle2llu(dataNodePtr->participantId), dataNodePtr->domainId);
-			powerValue = 0;
-		}
-		dataNodePtr->capabilityData.data.platformPowerStatus.adapterPowerRating = powerValue;
-
-		UInt32 u32Value = 0;
-		struct esif_data u32_response = { ESIF_DATA_UINT32, &u32Value, sizeof(u32Value), sizeof(u32Value) };
-
-		rc = EsifExecutePrimitive(dataNodePtr->participantId, GET_PLATFORM_POWER_SOURCE, esif_primitive_domain_str((u16)dataNodePtr->domainId, qualifierStr, MAX_NAME_STRING_LENGTH), ESIF_INSTANCE_INVALID, NULL, &u32_response);
-		if (ESIF_OK != rc) {
-			ESIF_TRACE_INFO("Error while executing GET_PLATFORM_POWER_SOURCE primitive for participant " ESIF_HANDLE_FMT " domain : %d", esif_ccb_handle2llu(dataNodePtr->participantId), dataNodePtr->domainId);
-			u32Value = 0;
-		}
-		dataNodePtr->capabilityData.data.platformPowerStatus.platformPowerSource = u32Value;
-
-		u32Value = 0;
-		rc = EsifExecutePrimitive(dataNodePtr->participantId, GET_AVOL, esif_primitive_domain_str((u16)dataNodePtr->domainId, qualifierStr, MAX_NAME_STRING_LENGTH), ESIF_INSTANCE_INVALID, NULL, &u32_response);
-		if (ESIF_OK != rc) {
-			ESIF_TRACE_INFO("Error while executing GET_AVOL primitive for participant " ESIF_HANDLE_FMT " domain : %d", esif_ccb_handle2llu(dataNodePtr->participantId), dataNodePtr->domainId);
-			u32Value = 0;
-		}
-		dataNodePtr->capabilityData.data.platformPowerStatus.acNominalVoltage = u32Value;
-
-		u32Value = 0;
-		rc = EsifExecutePrimitive(dataNodePtr->participantId, GET_ACUR, esif_primitive_domain_str((u16)dataNodePtr->domainId, qualifierStr, MAX_NAME_STRING_LENGTH), ESIF_INSTANCE_INVALID, NULL, &u32_response);
-		if (ESIF_OK != rc) {
-			ESIF_TRACE_INFO("Error while executing GET_ACUR primitive for participant " ESIF_HANDLE_FMT "d domain : %d", esif_ccb_handle2llu(dataNodePtr->participantId), dataNodePtr->domainId);
-			u32Value = 0;
-		}
-		dataNodePtr->capabilityData.data.platformPowerStatus.acOperationalCurrent = u32Value;
-
-		rc = EsifExecutePrimitive(dataNodePtr->participantId, GET_AP01, esif_primitive_domain_str((u16)dataNodePtr->domainId, qualifierStr, MAX_NAME_STRING_LENGTH), ESIF_INSTANCE_INVALID, NULL, &u32_response);
-		if (ESIF_OK != rc) {
-			ESIF_TRACE_INFO("Error while executing GET_AP01 primitive for participant " ESIF_HANDLE_FMT " domain : %d", esif_ccb_handle2llu(dataNodePtr->participantId), dataNodePtr->domainId);
-			u32Value = 0;
-		}
-		dataNodePtr->capabilityData.data.platformPowerStatus.ac1msOverload = u32Value;
-
-		u32Value = 0;
-		rc = EsifExecutePrimitive(dataNodePtr->participantId, GET_AP02, esif_primitive_domain_str((u16)dataNodePtr->domainId, qualifierStr, MAX_NAME_STRING_LENGTH), ESIF_INSTANCE_INVALID, NULL, &u32_response);
-		if (ESIF_OK != rc) {
-			ESIF_TRACE_INFO("Error while executing GET_AP02 primitive for participant " ESIF_HANDLE_FMT " domain : %d", esif_ccb_handle2llu(dataNodePtr->participantId), dataNodePtr->domainId);
-			u32Value = 0;
-		}
-		dataNodePtr->capabilityData.data.platformPowerStatus.ac2msOverload = u32Value;
-
-		u32Value = 0;
-		rc = EsifExecutePrimitive(dataNodePtr->participantId, GET_AP10, esif_primitive_domain_str((u16)dataNodePtr->domainId, qualifierStr, MAX_NAME_STRING_LENGTH), ESIF_INSTANCE_INVALID, NULL, &u32_response);
-		if (ESIF_OK != rc) {
-			ESIF_TRACE_INFO("Error while executing GET_AP10 primitive for participant " ESIF_HANDLE_FMT " domain : %d", esif_ccb_handle2llu(dataNodePtr->participantId), dataNodePtr->domainId);
-			u32Value = 0;
-		}
-		dataNodePtr->capabilityData.data.platformPowerStatus.ac10msOverload = u32Value;
+		const UInt32 primitiveIds[] = {
+			GET_PLATFORM_REST_OF_POWER,
+			GET_ADAPTER_POWER_RATING,
+			GET_PLATFORM_POWER_SOURCE,
+			GET_AVOL,
+			GET_ACUR,
+			GET_AP01,
+			GET_AP02,
+			GET_AP10
+		};
+		const enum esif_data_type dataTypes[] = {
+			ESIF_DATA_POWER,
+			ESIF_DATA_POWER,
+			ESIF_DATA_UINT32,
+			ESIF_DATA_UINT32,
+			ESIF_DATA_UINT32,
+			ESIF_DATA_UINT32,
+			ESIF_DATA_UINT32,
+			ESIF_DATA_UINT32
+		};
+		UInt32 values[ESIF_ARRAY_LEN(primitiveIds)] = { 0 };
+
+		EsifLogMgr_ExecuteStatusSampleSet(dataNodePtr, primitiveIds, dataTypes, values, ESIF_ARRAY_LEN(primitiveIds));
+
+		dataNodePtr->capabilityData.data.platformPowerStatus.platformRestOfPower = values[0];
+		dataNodePtr->capabilityData.data.platformPowerStatus.adapterPowerRating = values[1];
+		dataNodePtr->capabilityData.data.platformPowerStatus.platformPowerSource = values[2];
+		dataNodePtr->capabilityData.data.platformPowerStatus.acNominalVoltage = values[3];
+		dataNodePtr->capabilityData.data.platformPowerStatus.acOperationalCurrent = values[4];
+		dataNodePtr->capabilityData.data.platformPowerStatus.ac1msOverload = values[5];
+		dataNodePtr->capabilityData.data.platformPowerStatus.ac2msOverload = values[6];
+		dataNodePtr->capabilityData.data.platformPowerStatus.ac10msOverload = values[7];
 		break;
 	}
 	case ESIF_CAPABILITY_TYPE_BATTERY_STATUS:
 	{
-		UInt32 powerValue = 0;
-		struct esif_data power_response = { ESIF_DATA_POWER, &powerValue, sizeof(powerValue), sizeof(powerValue) };
-
-		rc = EsifExecutePrimitive(dataNodePtr->participantId, GET_PLATFORM_MAX_BATTERY_POWER, esif_primitive_domain_str((u16)dataNodePtr->domainId, qualifierStr, MAX_NAME_STRING_LENGTH), ESIF_INSTANCE_INVALID, NULL, &power_response);
-		if (ESIF_OK != rc) {
-			ESIF_TRACE_INFO("Error while executing GET_PLATFORM_MAX_BATTERY_POWER primitive for participant " ESIF_HANDLE_FMT " domain : %d", esif_ccb_handle2llu(dataNodePtr->participantId), dataNodePtr->domainId);
-			powerValue = 0;
-		}
-		dataNodePtr->capabilityData.data.batteryStatus.maxBatteryPower = powerValue;
-
-		powerValue = 0;
-		rc = EsifExecutePrimitive(dataNodePtr->participantId, GET_PLATFORM_BATTERY_STEADY_STATE, esif_primitive_domain_str((u16)dataNodePtr->domainId, qualifierStr, MAX_NAME_STRING_LENGTH), ESIF_INSTANCE_INVALID, NULL, &power_response);
-		if (ESIF_OK != rc) {
-			ESIF_TRACE_INFO("Error while executing GET_PLATFORM_BATTERY_STEADY_STATE primitive for participant " ESIF_HANDLE_FMT " domain : %d", esif_ccb_handle2llu(dataNodePtr->participantId), dataNodePtr->domainId);
-			powerValue = 0;
-		}
-		dataNodePtr->capabilityData.data.batteryStatus.steadyStateBatteryPower = powerValue;
-
-		UInt32 u32Value = 0;
-		struct esif_data u32_response = { ESIF_DATA_UINT32, &u32Value, sizeof(u32Value), sizeof(u32Value) };
-		rc = EsifExecutePrimitive(dataNodePtr->participantId, GET_CHARGER_TYPE, esif_primitive_domain_str((u16)dataNodePtr->domainId, qualifierStr, MAX_NAME_STRING_LENGTH), ESIF_INSTANCE_INVALID, NULL, &u32_response);
-		if (ESIF_OK != rc) {
-			ESIF_TRACE_INFO("Error while executing GET_CHARGER_TYPE primitive for participant " ESIF_HANDLE_FMT " domain : %d", esif_ccb_handle2llu(dataNodePtr->participantId), dataNodePtr->domainId);
-			u32Value = 0;
-		}
-		dataNodePtr->capabilityData.data.batteryStatus.chargerType = u32Value;
-
-		u32Value = 0;
-		rc = EsifExecutePrimitive(dataNodePtr->participantId, GET_BATTERY_HIGH_FREQUENCY_IMPEDANCE, esif_primitive_domain_str((u16)dataNodePtr->domainId, qualifierStr, MAX_NAME_STRING_LENGTH), ESIF_INSTANCE_INVALID, NULL, &u32_response);
-		if (ESIF_OK != rc) {
-			ESIF_TRACE_INFO("Error while executing GET_BATTERY_HIGH_FREQUENCY_IMPEDANCE primitive for participant " ESIF_HANDLE_FMT " domain : %d", esif_ccb_handle2llu(dataNodePtr->participantId), dataNodePtr->domainId);
-			u32Value = 0;
-		}
-		dataNodePtr->capabilityData.data.batteryStatus.highFrequencyImpedance = u32Value;
+		const UInt32 primitiveIds[] = {
+			GET_PLATFORM_MAX_BATTERY_POWER,
+			GET_PLATFORM_BATTERY_STEADY_STATE,
+			GET_CHARGER_TYPE,
+			GET_BATTERY_HIGH_FREQUENCY_IMPEDANCE,
+			GET_BATTERY_MAX_PEAK_CURRENT,
+			GET_BATTERY_NO_LOAD_VOLTAGE
+		};
+		const enum esif_data_type dataTypes[] = {
+			ESIF_DATA_POWER,
+			ESIF_DATA_POWER,
+			ESIF_DATA_UINT32,
+			ESIF_DATA_UINT32,
+			ESIF_DATA_UINT32,
+			ESIF_DATA_UINT32
+		};
+		UInt32 values[ESIF_ARRAY_LEN(primitiveIds)] = { 0 };
 
-		u32Value = 0;
-		rc = EsifExecutePrimitive(dataNodePtr->participantId, GET_BATTERY_MAX_PEAK_CURRENT, esif_primitive_domain_str((u16)dataNodePtr->domainId, qualifierStr, MAX_NAME_STRING_LENGTH), ESIF_INSTANCE_INVALID, NULL, &u32_response);
-		if (ESIF_OK != rc) {
-			ESIF_TRACE_INFO("Error while executing GET_BATTERY_MAX_PEAK_CURRENT primitive for participant " ESIF_HANDLE_FMT " domain : %d", esif_ccb_handle2llu(dataNodePtr->participantId), dataNodePtr->domainId);
-			u32Value = 0;
-		}
-		dataNodePtr->capabilityData.data.batteryStatus.maxPeakCurrent = u32Value;
+		EsifLogMgr_ExecuteStatusSampleSet(dataNodePtr, primitiveIds, dataTypes, values, ESIF_ARRAY_LEN(primitiveIds));
 
-		u32Value = 0;
-		rc = EsifExecutePrimitive(dataNodePtr->participantId, GET_BATTERY_NO_LOAD_VOLTAGE, esif_primitive_domain_str((u16)dataNodePtr->domainId, qualifierStr, MAX_NAME_STRING_LENGTH), ESIF_INSTANCE_INVALID, NULL, &u32_response);
-		if (ESIF_OK != rc) {
-			ESIF_TRACE_INFO("Error while executing GET_BATTERY_NO_LOAD_VOLTAGE primitive for participant " ESIF_HANDLE_FMT " domain : %d", esif_ccb_handle2llu(dataNodePtr->participantId), dataNodePtr->domainId);
-			u32Value = 0;
-		}
-		dataNodePtr->capabilityData.data.batteryStatus.noLoadVoltage = u32Value;
+		dataNodePtr->capabilityData.data.batteryStatus.maxBatteryPower = values[0];
+		dataNodePtr->capabilityData.data.batteryStatus.steadyStateBatteryPower = values[1];
+		dataNodePtr->capabilityData.data.batteryStatus.chargerType = values[2];
+		dataNodePtr->capabilityData.data.batteryStatus.highFrequencyImpedance = values[3];
+		dataNodePtr->capabilityData.data.batteryStatus.maxPeakCurrent = values[4];
+		dataNodePtr->capabilityData.data.batteryStatus.noLoadVoltage = values[5];
 
 		UInt32 battPercent = 0;
 		struct esif_data batt_percent_response = { ESIF_DATA_PERCENT, &battPercent, sizeof(battPercent), sizeof(battPercent) };
@@ -2744,6 +2869,56 @@ static void EsifLogMgr_UpdateStatusCapabilityData(EsifParticipantLogDataNodePtr
 	return;
 }
 
+/*
+ * Reads a set of UInt32 status values for a data node together.  Values whose
+ * primitive fails are logged as 0.
+ */
+static void EsifLogMgr_ExecuteStatusSampleSet(
+	EsifParticipantLogDataNodePtr dataNodePtr,
+	const UInt32 *primitiveIdsPtr,
+	const enum esif_data_type *dataTypesPtr,
+	UInt32 *valuesPtr,
+	UInt32 count
+	)
+{
+	char qualifierStr[MAX_NAME_STRING_LENGTH] = "D0";
+	struct esif_data responses[MAX_STATUS_SAMPLE_SET] = { 0 };
+	EsifPrimitiveSample samples[MAX_STATUS_SAMPLE_SET] = { 0 };
+	UInt16 domain = 0;
+	UInt32 i = 0;
+
+	ESIF_ASSERT(dataNodePtr != NULL);
+	ESIF_ASSERT(primitiveIdsPtr != NULL);
+	ESIF_ASSERT(dataTypesPtr != NULL);
+	ESIF_ASSERT(valuesPtr != NULL);
+	ESIF_ASSERT(count <= MAX_STATUS_SAMPLE_SET);
+
+	domain = domain_str_to_short(esif_primitive_domain_str((u16)dataNodePtr->domainId, qualifierStr, MAX_NAME_STRING_LENGTH));
+
+	for (i = 0; i < count; i++) {
+		valuesPtr[i] = 0;
+		responses[i].type = dataTypesPtr[i];
+		responses[i].buf_ptr = &valuesPtr[i];
+		responses[i].buf_len = sizeof(valuesPtr[i]);
+		responses[i].data_len = sizeof(valuesPtr[i]);
+
+		samples[i].participantId = dataNodePtr->participantId;
+		samples[i].tuple.id = (u16)primitiveIdsPtr[i];
+		samples[i].tuple.domain = domain;
+		samples[i].tuple.instance = ESIF_INSTANCE_INVALID;
+		samples[i].responsePtr = &responses[i];
+	}
+
+	EsifExecutePrimitiveSampleSet(samples, count);
+
+	for (i = 0; i < count; i++) {
+		if (ESIF_OK != samples[i].rc) {
+			ESIF_TRACE_INFO("Error while executing %s primitive for participant " ESIF_HANDLE_FMT " domain : %d", esif_primitive_str((enum esif_primitive_type)primitiveIdsPtr[i]), esif_ccb_handle2llu(dataNodePtr->participantId), dataNodePtr->domainId);
+			valuesPtr[i] = 0;
+		}
+	}
+}
+
 static void EsifLogMgr_DataLogWrite(
 	EsifLoggingManagerPtr self,
 	char *logstring,
@@ -2771,7 +2946,8 @@ static void EsifLogMgr_DataLogWrite(
 		}
 	}
 
-	if ((self->listenersMask & ESIF_LISTENER_LOGFILE_MASK) > 0) {
+	// Binary log files are written by EsifLogMgr_BinaryLogWriteRecord
+	if (((self->listenersMask & ESIF_LISTENER_LOGFILE_MASK) > 0) && (self->logFormat == ESIF_PARTICIPANTLOG_FORMAT_CSV)) {
 		if (!self->isLogHeader || (!(self->listenerHeadersWrittenMask & ESIF_LISTENER_LOGFILE_MASK))) {
 			va_start(args, logstring);
 			EsifLogFile_WriteArgsAppend(ESIF_LOG_PARTICIPANT, " ", logstring, args);
@@ -2826,6 +3002,642 @@ exit:
 	return;
 }
 
+//
+// Binary Participant Log
+//
+static const char *EsifLogMgr_LogFormatStr(EsifParticipantLogFormat logFormat)
+{
+	switch (logFormat) {
+	case ESIF_PARTICIPANTLOG_FORMAT_BINARY:
+		return PARTICIPANTLOG_FORMAT_BINARY_STR;
+	case ESIF_PARTICIPANTLOG_FORMAT_COMPRESSED:
+		return PARTICIPANTLOG_FORMAT_COMPRESSED_STR;
+	default:
+		return PARTICIPANTLOG_FORMAT_CSV_STR;
+	}
+}
+
+static Bool EsifLogMgr_IsBinaryFileLog(EsifLoggingManagerPtr self)
+{
+	return (Bool)(((self->listenersMask & ESIF_LISTENER_LOGFILE_MASK) != 0) &&
+		(self->logFormat != ESIF_PARTICIPANTLOG_FORMAT_CSV));
+}
+
+// Returns whether any target needs the samples formatted as text
+static Bool EsifLogMgr_IsTextLogNeeded(EsifLoggingManagerPtr self)
+{
+	UInt32 textListenersMask = self->listenersMask;
+
+	if (self->logFormat != ESIF_PARTICIPANTLOG_FORMAT_CSV) {
+		textListenersMask &= ~ESIF_LISTENER_LOGFILE_MASK;
+	}
+	return (Bool)(textListenersMask != ESIF_LISTENER_NONE);
+}
+
+static eEsifError EsifLogMgr_BinaryLogWriteFileHeader(void)
+{
+	EsifParticipantLogFileHeader fileHeader = { 0 };
+
+	esif_ccb_memcpy(fileHeader.signature, ESIF_PARTICIPANTLOG_BIN_SIGNATURE, sizeof(fileHeader.signature));
+	fileHeader.version = ESIF_PARTICIPANTLOG_BIN_VERSION;
+	fileHeader.dataSize = sizeof(EsifCapability);
+
+	if (EsifLogFile_WriteBinary(ESIF_LOG_PARTICIPANT, &fileHeader, sizeof(fileHeader)) != sizeof(fileHeader)) {
+		return ESIF_E_IO_ERROR;
+	}
+	return ESIF_OK;
+}
+
+// Size of the EsifCapability member used by a capability type; only these bytes are compared and written
+static UInt32 EsifLogMgr_BinaryLogGetDataSize(UInt32 capabilityType)
+{
+	EsifCapability capability;
+	UInt32 dataSize = sizeof(capability);
+
+	switch (capabilityType) {
+	case ESIF_CAPABILITY_TYPE_ACTIVE_CONTROL:
+		dataSize = sizeof(capability.activeControl);
+		break;
+	case ESIF_CAPABILITY_TYPE_CORE_CONTROL:
+		dataSize = sizeof(capability.coreControl);
+		break;
+	case ESIF_CAPABILITY_TYPE_DISPLAY_CONTROL:
+		dataSize = sizeof(capability.displayControl);
+		break;
+	case ESIF_CAPABILITY_TYPE_DOMAIN_PRIORITY:
+		dataSize = sizeof(capability.domainPriority);
+		break;
+	case ESIF_CAPABILITY_TYPE_ENERGY_CONTROL:
+		dataSize = sizeof(capability.energyControl);
+		break;
+	case ESIF_CAPABILITY_TYPE_PERF_CONTROL:
+		dataSize = sizeof(capability.performanceControl);
+		break;
+	case ESIF_CAPABILITY_TYPE_POWER_CONTROL:
+		dataSize = sizeof(capability.powerControl);
+		break;
+	case ESIF_CAPABILITY_TYPE_POWER_STATUS:
+		dataSize = sizeof(capability.powerStatus);
+		break;
+	case ESIF_CAPABILITY_TYPE_TEMP_STATUS:
+		dataSize = sizeof(capability.temperatureStatus);
+		break;
+	case ESIF_CAPABILITY_TYPE_UTIL_STATUS:
+		dataSize = sizeof(capability.utilizationStatus);
+		break;
+	case ESIF_CAPABILITY_TYPE_PLAT_POWER_STATUS:
+		dataSize = sizeof(capability.platformPowerStatus);
+		break;
+	case ESIF_CAPABILITY_TYPE_BATTERY_STATUS:
+		dataSize = sizeof(capability.batteryStatus);
+		break;
+	case ESIF_CAPABILITY_TYPE_TEMP_THRESHOLD:
+		dataSize = sizeof(capability.temperatureThresholdControl);
+		break;
+	case ESIF_CAPABILITY_TYPE_RFPROFILE_STATUS:
+		dataSize = sizeof(capability.rfProfileStatus);
+		break;
+	case ESIF_CAPABILITY_TYPE_RFPROFILE_CONTROL:
+		dataSize = sizeof(capability.rfProfileControl);
+		break;
+	case ESIF_CAPABILITY_TYPE_PSYS_CONTROL:
+		dataSize = sizeof(capability.psysControl);
+		break;
+	case ESIF_CAPABILITY_TYPE_PEAK_POWER_CONTROL:
+		dataSize = sizeof(capability.peakPowerControl);
+		break;
+	case ESIF_CAPABILITY_TYPE_PROCESSOR_CONTROL:
+		dataSize = sizeof(capability.processorControlStatus);
+		break;
+	default:
+		break;
+	}
+	return dataSize;
+}
+
+// Grow the frame buffer so at least 'needed' more bytes fit
+static eEsifError EsifLogMgr_BinaryLogReserve(
+	EsifParticipantLogBinaryPtr binPtr,
+	size_t needed
+	)
+{
+	UInt8 *newFrame = NULL;
+	size_t newSize = 0;
+
+	if (binPtr->frameLen + needed <= binPtr->frameSize) {
+		return ESIF_OK;
+	}
+
+	newSize = binPtr->frameLen + needed + ESIF_PARTICIPANTLOG_FRAME_SIZE;
+	newFrame = (UInt8 *)esif_ccb_realloc(binPtr->frame, newSize);
+	if (newFrame == NULL) {
+		return ESIF_E_NO_MEMORY;
+	}
+	binPtr->frame = newFrame;
+	binPtr->frameSize = newSize;
+	return ESIF_OK;
+}
+
+// Write the current frame to the log file and start a new one
+static void EsifLogMgr_BinaryLogFlushFrame(EsifLoggingManagerPtr self)
+{
+	EsifParticipantLogBinaryPtr binPtr = &self->binaryLog;
+	EsifParticipantLogFrameHeader frameHeader = { 0 };
+	EsifData payload = { ESIF_DATA_BINARY };
+
+	if (binPtr->recordCount == 0) {
+		goto exit;
+	}
+
+	// The record count follows the column count at the start of the payload
+	esif_ccb_memcpy(binPtr->frame + sizeof(UInt32), &binPtr->recordCount, sizeof(UInt32));
+
+	// buf_len is 0 since the frame buffer is not owned by payload
+	payload.buf_ptr = binPtr->frame;
+	payload.buf_len = 0;
+	payload.data_len = (u32)binPtr->frameLen;
+
+	// The frame is written uncompressed if the compression library is not available
+	if ((self->logFormat == ESIF_PARTICIPANTLOG_FORMAT_COMPRESSED) &&
+		(EsifData_Compress(&payload) == ESIF_OK) &&
+		(payload.buf_ptr != binPtr->frame)) {
+		frameHeader.flags |= ESIF_PARTICIPANTLOG_FRAME_COMPRESSED;
+	}
+	frameHeader.length = payload.data_len;
+
+	EsifLogFile_WriteBinary(ESIF_LOG_PARTICIPANT, &frameHeader, sizeof(frameHeader));
+	EsifLogFile_WriteBinary(ESIF_LOG_PARTICIPANT, payload.buf_ptr, payload.data_len);
+
+	if (payload.buf_ptr != binPtr->frame) {
+		esif_ccb_free(payload.buf_ptr);
+	}
+exit:
+	binPtr->frameLen = 0;
+	binPtr->recordCount = 0;
+}
+
+// Returns whether the columns of the current frame still match the logged capabilities. Caller must hold the list lock.
+static Bool EsifLogMgr_BinaryLogColumnsMatch(EsifLoggingManagerPtr self)
+{
+	EsifParticipantLogBinaryPtr binPtr = &self->binaryLog;
+	EsifLinkListNodePtr nodePtr = self->participantLogData.list->head_ptr;
+	EsifParticipantLogDataNodePtr curEntryPtr = NULL;
+	UInt32 column = 0;
+
+	while (nodePtr != NULL) {
+		curEntryPtr = (EsifParticipantLogDataNodePtr)nodePtr->data_ptr;
+		if (curEntryPtr != NULL) {
+			if ((column >= binPtr->columnCount) ||
+				(binPtr->columns[column].participantId != esif_ccb_handle2llu(curEntryPtr->participantId)) ||
+				(binPtr->columns[column].domainId != curEntryPtr->domainId) ||
+				(binPtr->columns[column].capabilityType != curEntryPtr->capabilityData.type)) {
+				return ESIF_FALSE;
+			}
+			column++;
+		}
+		nodePtr = nodePtr->next_ptr;
+	}
+	return (Bool)(column == binPtr->columnCount);
+}
+
+// Build the column list from the logged capabilities. Caller must hold the list lock.
+static eEsifError EsifLogMgr_BinaryLogCreateColumns(EsifLoggingManagerPtr self)
+{
+	eEsifError rc = ESIF_OK;
+	EsifParticipantLogBinaryPtr binPtr = &self->binaryLog;
+	EsifLinkListNodePtr nodePtr = NULL;
+	EsifParticipantLogDataNodePtr curEntryPtr = NULL;
+	EsifUpPtr upPtr = NULL;
+	UInt32 columnCount = 0;
+	UInt32 column = 0;
+
+	esif_ccb_free(binPtr->columns);
+	esif_ccb_free(binPtr->lastData);
+	esif_ccb_free(binPtr->hasLastData);
+	binPtr->columns = NULL;
+	binPtr->lastData = NULL;
+	binPtr->hasLastData = NULL;
+	binPtr->columnCount = 0;
+
+	for (nodePtr = self->participantLogData.list->head_ptr; nodePtr != NULL; nodePtr = nodePtr->next_ptr) {
+		if (nodePtr->data_ptr != NULL) {
+			columnCount++;
+		}
+	}
+	if (columnCount == 0) {
+		goto exit;
+	}
+
+	binPtr->columns = (EsifParticipantLogColumnPtr)esif_ccb_malloc(columnCount * sizeof(*binPtr->columns));
+	binPtr->lastData = (EsifCapability *)esif_ccb_malloc(columnCount * sizeof(*binPtr->lastData));
+	binPtr->hasLastData = (UInt8 *)esif_ccb_malloc(columnCount * sizeof(*binPtr->hasLastData));
+	if ((binPtr->columns == NULL) || (binPtr->lastData == NULL) || (binPtr->hasLastData == NULL)) {
+		rc = ESIF_E_NO_MEMORY;
+		goto exit;
+	}
+
+	for (nodePtr = self->participantLogData.list->head_ptr; nodePtr != NULL; nodePtr = nodePtr->next_ptr) {
+		curEntryPtr = (EsifParticipantLogDataNodePtr)nodePtr->data_ptr;
+		if (curEntryPtr != NULL) {
+			EsifParticipantLogColumnPtr columnPtr = &binPtr->columns[column++];
+
+			columnPtr->participantId = esif_ccb_handle2llu(curEntryPtr->participantId);
+			columnPtr->domainId = curEntryPtr->domainId;
+			columnPtr->capabilityType = curEntryPtr->capabilityData.type;
+			columnPtr->dataSize = EsifLogMgr_BinaryLogGetDataSize(columnPtr->capabilityType);
+			esif_ccb_strcpy(columnPtr->name, "UNK", sizeof(columnPtr->name));
+			upPtr = EsifUpPm_GetAvailableParticipantByInstance(curEntryPtr->participantId);
+			if (upPtr != NULL) {
+				esif_ccb_strcpy(columnPtr->name, EsifUp_GetName(upPtr), sizeof(columnPtr->name));
+				EsifUp_PutRef(upPtr);
+			}
+		}
+	}
+	binPtr->columnCount = columnCount;
+exit:
+	return rc;
+}
+
+static void EsifLogMgr_BinaryLogWriteRecord(
+	EsifLoggingManagerPtr self,
+	time_t now
+	)
+{
+	EsifParticipantLogBinaryPtr binPtr = &self->binaryLog;
+	EsifParticipantLogRecordHeader recordHeader = { 0 };
+	EsifLinkListNodePtr nodePtr = NULL;
+	EsifParticipantLogDataNodePtr curEntryPtr = NULL;
+	esif_handle_t currentParticipantId = ESIF_INVALID_HANDLE;
+	EsifUpPtr upPtr = NULL;
+	esif_ccb_time_t msec = 0;
+	UInt8 availableFlag = 0;
+	UInt32 column = 0;
+	size_t recordSize = 0;
+
+	if (self->participantLogData.list == NULL) {
+		goto exit;
+	}
+
+	esif_ccb_system_time(&msec);
+	recordHeader.time = (UInt64)now;
+	recordHeader.msec = (UInt64)msec;
+
+	esif_ccb_read_lock(&self->participantLogData.listLock);
+
+	// Start a new frame if the logged capabilities changed
+	if (EsifLogMgr_BinaryLogColumnsMatch(self) == ESIF_FALSE) {
+		EsifLogMgr_BinaryLogFlushFrame(self);
+		if (EsifLogMgr_BinaryLogCreateColumns(self) != ESIF_OK) {
+			goto unlock;
+		}
+	}
+	if (binPtr->columnCount == 0) {
+		goto unlock;
+	}
+
+	if (binPtr->recordCount == 0) {
+		if (EsifLogMgr_BinaryLogReserve(binPtr, (2 * sizeof(UInt32)) + (binPtr->columnCount * sizeof(EsifParticipantLogColumn))) != ESIF_OK) {
+			goto unlock;
+		}
+		esif_ccb_memcpy(binPtr->frame, &binPtr->columnCount, sizeof(UInt32));
+		esif_ccb_memset(binPtr->frame + sizeof(UInt32), 0, sizeof(UInt32));
+		esif_ccb_memcpy(binPtr->frame + (2 * sizeof(UInt32)), binPtr->columns, binPtr->columnCount * sizeof(EsifParticipantLogColumn));
+		binPtr->frameLen = (2 * sizeof(UInt32)) + (binPtr->columnCount * sizeof(EsifParticipantLogColumn));
+		esif_ccb_memset(binPtr->hasLastData, 0, binPtr->columnCount * sizeof(*binPtr->hasLastData));
+	}
+
+	recordSize = sizeof(recordHeader);
+	for (column = 0; column < binPtr->columnCount; column++) {
+		recordSize += 1 + binPtr->columns[column].dataSize;
+	}
+	column = 0;
+	if (EsifLogMgr_BinaryLogReserve(binPtr, recordSize) != ESIF_OK) {
+		goto unlock;
+	}
+	esif_ccb_memcpy(binPtr->frame + binPtr->frameLen, &recordHeader, sizeof(recordHeader));
+	binPtr->frameLen += sizeof(recordHeader);
+
+	nodePtr = self->participantLogData.list->head_ptr;
+	while ((nodePtr != NULL) && (column < binPtr->columnCount)) {
+		curEntryPtr = (EsifParticipantLogDataNodePtr)nodePtr->data_ptr;
+		if (curEntryPtr != NULL) {
+			UInt8 *flagsPtr = binPtr->frame + binPtr->frameLen;
+			binPtr->frameLen++;
+
+			if (currentParticipantId != curEntryPtr->participantId) {
+				upPtr = EsifUpPm_GetAvailableParticipantByInstance(curEntryPtr->participantId);
+				availableFlag = (upPtr != NULL ? ESIF_PARTICIPANTLOG_COLUMN_AVAILABLE : 0);
+				EsifUp_PutRef(upPtr);
+				currentParticipantId = curEntryPtr->participantId;
+			}
+			*flagsPtr = availableFlag;
+
+			// Only values that changed since the previous record in the frame are written, and only the bytes of
+			// the capability's own member of the union
+			esif_ccb_read_lock(&curEntryPtr->capabilityDataLock);
+			if ((curEntryPtr->state >= ESIF_DATA_INITIALIZED) && (curEntryPtr->isPresent != ESIF_FALSE)) {
+				UInt32 dataSize = binPtr->columns[column].dataSize;
+
+				*flagsPtr |= ESIF_PARTICIPANTLOG_COLUMN_PRESENT;
+				if (!binPtr->hasLastData[column] ||
+					(memcmp(&binPtr->lastData[column], &curEntryPtr->capabilityData.data, dataSize) != 0)) {
+					*flagsPtr |= ESIF_PARTICIPANTLOG_COLUMN_CHANGED;
+					esif_ccb_memcpy(&binPtr->lastData[column], &curEntryPtr->capabilityData.data, dataSize);
+					binPtr->hasLastData[column] = ESIF_TRUE;
+					esif_ccb_memcpy(binPtr->frame + binPtr->frameLen, &curEntryPtr->capabilityData.data, dataSize);
+					binPtr->frameLen += dataSize;
+				}
+			}
+			esif_ccb_read_unlock(&curEntryPtr->capabilityDataLock);
+			column++;
+		}
+		nodePtr = nodePtr->next_ptr;
+	}
+	binPtr->recordCount++;
+
+unlock:
+	esif_ccb_read_unlock(&self->participantLogData.listLock);
+
+	if ((binPtr->recordCount >= ESIF_PARTICIPANTLOG_FRAME_RECORDS) || (binPtr->frameLen >= ESIF_PARTICIPANTLOG_FRAME_SIZE)) {
+		EsifLogMgr_BinaryLogFlushFrame(self);
+	}
+exit:
+	return;
+}
+
+static void EsifLogMgr_BinaryLogDestroy(EsifLoggingManagerPtr self)
+{
+	EsifParticipantLogBinaryPtr binPtr = &self->binaryLog;
+
+	esif_ccb_free(binPtr->columns);
+	esif_ccb_free(binPtr->lastData);
+	esif_ccb_free(binPtr->hasLastData);
+	esif_ccb_free(binPtr->frame);
+	esif_ccb_memset(binPtr, 0, sizeof(*binPtr));
+}
+
+// Write the CSV header line for the given columns, as EsifLogMgr_ParticipantLogWriteHeader does
+static void EsifLogMgr_DecodeWriteHeader(
+	FILE *outFile,
+	char *logString,
+	EsifParticipantLogColumnPtr columns,
+	UInt32 columnCount
+	)
+{
+	EsifCapabilityData capabilityData = { 0 };
+	UInt64 currentParticipantId = (UInt64)-1;
+	UInt32 currentDomainId = (UInt32)-1;
+	UInt8 domainIndex = 0;
+	UInt32 column = 0;
+
+	esif_ccb_sprintf(MAX_LOG_DATA, logString, " Date, Time, Server Msec,");
+	for (column = 0; column < columnCount; column++) {
+		if (currentParticipantId != columns[column].participantId) {
+			esif_ccb_sprintf_concat(MAX_LOG_DATA, logString, " Participant ID, Participant Name, Domain Id,");
+		}
+		else if (currentDomainId != columns[column].domainId) {
+			esif_ccb_sprintf_concat(MAX_LOG_DATA, logString, " Domain Id,");
+		}
+		EsifDomainIdToIndex((UInt16)columns[column].domainId, &domainIndex);
+		capabilityData.type = columns[column].capabilityType;
+		EsifLogMgr_ParticipantLogAddHeaderData(logString, MAX_LOG_DATA, &capabilityData, columns[column].name, domainIndex);
+
+		currentParticipantId = columns[column].participantId;
+		currentDomainId = columns[column].domainId;
+	}
+	// Same line ending as the text log file
+	esif_ccb_fprintf(outFile, "%s \n ", logString);
+}
+
+// Convert one frame payload to CSV lines, as EsifLogMgr_ParticipantLogWriteData writes them
+static eEsifError EsifLogMgr_DecodeFrame(
+	FILE *outFile,
+	char *logString,
+	UInt8 *payload,
+	size_t payloadLen,
+	EsifParticipantLogColumnPtr *lastColumnsPtr,
+	UInt32 *lastColumnCountPtr,
+	UInt32 *recordsPtr
+	)
+{
+	eEsifError rc = ESIF_OK;
+	EsifParticipantLogColumnPtr columns = NULL;
+	EsifParticipantLogDataNodePtr nodes = NULL;
+	EsifParticipantLogRecordHeader recordHeader = { 0 };
+	UInt32 columnCount = 0;
+	UInt32 recordCount = 0;
+	UInt32 record = 0;
+	UInt32 column = 0;
+	size_t offset = 0;
+
+	if (payloadLen < 2 * sizeof(UInt32)) {
+		rc = ESIF_E_INVALID_REQUEST_TYPE;
+		goto exit;
+	}
+	esif_ccb_memcpy(&columnCount, payload, sizeof(UInt32));
+	esif_ccb_memcpy(&recordCount, payload + sizeof(UInt32), sizeof(UInt32));
+	offset = 2 * sizeof(UInt32);
+	if ((columnCount == 0) || (columnCount > (payloadLen - offset) / sizeof(EsifParticipantLogColumn))) {
+		rc = ESIF_E_INVALID_REQUEST_TYPE;
+		goto exit;
+	}
+	columns = (EsifParticipantLogColumnPtr)(payload + offset);
+	offset += columnCount * sizeof(EsifParticipantLogColumn);
+
+	// Column names are written to the CSV as strings, so never read past the name field of a corrupt column
+	for (column = 0; column < columnCount; column++) {
+		if (columns[column].dataSize > sizeof(EsifCapability)) {
+			rc = ESIF_E_INVALID_REQUEST_TYPE;
+			goto exit;
+		}
+		columns[column].name[sizeof(columns[column].name) - 1] = '\0';
+	}
+
+	// Write a header line whenever the columns change
+	if ((*lastColumnsPtr == NULL) || (*lastColumnCountPtr != columnCount) ||
+		(memcmp(*lastColumnsPtr, columns, columnCount * sizeof(EsifParticipantLogColumn)) != 0)) {
+		esif_ccb_free(*lastColumnsPtr);
+		*lastColumnCountPtr = 0;
+		*lastColumnsPtr = (EsifParticipantLogColumnPtr)esif_ccb_malloc(columnCount * sizeof(EsifParticipantLogColumn));
+		if (*lastColumnsPtr == NULL) {
+			rc = ESIF_E_NO_MEMORY;
+			goto exit;
+		}
+		esif_ccb_memcpy(*lastColumnsPtr, columns, columnCount * sizeof(EsifParticipantLogColumn));
+		*lastColumnCountPtr = columnCount;
+		EsifLogMgr_DecodeWriteHeader(outFile, logString, columns, columnCount);
+	}
+
+	nodes = (EsifParticipantLogDataNodePtr)esif_ccb_malloc(columnCount * sizeof(*nodes));
+	if (nodes == NULL) {
+		rc = ESIF_E_NO_MEMORY;
+		goto exit;
+	}
+	esif_ccb_memset(nodes, 0, columnCount * sizeof(*nodes));
+	for (column = 0; column < columnCount; column++) {
+		nodes[column].participantId = (esif_handle_t)columns[column].participantId;
+		nodes[column].domainId = columns[column].domainId;
+		nodes[column].capabilityData.type = columns[column].capabilityType;
+	}
+
+	for (record = 0; record < recordCount; record++) {
+		UInt64 currentParticipantId = (UInt64)-1;
+		UInt32 currentDomainId = (UInt32)-1;
+		time_t recordTime = 0;
+		struct tm time = { 0 };
+		UInt8 domainIndex = 0;
+
+		if (offset + sizeof(recordHeader) > payloadLen) {
+			rc = ESIF_E_INVALID_REQUEST_TYPE;
+			goto exit;
+		}
+		esif_ccb_memcpy(&recordHeader, payload + offset, sizeof(recordHeader));
+		offset += sizeof(recordHeader);
+
+		*logString = '\0';
+		recordTime = (time_t)recordHeader.time;
+		if (esif_ccb_localtime(&time, &recordTime) == 0) {
+			esif_ccb_sprintf(MAX_LOG_DATA, logString, " %04d-%02d-%02d, %02d:%02d:%02d, %llu,",
+				time.tm_year + TIME_BASE_YEAR, time.tm_mon + 1, time.tm_mday, time.tm_hour, time.tm_min, time.tm_sec, recordHeader.msec);
+		}
+
+		for (column = 0; column < columnCount; column++) {
+			UInt8 flags = 0;
+
+			if (offset >= payloadLen) {
+				rc = ESIF_E_INVALID_REQUEST_TYPE;
+				goto exit;
+			}
+			flags = payload[offset++];
+			if (flags & ESIF_PARTICIPANTLOG_COLUMN_CHANGED) {
+				if (offset + columns[column].dataSize > payloadLen) {
+					rc = ESIF_E_INVALID_REQUEST_TYPE;
+					goto exit;
+				}
+				esif_ccb_memcpy(&nodes[column].capabilityData.data, payload + offset, columns[column].dataSize);
+				offset += columns[column].dataSize;
+			}
+			nodes[column].state = ESIF_DATA_INITIALIZED;
+			nodes[column].isPresent = ((flags & ESIF_PARTICIPANTLOG_COLUMN_PRESENT) != 0);
+
+			EsifDomainIdToIndex((UInt16)columns[column].domainId, &domainIndex);
+			if (currentParticipantId != columns[column].participantId) {
+				if (flags & ESIF_PARTICIPANTLOG_COLUMN_AVAILABLE) {
+					esif_ccb_sprintf_concat(MAX_LOG_DATA, logString, " %llu, %s, %d,", columns[column].participantId, columns[column].name, domainIndex);
+				}
+				else {
+					esif_ccb_sprintf_concat(MAX_LOG_DATA, logString, " %llu, UNAVAIL, %d,", columns[column].participantId, domainIndex);
+				}
+			}
+			else if (currentDomainId != columns[column].domainId) {
+				esif_ccb_sprintf_concat(MAX_LOG_DATA, logString, " %d,", domainIndex);
+			}
+			EsifLogMgr_ParticipantLogAddCapabilityData(logString, MAX_LOG_DATA, &nodes[column]);
+
+			currentParticipantId = columns[column].participantId;
+			currentDomainId = columns[column].domainId;
+		}
+		esif_ccb_fprintf(outFile, "%s \n ", logString);
+		(*recordsPtr)++;
+	}
+exit:
+	esif_ccb_free(nodes);
+	return rc;
+}
+
+// Convert a binary participant log file to the CSV format of the text log file
+static eEsifError EsifLogMgr_DecodeBinaryLog(
+	char *inPath,
+	char *outPath,
+	UInt32 *recordsPtr
+	)
+{
+	eEsifError rc = ESIF_OK;
+	FILE *inFile = NULL;
+	FILE *outFile = NULL;
+	EsifParticipantLogFileHeader fileHeader = { 0 };
+	EsifParticipantLogFrameHeader frameHeader = { 0 };
+	EsifData payload = { ESIF_DATA_BINARY };
+	EsifParticipantLogColumnPtr lastColumns = NULL;
+	UInt32 lastColumnCount = 0;
+	char *logString = NULL;
+	long fileSize = 0;
+	long offset = 0;
+
+	*recordsPtr = 0;
+
+	inFile = esif_ccb_fopen(inPath, FILEMODE_READ FILEMODE_BINARY, NULL);
+	if (inFile == NULL) {
+		rc = ESIF_E_NOT_FOUND;
+		goto exit;
+	}
+	if ((esif_ccb_fread(&fileHeader, sizeof(fileHeader), sizeof(fileHeader), 1, inFile) != 1) ||
+		(memcmp(fileHeader.signature, ESIF_PARTICIPANTLOG_BIN_SIGNATURE, sizeof(fileHeader.signature)) != 0) ||
+		(fileHeader.version != ESIF_PARTICIPANTLOG_BIN_VERSION) ||
+		(fileHeader.dataSize != sizeof(EsifCapability))) {
+		rc = ESIF_E_NOT_SUPPORTED;
+		goto exit;
+	}
+
+	// Frame lengths are checked against the rest of the file before anything is allocated for them
+	if ((esif_ccb_fseek(inFile, 0, SEEK_END) != 0) ||
+		((fileSize = esif_ccb_ftell(inFile)) < 0) ||
+		(esif_ccb_fseek(inFile, sizeof(fileHeader), SEEK_SET) != 0)) {
+		rc = ESIF_E_IO_ERROR;
+		goto exit;
+	}
+
+	logString = (char *)esif_ccb_malloc(MAX_LOG_DATA);
+	outFile = esif_ccb_fopen(outPath, FILEMODE_WRITE, NULL);
+	if ((logString == NULL) || (outFile == NULL)) {
+		rc = (logString == NULL ? ESIF_E_NO_MEMORY : ESIF_E_IO_ERROR);
+		goto exit;
+	}
+
+	while (esif_ccb_fread(&frameHeader, sizeof(frameHeader), sizeof(frameHeader), 1, inFile) == 1) {
+		void *buffer = NULL;
+
+		offset = esif_ccb_ftell(inFile);
+		if (frameHeader.length == 0) {
+			rc = ESIF_E_INVALID_REQUEST_TYPE;
+			goto exit;
+		}
+		if ((offset < 0) || ((UInt64)frameHeader.length > (UInt64)(fileSize - offset))) {
+			break;	// Frame was not completely written; ignore it
+		}
+		buffer = esif_ccb_malloc(frameHeader.length);
+		if (buffer == NULL) {
+			rc = ESIF_E_NO_MEMORY;
+			goto exit;
+		}
+		EsifData_Set(&payload, ESIF_DATA_BINARY, buffer, frameHeader.length, frameHeader.length);
+		if (esif_ccb_fread(payload.buf_ptr, payload.buf_len, sizeof(char), frameHeader.length, inFile) != frameHeader.length) {
+			break;	// Frame was not completely written; ignore it
+		}
+		if (frameHeader.flags & ESIF_PARTICIPANTLOG_FRAME_COMPRESSED) {
+			rc = EsifData_Decompress(&payload);
+			if (rc != ESIF_OK) {
+				goto exit;
+			}
+		}
+		rc = EsifLogMgr_DecodeFrame(outFile, logString, (UInt8 *)payload.buf_ptr, payload.data_len, &lastColumns, &lastColumnCount, recordsPtr);
+		if (rc != ESIF_OK) {
+			goto exit;
+		}
+	}
+exit:
+	EsifData_Set(&payload, ESIF_DATA_VOID, NULL, 0, 0);
+	esif_ccb_free(lastColumns);
+	esif_ccb_free(logString);
+	if (outFile != NULL) {
+		esif_ccb_fclose(outFile);
+	}
+	if (inFile != NULL) {
+		esif_ccb_fclose(inFile);
+	}
+	return rc;
+}
+
 static eEsifError EsifLogMgr_Uninit(EsifLoggingManagerPtr self)
 {
 	eEsifError rc = ESIF_OK;
@@ -2883,6 +3695,7 @@ static eEsifError EsifLogMgr_Uninit(EsifLoggingManagerPtr self)
 		esif_ccb_ptr2context(self));
 
 	EsifLogMgr_DestroyParticipantLogData(self);
+	EsifLogMgr_BinaryLogDestroy(self);
 
 	esif_link_list_destroy(self->participantLogData.list);
 	self->participantLogData.list = NULL;
@@ -2935,21 +3748,34 @@ exit:
 	return;
 }
 
-static eEsifError EsifLogMgr_OpenParticipantLogFile(char *fileName)
+static eEsifError EsifLogMgr_OpenParticipantLogFile(
+	EsifLoggingManagerPtr self,
+	char *fileName
+	)
 {
 	eEsifError rc = ESIF_OK;
 	EsifLogType logtype = ESIF_LOG_PARTICIPANT;
 	char logname[MAX_PATH] = { 0 };
 	int append = ESIF_FALSE;
+	Bool isBinary = (Bool)(self->logFormat != ESIF_PARTICIPANTLOG_FORMAT_CSV);
 
 	if (fileName == NULL) {
 		time_t now = time(NULL);
 		struct tm time = { 0 };
 		if (esif_ccb_localtime(&time, &now) == 0) {
-			esif_ccb_sprintf(sizeof(logname), logname, "participant_log_%04d-%02d-%02d-%02d%02d%02d.csv",
-				time.tm_year + TIME_BASE_YEAR, time.tm_mon + 1, time.tm_mday, time.tm_hour, time.tm_min, time.tm_sec);
+			esif_ccb_sprintf(sizeof(logname), logname, "participant_log_%04d-%02d-%02d-%02d%02d%02d%s",
+				time.tm_year + TIME_BASE_YEAR, time.tm_mon + 1, time.tm_mday, time.tm_hour, time.tm_min, time.tm_sec,
+				(isBinary ? ESIF_PARTICIPANTLOG_BIN_EXT : ".csv"));
 		}
-		EsifLogFile_Open(logtype, logname, append);
+		fileName = logname;
+	}
+
+	// Each binary log file starts with a new frame
+	self->binaryLog.frameLen = 0;
+	self->binaryLog.recordCount = 0;
+
+	if (isBinary) {
+		EsifLogFile_OpenBinary(logtype, fileName, append);
 	}
 	else {
 		EsifLogFile_Open(logtype, fileName, append);
@@ -2958,6 +3784,9 @@ static eEsifError EsifLogMgr_OpenParticipantLogFile(char *fileName)
 		rc = ESIF_E_IO_ERROR;
 		goto exit;
 	}
+	if (isBinary) {
+		rc = EsifLogMgr_BinaryLogWriteFileHeader();
+	}
 exit:
 	return rc;
 }
@@ -3143,6 +3972,7 @@ static void EsifLogMgr_PrintListenerStatus(
 				}
 			}
 			esif_ccb_strcat(output, "\n", datalength);
+			esif_ccb_sprintf_concat(datalength, output, "Log File Format : %s\n", EsifLogMgr_LogFormatStr(self->logFormat));
 		}
 	}
 }
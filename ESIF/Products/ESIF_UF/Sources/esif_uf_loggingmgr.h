@@ -42,6 +42,12 @@
 #define PARTICIPANTLOG_CMD_ROUTE_STR        "route"
 #define PARTICIPANTLOG_CMD_INTERVAL_STR     "interval"
 #define PARTICIPANTLOG_CMD_SCHEDULE_STR     "schedule"
+#define PARTICIPANTLOG_CMD_FORMAT_STR       "format"
+#define PARTICIPANTLOG_CMD_DECODE_STR       "decode"
+
+#define PARTICIPANTLOG_FORMAT_CSV_STR        "csv"
+#define PARTICIPANTLOG_FORMAT_BINARY_STR     "binary"
+#define PARTICIPANTLOG_FORMAT_COMPRESSED_STR "compressed"
 
 #define MAX_DOMAIN_ID_LENGTH      2
 #define ESIF_DOMAIN_IDENT_CHAR_D  'D'
@@ -74,6 +80,73 @@ typedef struct EsifParticipantLogScheduler_s{
 	UInt32 delay;                           /* delay in ms*/
 } EsifParticipantLogScheduler, *EsifParticipantLogSchedulerPtr;
 
+/*
+ * Binary Participant Log File Format
+ * The file starts with an EsifParticipantLogFileHeader followed by frames. Each frame is an
+ * EsifParticipantLogFrameHeader followed by its (optionally compressed) payload:
+ *   UInt32 columnCount, UInt32 recordCount, EsifParticipantLogColumn[columnCount], records
+ * Each record is an EsifParticipantLogRecordHeader followed by one flags byte per column; the
+ * capability data (only the column's dataSize bytes of the active EsifCapability member) follows
+ * the flags byte only if the value changed since the previous record in the frame. The first
+ * record of a frame contains every present value, so each frame can be decoded on its own.
+ */
+#define ESIF_PARTICIPANTLOG_BIN_SIGNATURE     "ESIFPLOG"
+#define ESIF_PARTICIPANTLOG_BIN_VERSION       2
+#define ESIF_PARTICIPANTLOG_BIN_EXT           ".plog"
+#define ESIF_PARTICIPANTLOG_FRAME_SIZE        (32 * 1024) /* Frame is written once its payload reaches this size */
+#define ESIF_PARTICIPANTLOG_FRAME_RECORDS     60          /* or once it holds this many records */
+
+#define ESIF_PARTICIPANTLOG_FRAME_COMPRESSED  0x00000001
+
+#define ESIF_PARTICIPANTLOG_COLUMN_PRESENT    0x01 /* Capability data is valid */
+#define ESIF_PARTICIPANTLOG_COLUMN_AVAILABLE  0x02 /* Participant was available when sampled */
+#define ESIF_PARTICIPANTLOG_COLUMN_CHANGED    0x04 /* Capability data follows */
+
+typedef enum EsifParticipantLogFormat_e {
+	ESIF_PARTICIPANTLOG_FORMAT_CSV = 0,     /* Text file, one line per sample */
+	ESIF_PARTICIPANTLOG_FORMAT_BINARY,      /* Binary file of frames */
+	ESIF_PARTICIPANTLOG_FORMAT_COMPRESSED,  /* Binary file of frames compressed by the ESIF compression library */
+} EsifParticipantLogFormat;
+
+#pragma pack(push, 1)
+
+typedef struct EsifParticipantLogFileHeader_s {
+	char signature[8];	/* ESIF_PARTICIPANTLOG_BIN_SIGNATURE */
+	UInt32 version;
+	UInt32 dataSize;	/* sizeof(EsifCapability); no column has more capability data than this */
+} EsifParticipantLogFileHeader, *EsifParticipantLogFileHeaderPtr;
+
+typedef struct EsifParticipantLogFrameHeader_s {
+	UInt32 flags;		/* ESIF_PARTICIPANTLOG_FRAME_* */
+	UInt32 length;		/* Payload length in the file */
+} EsifParticipantLogFrameHeader, *EsifParticipantLogFrameHeaderPtr;
+
+typedef struct EsifParticipantLogColumn_s {
+	UInt64 participantId;
+	UInt32 domainId;
+	UInt32 capabilityType;
+	UInt32 dataSize;	/* Bytes of capability data written for a changed value */
+	char name[ESIF_NAME_LEN];	/* Participant name when the frame was started */
+} EsifParticipantLogColumn, *EsifParticipantLogColumnPtr;
+
+typedef struct EsifParticipantLogRecordHeader_s {
+	UInt64 time;		/* Seconds since the epoch */
+	UInt64 msec;		/* Server msec */
+} EsifParticipantLogRecordHeader, *EsifParticipantLogRecordHeaderPtr;
+
+#pragma pack(pop)
+
+typedef struct EsifParticipantLogBinary_s {
+	EsifParticipantLogColumnPtr columns;
+	EsifCapability *lastData;	/* Last value written for each column in the current frame */
+	UInt8 *hasLastData;
+	UInt32 columnCount;
+	UInt32 recordCount;			/* Records in the current frame */
+	UInt8 *frame;				/* Frame payload being built */
+	size_t frameLen;
+	size_t frameSize;
+} EsifParticipantLogBinary, *EsifParticipantLogBinaryPtr;
+
 typedef struct EsifLoggingManager_s {
 	Bool isInitialized;
 	EsifParticipantLogData participantLogData; /*Pointer to the Data structure which maintains the list of participant Data*/
@@ -92,6 +165,8 @@ typedef struct EsifLoggingManager_s {
 	EsifCommandInfoPtr commandInfo;
 	int commandInfoCount;
 	char *logData;
+	EsifParticipantLogFormat logFormat;	/* Format of the file target */
+	EsifParticipantLogBinary binaryLog;
 } EsifLoggingManager, *EsifLoggingManagerPtr;
 
 
@@ -36,6 +36,8 @@
 
 #define CONNECTED_STANDBY_POLLING_RATE_DEFAULT 60000
 
+int g_resultCache = ESIF_TRUE;	// Reuse oversize GET results instead of executing the primitive again?
+
 /*
  * Need to move to header POC.  Also don't forget to free returned
  * memory JDH
@@ -45,6 +47,59 @@ extern char *esif_str_replace(char *orig, char *rep, char *with);
 /*
  * PRIVATE FUNCTION PROTOTYPES
  */
+static EsifUpResultCacheEntryPtr EsifUp_GetResultCacheEntry(
+	EsifUpPtr self,
+	EsifPrimitiveTuplePtr tuplePtr,
+	Bool create
+	);
+
+static UInt32 EsifUp_GetResultSizeHint(
+	EsifUpPtr self,
+	EsifPrimitiveTuplePtr tuplePtr
+	);
+
+static void EsifUp_SetResultSizeHint(
+	EsifUpPtr self,
+	EsifPrimitiveTuplePtr tuplePtr,
+	UInt32 sizeHint
+	);
+
+static void EsifUp_FreeCachedResult(
+	EsifUpResultCacheEntryPtr entryPtr
+	);
+
+static Bool EsifUp_IsCachedRequest(
+	EsifUpResultCacheEntryPtr entryPtr,
+	const EsifDataPtr requestPtr
+	);
+
+static Bool EsifUp_TakeCachedResult(
+	EsifUpPtr self,
+	EsifPrimitiveTuplePtr tuplePtr,
+	const EsifDataPtr requestPtr,
+	EsifDataPtr responsePtr
+	);
+
+static void EsifUp_CacheResult(
+	EsifUpPtr self,
+	EsifPrimitiveTuplePtr tuplePtr,
+	const EsifDataPtr requestPtr,
+	EsifDataPtr resultPtr
+	);
+
+static void EsifUp_DestroyResultCache(
+	EsifUpPtr self
+	);
+
+static eEsifError EsifUp_ExecuteOversizePrimitive(
+	EsifUpPtr self,
+	EsifPrimitiveTuplePtr tuplePtr,
+	const EsifPrimitiveActionSelectorPtr selectorPtr,
+	const EsifDataPtr requestPtr,
+	EsifDataPtr responsePtr,
+	UInt32 sizeHint
+	);
+
 static eEsifError EsifUp_CreateParticipantByLpEventData(
 	struct esif_ipc_event_data_create_participant *lpCreateDataPtr,
 	EsifUpPtr *upPtr
@@ -603,6 +658,7 @@ static eEsifError EsifUp_CreateParticipantByLpEventData(
 	newUpPtr->markedForDelete = ESIF_FALSE;
 	esif_ccb_event_init(&newUpPtr->deleteEvent);
 	esif_ccb_lock_init(&newUpPtr->objLock);
+	esif_ccb_lock_init(&newUpPtr->resultCacheLock);
 
 	/* origin of creation */
 	newUpPtr->fOrigin = eParticipantOriginLF;
@@ -699,6 +755,7 @@ static eEsifError EsifUp_CreateParticipantByUpInterface(
 	newUpPtr->markedForDelete = ESIF_FALSE;
 	esif_ccb_event_init(&newUpPtr->deleteEvent);
 	esif_ccb_lock_init(&newUpPtr->objLock);
+	esif_ccb_lock_init(&newUpPtr->resultCacheLock);
 
 	/* origin of creation */
 	newUpPtr->fOrigin = eParticipantOriginUF;
@@ -886,6 +943,7 @@ void EsifUp_DestroyParticipant(
 
 		esif_ccb_event_uninit(&self->deleteEvent);
 		esif_ccb_lock_uninit(&self->objLock);
+		EsifUp_DestroyResultCache(self);
 
 		esif_ccb_free(self);
 	}
@@ -1155,6 +1213,7 @@ eEsifError EsifUp_ExecuteSpecificActionPrimitive(
 	Bool excludeAction = ESIF_FALSE;
 	Bool typeValid = ESIF_FALSE;
 	Bool indexValid = ESIF_FALSE;
+	Bool useResultCache = ESIF_FALSE;
 
 	if (NULL == self) {
 		ESIF_TRACE_ERROR("Participant pointer is NULL\n");
@@ -1256,6 +1315,9 @@ eEsifError EsifUp_ExecuteSpecificActionPrimitive(
 			if (ESIF_DATA_BINARY == responsePtr->type) {
 				size = 4096;
 			}
+			if (g_resultCache && (primitivePtr->operation == ESIF_PRIMITIVE_OP_GET)) {
+				size = esif_ccb_max(size, (int)EsifUp_GetResultSizeHint(self, tuplePtr));
+			}
 
 			responsePtr->buf_ptr = esif_ccb_malloc(size);
 			responsePtr->buf_len = size;
@@ -1291,6 +1353,27 @@ eEsifError EsifUp_ExecuteSpecificActionPrimitive(
 	typeValid = selectorPtr->flags & ESIF_PRIM_ACT_SEL_FLAG_TYPE_VALID;
 	indexValid = selectorPtr->flags & ESIF_PRIM_ACT_SEL_FLAG_INDEX_VALID;
 
+	/*
+	 * GET primitives with variable-size results are executed only once per request when the size is known:
+	 * a retry with a larger buffer and the same request data is given the result computed for the previous
+	 * call, and a buffer smaller than the learned size is handled by executing into a buffer of the learned size.
+	 */
+	useResultCache = (g_resultCache && tryAll && (responsePtr != NULL) && (responsePtr->buf_ptr != NULL) &&
+		(primitivePtr->operation == ESIF_PRIMITIVE_OP_GET));
+	if (useResultCache) {
+		UInt32 sizeHint = 0;
+
+		if (EsifUp_TakeCachedResult(self, tuplePtr, requestPtr, responsePtr)) {
+			rc = ESIF_OK;
+			goto exit;
+		}
+		sizeHint = EsifUp_GetResultSizeHint(self, tuplePtr);
+		if ((sizeHint > responsePtr->buf_len) && (ESIF_FALSE == rspAuto)) {
+			rc = EsifUp_ExecuteOversizePrimitive(self, tuplePtr, selectorPtr, requestPtr, responsePtr, sizeHint);
+			goto exit;
+		}
+	}
+
 	rc = ESIF_E_PRIMITIVE_NO_ACTION_AVAIL;
 	supActRc = rc;
 	for (kernAct = 0, i = 0; i < (int)primitivePtr->num_actions; i++) {
@@ -1360,12 +1443,257 @@ eEsifError EsifUp_ExecuteSpecificActionPrimitive(
 		}
 	}
 
+	if (useResultCache && (ESIF_E_NEED_LARGER_BUFFER == rc) && (responsePtr->data_len > responsePtr->buf_len)) {
+		EsifUp_SetResultSizeHint(self, tuplePtr, responsePtr->data_len);
+	}
 exit:
 	ESIF_TRACE_DEBUG("Primitive result = %s\n", esif_rc_str(rc));
 	return rc;
 }
 
 
+/*
+ * Execute a GET primitive into a buffer of the learned result size for a caller whose buffer is too small.
+ * A result that doesn't fit is kept for the caller's retry with a larger buffer.
+ */
+static eEsifError EsifUp_ExecuteOversizePrimitive(
+	EsifUpPtr self,
+	EsifPrimitiveTuplePtr tuplePtr,
+	const EsifPrimitiveActionSelectorPtr selectorPtr,
+	const EsifDataPtr requestPtr,
+	EsifDataPtr responsePtr,
+	UInt32 sizeHint
+	)
+{
+	eEsifError rc = ESIF_OK;
+	EsifData oversizeResponse = { responsePtr->type, NULL, sizeHint, 0 };
+
+	oversizeResponse.buf_ptr = esif_ccb_malloc(sizeHint);
+	if (NULL == oversizeResponse.buf_ptr) {
+		rc = ESIF_E_NO_MEMORY;
+		goto exit;
+	}
+
+	rc = EsifUp_ExecuteSpecificActionPrimitive(self, tuplePtr, selectorPtr, requestPtr, &oversizeResponse);
+
+	responsePtr->type = oversizeResponse.type;
+	responsePtr->data_len = oversizeResponse.data_len;
+	if (ESIF_OK == rc) {
+		if (oversizeResponse.data_len <= responsePtr->buf_len) {
+			esif_ccb_memcpy(responsePtr->buf_ptr, oversizeResponse.buf_ptr, oversizeResponse.data_len);
+		}
+		else {
+			EsifUp_CacheResult(self, tuplePtr, requestPtr, &oversizeResponse);
+			rc = ESIF_E_NEED_LARGER_BUFFER;
+		}
+	}
+exit:
+	esif_ccb_free(oversizeResponse.buf_ptr);
+	return rc;
+}
+
+
+/*
+ * Returns the result cache entry of a tuple, replacing the oldest entry if create is set.
+ * Caller must hold the result cache lock.
+ */
+static EsifUpResultCacheEntryPtr EsifUp_GetResultCacheEntry(
+	EsifUpPtr self,
+	EsifPrimitiveTuplePtr tuplePtr,
+	Bool create
+	)
+{
+	EsifUpResultCacheEntryPtr entryPtr = NULL;
+	UInt32 i = 0;
+
+	for (i = 0; i < ESIF_UP_RESULT_CACHE_SIZE; i++) {
+		if ((self->resultCache[i].sizeHint != 0) &&
+			(self->resultCache[i].tuple.id == tuplePtr->id) &&
+			(self->resultCache[i].tuple.domain == tuplePtr->domain) &&
+			(self->resultCache[i].tuple.instance == tuplePtr->instance)) {
+			entryPtr = &self->resultCache[i];
+			goto exit;
+		}
+	}
+
+	if (create) {
+		entryPtr = &self->resultCache[self->resultCacheNext];
+		self->resultCacheNext = (self->resultCacheNext + 1) % ESIF_UP_RESULT_CACHE_SIZE;
+
+		EsifUp_FreeCachedResult(entryPtr);
+		esif_ccb_memset(entryPtr, 0, sizeof(*entryPtr));
+		entryPtr->tuple = *tuplePtr;
+	}
+exit:
+	return entryPtr;
+}
+
+
+static UInt32 EsifUp_GetResultSizeHint(
+	EsifUpPtr self,
+	EsifPrimitiveTuplePtr tuplePtr
+	)
+{
+	UInt32 sizeHint = 0;
+	EsifUpResultCacheEntryPtr entryPtr = NULL;
+
+	esif_ccb_read_lock(&self->resultCacheLock);
+	entryPtr = EsifUp_GetResultCacheEntry(self, tuplePtr, ESIF_FALSE);
+	if (entryPtr != NULL) {
+		sizeHint = entryPtr->sizeHint;
+	}
+	esif_ccb_read_unlock(&self->resultCacheLock);
+	return sizeHint;
+}
+
+
+static void EsifUp_SetResultSizeHint(
+	EsifUpPtr self,
+	EsifPrimitiveTuplePtr tuplePtr,
+	UInt32 sizeHint
+	)
+{
+	EsifUpResultCacheEntryPtr entryPtr = NULL;
+
+	esif_ccb_write_lock(&self->resultCacheLock);
+	entryPtr = EsifUp_GetResultCacheEntry(self, tuplePtr, ESIF_TRUE);
+	entryPtr->sizeHint = sizeHint;
+	esif_ccb_write_unlock(&self->resultCacheLock);
+}
+
+
+/* Releases a cached result and the request data it was computed for */
+static void EsifUp_FreeCachedResult(
+	EsifUpResultCacheEntryPtr entryPtr
+	)
+{
+	esif_ccb_free(entryPtr->resultPtr);
+	entryPtr->resultPtr = NULL;
+	entryPtr->resultLen = 0;
+	esif_ccb_free(entryPtr->requestPtr);
+	entryPtr->requestPtr = NULL;
+	entryPtr->requestLen = 0;
+}
+
+
+/* Returns whether a cached result was computed for the same request data */
+static Bool EsifUp_IsCachedRequest(
+	EsifUpResultCacheEntryPtr entryPtr,
+	const EsifDataPtr requestPtr
+	)
+{
+	UInt32 requestLen = 0;
+
+	if ((requestPtr != NULL) && (requestPtr->buf_ptr != NULL)) {
+		requestLen = requestPtr->data_len;
+	}
+	if (requestLen != entryPtr->requestLen) {
+		return ESIF_FALSE;
+	}
+	return (0 == requestLen) || (0 == memcmp(entryPtr->requestPtr, requestPtr->buf_ptr, requestLen));
+}
+
+
+/*
+ * Copies a result kept by EsifUp_CacheResult to the response if it is recent, was computed
+ * for the same request data and fits.  Each result is handed out once.
+ */
+static Bool EsifUp_TakeCachedResult(
+	EsifUpPtr self,
+	EsifPrimitiveTuplePtr tuplePtr,
+	const EsifDataPtr requestPtr,
+	EsifDataPtr responsePtr
+	)
+{
+	Bool isTaken = ESIF_FALSE;
+	EsifUpResultCacheEntryPtr entryPtr = NULL;
+	esif_ccb_time_t now = 0;
+
+	esif_ccb_write_lock(&self->resultCacheLock);
+	entryPtr = EsifUp_GetResultCacheEntry(self, tuplePtr, ESIF_FALSE);
+	if ((entryPtr == NULL) || (entryPtr->resultPtr == NULL)) {
+		goto exit;
+	}
+
+	esif_ccb_system_time(&now);
+	if ((now - entryPtr->resultTime <= ESIF_UP_RESULT_CACHE_TIMEOUT) &&
+		(entryPtr->resultLen <= responsePtr->buf_len) &&
+		EsifUp_IsCachedRequest(entryPtr, requestPtr)) {
+		esif_ccb_memcpy(responsePtr->buf_ptr, entryPtr->resultPtr, entryPtr->resultLen);
+		responsePtr->type = entryPtr->resultType;
+		responsePtr->data_len = entryPtr->resultLen;
+		isTaken = ESIF_TRUE;
+	}
+
+	// Stale results are dropped rather than returned
+	if (isTaken || (now - entryPtr->resultTime > ESIF_UP_RESULT_CACHE_TIMEOUT)) {
+		EsifUp_FreeCachedResult(entryPtr);
+	}
+exit:
+	esif_ccb_write_unlock(&self->resultCacheLock);
+	return isTaken;
+}
+
+
+/*
+ * Keeps a copy of an oversize result for the caller's retry, along with the request data it
+ * was computed for since the result of a primitive may depend on its request data
+ */
+static void EsifUp_CacheResult(
+	EsifUpPtr self,
+	EsifPrimitiveTuplePtr tuplePtr,
+	const EsifDataPtr requestPtr,
+	EsifDataPtr resultPtr
+	)
+{
+	EsifUpResultCacheEntryPtr entryPtr = NULL;
+	void *bufPtr = NULL;
+	void *requestBufPtr = NULL;
+	UInt32 requestLen = 0;
+
+	if ((requestPtr != NULL) && (requestPtr->buf_ptr != NULL) && (requestPtr->data_len > 0)) {
+		requestLen = requestPtr->data_len;
+		requestBufPtr = esif_ccb_malloc(requestLen);
+		if (NULL == requestBufPtr) {
+			return;
+		}
+		esif_ccb_memcpy(requestBufPtr, requestPtr->buf_ptr, requestLen);
+	}
+
+	bufPtr = esif_ccb_malloc(resultPtr->data_len);
+	if (NULL == bufPtr) {
+		esif_ccb_free(requestBufPtr);
+		return;
+	}
+	esif_ccb_memcpy(bufPtr, resultPtr->buf_ptr, resultPtr->data_len);
+
+	esif_ccb_write_lock(&self->resultCacheLock);
+	entryPtr = EsifUp_GetResultCacheEntry(self, tuplePtr, ESIF_TRUE);
+	EsifUp_FreeCachedResult(entryPtr);
+	entryPtr->sizeHint = esif_ccb_max(entryPtr->sizeHint, resultPtr->data_len);
+	entryPtr->resultType = resultPtr->type;
+	entryPtr->resultPtr = bufPtr;
+	entryPtr->resultLen = resultPtr->data_len;
+	entryPtr->requestPtr = requestBufPtr;
+	entryPtr->requestLen = requestLen;
+	esif_ccb_system_time(&entryPtr->resultTime);
+	esif_ccb_write_unlock(&self->resultCacheLock);
+}
+
+
+static void EsifUp_DestroyResultCache(
+	EsifUpPtr self
+	)
+{
+	UInt32 i = 0;
+
+	for (i = 0; i < ESIF_UP_RESULT_CACHE_SIZE; i++) {
+		EsifUp_FreeCachedResult(&self->resultCache[i]);
+	}
+	esif_ccb_lock_uninit(&self->resultCacheLock);
+}
+
+
 /*
  * Execute Primitive
  * NOTE: This version may be called by functions within the
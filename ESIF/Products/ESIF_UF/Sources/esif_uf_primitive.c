@@ -22,6 +22,7 @@
 #include "esif_uf_trace.h"
 #include "esif_dsp.h"
 #include "esif_uf_action.h"
+#include "esif_uf_ccb_imp_spec.h"
 
 #ifdef ESIF_ATTR_OS_WINDOWS
 //
@@ -179,6 +180,52 @@ exit:
 }
 
 
+eEsifError EsifExecutePrimitiveSampleSet(
+	EsifPrimitiveSamplePtr samplesPtr,
+	const UInt32 count
+	)
+{
+	eEsifError rc = ESIF_OK;
+	EsifUpPtr upPtr = NULL;
+	UInt32 i = 0;
+
+	if (NULL == samplesPtr) {
+		rc = ESIF_E_PARAMETER_IS_NULL;
+		goto exit;
+	}
+
+	for (i = 0; i < count; i++) {
+		samplesPtr[i].rc = ESIF_E_UNSPECIFIED;
+	}
+
+	/* Let the OS-specific implementation read whatever it can in one pass */
+	esif_ccb_imp_spec_sample_set(samplesPtr, count);
+
+	/* Execute the remaining samples individually */
+	for (i = 0; i < count; i++) {
+		if (ESIF_OK == samplesPtr[i].rc) {
+			continue;
+		}
+
+		upPtr = EsifUpPm_GetAvailableParticipantByInstance(samplesPtr[i].participantId);
+		if (NULL == upPtr) {
+			samplesPtr[i].rc = ESIF_E_PARTICIPANT_NOT_FOUND;
+		}
+		else {
+			samplesPtr[i].rc = EsifUp_ExecutePrimitive(upPtr, &samplesPtr[i].tuple, NULL, samplesPtr[i].responsePtr);
+			EsifUp_PutRef(upPtr);
+			upPtr = NULL;
+		}
+
+		if ((ESIF_OK == rc) && (samplesPtr[i].rc != ESIF_OK)) {
+			rc = samplesPtr[i].rc;
+		}
+	}
+exit:
+	return rc;
+}
+
+
 eEsifError EsifPrimitiveGetDataType(
 	const esif_handle_t participantId,
 	const UInt32 primitiveId,
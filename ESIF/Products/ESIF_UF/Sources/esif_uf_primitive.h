@@ -52,6 +52,31 @@ eEsifError EsifExecutePrimitive(
 	EsifDataPtr responsePtr
 	);
 
+/*
+ * Primitive Sample
+ * One GET request within a sample set.  The caller fills in the participant,
+ * tuple and response buffer; rc is set for each sample when the set completes.
+ */
+typedef struct EsifPrimitiveSample_s {
+	esif_handle_t participantId;
+	EsifPrimitiveTuple tuple;
+	EsifDataPtr responsePtr;
+	eEsifError rc;
+} EsifPrimitiveSample, *EsifPrimitiveSamplePtr;
+
+/*
+ * Execute a set of GET primitives together
+ * Samples which can be serviced by the OS-specific implementation in a single
+ * pass (such as already open sysfs nodes) are read first; any remaining
+ * samples are executed individually through EsifExecutePrimitive.  Returns
+ * ESIF_OK if every sample succeeded, otherwise the error of the first sample
+ * that failed.
+ */
+eEsifError EsifExecutePrimitiveSampleSet(
+	EsifPrimitiveSamplePtr samplesPtr,
+	const UInt32 count
+	);
+
 Bool EsifPrimitiveVerifyOpcode(
 	const esif_handle_t participantId,
 	const UInt32 primitiveId,
@@ -147,6 +147,7 @@ extern int g_disconnectClient;	// Disconnect shell client
 int g_repeat = 1;		// Repeat N Times
 int g_repeat_delay = 0;		// Repeat Delay In ms
 extern int g_timestamp;		// Timestamp on / off?
+extern int g_resultCache;	// Reuse oversize primitive results on / off?
 char g_os[64];
 char g_illegalXmlChars[] = { '<','>','&','\0' };
 
@@ -1643,6 +1644,11 @@ static char *esif_shell_cmd_apps(EsifShellCmdPtr shell)
 		showIntro = ESIF_TRUE;
 		arg++;
 	}
+	Bool showStats = ESIF_FALSE;
+	if (argc > arg && esif_ccb_stricmp(argv[arg], "stats") == 0) {
+		showStats = ESIF_TRUE;
+		arg++;
+	}
 	char delimiter = 0;
 	if (argc > arg && (esif_ccb_stricmp(argv[arg], "delimited") == 0 || esif_ccb_stricmp(argv[arg], "tsv") == 0 || esif_ccb_stricmp(argv[arg], "bsv") == 0 || esif_ccb_stricmp(argv[arg], "csv") == 0)) {
 		if (esif_ccb_stricmp(argv[arg], "tsv") == 0) {
@@ -1711,6 +1717,18 @@ static char *esif_shell_cmd_apps(EsifShellCmdPtr shell)
 					(appPtr->isRestartable ? "plugin" : "client"),
 					(esif_string)data_version.buf_ptr);
 
+				if (showStats) {
+					EsifAppTranslationStats translationStats = { 0 };
+
+					EsifApp_GetTranslationStats(appPtr, &translationStats);
+					esif_ccb_sprintf_concat(OUT_BUF_LEN, output,
+						"   Handle Translations: %llu  Index Probes: %llu (%.2f avg)  Misses: %llu\n",
+						(unsigned long long)translationStats.translationCount,
+						(unsigned long long)translationStats.translationProbes,
+						(translationStats.translationCount ? (double)translationStats.translationProbes / (double)translationStats.translationCount : 0.0),
+						(unsigned long long)translationStats.translationMisses);
+				}
+
 				if (showIntro) {
 					u32 introBufLen = 1024;
 					esif_string introBuffer = esif_ccb_malloc(introBufLen);
@@ -1783,6 +1801,30 @@ static char *esif_shell_cmd_apps(EsifShellCmdPtr shell)
 	}
 	esif_ccb_sprintf_concat(OUT_BUF_LEN, output, "\n");
 	EsifAppMgr_PutRef(appPtr);
+
+	if (showStats && !delimiter) {
+		EsifAppMgrPartQueueStats partQueueStats = { 0 };
+
+		EsifAppMgr_GetPartQueueStats(&partQueueStats);
+		esif_ccb_sprintf_concat(OUT_BUF_LEN, output,
+			"PARTICIPANT CHANGES:\n\n"
+			"  Queued:          %u\n"
+			"  Total Queued:    %llu\n"
+			"  Coalesced:       %llu\n"
+			"  Published:       %llu\n"
+			"  Batches:         %llu\n"
+			"  Creation Waits:  %llu\n"
+			"  Average Latency: %llu ms\n"
+			"  Max Latency:     %llu ms\n\n",
+			partQueueStats.queuedCount,
+			(unsigned long long)partQueueStats.totalQueued,
+			(unsigned long long)partQueueStats.coalescedCount,
+			(unsigned long long)partQueueStats.publishedCount,
+			(unsigned long long)partQueueStats.batchCount,
+			(unsigned long long)partQueueStats.creationWaitCount,
+			(unsigned long long)partQueueStats.averageLatencyMs,
+			(unsigned long long)partQueueStats.maxLatencyMs);
+	}
 	return output;
 }
 
@@ -1894,6 +1936,23 @@ static char *esif_shell_cmd_events(EsifShellCmdPtr shell)
 	if ((rc != ESIF_OK) && ((rc != ESIF_E_ITERATION_DONE))) {
 		esif_ccb_sprintf(OUT_BUF_LEN, output, "Failed to get event data: [%s (%d)]\n", esif_rc_str(rc), rc);
 	}
+	else {
+		EsifEventQueueStats queueStats = { 0 };
+
+		EsifEventMgr_GetQueueStats(&queueStats);
+		esif_ccb_sprintf_concat(OUT_BUF_LEN, output,
+			"EVENT QUEUE:\n\n"
+			"  Slots:           %u\n"
+			"  Queued:          %u\n"
+			"  High Water Mark: %u\n"
+			"  Overflowed:      %llu\n"
+			"  Dropped:         %llu\n\n",
+			queueStats.ringSize,
+			queueStats.queuedCount,
+			queueStats.highWaterMark,
+			(unsigned long long)queueStats.overflowCount,
+			(unsigned long long)queueStats.droppedCount);
+	}
 	return output;
 }
 
@@ -6185,6 +6244,20 @@ static char *esif_shell_cmd_timestamp(EsifShellCmdPtr shell)
 }
 
 
+static char *esif_shell_cmd_resultcache(EsifShellCmdPtr shell)
+{
+	int argc     = shell->argc;
+	char **argv  = shell->argv;
+	char *output = shell->outbuf;
+
+	if (argc >= 2) {
+		g_resultCache = (strcmp(argv[1], "on") == 0);
+	}
+	esif_ccb_sprintf(OUT_BUF_LEN, output, "resultcache=%d\n", g_resultCache);
+	return output;
+}
+
+
 ///////////////////////////////////////////////////////////////////////////////
 // COMMANDS
 ///////////////////////////////////////////////////////////////////////////////
@@ -7865,6 +7938,8 @@ static char *esif_shell_cmd_help(EsifShellCmdPtr shell)
 		"                            0xde,0xad,0xbe,0xef,0xde,0xad,0xbe,0xef}\n"
 		"                                            Capabilities per APCI Spec\n"
 		"setb <buffer_size>                          Set Binary Buffer Size\n"
+		"resultcache [on|off]                        Reuse Oversize GET Results On Retry\n"
+		"                                            Instead Of Executing The Primitive Again\n"
 		"\n"
 		"rstp <id> [qualifier] [instance]            Resets/clears an override\n"
 		"\n"
@@ -7915,6 +7990,7 @@ static char *esif_shell_cmd_help(EsifShellCmdPtr shell)
 		"EVENT API:\n"
 		"event [enable|disable] <eventType> [participant] [domain]   Enable/Disable/Send a User Mode Event\n" 
 		"events [namespec] [appspec]                   Display all events registered in the Event Manager\n"
+		"                                              and the event queue statistics\n"
 		"eventkpe <eventType> <index> [u32 data]       Send Kernel Event to KPE\n"
 		"                                              index - Index of the KPE based on\n"
 		"                                              the order of driversk (0-based)\n"
@@ -7928,6 +8004,8 @@ static char *esif_shell_cmd_help(EsifShellCmdPtr shell)
 	#endif
 		"APPLICATION MANAGEMENT:\n"
 		"apps                                     List all ESIF hosted Applications\n"
+		"apps stats                               List Applications with their handle translation statistics\n"
+		"                                         and the participant change queue statistics\n"
 		"appstart   <application>                 Start an ESIF Application\n"
 		"appstop    <application>                 Stop an ESIF Application\n"
 		"appstatus  <application>                 App Status\n"
@@ -8014,6 +8092,16 @@ static char *esif_shell_cmd_help(EsifShellCmdPtr shell)
 		"                                        *If a filename is not specified, a default\n"
 		"                                        file name is used based on the timestamp;\n"
 		"                                        e.g, participant_log_2015-11-24-142412.csv.\n"
+		"participantlog "PARTICIPANTLOG_CMD_FORMAT_STR" [csv | binary | compressed]\n"
+		"                                        Sets the format of the log file. Binary\n"
+		"                                        logs only store changed values and use\n"
+		"                                        the " ESIF_PARTICIPANTLOG_BIN_EXT " extension by default.\n"
+		"                                        Compressed logs also compress each\n"
+		"                                        frame. Must be set before logging starts.\n"
+		"participantlog "PARTICIPANTLOG_CMD_DECODE_STR" <infile> [outfile]\n"
+		"                                        Converts a binary log file to CSV.\n"
+		"                                        outfile - Defaults to infile with a\n"
+		"                                        .csv extension.\n"
 		"participantlog "PARTICIPANTLOG_CMD_STOP_STR"                     Stops participant data logging if\n"
 		"                                        started already\n"
 		"\n"										  
@@ -12626,6 +12714,7 @@ static EsifShellMap ShellCommands[] = {
 	{"rem",                  fnArgv, (VoidFunc)esif_shell_cmd_rem                 },
 	{"repeat",               fnArgv, (VoidFunc)esif_shell_cmd_repeat              },
 	{"repeat_delay",         fnArgv, (VoidFunc)esif_shell_cmd_repeatdelay         },
+	{"resultcache",          fnArgv, (VoidFunc)esif_shell_cmd_resultcache         },
 	{"rstp",	             fnArgv, (VoidFunc)esif_shell_cmd_reset_override      },
 	{"rstp_part",	         fnArgv, (VoidFunc)esif_shell_cmd_reset_override },
 	{"set_osc",              fnArgv, (VoidFunc)esif_shell_cmd_set_osc             },
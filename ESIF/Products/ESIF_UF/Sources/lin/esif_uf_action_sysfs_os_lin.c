@@ -29,6 +29,9 @@
 #include "esif_participant.h"
 #include "esif_sdk_fan.h"
 #include "esif_uf_sysfs_os_lin.h"
+#include "esif_uf_rapl_sampler_os_lin.h"
+#include "esif_uf_primitive.h"
+#include "esif_uf_xform.h"
 
 #define MIN_PERF_PERCENTAGE 0
 #define MAX_SEARCH_STRING 50
@@ -169,6 +172,13 @@ struct tzPolicy {
 };
 #pragma pack(pop)
 
+struct sysfsSampleContext {
+	EsifUpPtr upPtr;	/* Reference held while the sample is pending; NULL if not serviced here */
+	int fd;
+	Int64 value;
+	Bool isRead;
+};
+
 static struct tzPolicy* tzPolicies = NULL;
 
 static int replace_str(char *str, char *old, char *new, char *rpl_buff, int rpl_buff_len);
@@ -256,6 +266,8 @@ static eEsifError ESIF_CALLCONV ActionSysfsGet(
 	struct timeval endtm = { 0 };
 	double elapsed_tm = 0;
 	u64 ret_val = 0;
+	UInt64 rapl_instant = 0;
+	UInt64 rapl_average = 0;
 	int domain_idx0 = 0;	// DTS 0
 	int domain_idx1 = 0;	// DTS 1
 	int temp_val0 = 0;
@@ -503,9 +515,30 @@ static eEsifError ESIF_CALLCONV ActionSysfsGet(
 					rc = ESIF_E_INVALID_DOMAIN_ID;
 					goto exit;
 				}
+
+				// Use the background sampler when available so the caller does not have to wait between reads
+				rc = EsifRaplSampler_GetPower(parm1, parm2, &rapl_instant, &rapl_average);
+				if (ESIF_OK == rc) {
+					*(u32 *) responsePtr->buf_ptr = (u32) rapl_instant;
+					break;
+				}
+				if (ESIF_I_AGAIN == rc) {
+					goto exit;
+				}
+				rc = ESIF_OK;
+
+				// Without a baseline the whole counter would be divided by a near-zero interval, so only record the
+				// first reading and have the caller read again after a delay
 				if (domainPtr->lastPowerTime == 0) {
+					if (SysfsGetInt64(parm1, parm2, &sysval) < SYSFS_FILE_RETRIEVAL_SUCCESS) {
+						rc = ESIF_E_PRIMITIVE_ACTION_FAILURE;
+						goto exit;
+					}
 					esif_ccb_get_time(&starttm);
 					domainPtr->lastPowerTime = (u64)(starttm.tv_sec * 1000000) + starttm.tv_usec;
+					domainPtr->lastPower = sysval;
+					rc = ESIF_I_AGAIN;
+					goto exit;
 				}
 
 				esif_ccb_get_time(&endtm);
@@ -2019,6 +2052,116 @@ exit:
 	return rc;
 }
 
+/*
+ * Read a set of GET samples in a single pass
+ * Samples whose primitive is serviced by the sysfs action and whose node is
+ * already open in the action context table are resolved first and then read
+ * back to back.  Samples that cannot be serviced here are left untouched so
+ * the caller can execute them normally, which opens their node for the next
+ * pass.
+ */
+void EsifActSysfsGetSampleSet(EsifPrimitiveSamplePtr samplesPtr, UInt32 count)
+{
+	struct sysfsSampleContext *contextsPtr = NULL;
+	EsifPrimitiveSamplePtr samplePtr = NULL;
+	EsifUpPtr upPtr = NULL;
+	EsifDspPtr dspPtr = NULL;
+	EsifFpcPrimitivePtr primitivePtr = NULL;
+	EsifFpcActionPtr fpcActionPtr = NULL;
+	struct sysfsActionHashKey key = {0};
+	size_t actionContext = 0;
+	UInt32 i = 0;
+
+	if ((NULL == samplesPtr) || (0 == count) || (NULL == actionHashTablePtr)) {
+		goto exit;
+	}
+
+	contextsPtr = (struct sysfsSampleContext *)esif_ccb_malloc(count * sizeof(*contextsPtr));
+	if (NULL == contextsPtr) {
+		goto exit;
+	}
+
+	/* Resolve each sample to the file descriptor of its sysfs node */
+	for (i = 0; i < count; i++) {
+		samplePtr = &samplesPtr[i];
+		if ((NULL == samplePtr->responsePtr) ||
+			(NULL == samplePtr->responsePtr->buf_ptr) ||
+			(ESIF_DATA_AUTO == samplePtr->responsePtr->type) ||
+			(samplePtr->responsePtr->buf_len < sizeof(u32))) {
+			continue;
+		}
+
+		upPtr = EsifUpPm_GetAvailableParticipantByInstance(samplePtr->participantId);
+		if (NULL == upPtr) {
+			continue;
+		}
+
+		/*
+		 * Only primitives whose first action is sysfs may be serviced here, as
+		 * that is the action normal execution would use for an open node.
+		 */
+		fpcActionPtr = NULL;
+		primitivePtr = NULL;
+		dspPtr = EsifUp_GetDsp(upPtr);
+		if ((dspPtr != NULL) && (dspPtr->type != NULL)) {
+			primitivePtr = dspPtr->get_primitive(dspPtr, &samplePtr->tuple);
+		}
+		if ((primitivePtr != NULL) &&
+			(ESIF_PRIMITIVE_OP_GET == primitivePtr->operation) &&
+			(primitivePtr->num_actions > 0)) {
+			fpcActionPtr = dspPtr->get_action(dspPtr, primitivePtr, 0);
+		}
+		if ((NULL == fpcActionPtr) || (fpcActionPtr->type != ESIF_ACTION_SYSFS) || (fpcActionPtr->is_kernel > 0)) {
+			EsifUp_PutRef(upPtr);
+			continue;
+		}
+
+		key.participantId = EsifUp_GetInstance(upPtr);
+		key.primitiveTuple = primitivePtr->tuple;
+		actionContext = (size_t) esif_ht_get_item(actionHashTablePtr, (u8 *)&key, sizeof(key));
+		if (!actionContext) {
+			EsifUp_PutRef(upPtr);
+			continue;
+		}
+
+		contextsPtr[i].upPtr = upPtr;
+		contextsPtr[i].fd = (int) actionContext;
+	}
+
+	/* Read all resolved nodes together */
+	for (i = 0; i < count; i++) {
+		if (contextsPtr[i].upPtr != NULL) {
+			contextsPtr[i].isRead = (SysfsGetInt64Direct(contextsPtr[i].fd, &contextsPtr[i].value) > 0);
+		}
+	}
+
+	/* Complete the samples that were read and release the participants */
+	for (i = 0; i < count; i++) {
+		if (NULL == contextsPtr[i].upPtr) {
+			continue;
+		}
+
+		samplePtr = &samplesPtr[i];
+		if (contextsPtr[i].isRead) {
+			*(u32 *) samplePtr->responsePtr->buf_ptr = (u32) contextsPtr[i].value;
+			samplePtr->responsePtr->data_len = sizeof(u32);
+			samplePtr->rc = EsifUfExecuteTransform(samplePtr->responsePtr,
+				contextsPtr[i].upPtr,
+				ESIF_ACTION_SYSFS,
+				ESIF_PRIMITIVE_OP_GET);
+		}
+		else {
+			ESIF_TRACE_WARN("Failed to read sample from action context, leaving it to be read from sysfs.\n");
+		}
+		EsifUp_PutRef(contextsPtr[i].upPtr);
+	}
+
+exit:
+	if (contextsPtr != NULL) {
+		esif_ccb_free(contextsPtr);
+	}
+}
+
 static EsifActIfaceStatic g_sysfs = {
 	eIfaceTypeAction,
 	ESIF_ACT_IFACE_VER_STATIC,
@@ -0,0 +1,312 @@
+/******************************************************************************
+** Copyright (c) 2013-2020 Intel Corporation All Rights Reserved
+**
+** Licensed under the Apache License, Version 2.0 (the "License"); you may not
+** use this file except in compliance with the License.
+**
+** You may obtain a copy of the License at
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+** WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+******************************************************************************/
+
+#define ESIF_TRACE_ID	ESIF_TRACEMODULE_LINUX
+
+#include "esif_uf.h"
+#include "esif_uf_rapl_sampler_os_lin.h"
+#include "esif_uf_reactor_os_lin.h"
+#include "esif_uf_sysfs_os_lin.h"
+
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+
+#define ESIF_RAPL_MAX_ENERGY_RANGE_NODE "max_energy_range_uj"
+
+typedef struct RaplSample_s {
+	UInt64 energy;		// Accumulated energy, corrected for counter wraparound
+	UInt64 timeUs;		// Monotonic time of the read
+} RaplSample, *RaplSamplePtr;
+
+typedef struct RaplCounter_s {
+	char path[MAX_SYSFS_PATH];
+	char node[MAX_SYSFS_FILENAME];
+	int fd;
+	UInt64 maxEnergyRange;	// Counter wraps to 0 after this value; 0 if unknown
+	UInt64 lastRawEnergy;
+	UInt64 energy;
+	RaplSample samples[ESIF_RAPL_SAMPLER_HISTORY];
+	UInt32 newest;			// Index of the newest sample
+	UInt32 count;
+} RaplCounter, *RaplCounterPtr;
+
+typedef struct RaplSampler_s {
+	Bool initialized;
+	esif_ccb_mutex_t lock;
+	int timerFd;
+	UInt32 numCounters;
+	RaplCounter counters[ESIF_RAPL_SAMPLER_MAX_COUNTERS];
+} RaplSampler;
+
+static RaplSampler g_raplSampler = { 0 };
+
+static UInt64 RaplSampler_GetTimeUs(void)
+{
+	struct timespec now = { 0 };
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((UInt64)now.tv_sec * 1000000) + ((UInt64)now.tv_nsec / 1000);
+}
+
+/* Must be called with the lock held */
+static void RaplSampler_SampleLocked(RaplCounterPtr counterPtr)
+{
+	Int64 rawEnergy = 0;
+	UInt64 delta = 0;
+	RaplSamplePtr samplePtr = NULL;
+
+	if (SysfsGetInt64Direct(counterPtr->fd, &rawEnergy) <= 0 || rawEnergy < 0) {
+		return;
+	}
+
+	if (counterPtr->count > 0) {
+		if ((UInt64)rawEnergy >= counterPtr->lastRawEnergy) {
+			delta = (UInt64)rawEnergy - counterPtr->lastRawEnergy;
+		}
+		else if (counterPtr->maxEnergyRange > counterPtr->lastRawEnergy) {
+			// The counter wrapped since the previous sample
+			delta = (counterPtr->maxEnergyRange - counterPtr->lastRawEnergy) + (UInt64)rawEnergy;
+		}
+		else {
+			// Range unknown; drop the interval rather than report a bogus value
+			counterPtr->count = 0;
+		}
+	}
+	counterPtr->lastRawEnergy = (UInt64)rawEnergy;
+	counterPtr->energy += delta;
+
+	counterPtr->newest = (counterPtr->newest + 1) % ESIF_RAPL_SAMPLER_HISTORY;
+	samplePtr = &counterPtr->samples[counterPtr->newest];
+	samplePtr->energy = counterPtr->energy;
+	samplePtr->timeUs = RaplSampler_GetTimeUs();
+	if (counterPtr->count < ESIF_RAPL_SAMPLER_HISTORY) {
+		counterPtr->count++;
+	}
+}
+
+static void RaplSampler_TimerCallback(int fd, UInt32 events, void *contextPtr)
+{
+	UInt64 expirations = 0;
+	UInt32 i = 0;
+
+	UNREFERENCED_PARAMETER(events);
+	UNREFERENCED_PARAMETER(contextPtr);
+
+	if (read(fd, &expirations, sizeof(expirations)) != sizeof(expirations)) {
+		return;
+	}
+
+	esif_ccb_mutex_lock(&g_raplSampler.lock);
+	for (i = 0; i < g_raplSampler.numCounters; i++) {
+		RaplSampler_SampleLocked(&g_raplSampler.counters[i]);
+	}
+	esif_ccb_mutex_unlock(&g_raplSampler.lock);
+}
+
+/* Returns the power between two samples in counter units per second */
+static UInt64 RaplSampler_CalcPower(RaplSamplePtr startPtr, RaplSamplePtr endPtr)
+{
+	if (endPtr->timeUs <= startPtr->timeUs) {
+		return 0;
+	}
+	return ((endPtr->energy - startPtr->energy) * 1000000) / (endPtr->timeUs - startPtr->timeUs);
+}
+
+/* Must be called with the lock held; starts the periodic timer the first time a counter is sampled */
+static eEsifError RaplSampler_ArmTimerLocked(void)
+{
+	struct itimerspec spec = { 0 };
+
+	spec.it_value.tv_nsec = ESIF_RAPL_SAMPLER_PERIOD_MS * 1000000;
+	spec.it_interval.tv_nsec = ESIF_RAPL_SAMPLER_PERIOD_MS * 1000000;
+	if (timerfd_settime(g_raplSampler.timerFd, 0, &spec, NULL) < 0) {
+		return ESIF_E_NOT_SUPPORTED;
+	}
+	return ESIF_OK;
+}
+
+/*
+ * Must be called with the lock held; starts sampling the counter if it is not
+ * sampled yet.  A new counter only has its first sample.
+ */
+static RaplCounterPtr RaplSampler_GetCounterLocked(const char *path, const char *node)
+{
+	RaplCounterPtr counterPtr = NULL;
+	char filepath[MAX_SYSFS_PATH + MAX_SYSFS_FILENAME] = { 0 };
+	Int64 maxEnergyRange = 0;
+	UInt32 i = 0;
+
+	for (i = 0; i < g_raplSampler.numCounters; i++) {
+		counterPtr = &g_raplSampler.counters[i];
+		if (!esif_ccb_strcmp(counterPtr->path, path) && !esif_ccb_strcmp(counterPtr->node, node)) {
+			return counterPtr;
+		}
+	}
+
+	if (g_raplSampler.numCounters >= ESIF_RAPL_SAMPLER_MAX_COUNTERS) {
+		return NULL;
+	}
+
+	esif_ccb_sprintf(sizeof(filepath), filepath, "%s/%s", path, node);
+	counterPtr = &g_raplSampler.counters[g_raplSampler.numCounters];
+	esif_ccb_memset(counterPtr, 0, sizeof(*counterPtr));
+	counterPtr->fd = open(filepath, O_RDONLY | O_CLOEXEC);
+	if (counterPtr->fd < 0) {
+		return NULL;
+	}
+	esif_ccb_strcpy(counterPtr->path, path, sizeof(counterPtr->path));
+	esif_ccb_strcpy(counterPtr->node, node, sizeof(counterPtr->node));
+	if (SysfsGetInt64(path, ESIF_RAPL_MAX_ENERGY_RANGE_NODE, &maxEnergyRange) > 0 && maxEnergyRange > 0) {
+		counterPtr->maxEnergyRange = (UInt64)maxEnergyRange;
+	}
+
+	if ((0 == g_raplSampler.numCounters) && (RaplSampler_ArmTimerLocked() != ESIF_OK)) {
+		close(counterPtr->fd);
+		return NULL;
+	}
+
+	g_raplSampler.numCounters++;
+	RaplSampler_SampleLocked(counterPtr);
+	return counterPtr;
+}
+
+eEsifError EsifRaplSampler_GetPower(
+	const char *path,
+	const char *node,
+	UInt64 *instantPowerPtr,
+	UInt64 *averagePowerPtr
+	)
+{
+	eEsifError rc = ESIF_OK;
+	RaplCounterPtr counterPtr = NULL;
+	RaplSamplePtr newestPtr = NULL;
+	RaplSamplePtr previousPtr = NULL;
+	RaplSamplePtr oldestPtr = NULL;
+	UInt32 newest = 0;
+
+	if ((NULL == path) || (NULL == node) || (NULL == instantPowerPtr) || (NULL == averagePowerPtr)) {
+		return ESIF_E_PARAMETER_IS_NULL;
+	}
+	if (!g_raplSampler.initialized) {
+		return ESIF_E_NOT_INITIALIZED;
+	}
+
+	esif_ccb_mutex_lock(&g_raplSampler.lock);
+
+	counterPtr = RaplSampler_GetCounterLocked(path, node);
+	if (NULL == counterPtr) {
+		rc = ESIF_E_NOT_SUPPORTED;
+		goto exit;
+	}
+
+	// A new counter is primed by waiting one sampling period for its second sample so the first request already
+	// gets a valid power.  The lock is released meanwhile since the timer callback takes it on the reactor thread.
+	if (counterPtr->count < 2) {
+		esif_ccb_mutex_unlock(&g_raplSampler.lock);
+		esif_ccb_sleep_msec(ESIF_RAPL_SAMPLER_PERIOD_MS);
+		esif_ccb_mutex_lock(&g_raplSampler.lock);
+
+		if (!g_raplSampler.initialized) {
+			rc = ESIF_E_NOT_INITIALIZED;
+			goto exit;
+		}
+		if (counterPtr->count < 2) {
+			RaplSampler_SampleLocked(counterPtr);
+		}
+	}
+	if (counterPtr->count < 2) {
+		rc = ESIF_I_AGAIN;
+		goto exit;
+	}
+
+	newest = counterPtr->newest;
+	newestPtr = &counterPtr->samples[newest];
+	previousPtr = &counterPtr->samples[(newest + ESIF_RAPL_SAMPLER_HISTORY - 1) % ESIF_RAPL_SAMPLER_HISTORY];
+	oldestPtr = &counterPtr->samples[(newest + ESIF_RAPL_SAMPLER_HISTORY - (counterPtr->count - 1)) % ESIF_RAPL_SAMPLER_HISTORY];
+
+	*instantPowerPtr = RaplSampler_CalcPower(previousPtr, newestPtr);
+	*averagePowerPtr = RaplSampler_CalcPower(oldestPtr, newestPtr);
+exit:
+	esif_ccb_mutex_unlock(&g_raplSampler.lock);
+	return rc;
+}
+
+eEsifError EsifRaplSampler_Init(void)
+{
+	eEsifError rc = ESIF_OK;
+
+	if (g_raplSampler.initialized) {
+		goto exit;
+	}
+
+	esif_ccb_mutex_init(&g_raplSampler.lock);
+	g_raplSampler.numCounters = 0;
+
+	// The timer is left disarmed until the first counter is requested since there is nothing to read until then
+	g_raplSampler.timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+	if (g_raplSampler.timerFd < 0) {
+		rc = ESIF_E_NOT_SUPPORTED;
+		goto exit;
+	}
+
+	rc = EsifReactor_AddSource(g_raplSampler.timerFd, EPOLLIN, RaplSampler_TimerCallback, NULL);
+	if (rc != ESIF_OK) {
+		goto exit;
+	}
+	g_raplSampler.initialized = ESIF_TRUE;
+exit:
+	if ((rc != ESIF_OK) && !g_raplSampler.initialized) {
+		ESIF_TRACE_WARN("Unable to start RAPL sampler; rc = %s(%d)\n", esif_rc_str(rc), rc);
+		if (g_raplSampler.timerFd >= 0) {
+			close(g_raplSampler.timerFd);
+		}
+		g_raplSampler.timerFd = -1;
+		esif_ccb_mutex_uninit(&g_raplSampler.lock);
+	}
+	return rc;
+}
+
+void EsifRaplSampler_Exit(void)
+{
+	UInt32 i = 0;
+
+	if (!g_raplSampler.initialized) {
+		return;
+	}
+
+	EsifReactor_RemoveSource(g_raplSampler.timerFd);
+	close(g_raplSampler.timerFd);
+	g_raplSampler.timerFd = -1;
+
+	esif_ccb_mutex_lock(&g_raplSampler.lock);
+	g_raplSampler.initialized = ESIF_FALSE;
+	for (i = 0; i < g_raplSampler.numCounters; i++) {
+		close(g_raplSampler.counters[i].fd);
+	}
+	g_raplSampler.numCounters = 0;
+	esif_ccb_mutex_unlock(&g_raplSampler.lock);
+
+	esif_ccb_mutex_uninit(&g_raplSampler.lock);
+}
+
+/*****************************************************************************/
+/*****************************************************************************/
+/*****************************************************************************/
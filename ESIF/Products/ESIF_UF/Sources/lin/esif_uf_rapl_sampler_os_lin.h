@@ -0,0 +1,63 @@
+/******************************************************************************
+** Copyright (c) 2013-2020 Intel Corporation All Rights Reserved
+**
+** Licensed under the Apache License, Version 2.0 (the "License"); you may not
+** use this file except in compliance with the License.
+**
+** You may obtain a copy of the License at
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+** WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+******************************************************************************/
+
+#ifndef _ESIF_UF_RAPL_SAMPLER_LIN_
+#define _ESIF_UF_RAPL_SAMPLER_LIN_
+
+#include "esif.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * RAPL energy sampler.  Energy counters (e.g. intel-rapl:0/energy_uj) are
+ * read on a fixed period from the reactor thread into a history of samples
+ * so callers can get power without waiting between two reads.  A counter is
+ * sampled from the first time its power is requested; that first request
+ * waits one sampling period for the second sample.
+ */
+#define ESIF_RAPL_SAMPLER_MAX_COUNTERS 8
+#define ESIF_RAPL_SAMPLER_PERIOD_MS 250
+#define ESIF_RAPL_SAMPLER_HISTORY 8 // Samples kept per counter; the average covers all of them
+
+eEsifError EsifRaplSampler_Init(void);
+void EsifRaplSampler_Exit(void);
+
+/*
+ * Returns the power over the last sampling period and the average power over
+ * the sample history, in counter units per second (uW for energy_uj).
+ * Returns ESIF_I_AGAIN if the counter has no usable interval, which only
+ * happens after a wraparound of a counter with an unknown range.
+ */
+eEsifError EsifRaplSampler_GetPower(
+	const char *path,
+	const char *node,
+	UInt64 *instantPowerPtr,
+	UInt64 *averagePowerPtr
+	);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	// _ESIF_UF_RAPL_SAMPLER_LIN_
+
+/*****************************************************************************/
+/*****************************************************************************/
+/*****************************************************************************/
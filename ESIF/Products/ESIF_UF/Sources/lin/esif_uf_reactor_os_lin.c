@@ -0,0 +1,320 @@
+/******************************************************************************
+** Copyright (c) 2013-2020 Intel Corporation All Rights Reserved
+**
+** Licensed under the Apache License, Version 2.0 (the "License"); you may not
+** use this file except in compliance with the License.
+**
+** You may obtain a copy of the License at
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+** WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+******************************************************************************/
+
+#define ESIF_TRACE_ID	ESIF_TRACEMODULE_LINUX
+
+#include "esif_uf.h"
+#include "esif_uf_reactor_os_lin.h"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <errno.h>
+
+#define ESIF_REACTOR_MAX_EVENTS 16
+#define ESIF_REACTOR_NO_FD (-1)
+#define ESIF_REACTOR_WAKE_TOKEN ((UInt64)-1)
+
+typedef struct EsifReactorSource_s {
+	int fd;
+	UInt32 generation;	// Incremented each time the slot is reused so stale events can be ignored
+	EsifReactorCallback callback;
+	void *contextPtr;
+} EsifReactorSource, *EsifReactorSourcePtr;
+
+typedef struct EsifReactor_s {
+	Bool initialized;
+	Bool quit;
+	int epollFd;
+	int wakeFd;
+	esif_thread_t thread;
+	esif_ccb_mutex_t sourcesLock;	// Protects the sources table
+	esif_ccb_mutex_t dispatchLock;	// Held while callbacks run; recursive so callbacks may remove sources
+	EsifReactorSource sources[ESIF_REACTOR_MAX_SOURCES];
+} EsifReactor;
+
+static EsifReactor g_reactor = { 0 };
+
+static void *ESIF_CALLCONV EsifReactor_Worker(void *ptr);
+
+static UInt64 EsifReactor_MakeToken(UInt32 slot)
+{
+	return ((UInt64)g_reactor.sources[slot].generation << 32) | slot;
+}
+
+/* Must be called with the sources lock held */
+static int EsifReactor_FindSlot(int fd)
+{
+	int slot = 0;
+
+	for (slot = 0; slot < ESIF_REACTOR_MAX_SOURCES; slot++) {
+		if (g_reactor.sources[slot].fd == fd) {
+			return slot;
+		}
+	}
+	return ESIF_REACTOR_NO_FD;
+}
+
+static void EsifReactor_Wake(void)
+{
+	UInt64 one = 1;
+
+	if (write(g_reactor.wakeFd, &one, sizeof(one)) != sizeof(one)) {
+		ESIF_TRACE_WARN("Unable to wake reactor; errno = %d\n", errno);
+	}
+}
+
+static void EsifReactor_Close(void)
+{
+	if (g_reactor.wakeFd >= 0) {
+		close(g_reactor.wakeFd);
+	}
+	if (g_reactor.epollFd >= 0) {
+		close(g_reactor.epollFd);
+	}
+	g_reactor.wakeFd = ESIF_REACTOR_NO_FD;
+	g_reactor.epollFd = ESIF_REACTOR_NO_FD;
+	esif_ccb_mutex_uninit(&g_reactor.dispatchLock);
+	esif_ccb_mutex_uninit(&g_reactor.sourcesLock);
+}
+
+eEsifError EsifReactor_Init(void)
+{
+	eEsifError rc = ESIF_OK;
+	struct epoll_event event = { 0 };
+	int slot = 0;
+
+	if (g_reactor.initialized) {
+		goto exit;
+	}
+
+	for (slot = 0; slot < ESIF_REACTOR_MAX_SOURCES; slot++) {
+		g_reactor.sources[slot].fd = ESIF_REACTOR_NO_FD;
+	}
+	esif_ccb_mutex_init(&g_reactor.sourcesLock);
+	esif_ccb_mutex_init(&g_reactor.dispatchLock);
+
+	g_reactor.epollFd = epoll_create1(EPOLL_CLOEXEC);
+	g_reactor.wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (g_reactor.epollFd < 0 || g_reactor.wakeFd < 0) {
+		ESIF_TRACE_ERROR("Unable to create reactor; errno = %d\n", errno);
+		rc = ESIF_E_NOT_SUPPORTED;
+		goto exit;
+	}
+
+	event.events = EPOLLIN;
+	event.data.u64 = ESIF_REACTOR_WAKE_TOKEN;
+	if (epoll_ctl(g_reactor.epollFd, EPOLL_CTL_ADD, g_reactor.wakeFd, &event) < 0) {
+		rc = ESIF_E_NOT_SUPPORTED;
+		goto exit;
+	}
+
+	g_reactor.quit = ESIF_FALSE;
+	g_reactor.initialized = ESIF_TRUE;
+	rc = esif_ccb_thread_create(&g_reactor.thread, EsifReactor_Worker, NULL);
+	if (rc != ESIF_OK) {
+		g_reactor.initialized = ESIF_FALSE;
+	}
+exit:
+	if ((rc != ESIF_OK) && !g_reactor.initialized) {
+		EsifReactor_Close();
+	}
+	return rc;
+}
+
+void EsifReactor_Exit(void)
+{
+	if (!g_reactor.initialized) {
+		return;
+	}
+
+	g_reactor.quit = ESIF_TRUE;
+	EsifReactor_Wake();
+	esif_ccb_thread_join(&g_reactor.thread);
+
+	esif_ccb_mutex_lock(&g_reactor.sourcesLock);
+	g_reactor.initialized = ESIF_FALSE;
+	esif_ccb_mutex_unlock(&g_reactor.sourcesLock);
+
+	EsifReactor_Close();
+}
+
+eEsifError EsifReactor_AddSource(int fd, UInt32 events, EsifReactorCallback callback, void *contextPtr)
+{
+	eEsifError rc = ESIF_OK;
+	struct epoll_event event = { 0 };
+	int slot = 0;
+
+	if ((fd < 0) || (NULL == callback)) {
+		return ESIF_E_PARAMETER_IS_NULL;
+	}
+	if (!g_reactor.initialized) {
+		return ESIF_E_NOT_INITIALIZED;
+	}
+
+	esif_ccb_mutex_lock(&g_reactor.sourcesLock);
+
+	if (EsifReactor_FindSlot(fd) != ESIF_REACTOR_NO_FD) {
+		rc = ESIF_E_IO_ALREADY_EXISTS;
+		goto exit;
+	}
+
+	slot = EsifReactor_FindSlot(ESIF_REACTOR_NO_FD);
+	if (ESIF_REACTOR_NO_FD == slot) {
+		rc = ESIF_E_MAXIMUM_CAPACITY_REACHED;
+		goto exit;
+	}
+
+	g_reactor.sources[slot].generation++;
+	event.events = events;
+	event.data.u64 = EsifReactor_MakeToken(slot);
+	if (epoll_ctl(g_reactor.epollFd, EPOLL_CTL_ADD, fd, &event) < 0) {
+		ESIF_TRACE_WARN("Unable to add fd %d to reactor; errno = %d\n", fd, errno);
+		rc = ESIF_E_INVALID_HANDLE;
+		goto exit;
+	}
+
+	g_reactor.sources[slot].fd = fd;
+	g_reactor.sources[slot].callback = callback;
+	g_reactor.sources[slot].contextPtr = contextPtr;
+exit:
+	esif_ccb_mutex_unlock(&g_reactor.sourcesLock);
+	return rc;
+}
+
+eEsifError EsifReactor_ModifySource(int fd, UInt32 events)
+{
+	eEsifError rc = ESIF_OK;
+	struct epoll_event event = { 0 };
+	int slot = 0;
+
+	if (fd < 0) {
+		return ESIF_E_PARAMETER_IS_NULL;
+	}
+	if (!g_reactor.initialized) {
+		return ESIF_E_NOT_INITIALIZED;
+	}
+
+	esif_ccb_mutex_lock(&g_reactor.sourcesLock);
+
+	slot = EsifReactor_FindSlot(fd);
+	if (ESIF_REACTOR_NO_FD == slot) {
+		rc = ESIF_E_NOT_FOUND;
+		goto exit;
+	}
+
+	event.events = events;
+	event.data.u64 = EsifReactor_MakeToken(slot);
+	if (epoll_ctl(g_reactor.epollFd, EPOLL_CTL_MOD, fd, &event) < 0) {
+		rc = ESIF_E_INVALID_HANDLE;
+	}
+exit:
+	esif_ccb_mutex_unlock(&g_reactor.sourcesLock);
+	return rc;
+}
+
+void EsifReactor_RemoveSource(int fd)
+{
+	int slot = 0;
+
+	if ((fd < 0) || !g_reactor.initialized) {
+		return;
+	}
+
+	esif_ccb_mutex_lock(&g_reactor.sourcesLock);
+	slot = EsifReactor_FindSlot(fd);
+	if (slot != ESIF_REACTOR_NO_FD) {
+		epoll_ctl(g_reactor.epollFd, EPOLL_CTL_DEL, fd, NULL);
+		g_reactor.sources[slot].fd = ESIF_REACTOR_NO_FD;
+		g_reactor.sources[slot].callback = NULL;
+		g_reactor.sources[slot].contextPtr = NULL;
+	}
+	esif_ccb_mutex_unlock(&g_reactor.sourcesLock);
+
+	// Wait for a dispatch in progress on another thread; does not block when called from a callback
+	esif_ccb_mutex_lock(&g_reactor.dispatchLock);
+	esif_ccb_mutex_unlock(&g_reactor.dispatchLock);
+}
+
+/*
+ * Wait up to timeoutMs (-1 for no timeout) and dispatch any ready sources.
+ * Each event is checked against the current table under the sources lock, so
+ * a source removed by an earlier callback in the same batch is not called.
+ */
+static void EsifReactor_RunOnce(int timeoutMs)
+{
+	struct epoll_event events[ESIF_REACTOR_MAX_EVENTS];
+	int numEvents = 0;
+	int i = 0;
+
+	numEvents = epoll_wait(g_reactor.epollFd, events, ESIF_REACTOR_MAX_EVENTS, timeoutMs);
+	if (numEvents < 0) {
+		if (errno != EINTR) {
+			ESIF_TRACE_WARN("Reactor wait failed; errno = %d\n", errno);
+		}
+		return;
+	}
+
+	esif_ccb_mutex_lock(&g_reactor.dispatchLock);
+
+	for (i = 0; i < numEvents && !g_reactor.quit; i++) {
+		EsifReactorCallback callback = NULL;
+		void *contextPtr = NULL;
+		int fd = ESIF_REACTOR_NO_FD;
+		UInt32 slot = 0;
+
+		if (ESIF_REACTOR_WAKE_TOKEN == events[i].data.u64) {
+			UInt64 count = 0;
+			if (read(g_reactor.wakeFd, &count, sizeof(count)) < 0) {
+				// Nothing to do; the wake count is only used to interrupt the wait
+			}
+			continue;
+		}
+
+		slot = (UInt32)(events[i].data.u64 & 0xFFFFFFFF);
+
+		esif_ccb_mutex_lock(&g_reactor.sourcesLock);
+		if ((slot < ESIF_REACTOR_MAX_SOURCES) &&
+			(g_reactor.sources[slot].fd != ESIF_REACTOR_NO_FD) &&
+			(EsifReactor_MakeToken(slot) == events[i].data.u64)) {
+			fd = g_reactor.sources[slot].fd;
+			callback = g_reactor.sources[slot].callback;
+			contextPtr = g_reactor.sources[slot].contextPtr;
+		}
+		esif_ccb_mutex_unlock(&g_reactor.sourcesLock);
+
+		if (callback != NULL) {
+			callback(fd, events[i].events, contextPtr);
+		}
+	}
+
+	esif_ccb_mutex_unlock(&g_reactor.dispatchLock);
+}
+
+static void *ESIF_CALLCONV EsifReactor_Worker(void *ptr)
+{
+	UNREFERENCED_PARAMETER(ptr);
+
+	while (!g_reactor.quit) {
+		EsifReactor_RunOnce(-1);
+	}
+	return NULL;
+}
+
+/*****************************************************************************/
+/*****************************************************************************/
+/*****************************************************************************/
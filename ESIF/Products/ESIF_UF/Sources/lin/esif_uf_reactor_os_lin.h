@@ -0,0 +1,59 @@
+/******************************************************************************
+** Copyright (c) 2013-2020 Intel Corporation All Rights Reserved
+**
+** Licensed under the Apache License, Version 2.0 (the "License"); you may not
+** use this file except in compliance with the License.
+**
+** You may obtain a copy of the License at
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+** WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+******************************************************************************/
+
+#ifndef _ESIF_UF_REACTOR_LIN_
+#define _ESIF_UF_REACTOR_LIN_
+
+#include "esif.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Upper framework event loop.  Sources such as the uevent socket, D-Bus and
+ * IIO buffers register a file descriptor and are dispatched from a single
+ * thread instead of each running a blocking thread of its own.  Callbacks run
+ * on the reactor thread, one at a time, and may add or remove sources.
+ */
+#define ESIF_REACTOR_MAX_SOURCES 32
+
+typedef void (*EsifReactorCallback)(int fd, UInt32 events, void *contextPtr);
+
+eEsifError EsifReactor_Init(void);
+void EsifReactor_Exit(void);
+
+/* Events are EPOLLIN, EPOLLOUT, etc.; sources are level triggered */
+eEsifError EsifReactor_AddSource(int fd, UInt32 events, EsifReactorCallback callback, void *contextPtr);
+eEsifError EsifReactor_ModifySource(int fd, UInt32 events);
+
+/*
+ * Once this returns, the callback of the source is not running and will not
+ * be called again, so its context may be released.
+ */
+void EsifReactor_RemoveSource(int fd);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	// _ESIF_UF_REACTOR_LIN_
+
+/*****************************************************************************/
+/*****************************************************************************/
+/*****************************************************************************/
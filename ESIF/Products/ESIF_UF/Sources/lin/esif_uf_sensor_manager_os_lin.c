@@ -25,6 +25,7 @@
 #include "esif_uf_eventmgr.h"
 #include "esif_uf_sensors.h"
 #include "esif_uf_sysfs_os_lin.h"
+#include "esif_uf_reactor_os_lin.h"
 
 #include <sys/socket.h>
 #include <sys/types.h>
@@ -35,8 +36,19 @@
 #include <sys/file.h>
 #include <math.h>
 #include <dirent.h>
-
-#define ESIF_IIO_SAMPLE_PERIOD 5 // In seconds
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+
+#define ESIF_IIO_SAMPLE_PERIOD 5 // In seconds; longest period between checks of sources which must be polled
+#define ESIF_IIO_MIN_POLL_PERIOD_MS 1000 // Polling period used right after a polled source has changed
+#define ESIF_IIO_BUFFER_LENGTH 16 // Number of scans the kernel holds for a buffered sensor
+#define ESIF_IIO_BUFFER_SAMPLING_FREQUENCY (1.0 / ESIF_IIO_SAMPLE_PERIOD) // In Hz; highest rate requested from buffered sensors
+#define ESIF_IIO_MAX_BUFFER_CHANNELS 3
+#define ESIF_IIO_MAX_SCAN_SIZE 64 // In bytes
+#define ESIF_IIO_DEV_PATH "/dev"
+#define ESIF_IIO_MAX_SAVED_NODES 16 // Device settings changed for buffered capture and restored afterwards
+#define ESIF_IIO_MAX_NODE_NAME 64
+#define ESIF_UEVENT_BUFFER_SIZE 4096
 #define MAX_GFORCE (9.8 * 2) // All Chromebooks accel have default -2G to 2G range
 #define MOTION_CHANGE_THRESHOLD 0.007 // Normalize threshold to declare motion state change
 #define PLAT_TYPE_CLAMSHELL_ANGLE_MIN 5
@@ -75,28 +87,57 @@ typedef struct LidAngle_s {
 	int angleRaw;
 } LidAngle, *LidAnglePtr;
 
+typedef struct IioChannel_s {
+	int *rawPtr;	// Raw value updated from each scan
+	int index;	// Position of the channel within a scan
+	UInt32 offset;	// Byte offset of the channel within a scan
+	UInt32 storageBytes;
+	UInt32 bits;
+	UInt32 shift;
+	Bool isSigned;
+	Bool isBigEndian;
+} IioChannel, *IioChannelPtr;
+
+typedef struct IioSavedNode_s {
+	char name[ESIF_IIO_MAX_NODE_NAME];	// Relative to the device directory
+	char value[IIO_STR_LEN];	// Value before buffered capture was enabled
+} IioSavedNode, *IioSavedNodePtr;
+
+typedef struct IioBuffer_s {
+	int fd;	// File descriptor for the IIO character device; only open while the buffer is enabled
+	UInt32 scanSize;
+	UInt32 numChannels;
+	IioChannel channels[ESIF_IIO_MAX_BUFFER_CHANNELS];
+	UInt32 numSavedNodes;
+	IioSavedNode savedNodes[ESIF_IIO_MAX_SAVED_NODES];
+} IioBuffer, *IioBufferPtr;
+
 /**
  * ToDo: Add definitions of gyro, pressure sensor, etc.
  */
 
 typedef struct Sensor_s {
 	SensorBase base;
+	char devName[IIO_STR_LEN];
+	IioBuffer buffer;	// Used instead of the sysfs nodes when the sensor supports buffered capture
 	union {
 		Accelerometer accel;
 		LidAngle lidAngle;
 	} data;
 } Sensor, *SensorPtr;
 
-static esif_thread_t gEsifSensorMgrThread;
 static Bool gEsifSensorMgrStarted = ESIF_FALSE;
 static const char gXRawNodeName[] = "in_accel_x_raw";
 static const char gYRawNodeName[] = "in_accel_y_raw";
 static const char gZRawNodeName[] = "in_accel_z_raw";
 static const char gAngleRawNodeName[] = "in_angl_raw";
+static const char *gAccelChannelNames[] = { "accel_x", "accel_y", "accel_z" };
+static const char *gAngleChannelNames[] = { "angl" };
 static const char gSensorBasePath[] =  "/sys/bus/iio/devices";
 static char gLidStateBasePath[] = "/proc/acpi/button/lid/LID0";
 static char gPowerSrcBasePath[] = "/sys/class/power_supply/BAT0";
 static char gDockingBasePath[] = "/sys/bus/acpi/devices/GOOG6666:00";
+static const char gDockingDevName[] = "GOOG6666";
 static const InclinometerMinMaxConfig gInclinMinMaxConfig= {
 	INCLIN_X_ORIENT_FLAT_UP_MIN,
 	INCLIN_X_ORIENT_FLAT_UP_MAX,
@@ -124,6 +165,13 @@ static int gFdPowerSrc;
 static int gFdBattCharge;
 static int gFdDocking;
 
+// Kernel uevent socket used to learn about power supply and docking changes without polling
+static int gUeventSock;
+
+// One-shot timer for the sources which must be polled, re-armed after each poll
+static int gPollTimerFd = -1;
+static UInt32 gPollPeriodMs = ESIF_IIO_MIN_POLL_PERIOD_MS;
+
 // Global variables keeping track of current x/y/z vectors and platform/display orientation/platform type
 static AccelerometerData gCurAccelData;
 static PlatformOrientation gPlatOrientation = ORIENTATION_PLAT_MAX;
@@ -135,24 +183,6 @@ static PowerSrc gPowerSrc = POWER_SRC_AC;
 static PlatformType gPlatType = PLATFORM_TYPE_INVALID;
 static int gBatteryPercentage = 0;
 
-// The SIGUSR1 handler below is the alternative
-// solution for Android where the pthread_cancel()
-// is not implemented in Android NDK
-
-/* SIGUSR1 Signal Handler */
-static void sigusr1_handler(int signum)
-{
-	pthread_exit(0);
-}
-
-/* Enable or Disable SIGTERM Handler */
-static void sigusr1_enable()
-{
-	struct sigaction action={0};
-	action.sa_handler = sigusr1_handler;
-	sigaction(SIGUSR1, &action, NULL);
-}
-
 static int IioDeviceFilter(const struct dirent *entry)
 {
 	if (esif_ccb_strstr(entry->d_name, "iio:device")) return 1;
@@ -216,6 +246,396 @@ static void LidAngleOpenFileDescriptors(SensorPtr sensorPtr, char *fullPath)
 	if (NULL == gLidAngle) gLidAngle = sensorPtr;
 }
 
+static eEsifError IioWriteNode(const char *path, const char *nodeName, const char *val)
+{
+	eEsifError rc = ESIF_OK;
+	char nodePath[MAX_PATH] = { 0 };
+	size_t valLen = esif_ccb_strlen(val, MAX_PATH);
+	int fd = 0;
+
+	esif_ccb_sprintf(MAX_PATH, nodePath, "%s/%s", path, nodeName);
+	fd = open(nodePath, O_WRONLY);
+	if (fd < 0) {
+		rc = ESIF_E_IO_OPEN_FAILED;
+		goto exit;
+	}
+
+	// Unlike SysfsSetString, the result of the write is checked since the driver may reject the value
+	if (write(fd, val, valLen) != (ssize_t)valLen) {
+		rc = ESIF_E_IO_ERROR;
+	}
+	close(fd);
+exit:
+	return rc;
+}
+
+/*
+ * Parse a scan element type such as "le:s16/16>>0" (endianness, sign,
+ * significant bits, storage bits and shift).  Only storage of up to 32 bits is
+ * supported since raw values are kept as int.
+ */
+static Bool IioParseChannelType(const char *typeStr, IioChannelPtr channelPtr)
+{
+	char endian = 0;
+	char sign = 0;
+	UInt32 storageBits = 0;
+
+	if (esif_ccb_sscanf(typeStr, "%ce:%c%u/%u>>%u",
+		&endian,
+		&sign,
+		&channelPtr->bits,
+		&storageBits,
+		&channelPtr->shift) != 5) {
+		return ESIF_FALSE;
+	}
+
+	if ((storageBits != 8 && storageBits != 16 && storageBits != 32) ||
+		(channelPtr->bits == 0) ||
+		(channelPtr->bits + channelPtr->shift > storageBits)) {
+		return ESIF_FALSE;
+	}
+
+	channelPtr->storageBytes = storageBits / 8;
+	channelPtr->isBigEndian = ('b' == endian);
+	channelPtr->isSigned = ('s' == sign);
+	return ESIF_TRUE;
+}
+
+/*
+ * The scan elements, sampling frequency and buffer length are device-global
+ * and may be shared with other consumers such as iio-sensor-proxy, so the
+ * original value of every node changed here is saved to be restored when
+ * buffered capture is disabled.  Nodes which already hold the value are not
+ * written.
+ */
+static eEsifError IioSaveAndWriteNode(IioBufferPtr bufferPtr, const char *path, const char *nodeName, const char *val)
+{
+	eEsifError rc = ESIF_OK;
+	IioSavedNodePtr savedPtr = NULL;
+
+	if (bufferPtr->numSavedNodes >= ESIF_IIO_MAX_SAVED_NODES ||
+		esif_ccb_strlen(nodeName, ESIF_IIO_MAX_NODE_NAME) >= ESIF_IIO_MAX_NODE_NAME) {
+		rc = ESIF_E_NEED_LARGER_BUFFER;
+		goto exit;
+	}
+
+	savedPtr = &bufferPtr->savedNodes[bufferPtr->numSavedNodes];
+	if (SysfsGetString((char *)path, (char *)nodeName, savedPtr->value, sizeof(savedPtr->value)) <= 0) {
+		rc = ESIF_E_IO_ERROR;
+		goto exit;
+	}
+	if (esif_ccb_strcmp(savedPtr->value, val) == 0) {
+		goto exit;
+	}
+
+	rc = IioWriteNode(path, nodeName, val);
+	if (rc == ESIF_OK) {
+		esif_ccb_strcpy(savedPtr->name, nodeName, sizeof(savedPtr->name));
+		bufferPtr->numSavedNodes++;
+	}
+exit:
+	return rc;
+}
+
+// Put back the saved settings in the reverse order they were changed; the buffer must already be disabled
+static void IioRestoreNodes(IioBufferPtr bufferPtr, const char *path)
+{
+	while (bufferPtr->numSavedNodes > 0) {
+		IioSavedNodePtr savedPtr = &bufferPtr->savedNodes[--bufferPtr->numSavedNodes];
+
+		if (IioWriteNode(path, savedPtr->name, savedPtr->value) != ESIF_OK) {
+			ESIF_TRACE_WARN("ESIF Sensor Manager: unable to restore %s/%s\n", path, savedPtr->name);
+		}
+	}
+}
+
+static Bool IioIsOwnChannelEnableNode(const char *nodeName, const char **channelNames, UInt32 numChannels)
+{
+	char enableNodeName[MAX_SYSFS_FILENAME] = { 0 };
+	UInt32 i = 0;
+
+	for (i = 0; i < numChannels; i++) {
+		esif_ccb_sprintf(sizeof(enableNodeName), enableNodeName, "in_%s_en", channelNames[i]);
+		if (0 == esif_ccb_strcmp(nodeName, enableNodeName)) {
+			return ESIF_TRUE;
+		}
+	}
+	return ESIF_FALSE;
+}
+
+/*
+ * Lay the channels out the way the IIO core packs a scan: in index order, each
+ * aligned to its own storage size, with the scan padded to the largest one.
+ */
+static void IioComputeScanLayout(IioBufferPtr bufferPtr)
+{
+	IioChannel channel = { 0 };
+	UInt32 offset = 0;
+	UInt32 largest = 1;
+	UInt32 i = 0;
+	UInt32 j = 0;
+
+	for (i = 1; i < bufferPtr->numChannels; i++) {
+		channel = bufferPtr->channels[i];
+		for (j = i; j > 0 && bufferPtr->channels[j - 1].index > channel.index; j--) {
+			bufferPtr->channels[j] = bufferPtr->channels[j - 1];
+		}
+		bufferPtr->channels[j] = channel;
+	}
+
+	for (i = 0; i < bufferPtr->numChannels; i++) {
+		UInt32 size = bufferPtr->channels[i].storageBytes;
+
+		offset = (offset + size - 1) / size * size;
+		bufferPtr->channels[i].offset = offset;
+		offset += size;
+		if (size > largest) {
+			largest = size;
+		}
+	}
+	bufferPtr->scanSize = (offset + largest - 1) / largest * largest;
+}
+
+/*
+ * Set the sampling frequency for buffered capture to the fastest rate the
+ * sensor lists that is no faster than ESIF_IIO_BUFFER_SAMPLING_FREQUENCY.
+ * Each scan wakes the poll thread, so a sensor that cannot sample that slowly
+ * (including one that rounds the rate up) is left polled rather than waking it
+ * more often than the polled sensors are checked.  Entries of range lists such
+ * as "[min step max]" are treated as rates, which still finds the minimum.
+ */
+static eEsifError IioSetSamplingFrequency(IioBufferPtr bufferPtr, const char *path)
+{
+	eEsifError rc = ESIF_OK;
+	char available[MAX_PATH] = { 0 };
+	char freqStr[IIO_STR_LEN] = { 0 };
+	char *token = NULL;
+	char *context = NULL;
+	double freq = 0.0;
+	double best = 0.0;
+
+	if (SysfsGetString((char *)path, "sampling_frequency_available", available, sizeof(available)) > 0) {
+		token = esif_ccb_strtok(available, " []\n", &context);
+		while (token != NULL) {
+			freq = strtod(token, NULL);
+			if ((freq > 0.0) && (freq <= ESIF_IIO_BUFFER_SAMPLING_FREQUENCY) && (freq > best)) {
+				best = freq;
+			}
+			token = esif_ccb_strtok(NULL, " []\n", &context);
+		}
+		if (best == 0.0) {
+			rc = ESIF_E_NOT_SUPPORTED;
+			goto exit;
+		}
+	}
+	else {
+		best = ESIF_IIO_BUFFER_SAMPLING_FREQUENCY;
+	}
+
+	esif_ccb_sprintf(sizeof(freqStr), freqStr, "%g", best);
+	rc = IioSaveAndWriteNode(bufferPtr, path, "sampling_frequency", freqStr);
+	if (rc != ESIF_OK) {
+		goto exit;
+	}
+	if ((SysfsGetString((char *)path, "sampling_frequency", freqStr, sizeof(freqStr)) <= 0) ||
+		(strtod(freqStr, NULL) > ESIF_IIO_BUFFER_SAMPLING_FREQUENCY * 1.001)) {
+		rc = ESIF_E_NOT_SUPPORTED;
+	}
+exit:
+	return rc;
+}
+
+/*
+ * Switch a sensor to buffered capture so the poll thread can wait on its
+ * character device instead of sampling the raw sysfs nodes.  The character
+ * device is opened first since the kernel only lets one consumer own it, so
+ * nothing is changed when another consumer already has the buffer.  The
+ * sensor is left in polled mode if its buffer is already in use, has no
+ * usable scan elements, cannot sample as slowly as the sensors are polled or
+ * cannot be enabled (for example because it needs a trigger), and any
+ * settings changed along the way are restored.
+ */
+static void IioBufferEnable(SensorPtr sensorPtr, const char **channelNames, int **rawPtrs, UInt32 numChannels)
+{
+	IioBufferPtr bufferPtr = NULL;
+	char fullPath[MAX_PATH + IIO_STR_LEN] = { 0 };
+	char scanPath[MAX_PATH + IIO_STR_LEN] = { 0 };
+	char nodeName[MAX_SYSFS_FILENAME] = { 0 };
+	char devPath[MAX_PATH] = { 0 };
+	char typeStr[IIO_STR_LEN] = { 0 };
+	char bufferEnable[IIO_STR_LEN] = { 0 };
+	DIR *dir = NULL;
+	struct dirent *entry = NULL;
+	Bool isOwnChannel = ESIF_FALSE;
+	Bool isEnabled = ESIF_FALSE;
+	UInt32 i = 0;
+
+	if (!sensorPtr || numChannels > ESIF_IIO_MAX_BUFFER_CHANNELS)
+		return;
+
+	bufferPtr = &sensorPtr->buffer;
+	bufferPtr->numSavedNodes = 0;
+	esif_ccb_sprintf(sizeof(fullPath), fullPath, "%s/%s", gSensorBasePath, sensorPtr->devName);
+	esif_ccb_sprintf(sizeof(scanPath), scanPath, "%s/scan_elements", fullPath);
+
+	// Fails with EBUSY while another consumer owns the buffer
+	esif_ccb_sprintf(sizeof(devPath), devPath, "%s/%s", ESIF_IIO_DEV_PATH, sensorPtr->devName);
+	bufferPtr->fd = open(devPath, O_RDONLY | O_NONBLOCK);
+	if (bufferPtr->fd < 0) {
+		bufferPtr->fd = 0;
+		goto exit;
+	}
+
+	// Leave the buffer alone if another consumer has already enabled it
+	if ((SysfsGetString(fullPath, "buffer/enable", bufferEnable, sizeof(bufferEnable)) <= 0) ||
+		(esif_ccb_strcmp(bufferEnable, "0") != 0)) {
+		goto exit;
+	}
+
+	for (i = 0; i < numChannels; i++) {
+		IioChannelPtr channelPtr = &bufferPtr->channels[i];
+
+		channelPtr->rawPtr = rawPtrs[i];
+		esif_ccb_sprintf(sizeof(nodeName), nodeName, "in_%s_type", channelNames[i]);
+		if ((SysfsGetString(scanPath, nodeName, typeStr, sizeof(typeStr)) <= 0) ||
+			!IioParseChannelType(typeStr, channelPtr)) {
+			goto exit;
+		}
+		esif_ccb_sprintf(sizeof(nodeName), nodeName, "in_%s_index", channelNames[i]);
+		if (SysfsGetInt(scanPath, nodeName, &channelPtr->index) != ESIF_OK) {
+			goto exit;
+		}
+	}
+	bufferPtr->numChannels = numChannels;
+	IioComputeScanLayout(bufferPtr);
+	if (bufferPtr->scanSize > ESIF_IIO_MAX_SCAN_SIZE) {
+		goto exit;
+	}
+
+	// Capture only the channels used here so the scan layout is known
+	dir = opendir(scanPath);
+	if (NULL == dir) {
+		goto exit;
+	}
+	while ((entry = readdir(dir)) != NULL) {
+		size_t nameLen = esif_ccb_strlen(entry->d_name, sizeof(entry->d_name));
+
+		if (nameLen < 3 || esif_ccb_strcmp(entry->d_name + nameLen - 3, "_en") != 0) {
+			continue;
+		}
+		isOwnChannel = IioIsOwnChannelEnableNode(entry->d_name, channelNames, numChannels);
+		esif_ccb_sprintf(sizeof(nodeName), nodeName, "scan_elements/%s", entry->d_name);
+		if ((IioSaveAndWriteNode(bufferPtr, fullPath, nodeName, isOwnChannel ? "1" : "0") != ESIF_OK) && isOwnChannel) {
+			goto exit;
+		}
+	}
+
+	// Stay polled unless the rate can be lowered, since the driver's default rate may be much faster than polling
+	if (IioSetSamplingFrequency(bufferPtr, fullPath) != ESIF_OK) {
+		goto exit;
+	}
+	esif_ccb_sprintf(sizeof(nodeName), nodeName, "%d", ESIF_IIO_BUFFER_LENGTH);
+	if ((IioSaveAndWriteNode(bufferPtr, fullPath, "buffer/length", nodeName) != ESIF_OK) ||
+		(IioWriteNode(fullPath, "buffer/enable", "1") != ESIF_OK)) {
+		goto exit;
+	}
+	isEnabled = ESIF_TRUE;
+	ESIF_TRACE_INFO("ESIF Sensor Manager: %s is using buffered capture\n", sensorPtr->devName);
+
+exit:
+	if (dir) {
+		closedir(dir);
+	}
+	if (bufferPtr && !isEnabled) {
+		IioRestoreNodes(bufferPtr, fullPath);
+		if (bufferPtr->fd > 0) {
+			close(bufferPtr->fd);
+		}
+		bufferPtr->fd = 0;
+		bufferPtr->numChannels = 0;
+		ESIF_TRACE_INFO("ESIF Sensor Manager: %s is polled\n", sensorPtr->devName);
+	}
+}
+
+static void IioBufferDisable(SensorPtr sensorPtr)
+{
+	char fullPath[MAX_PATH + IIO_STR_LEN] = { 0 };
+
+	if (!sensorPtr || sensorPtr->buffer.fd <= 0)
+		return;
+
+	// The character device is kept open until the settings are restored so no other consumer can take the buffer
+	esif_ccb_sprintf(sizeof(fullPath), fullPath, "%s/%s", gSensorBasePath, sensorPtr->devName);
+	IioWriteNode(fullPath, "buffer/enable", "0");
+	IioRestoreNodes(&sensorPtr->buffer, fullPath);
+
+	close(sensorPtr->buffer.fd);
+	sensorPtr->buffer.fd = 0;
+	sensorPtr->buffer.numChannels = 0;
+}
+
+static Bool IioIsBuffered(SensorPtr sensorPtr)
+{
+	return (sensorPtr && sensorPtr->buffer.fd > 0) ? ESIF_TRUE : ESIF_FALSE;
+}
+
+static int IioDecodeChannel(const UInt8 *scanPtr, IioChannelPtr channelPtr)
+{
+	UInt32 value = 0;
+	UInt32 mask = 0;
+	UInt32 i = 0;
+
+	for (i = 0; i < channelPtr->storageBytes; i++) {
+		UInt32 byteIndex = channelPtr->isBigEndian ? i : (channelPtr->storageBytes - 1 - i);
+		value = (value << 8) | scanPtr[channelPtr->offset + byteIndex];
+	}
+	value >>= channelPtr->shift;
+
+	if (channelPtr->bits < 32) {
+		mask = (1U << channelPtr->bits) - 1;
+		value &= mask;
+		if (channelPtr->isSigned && (value & (1U << (channelPtr->bits - 1)))) {
+			value |= ~mask;
+		}
+	}
+	return (int)value;
+}
+
+/*
+ * Drain the buffer of a sensor and update its raw values from the most recent
+ * scan.  Returns ESIF_TRUE if at least one complete scan was read.
+ */
+static Bool IioBufferRead(SensorPtr sensorPtr)
+{
+	IioBufferPtr bufferPtr = &sensorPtr->buffer;
+	UInt8 scans[ESIF_IIO_BUFFER_LENGTH * ESIF_IIO_MAX_SCAN_SIZE];
+	UInt8 lastScan[ESIF_IIO_MAX_SCAN_SIZE];
+	Bool isUpdated = ESIF_FALSE;
+	ssize_t bytesRead = 0;
+	UInt32 i = 0;
+
+	if (bufferPtr->scanSize == 0) {
+		return ESIF_FALSE;
+	}
+
+	// The IIO core only returns whole scans
+	while ((bytesRead = read(bufferPtr->fd, scans, sizeof(scans) / bufferPtr->scanSize * bufferPtr->scanSize)) > 0) {
+		if ((size_t)bytesRead >= bufferPtr->scanSize) {
+			esif_ccb_memcpy(lastScan,
+				&scans[((size_t)bytesRead / bufferPtr->scanSize - 1) * bufferPtr->scanSize],
+				bufferPtr->scanSize);
+			isUpdated = ESIF_TRUE;
+		}
+	}
+
+	if (isUpdated) {
+		for (i = 0; i < bufferPtr->numChannels; i++) {
+			*bufferPtr->channels[i].rawPtr = IioDecodeChannel(lastScan, &bufferPtr->channels[i]);
+		}
+	}
+	return isUpdated;
+}
+
 static void InitSensor(int index, char *devName)
 {
 	SensorPtr sensorPtr = &gSensors[index];
@@ -223,6 +643,7 @@ static void InitSensor(int index, char *devName)
 	char fullPath[MAX_PATH + IIO_STR_LEN] = { 0 };
 
 	sensorPtr->base.type = SENSOR_TYPE_NA;
+	esif_ccb_strcpy(sensorPtr->devName, devName, sizeof(sensorPtr->devName));
 
 	esif_ccb_sprintf(sizeof(fullPath), fullPath, "%s/%s", gSensorBasePath, devName);
 	if (SysfsGetString(fullPath, "name", iioSysfsNode, sizeof(iioSysfsNode)) > 0) {
@@ -241,6 +662,8 @@ static void InitSensor(int index, char *devName)
 
 static void DeinitSensor(int index)
 {
+	IioBufferDisable(&gSensors[index]);
+
 	if (SENSOR_TYPE_ACCEL == gSensors[index].base.type) {
 		int fd = gSensors[index].data.accel.fdX;
 		if (fd > 0) close(fd);
@@ -325,6 +748,76 @@ static void EsifSensorMgr_DeregisterSensors()
 	if (gFdPowerSrc > 0) close(gFdPowerSrc);
 	if (gFdBattCharge > 0) close(gFdBattCharge);
 	if (gFdDocking > 0) close(gFdDocking);
+
+	if (gUeventSock > 0) close(gUeventSock);
+	gUeventSock = 0;
+}
+
+static void EsifSensorMgr_EnableBuffers()
+{
+	SensorPtr accels[] = { gAccelLid, gAccelBase };
+	int i = 0;
+
+	for (i = 0; i < (int)ESIF_ARRAY_LEN(accels); i++) {
+		if (accels[i] && !IioIsBuffered(accels[i])) {
+			int *rawPtrs[] = {
+				&accels[i]->data.accel.xRaw,
+				&accels[i]->data.accel.yRaw,
+				&accels[i]->data.accel.zRaw
+			};
+			IioBufferEnable(accels[i], gAccelChannelNames, rawPtrs, ESIF_ARRAY_LEN(rawPtrs));
+		}
+	}
+
+	if (gLidAngle) {
+		int *rawPtrs[] = { &gLidAngle->data.lidAngle.angleRaw };
+		IioBufferEnable(gLidAngle, gAngleChannelNames, rawPtrs, ESIF_ARRAY_LEN(rawPtrs));
+	}
+}
+
+static void EsifSensorMgr_OpenUeventSocket()
+{
+	struct sockaddr_nl addr = { 0 };
+
+	// Only needed for the power supply and docking nodes
+	if (gFdPowerSrc <= 0 && gFdBattCharge <= 0 && gFdDocking <= 0)
+		return;
+
+	gUeventSock = socket(PF_NETLINK, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_KOBJECT_UEVENT);
+	if (gUeventSock < 0) {
+		gUeventSock = 0;
+		return;
+	}
+
+	// Let the kernel pick the port id; the udev listener in main.c already uses the process id
+	addr.nl_family = AF_NETLINK;
+	addr.nl_pid = 0;
+	addr.nl_groups = 1;
+	if (bind(gUeventSock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		close(gUeventSock);
+		gUeventSock = 0;
+	}
+}
+
+/*
+ * Drain pending kernel uevents, noting whether any of them were for a power
+ * supply or for the docking device.
+ */
+static void EsifSensorMgr_ProcessUevents(Bool *isPowerChangedPtr, Bool *isDockChangedPtr)
+{
+	char buffer[ESIF_UEVENT_BUFFER_SIZE + 1];
+	ssize_t len = 0;
+
+	while ((len = recv(gUeventSock, buffer, ESIF_UEVENT_BUFFER_SIZE, 0)) > 0) {
+		// The message starts with a NUL terminated "action@devpath" header
+		buffer[len] = 0;
+		if (esif_ccb_strstr(buffer, "/power_supply/")) {
+			*isPowerChangedPtr = ESIF_TRUE;
+		}
+		if (esif_ccb_strstr(buffer, gDockingDevName)) {
+			*isDockChangedPtr = ESIF_TRUE;
+		}
+	}
 }
 
 static void AccelRawUpdate(SensorPtr sensorPtr)
@@ -364,14 +857,15 @@ static AccelerometerData NormalizeAccelRawData(SensorPtr sensorPtr)
 	return data;
 };
 
-static void CheckDispPlatOrientation(SensorPtr sensorPtr)
+static Bool CheckDispPlatOrientation(SensorPtr sensorPtr)
 {
 	PlatformOrientation newPlatOrientation = ORIENTATION_PLAT_MAX;
 	DisplayOrientation newDispOrientation = ORIENTATION_DISP_MAX;
 	EsifData evtData = { 0 };
+	Bool isChanged = ESIF_FALSE;
 
 	if (!sensorPtr)
-		return;
+		return ESIF_FALSE;
 
 	AccelerometerData data = NormalizeAccelRawData(sensorPtr);
 	EsifAccelerometer_GetOrientations(
@@ -386,25 +880,29 @@ static void CheckDispPlatOrientation(SensorPtr sensorPtr)
 		ESIF_DATA_UINT32_ASSIGN(evtData, &newDispOrientation, sizeof(DisplayOrientation));
 		EsifEventMgr_SignalEvent(ESIF_HANDLE_PRIMARY_PARTICIPANT, EVENT_MGR_DOMAIN_D0, ESIF_EVENT_DISPLAY_ORIENTATION_CHANGED, &evtData);
 		gDispOrientation = newDispOrientation;
+		isChanged = ESIF_TRUE;
 	}
 
 	if (newPlatOrientation != gPlatOrientation) {
 		ESIF_DATA_UINT32_ASSIGN(evtData, &newPlatOrientation, sizeof(PlatformOrientation));
 		EsifEventMgr_SignalEvent(ESIF_HANDLE_PRIMARY_PARTICIPANT, EVENT_MGR_DOMAIN_D0, ESIF_EVENT_DEVICE_ORIENTATION_CHANGED, &evtData);
 		gPlatOrientation = newPlatOrientation;
+		isChanged = ESIF_TRUE;
 	}
+	return isChanged;
 }
 
 
-static void CheckMotionChange(SensorPtr sensorPtr)
+static Bool CheckMotionChange(SensorPtr sensorPtr)
 {
 	EsifData evtData = { 0 };
 	float delta = 0;
 	AccelerometerData data = { 0 };
 	Motion newMotionState = MOTION_OFF;
+	Bool isChanged = ESIF_FALSE;
 
 	if (!sensorPtr)
-		return;
+		return ESIF_FALSE;
 
 	data = NormalizeAccelRawData(sensorPtr);
 	delta = sqrt((data.xVal - gCurAccelData.xVal) * (data.xVal - gCurAccelData.xVal) +
@@ -418,43 +916,56 @@ static void CheckMotionChange(SensorPtr sensorPtr)
 		ESIF_DATA_UINT32_ASSIGN(evtData, &newMotionState, sizeof(UInt32));
 		EsifEventMgr_SignalEvent(ESIF_HANDLE_PRIMARY_PARTICIPANT, EVENT_MGR_DOMAIN_D0, ESIF_EVENT_MOTION_CHANGED, &evtData);
 		gInMotion = newMotionState;
+		isChanged = ESIF_TRUE;
 	}
 	gCurAccelData = data;
+	return isChanged;
 }
 
-static void CheckPlatTypeChange(SensorPtr sensorPtr)
+static Bool LidAngleRawUpdate(SensorPtr sensorPtr)
 {
-	EsifData evtData = { 0 };
-	PlatformType newPlatType = PLATFORM_TYPE_INVALID;
 	int fd = 0;
 
 	if (!sensorPtr)
-		return;
+		return ESIF_FALSE;
 
 	if (SENSOR_TYPE_LID_ANGLE != sensorPtr->base.type)
-		return;
+		return ESIF_FALSE;
 
 	fd = sensorPtr->data.lidAngle.fdAngle;
-	if (fd > 0) {
-		SysfsGetIntDirect(fd, &sensorPtr->data.lidAngle.angleRaw);
+	if (fd <= 0)
+		return ESIF_FALSE;
 
-		// We don't support tent mode yet and it will be treated as invalid
-		if (sensorPtr->data.lidAngle.angleRaw >= PLAT_TYPE_CLAMSHELL_ANGLE_MIN &&
-				sensorPtr->data.lidAngle.angleRaw < PLAT_TYPE_CLAMSHELL_ANGLE_MAX) {
-			newPlatType = PLATFORM_TYPE_CLAMSHELL;
-		} else if (sensorPtr->data.lidAngle.angleRaw >= PLAT_TYPE_TABLET_ANGLE_MIN) {
-			newPlatType = PLATFORM_TYPE_TABLET;
-		}
+	SysfsGetIntDirect(fd, &sensorPtr->data.lidAngle.angleRaw);
+	return ESIF_TRUE;
+}
 
-		if (newPlatType != gPlatType) {
-			ESIF_DATA_UINT32_ASSIGN(evtData, &newPlatType, sizeof(UInt32));
-			EsifEventMgr_SignalEvent(ESIF_HANDLE_PRIMARY_PARTICIPANT, EVENT_MGR_DOMAIN_D0, ESIF_EVENT_OS_PLATFORM_TYPE_CHANGED, &evtData);
-			gPlatType = newPlatType;
-		}
+static Bool CheckPlatTypeChange(SensorPtr sensorPtr)
+{
+	EsifData evtData = { 0 };
+	PlatformType newPlatType = PLATFORM_TYPE_INVALID;
+
+	if (!sensorPtr)
+		return ESIF_FALSE;
+
+	// We don't support tent mode yet and it will be treated as invalid
+	if (sensorPtr->data.lidAngle.angleRaw >= PLAT_TYPE_CLAMSHELL_ANGLE_MIN &&
+			sensorPtr->data.lidAngle.angleRaw < PLAT_TYPE_CLAMSHELL_ANGLE_MAX) {
+		newPlatType = PLATFORM_TYPE_CLAMSHELL;
+	} else if (sensorPtr->data.lidAngle.angleRaw >= PLAT_TYPE_TABLET_ANGLE_MIN) {
+		newPlatType = PLATFORM_TYPE_TABLET;
+	}
+
+	if (newPlatType != gPlatType) {
+		ESIF_DATA_UINT32_ASSIGN(evtData, &newPlatType, sizeof(UInt32));
+		EsifEventMgr_SignalEvent(ESIF_HANDLE_PRIMARY_PARTICIPANT, EVENT_MGR_DOMAIN_D0, ESIF_EVENT_OS_PLATFORM_TYPE_CHANGED, &evtData);
+		gPlatType = newPlatType;
+		return ESIF_TRUE;
 	}
+	return ESIF_FALSE;
 }
 
-static void CheckDockModeChange(void)
+static Bool CheckDockModeChange(void)
 {
 	DockMode dockMode = DOCK_MODE_INVALID;
 	char sysvalstring[MAX_SYSFS_STRING] = { 0 };
@@ -474,10 +985,12 @@ static void CheckDockModeChange(void)
 		ESIF_DATA_UINT32_ASSIGN(evtData, &dockMode, sizeof(UInt32));
 		EsifEventMgr_SignalEvent(ESIF_HANDLE_PRIMARY_PARTICIPANT, EVENT_MGR_DOMAIN_D0, ESIF_EVENT_OS_DOCK_MODE_CHANGED, &evtData);
 		gDockMode = dockMode;
+		return ESIF_TRUE;
 	}
+	return ESIF_FALSE;
 }
 
-static void CheckLidStateChange(void)
+static Bool CheckLidStateChange(void)
 {
 	LidState lidState = LID_STATE_CLOSED;
 	char sysvalstring[MAX_SYSFS_STRING] = { 0 };
@@ -497,10 +1010,12 @@ static void CheckLidStateChange(void)
 		ESIF_DATA_UINT32_ASSIGN(evtData, &lidState, sizeof(UInt32));
 		EsifEventMgr_SignalEvent(ESIF_HANDLE_PRIMARY_PARTICIPANT, EVENT_MGR_DOMAIN_D0, ESIF_EVENT_OS_LID_STATE_CHANGED, &evtData);
 		gLidState = lidState;
+		return ESIF_TRUE;
 	}
+	return ESIF_FALSE;
 }
 
-static void CheckPowerSrcChange(void)
+static Bool CheckPowerSrcChange(void)
 {
 	PowerSrc powerSrc = POWER_SRC_AC;
 	char sysvalstring[MAX_SYSFS_STRING] = { 0 };
@@ -520,10 +1035,12 @@ static void CheckPowerSrcChange(void)
 		ESIF_DATA_UINT32_ASSIGN(evtData, &powerSrc, sizeof(UInt32));
 		EsifEventMgr_SignalEvent(ESIF_HANDLE_PRIMARY_PARTICIPANT, EVENT_MGR_DOMAIN_D0, ESIF_EVENT_OS_POWER_SOURCE_CHANGED, &evtData);
 		gPowerSrc = powerSrc;
+		return ESIF_TRUE;
 	}
+	return ESIF_FALSE;
 }
 
-static void CheckBatteryPercentChange(void)
+static Bool CheckBatteryPercentChange(void)
 {
 	int batteryPercentage = 0;
 	char sysvalstring[MAX_SYSFS_STRING] = { 0 };
@@ -542,58 +1059,222 @@ static void CheckBatteryPercentChange(void)
 		ESIF_DATA_UINT32_ASSIGN(evtData, &batteryPercentage, sizeof(UInt32));
 		EsifEventMgr_SignalEvent(ESIF_HANDLE_PRIMARY_PARTICIPANT, EVENT_MGR_DOMAIN_D0, ESIF_EVENT_OS_BATTERY_PERCENT_CHANGED, &evtData);
 		gBatteryPercentage = batteryPercentage;
+		return ESIF_TRUE;
 	}
+	return ESIF_FALSE;
 }
 
-static void *EsifIio_Poll(void *ptr)
+/*
+ * Sources which cannot be waited on must be polled: the lid state and docking
+ * nodes, the power supply nodes when no uevent socket is available and any
+ * sensor which could not be switched to buffered capture.
+ */
+static Bool EsifSensorMgr_NeedsPolling(void)
 {
-	UNREFERENCED_PARAMETER(ptr);
+	return (gFdLidState > 0) ||
+		(gFdDocking > 0) ||
+		((gUeventSock <= 0) && (gFdPowerSrc > 0 || gFdBattCharge > 0)) ||
+		(gAccelLid && !IioIsBuffered(gAccelLid)) ||
+		(gAccelBase && !IioIsBuffered(gAccelBase)) ||
+		(gLidAngle && !IioIsBuffered(gLidAngle));
+}
 
-#ifdef ESIF_ATTR_OS_ANDROID
-	sigusr1_enable();
-#endif
+static void EsifSensorMgr_ArmPollTimer(void)
+{
+	struct itimerspec spec = { 0 };
 
-	while(gEsifSensorMgrStarted) {
-		// Update sensor values
-		if (gAccelLid) {
+	if (EsifSensorMgr_NeedsPolling()) {
+		spec.it_value.tv_sec = gPollPeriodMs / 1000;
+		spec.it_value.tv_nsec = (gPollPeriodMs % 1000) * 1000000;
+	}
+	// A zero it_value disarms the timer
+	if (timerfd_settime(gPollTimerFd, 0, &spec, NULL) < 0) {
+		ESIF_TRACE_WARN("ESIF Sensor Manager: unable to arm poll timer; errno = %d\n", errno);
+	}
+}
+
+/*
+ * Read the polled sources when a poll is due, then signal any state change
+ * caused by them or by the buffered sensors and uevents which were updated.
+ * The polling period drops to ESIF_IIO_MIN_POLL_PERIOD_MS after a change and
+ * backs off to ESIF_IIO_SAMPLE_PERIOD while nothing changes.
+ */
+static void EsifSensorMgr_ProcessChanges(
+	Bool isPollDue,
+	Bool isLidAccelUpdated,
+	Bool isBaseAccelUpdated,
+	Bool isLidAngleUpdated,
+	Bool isPowerChanged,
+	Bool isDockChanged)
+{
+	Bool isChanged = ESIF_FALSE;
+
+	// Update polled sensor values
+	if (isPollDue) {
+		if (gAccelLid && !IioIsBuffered(gAccelLid)) {
 			AccelRawUpdate(gAccelLid);
+			isLidAccelUpdated = ESIF_TRUE;
 		}
 
-		if (gAccelBase) {
+		if (gAccelBase && !IioIsBuffered(gAccelBase)) {
 			AccelRawUpdate(gAccelBase);
+			isBaseAccelUpdated = ESIF_TRUE;
 		}
 
-		// Platform and display orientation are only valid if the lid accel is present
-		if (gAccelLid) {
-			CheckDispPlatOrientation(gAccelLid);
+		if (gLidAngle && !IioIsBuffered(gLidAngle)) {
+			isLidAngleUpdated = LidAngleRawUpdate(gLidAngle);
 		}
+	}
 
-		// Motion detection
-		if (gAccelLid) {
-			CheckMotionChange(gAccelLid);
-		} else if (gAccelBase) {
-			CheckMotionChange(gAccelBase);
+	// Platform and display orientation are only valid if the lid accel is present
+	if (isLidAccelUpdated) {
+		isChanged |= CheckDispPlatOrientation(gAccelLid);
+	}
+
+	// Motion detection
+	if (gAccelLid) {
+		if (isLidAccelUpdated) {
+			isChanged |= CheckMotionChange(gAccelLid);
 		}
+	} else if (isBaseAccelUpdated) {
+		isChanged |= CheckMotionChange(gAccelBase);
+	}
+
+	// Dock mode change detection
+	if (isDockChanged || isPollDue) {
+		isChanged |= CheckDockModeChange();
+	}
+
+	// Power source and battery percent change detection
+	if (isPowerChanged || (isPollDue && gUeventSock <= 0)) {
+		isChanged |= CheckPowerSrcChange();
+		isChanged |= CheckBatteryPercentChange();
+	}
+
+	// Lid state change detection
+	if (isPollDue) {
+		isChanged |= CheckLidStateChange();
+	}
+
+	// Platform type change detection (clamshell, tablet, tent, etc.)
+	if (isLidAngleUpdated) {
+		isChanged |= CheckPlatTypeChange(gLidAngle);
+	}
+
+	if (isPollDue) {
+		if (isChanged) {
+			gPollPeriodMs = ESIF_IIO_MIN_POLL_PERIOD_MS;
+		} else {
+			gPollPeriodMs = esif_ccb_min(gPollPeriodMs * 2, ESIF_IIO_SAMPLE_PERIOD * 1000);
+		}
+	}
+}
+
+/*
+ * Reactor callbacks; these all run on the reactor thread so sensor state is
+ * never updated concurrently.
+ */
+static void EsifSensorMgr_PollTimerCallback(int fd, UInt32 events, void *contextPtr)
+{
+	UInt64 expirations = 0;
 
-		// Dock mode change detection
-		CheckDockModeChange();
+	UNREFERENCED_PARAMETER(events);
+	UNREFERENCED_PARAMETER(contextPtr);
 
-		// Power source change detection
-		CheckPowerSrcChange();
+	if (read(fd, &expirations, sizeof(expirations)) != sizeof(expirations)) {
+		return;
+	}
+	EsifSensorMgr_ProcessChanges(ESIF_TRUE, ESIF_FALSE, ESIF_FALSE, ESIF_FALSE, ESIF_FALSE, ESIF_FALSE);
+	EsifSensorMgr_ArmPollTimer();
+}
 
-		// Battery percent change detection
-		CheckBatteryPercentChange();
+static void EsifSensorMgr_UeventCallback(int fd, UInt32 events, void *contextPtr)
+{
+	Bool isPowerChanged = ESIF_FALSE;
+	Bool isDockChanged = ESIF_FALSE;
 
-		// Lid state change detection
-		CheckLidStateChange();
+	UNREFERENCED_PARAMETER(fd);
+	UNREFERENCED_PARAMETER(events);
+	UNREFERENCED_PARAMETER(contextPtr);
 
-		// Platform type change detection (clamshell, tablet, tent, etc.)
-		CheckPlatTypeChange(gLidAngle);
+	EsifSensorMgr_ProcessUevents(&isPowerChanged, &isDockChanged);
+	if (isPowerChanged || isDockChanged) {
+		EsifSensorMgr_ProcessChanges(ESIF_FALSE, ESIF_FALSE, ESIF_FALSE, ESIF_FALSE, isPowerChanged, isDockChanged);
+	}
+}
 
-		esif_ccb_sleep(ESIF_IIO_SAMPLE_PERIOD);
+static void EsifSensorMgr_BufferCallback(int fd, UInt32 events, void *contextPtr)
+{
+	SensorPtr sensorPtr = (SensorPtr)contextPtr;
+
+	// Fall back to polling if the device goes away
+	if (events & (EPOLLERR | EPOLLHUP)) {
+		EsifReactor_RemoveSource(fd);
+		IioBufferDisable(sensorPtr);
+		gPollPeriodMs = ESIF_IIO_MIN_POLL_PERIOD_MS;
+		EsifSensorMgr_ArmPollTimer();
+		return;
 	}
 
-	return NULL;
+	if (IioBufferRead(sensorPtr)) {
+		EsifSensorMgr_ProcessChanges(
+			ESIF_FALSE,
+			(sensorPtr == gAccelLid),
+			(sensorPtr == gAccelBase),
+			(sensorPtr == gLidAngle),
+			ESIF_FALSE,
+			ESIF_FALSE);
+	}
+}
+
+/*
+ * Register the buffered sensors, the uevent socket and the poll timer with the
+ * reactor.  A buffered sensor which cannot be registered is switched back to
+ * polling.
+ */
+static void EsifSensorMgr_AddSources(void)
+{
+	SensorPtr buffered[] = { gAccelLid, gAccelBase, gLidAngle };
+	int i = 0;
+
+	for (i = 0; i < (int)ESIF_ARRAY_LEN(buffered); i++) {
+		if (IioIsBuffered(buffered[i]) &&
+			(EsifReactor_AddSource(buffered[i]->buffer.fd, EPOLLIN, EsifSensorMgr_BufferCallback, buffered[i]) != ESIF_OK)) {
+			IioBufferDisable(buffered[i]);
+		}
+	}
+
+	if ((gUeventSock > 0) &&
+		(EsifReactor_AddSource(gUeventSock, EPOLLIN, EsifSensorMgr_UeventCallback, NULL) != ESIF_OK)) {
+		close(gUeventSock);
+		gUeventSock = 0;
+	}
+
+	if (gPollTimerFd >= 0) {
+		EsifReactor_AddSource(gPollTimerFd, EPOLLIN, EsifSensorMgr_PollTimerCallback, NULL);
+		EsifSensorMgr_ArmPollTimer();
+	}
+}
+
+static void EsifSensorMgr_RemoveSources(void)
+{
+	SensorPtr buffered[] = { gAccelLid, gAccelBase, gLidAngle };
+	int i = 0;
+
+	EsifReactor_RemoveSource(gPollTimerFd);
+	if (gUeventSock > 0) {
+		EsifReactor_RemoveSource(gUeventSock);
+	}
+	for (i = 0; i < (int)ESIF_ARRAY_LEN(buffered); i++) {
+		if (IioIsBuffered(buffered[i])) {
+			EsifReactor_RemoveSource(buffered[i]->buffer.fd);
+		}
+	}
+
+	if (gPollTimerFd >= 0) {
+		close(gPollTimerFd);
+		gPollTimerFd = -1;
+	}
 }
 
 static void StartEsifSensorMgr()
@@ -608,7 +1289,17 @@ static void StartEsifSensorMgr()
 
 		if (ESIF_OK == rc1 || ESIF_OK == rc2) {
 			gEsifSensorMgrStarted = ESIF_TRUE;
-			esif_ccb_thread_create(&gEsifSensorMgrThread, EsifIio_Poll, NULL);
+			gPollPeriodMs = ESIF_IIO_MIN_POLL_PERIOD_MS;
+			gPollTimerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+			if (gPollTimerFd < 0) {
+				ESIF_TRACE_WARN("ESIF Sensor Manager: unable to create poll timer; errno = %d\n", errno);
+			}
+
+			// The initial values are read from sysfs before switching sensors to buffered capture
+			EsifSensorMgr_ProcessChanges(ESIF_TRUE, ESIF_FALSE, ESIF_FALSE, ESIF_FALSE, ESIF_FALSE, ESIF_FALSE);
+			EsifSensorMgr_EnableBuffers();
+			EsifSensorMgr_OpenUeventSocket();
+			EsifSensorMgr_AddSources();
 		} else {
 			ESIF_TRACE_DEBUG("ESIF Sensor Manager: could not find any sensor, abort\n");
 		}
@@ -620,14 +1311,7 @@ static void StopEsifSensorMgr()
 	if (gEsifSensorMgrStarted) {
 		ESIF_TRACE_DEBUG("Stopping ESIF Sensor Manager...\n");
 		gEsifSensorMgrStarted = ESIF_FALSE;
-#ifdef ESIF_ATTR_OS_ANDROID
-		// Android NDK does not support pthread_cancel()
-		// Use pthread_kill() to emualte
-		pthread_kill(gEsifSensorMgrThread, SIGUSR1);
-#else
-		pthread_cancel(gEsifSensorMgrThread);
-#endif
-		esif_ccb_thread_join(&gEsifSensorMgrThread);
+		EsifSensorMgr_RemoveSources();
 		EsifSensorMgr_DeregisterSensors();
 	}
 }
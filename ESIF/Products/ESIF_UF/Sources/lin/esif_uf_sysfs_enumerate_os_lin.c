@@ -22,6 +22,8 @@
 #include "esif_dsp.h"
 #include "esif_uf_ccb_imp_spec.h"
 #include "esif_uf_sysfs_os_lin.h"
+#include "esif_ccb_file.h"
+#include "esif_ccb_thread.h"
 
 #define DEFAULT_DRIVER_NAME	""
 #define DEFAULT_DEVICE_NAME	""
@@ -46,14 +48,19 @@
 #define PARTICIPANT_FIELD_LEN 64
 #define NUM_CPU_LOCATIONS 3
 
+// Saved enumeration snapshot
+#define SYSFS_ENUM_SNAPSHOT_NAME "sysfs_enum"
+#define SYSFS_ENUM_SNAPSHOT_EXT ".snapshot"
+#define SYSFS_ENUM_SNAPSHOT_SIGNATURE 0x4D554E45 // "ENUM"
+#define SYSFS_ENUM_SNAPSHOT_VERSION 1
+#define SYSFS_FNV1A_64_OFFSET_BASIS 0xcbf29ce484222325ULL
+#define SYSFS_FNV1A_64_PRIME 0x100000001b3ULL
+
 static int g_zone_count = 0;
 const char *CPU_location[NUM_CPU_LOCATIONS] = {"0000:00:04.0", "0000:00:0b.0", "0000:00:00.1"};
 static Bool gSocParticipantFound = ESIF_FALSE;
 
 static void SysfsRegisterCustomParticipant(char *targetHID, char *targetACPIName, UInt32 pType);
-static int scanPCI(void);
-static int scanPlat(void);
-static int scanThermal(void);
 static Bool match_thermal_zone(const char *matchToName, char *participant_path);
 static enum esif_rc get_participant_name_alias(const char *ACPI_name, char *ACPI_alias);
 static eEsifError newParticipantCreate(
@@ -92,6 +99,57 @@ struct thermalZone {
 
 struct thermalZone thermalZones[MAX_PARTICIPANT_ENTRY] = { {0} };
 
+struct pciCandidate {
+	char participantPath[MAX_SYSFS_PATH];
+	char participantScope[ESIF_SCOPE_LEN];
+};
+
+struct platCandidate {
+	char participantPath[MAX_SYSFS_PATH];
+	char participantScope[ESIF_SCOPE_LEN];
+	char hid[HID_LEN];
+};
+
+// Everything read from sysfs that is needed to create the participants.  It is saved so that the next start can
+// create the participants without reading every sysfs node again.
+struct enumSnapshot {
+	UInt32 signature;
+	UInt32 version;
+	UInt32 size;
+	UInt64 fingerprint;
+	int zoneCount;
+	struct thermalZone zones[MAX_PARTICIPANT_ENTRY];
+	int pciCount;
+	struct pciCandidate pci[1]; // Only the first processor found is used
+	int platCount;
+	struct platCandidate plat[MAX_PARTICIPANT_ENTRY];
+};
+
+static esif_thread_t g_enumReconcileThread;
+static Bool g_enumReconcileStarted = ESIF_FALSE;
+
+// Names of the participants created from the last registered snapshot, so that participants a newer snapshot no longer
+// finds can be destroyed
+static char g_scannedParticipants[MAX_PARTICIPANT_ENTRY][ESIF_NAME_LEN] = { {0} };
+static int g_scannedParticipantCount = 0;
+
+void SysfsWaitForParticipantRegistration();
+static void collectEnumSnapshot(struct enumSnapshot *snapshotPtr);
+static void collectPCI(struct enumSnapshot *snapshotPtr);
+static void collectPlat(struct enumSnapshot *snapshotPtr);
+static void collectThermal(struct enumSnapshot *snapshotPtr);
+static void registerSnapshotParticipants(struct enumSnapshot *snapshotPtr);
+static void registerPCI(struct enumSnapshot *snapshotPtr);
+static void registerPlat(struct enumSnapshot *snapshotPtr);
+static void registerThermalZones(struct enumSnapshot *snapshotPtr);
+static void replaceSnapshotParticipants(struct enumSnapshot *snapshotPtr);
+static Bool isScannedParticipant(const char *name);
+static Bool isSysfsParticipant(EsifUpPtr upPtr);
+static UInt64 getSysfsFingerprint(void);
+static eEsifError loadEnumSnapshot(struct enumSnapshot *snapshotPtr);
+static void saveEnumSnapshot(struct enumSnapshot *snapshotPtr);
+static void startEnumReconcile(struct enumSnapshot *snapshotPtr);
+
 static void createParticipantsFromThermalSysfs(void)
 {
 	const struct participantInfo partInfo[] = {
@@ -147,7 +205,8 @@ void SysfsRegisterParticipants ()
 	char *spType = "IETM";
 	char *spDevicePath = "NA";
 	char *spDevice = SYSFS_DPTF_HID;
-	const esif_guid_t classGuid = ESIF_PARTICIPANT_PLAT_CLASS_GUID;
+	struct enumSnapshot *snapshotPtr = NULL;
+	UInt64 fingerprint = 0;
 
 	sysPart.version = ESIF_PARTICIPANT_VERSION;
 	sysPart.enumerator = ESIF_PARTICIPANT_ENUM_SYSFS;
@@ -161,15 +220,59 @@ void SysfsRegisterParticipants ()
 	esif_ccb_strncpy(sysPart.device_name,spDevice,PARTICIPANT_FIELD_LEN);
 	esif_ccb_sprintf(ESIF_NAME_LEN, sysPart.driver_name, "sysfs%s", ESIF_LIB_EXT);
 
+	// A reconcile left running by a previous start must not create participants while this one does
+	SysfsWaitForParticipantRegistration();
+
 	/* we forced IETM to index 0 for now because ESIF expects that */
 	EsifUpPm_RegisterParticipant(origin, &sysPart, &newInstance);
 
-	scanThermal();
-	scanPCI();
-	scanPlat();
+	snapshotPtr = (struct enumSnapshot *)esif_ccb_malloc(sizeof(*snapshotPtr));
+	if (NULL == snapshotPtr) {
+		ESIF_TRACE_ERROR("Unable to allocate sysfs enumeration snapshot\n");
+		return;
+	}
+
+	// Listing the sysfs folders is cheap compared to reading every node, so a snapshot saved by a previous start is
+	// used as long as the same nodes are present.  It is checked against the real nodes in the background.
+	fingerprint = getSysfsFingerprint();
+	if ((loadEnumSnapshot(snapshotPtr) == ESIF_OK) && (snapshotPtr->fingerprint == fingerprint)) {
+		ESIF_TRACE_INFO("Creating sysfs participants from the saved enumeration snapshot\n");
+		registerSnapshotParticipants(snapshotPtr);
+		startEnumReconcile(snapshotPtr);
+		return;
+	}
+
+	collectEnumSnapshot(snapshotPtr);
+	snapshotPtr->fingerprint = fingerprint;
+	saveEnumSnapshot(snapshotPtr);
+	registerSnapshotParticipants(snapshotPtr);
+	esif_ccb_free(snapshotPtr);
+}
 
-	// On platforms without DPTF BIOS support, the above scanPCI() and
-	// scanPlat() will not result in the creation of the SoC participant and
+void SysfsWaitForParticipantRegistration()
+{
+	// Participant creation must not continue once the managers start shutting down
+	if (g_enumReconcileStarted) {
+		esif_ccb_thread_join(&g_enumReconcileThread);
+		esif_ccb_thread_uninit(&g_enumReconcileThread);
+		g_enumReconcileStarted = ESIF_FALSE;
+	}
+}
+
+static void registerSnapshotParticipants(struct enumSnapshot *snapshotPtr)
+{
+	const esif_guid_t classGuid = ESIF_PARTICIPANT_PLAT_CLASS_GUID;
+
+	g_scannedParticipantCount = 0;
+	gSocParticipantFound = ESIF_FALSE;
+
+	// Participants are created in the same order as a serial scan so they are assigned the same instances
+	registerThermalZones(snapshotPtr);
+	registerPCI(snapshotPtr);
+	registerPlat(snapshotPtr);
+
+	// On platforms without DPTF BIOS support, the above registerPCI() and
+	// registerPlat() will not result in the creation of the SoC participant and
 	// possibly others (fan, board temperature sensor, etc.)
 	// In this case, we will manually create DPTF participants based on some
 	// commonly known types exposed in sysfs such as "x86_pkg_temp"
@@ -226,6 +329,8 @@ static eEsifError newParticipantCreate (
 	EsifParticipantIface sysPart;
 	const eEsifParticipantOrigin origin = eParticipantOriginUF;
 	esif_handle_t newInstance = ESIF_INVALID_HANDLE;
+	EsifUpPtr upPtr = NULL;
+	Bool isMoved = ESIF_FALSE;
 	int guid_element_counter = 0;
 
 	ESIF_ASSERT(NULL != classGuid);
@@ -247,90 +352,182 @@ static eEsifError newParticipantCreate (
 	esif_ccb_strncpy(sysPart.driver_name,driverName,ESIF_NAME_LEN);
 	esif_ccb_strncpy(sysPart.device_name,deviceName,ESIF_NAME_LEN);
 
+	// Registering an existing participant leaves it as it is, so one created from an older snapshot whose device has
+	// moved to another sysfs node is destroyed and created again on the new node
+	if (!isScannedParticipant(sysPart.name)) {
+		upPtr = EsifUpPm_GetAvailableParticipantByName(sysPart.name);
+		isMoved = isSysfsParticipant(upPtr) &&
+			(esif_ccb_strcmp(EsifUp_GetMetadata(upPtr)->fDevicePath, sysPart.device_path) != 0);
+		EsifUp_PutRef(upPtr);
+		if (isMoved) {
+			ESIF_TRACE_INFO("Participant %s moved to %s; creating it again\n", sysPart.name, sysPart.device_path);
+			EsifUpPm_DestroyParticipant(sysPart.name);
+		}
+	}
+
 	EsifUpPm_RegisterParticipant(origin, &sysPart, &newInstance);
 
+	// Participants that are not backed by a sysfs node cannot be made stale by a newer snapshot
+	if ((esif_ccb_strcmp(sysPart.device_path, "N/A") != 0) &&
+		(g_scannedParticipantCount < MAX_PARTICIPANT_ENTRY) && !isScannedParticipant(sysPart.name)) {
+		esif_ccb_strcpy(g_scannedParticipants[g_scannedParticipantCount], sysPart.name, ESIF_NAME_LEN);
+		g_scannedParticipantCount++;
+	}
+
 	return ESIF_OK;
 }
 
-static int scanPCI(void)
+static Bool isScannedParticipant(const char *name)
+{
+	int i = 0;
+
+	for (i = 0; i < g_scannedParticipantCount; i++) {
+		if (esif_ccb_stricmp(g_scannedParticipants[i], name) == 0) {
+			return ESIF_TRUE;
+		}
+	}
+	return ESIF_FALSE;
+}
+
+// Only participants created by this enumerator are replaced; an LF participant may have taken over the name
+static Bool isSysfsParticipant(EsifUpPtr upPtr)
+{
+	return (upPtr != NULL) && (upPtr->fOrigin == eParticipantOriginUF) &&
+		(EsifUp_GetEnumerator(upPtr) == ESIF_PARTICIPANT_ENUM_SYSFS);
+}
+
+static void *ESIF_CALLCONV collectPCIWorkerThread(void *ptr)
+{
+	collectPCI((struct enumSnapshot *)ptr);
+	return NULL;
+}
+
+static void *ESIF_CALLCONV collectPlatWorkerThread(void *ptr)
+{
+	collectPlat((struct enumSnapshot *)ptr);
+	return NULL;
+}
+
+static void collectEnumSnapshot(struct enumSnapshot *snapshotPtr)
+{
+	esif_thread_t pciThread;
+	esif_thread_t platThread;
+	Bool pciThreadStarted = ESIF_FALSE;
+	Bool platThreadStarted = ESIF_FALSE;
+
+	esif_ccb_memset(snapshotPtr, 0, sizeof(*snapshotPtr));
+	snapshotPtr->signature = SYSFS_ENUM_SNAPSHOT_SIGNATURE;
+	snapshotPtr->version = SYSFS_ENUM_SNAPSHOT_VERSION;
+	snapshotPtr->size = sizeof(*snapshotPtr);
+
+	// Each bus only fills in its own part of the snapshot, so they can be read at the same time.
+	// Fall back to reading a bus on this thread if its thread cannot be started.
+	esif_ccb_thread_init(&pciThread);
+	esif_ccb_thread_init(&platThread);
+	pciThreadStarted = (esif_ccb_thread_create(&pciThread, collectPCIWorkerThread, snapshotPtr) == ESIF_OK);
+	platThreadStarted = (esif_ccb_thread_create(&platThread, collectPlatWorkerThread, snapshotPtr) == ESIF_OK);
+
+	collectThermal(snapshotPtr);
+
+	if (pciThreadStarted) {
+		esif_ccb_thread_join(&pciThread);
+	}
+	else {
+		collectPCI(snapshotPtr);
+	}
+	if (platThreadStarted) {
+		esif_ccb_thread_join(&platThread);
+	}
+	else {
+		collectPlat(snapshotPtr);
+	}
+	esif_ccb_thread_uninit(&pciThread);
+	esif_ccb_thread_uninit(&platThread);
+}
+
+static void collectPCI(struct enumSnapshot *snapshotPtr)
 {
-	DIR *dir;
 	struct dirent **namelist;
 	int n = 0;
 	int cpu_loc_counter = 0;
-	int thermal_counter = 0;
 	char participant_path[MAX_SYSFS_PATH] = { 0 };
 	char firmware_path[MAX_SYSFS_PATH] = { 0 };
 	char participant_scope[ESIF_SCOPE_LEN] = { 0 };
-	UInt32 ptype = ESIF_PARTICIPANT_INVALID_TYPE;
-	esif_guid_t classGuid = ESIF_PARTICIPANT_CPU_CLASS_GUID;
 
-	dir = opendir(SYSFS_PCI);
-	if (!dir) {
-		ESIF_TRACE_DEBUG("No PCI sysfs\n");
-		return -1;
-	}
 	n = scandir(SYSFS_PCI, &namelist, 0, alphasort);
 	if (n < 0) {
-		//no scan
+		ESIF_TRACE_DEBUG("No PCI sysfs\n");
+		return;
 	}
-	else {
-		while (n--) {
-			if (gSocParticipantFound) goto exit_participant;
-
-			for (cpu_loc_counter = 0;cpu_loc_counter < NUM_CPU_LOCATIONS;cpu_loc_counter++) {
-				if (esif_ccb_strstr(namelist[n]->d_name, CPU_location[cpu_loc_counter]) != NULL) {
-					esif_ccb_sprintf(MAX_SYSFS_PATH, participant_path, "%s/%s", SYSFS_PCI,namelist[n]->d_name);
-					esif_ccb_sprintf(MAX_SYSFS_PATH, firmware_path, "%s/firmware_node", participant_path);
-
-					if (SysfsGetString(firmware_path,"path", participant_scope, sizeof(participant_scope)) > -1) {
-						int scope_len = esif_ccb_strlen(participant_scope,ESIF_SCOPE_LEN);
-						if (scope_len < ACPI_DEVICE_NAME_LEN) {
-							continue;
-						}
-						char *ACPI_name = participant_scope + (scope_len - ACPI_DEVICE_NAME_LEN);
-						/* map to thermal zone (try pkg thermal zone first)*/
-						for (thermal_counter=0; thermal_counter <= g_zone_count; thermal_counter++) {
-							struct thermalZone tz = (struct thermalZone)thermalZones[thermal_counter];
-							if (esif_ccb_strcmp(tz.acpiCode, ACPI_name)==0) {
-								// Re-initialize the device path to one of the thermal zones
-								esif_ccb_sprintf(MAX_SYSFS_PATH, participant_path, "%s", tz.thermalPath);
-								break;
-							}
-						}
-
-						/* map to thermal zone (try pkg thermal zone first)*/
-						newParticipantCreate(ESIF_PARTICIPANT_VERSION,
-							classGuid,
-							ESIF_PARTICIPANT_ENUM_SYSFS,
-							0x0,
-							ACPI_name,
-							ESIF_PARTICIPANT_CPU_DESC,
-							"N/A",
-							SYSFS_PROCESSOR_HID,
-							participant_path,
-							participant_scope,
-							ptype);
-						gSocParticipantFound = ESIF_TRUE;
-						break;
+
+	while (n--) {
+		// Only the first processor found is used
+		for (cpu_loc_counter = 0; (snapshotPtr->pciCount == 0) && (cpu_loc_counter < NUM_CPU_LOCATIONS); cpu_loc_counter++) {
+			if (esif_ccb_strstr(namelist[n]->d_name, CPU_location[cpu_loc_counter]) != NULL) {
+				esif_ccb_sprintf(MAX_SYSFS_PATH, participant_path, "%s/%s", SYSFS_PCI,namelist[n]->d_name);
+				esif_ccb_sprintf(MAX_SYSFS_PATH, firmware_path, "%s/firmware_node", participant_path);
+
+				if (SysfsGetString(firmware_path,"path", participant_scope, sizeof(participant_scope)) > -1) {
+					if (esif_ccb_strlen(participant_scope,ESIF_SCOPE_LEN) < ACPI_DEVICE_NAME_LEN) {
+						continue;
 					}
+					esif_ccb_strcpy(snapshotPtr->pci[0].participantPath, participant_path, MAX_SYSFS_PATH);
+					esif_ccb_strcpy(snapshotPtr->pci[0].participantScope, participant_scope, ESIF_SCOPE_LEN);
+					snapshotPtr->pciCount = 1;
 				}
 			}
+		}
+		free(namelist[n]);
+	}
+	free(namelist);
+}
 
-exit_participant:
-			free(namelist[n]);
+static void registerPCI(struct enumSnapshot *snapshotPtr)
+{
+	int thermal_counter = 0;
+	char participant_path[MAX_SYSFS_PATH] = { 0 };
+	char *participant_scope = NULL;
+	UInt32 ptype = ESIF_PARTICIPANT_INVALID_TYPE;
+	esif_guid_t classGuid = ESIF_PARTICIPANT_CPU_CLASS_GUID;
+
+	if (gSocParticipantFound || (snapshotPtr->pciCount == 0)) {
+		return;
+	}
+
+	esif_ccb_strcpy(participant_path, snapshotPtr->pci[0].participantPath, MAX_SYSFS_PATH);
+	participant_scope = snapshotPtr->pci[0].participantScope;
+	int scope_len = esif_ccb_strlen(participant_scope,ESIF_SCOPE_LEN);
+	if (scope_len < ACPI_DEVICE_NAME_LEN) {
+		return;
+	}
+	char *ACPI_name = participant_scope + (scope_len - ACPI_DEVICE_NAME_LEN);
+
+	/* map to thermal zone (try pkg thermal zone first)*/
+	for (thermal_counter=0; thermal_counter < g_zone_count; thermal_counter++) {
+		struct thermalZone tz = (struct thermalZone)thermalZones[thermal_counter];
+		if (esif_ccb_strcmp(tz.acpiCode, ACPI_name)==0) {
+			// Re-initialize the device path to one of the thermal zones
+			esif_ccb_sprintf(MAX_SYSFS_PATH, participant_path, "%s", tz.thermalPath);
+			break;
 		}
-		free(namelist);
 	}
-	closedir(dir);
 
-	return 0;
+	newParticipantCreate(ESIF_PARTICIPANT_VERSION,
+		classGuid,
+		ESIF_PARTICIPANT_ENUM_SYSFS,
+		0x0,
+		ACPI_name,
+		ESIF_PARTICIPANT_CPU_DESC,
+		"N/A",
+		SYSFS_PROCESSOR_HID,
+		participant_path,
+		participant_scope,
+		ptype);
+	gSocParticipantFound = ESIF_TRUE;
 }
 
-
-static int scanPlat(void)
+static void collectPlat(struct enumSnapshot *snapshotPtr)
 {
-	DIR *dir;
 	struct dirent **namelist;
 	int n;
 	int prefix_len = esif_ccb_strlen(DPTF_PARTICIPANT_PREFIX,ESIF_NAME_LEN);
@@ -340,136 +537,344 @@ static int scanPlat(void)
 	char firmware_path[MAX_SYSFS_PATH] = { 0 };
 	char participant_scope[ESIF_SCOPE_LEN] = { 0 };
 	char hid[HID_LEN] = { 0 };
-	UInt32 ptype = ESIF_PARTICIPANT_INVALID_TYPE;
-	esif_guid_t classGuid = ESIF_PARTICIPANT_PLAT_CLASS_GUID;
 
-	dir = opendir(SYSFS_PLATFORM);
-	if (!dir) {
-		ESIF_TRACE_DEBUG("No platform sysfs\n");
-		return -1;
-	}
 	n = scandir(SYSFS_PLATFORM, &namelist, 0, alphasort);
 	if (n < 0) {
-		//no scan
+		ESIF_TRACE_DEBUG("No platform sysfs\n");
+		return;
 	}
-	else {
-		while (n--) {
-			for (i=0;i < prefix_len;i++) {
-				if (namelist[n]->d_name[i] != dptf_prefix[i]) {
-					goto exit_participant;
-				}
-			}
 
-			esif_ccb_sprintf(MAX_SYSFS_PATH, participant_path, "%s/%s", SYSFS_PLATFORM,namelist[n]->d_name);
-			esif_ccb_sprintf(MAX_SYSFS_PATH, firmware_path, "%s/firmware_node", participant_path);
-
-			if (SysfsGetString(firmware_path,"hid", hid, sizeof(hid)) < 1) {
-				esif_ccb_strncpy(hid,SYSFS_DEFAULT_HID,HID_LEN);
+	while (n--) {
+		for (i=0;i < prefix_len;i++) {
+			if (namelist[n]->d_name[i] != dptf_prefix[i]) {
+				goto exit_participant;
 			}
+		}
+		if (snapshotPtr->platCount >= MAX_PARTICIPANT_ENTRY) {
+			goto exit_participant;
+		}
 
-			if (SysfsGetString(firmware_path,"path", participant_scope, sizeof(participant_scope)) > -1) {
-				int scope_len = esif_ccb_strlen(participant_scope,ESIF_SCOPE_LEN);
-				if (scope_len < ACPI_DEVICE_NAME_LEN) {
-					continue;
-				}
-				char *ACPI_name = participant_scope + (scope_len - ACPI_DEVICE_NAME_LEN);
-				if (esif_ccb_strcmp(ACPI_name, ACPI_DPTF)==0) {
-					// DPTF (IETM) participant has already been created prior to the scanPlat() call
-					goto exit_participant;
-				}
+		esif_ccb_sprintf(MAX_SYSFS_PATH, participant_path, "%s/%s", SYSFS_PLATFORM,namelist[n]->d_name);
+		esif_ccb_sprintf(MAX_SYSFS_PATH, firmware_path, "%s/firmware_node", participant_path);
 
-				char *ACPI_alias = NULL;
-				ACPI_alias = esif_ccb_malloc(MAX_ZONE_NAME_LEN);
-				if (ACPI_alias == NULL) {
-					//no memory
-					goto exit_participant;
-				}
+		if (SysfsGetString(firmware_path,"hid", hid, sizeof(hid)) < 1) {
+			esif_ccb_strncpy(hid,SYSFS_DEFAULT_HID,HID_LEN);
+		}
 
-				/* map to thermal zone */
-				get_participant_name_alias(ACPI_name, ACPI_alias);
-				if (match_thermal_zone(ACPI_alias, participant_path) == ESIF_TRUE) {
-					newParticipantCreate(ESIF_PARTICIPANT_VERSION,
-							classGuid,
-							ESIF_PARTICIPANT_ENUM_SYSFS,
-							0x0,
-							ACPI_name,
-							ACPI_name,
-							"N/A",
-							hid,
-							participant_path,
-							participant_scope,
-							ptype);
-				}
-				esif_ccb_free(ACPI_alias);
+		if (SysfsGetString(firmware_path,"path", participant_scope, sizeof(participant_scope)) > -1) {
+			int scope_len = esif_ccb_strlen(participant_scope,ESIF_SCOPE_LEN);
+			if (scope_len < ACPI_DEVICE_NAME_LEN) {
+				goto exit_participant;
+			}
+			char *ACPI_name = participant_scope + (scope_len - ACPI_DEVICE_NAME_LEN);
+			if (esif_ccb_strcmp(ACPI_name, ACPI_DPTF)==0) {
+				// DPTF (IETM) participant has already been created prior to the sysfs scan
+				goto exit_participant;
 			}
 
-exit_participant:
-			free(namelist[n]);
+			struct platCandidate *candidatePtr = &snapshotPtr->plat[snapshotPtr->platCount];
+			esif_ccb_strcpy(candidatePtr->participantPath, participant_path, MAX_SYSFS_PATH);
+			esif_ccb_strcpy(candidatePtr->participantScope, participant_scope, ESIF_SCOPE_LEN);
+			esif_ccb_strcpy(candidatePtr->hid, hid, HID_LEN);
+			snapshotPtr->platCount++;
 		}
-		free(namelist);
-	}
-	closedir(dir);
 
-	return 0;
+exit_participant:
+		free(namelist[n]);
+	}
+	free(namelist);
 }
 
+static void registerPlat(struct enumSnapshot *snapshotPtr)
+{
+	int candidate = 0;
+	char participant_path[MAX_SYSFS_PATH] = { 0 };
+	UInt32 ptype = ESIF_PARTICIPANT_INVALID_TYPE;
+	esif_guid_t classGuid = ESIF_PARTICIPANT_PLAT_CLASS_GUID;
+
+	for (candidate = 0; candidate < snapshotPtr->platCount; candidate++) {
+		struct platCandidate *candidatePtr = &snapshotPtr->plat[candidate];
+		int scope_len = esif_ccb_strlen(candidatePtr->participantScope,ESIF_SCOPE_LEN);
+		if (scope_len < ACPI_DEVICE_NAME_LEN) {
+			continue;
+		}
+		char *ACPI_name = candidatePtr->participantScope + (scope_len - ACPI_DEVICE_NAME_LEN);
+
+		char *ACPI_alias = NULL;
+		ACPI_alias = esif_ccb_malloc(MAX_ZONE_NAME_LEN);
+		if (ACPI_alias == NULL) {
+			//no memory
+			continue;
+		}
+
+		/* map to thermal zone */
+		esif_ccb_strcpy(participant_path, candidatePtr->participantPath, MAX_SYSFS_PATH);
+		get_participant_name_alias(ACPI_name, ACPI_alias);
+		if (match_thermal_zone(ACPI_alias, participant_path) == ESIF_TRUE) {
+			newParticipantCreate(ESIF_PARTICIPANT_VERSION,
+					classGuid,
+					ESIF_PARTICIPANT_ENUM_SYSFS,
+					0x0,
+					ACPI_name,
+					ACPI_name,
+					"N/A",
+					candidatePtr->hid,
+					participant_path,
+					candidatePtr->participantScope,
+					ptype);
+		}
+		esif_ccb_free(ACPI_alias);
+	}
+}
 
-static int scanThermal(void)
+static void collectThermal(struct enumSnapshot *snapshotPtr)
 {
-	DIR *dir;
 	struct dirent **namelist;
 	int n;
-	int thermal_counter = 0;
 
-	dir = opendir(SYSFS_THERMAL);
-	if (!dir) {
-		ESIF_TRACE_DEBUG("No thermal sysfs\n");
-		return -1;
-	}
 	n = scandir(SYSFS_THERMAL, &namelist, 0, alphasort);
 	if (n < 0) {
-		//no scan
+		ESIF_TRACE_DEBUG("No thermal sysfs\n");
+		return;
 	}
-	else {
+
+	while (n--) {
+		enum zoneType zt = THERM;
+		char target_path[MAX_SYSFS_PATH] = { 0 };
+		char acpi_name[MAX_ZONE_NAME_LEN] = { 0 };
+		char *zone_indicator = NULL;
+
+		/* find out if cooling device or thermal zone (or invalid) */
+		zone_indicator = esif_ccb_strstr(namelist[n]->d_name,"cooling_device");
+		if (zone_indicator == NULL) {
+			zone_indicator = esif_ccb_strstr(namelist[n]->d_name,"thermal_zone");
+		}
+		else {
+			zt = CDEV;
+		}
+		/* invalid directory */
+		if ((zone_indicator == NULL) || (snapshotPtr->zoneCount >= MAX_PARTICIPANT_ENTRY)) {
+			goto exit_zone;
+		}
+		esif_ccb_sprintf(MAX_SYSFS_PATH, target_path, "%s/%s", SYSFS_THERMAL,namelist[n]->d_name);
+
+		if (SysfsGetString(target_path,"type", acpi_name, sizeof(acpi_name)) > -1) {
+			// Filled in place so the snapshot can be compared byte for byte
+			struct thermalZone *tzPtr = &snapshotPtr->zones[snapshotPtr->zoneCount];
+			tzPtr->zoneType = zt;
+			esif_ccb_sprintf(MAX_ZONE_NAME_LEN,tzPtr->acpiCode,"%s",acpi_name);
+			esif_ccb_sprintf(MAX_SYSFS_PATH,tzPtr->thermalPath,"%s",target_path);
+			snapshotPtr->zoneCount++;
+		}
+
+exit_zone:
+		free(namelist[n]);
+	}
+	free(namelist);
+}
+
+static void registerThermalZones(struct enumSnapshot *snapshotPtr)
+{
+	int thermal_counter = 0;
+
+	// Zones left over from an older snapshot must not be matched
+	esif_ccb_memset(thermalZones, 0, sizeof(thermalZones));
+	for (thermal_counter = 0; thermal_counter < snapshotPtr->zoneCount; thermal_counter++) {
+		thermalZones[thermal_counter] = snapshotPtr->zones[thermal_counter];
+		thermalZones[thermal_counter].bound = ESIF_FALSE;
+	}
+	g_zone_count = snapshotPtr->zoneCount;
+}
+
+static UInt64 hashSysfsString(UInt64 hash, const char *str)
+{
+	size_t i = 0;
+
+	for (i = 0; str[i] != '\0'; i++) {
+		hash = (hash ^ (UInt8)str[i]) * SYSFS_FNV1A_64_PRIME;
+	}
+	return (hash ^ (UInt8)'/') * SYSFS_FNV1A_64_PRIME;
+}
+
+// Hashes the contents of a sysfs file without going through the open file cache, which is meant for the few nodes that
+// are polled and would otherwise be flushed by the zone types read here.
+static UInt64 hashSysfsFile(UInt64 hash, const char *path, const char *filename)
+{
+	char filepath[MAX_SYSFS_PATH] = { 0 };
+	char contents[MAX_SYSFS_PATH] = { 0 };
+	FILE *fp = NULL;
+
+	esif_ccb_sprintf(MAX_SYSFS_PATH, filepath, "%s/%s", path, filename);
+	fp = esif_ccb_fopen(filepath, FILEMODE_READ, NULL);
+	if (fp != NULL) {
+		if (fgets(contents, sizeof(contents), fp) == NULL) {
+			contents[0] = '\0';
+		}
+		esif_ccb_fclose(fp);
+	}
+	return hashSysfsString(hash, contents);
+}
+
+// FNV-1a hash of the sysfs entries that the enumeration looks at: the thermal zones and cooling devices with their types,
+// the PCI slots a processor is found at and the INT* platform devices.  Zone numbering depends on driver probe order, so
+// the zone types are hashed along with the names.  No firmware node is read; changes to those are left to the
+// background scan.
+static UInt64 getSysfsFingerprint(void)
+{
+	UInt64 hash = SYSFS_FNV1A_64_OFFSET_BASIS;
+	struct dirent **namelist;
+	char node_path[MAX_SYSFS_PATH] = { 0 };
+	int prefix_len = esif_ccb_strlen(DPTF_PARTICIPANT_PREFIX, ESIF_NAME_LEN);
+	int cpu_loc_counter = 0;
+	int n = 0;
+
+	n = scandir(SYSFS_THERMAL, &namelist, 0, alphasort);
+	if (n >= 0) {
 		while (n--) {
-			enum zoneType zt = THERM;
-			char target_path[MAX_SYSFS_PATH] = { 0 };
-			char acpi_name[MAX_ZONE_NAME_LEN] = { 0 };
-			char *zone_indicator = NULL;
-
-			/* find out if cooling device or thermal zone (or invalid) */
-			zone_indicator = esif_ccb_strstr(namelist[n]->d_name,"cooling_device");
-			if (zone_indicator == NULL) {
-				zone_indicator = esif_ccb_strstr(namelist[n]->d_name,"thermal_zone");
-			}
-			else {
-				zt = CDEV;
-			}
-			/* invalid directory */
-			if (zone_indicator == NULL) {
-				goto exit_zone;
-			}
-			esif_ccb_sprintf(MAX_SYSFS_PATH, target_path, "%s/%s", SYSFS_THERMAL,namelist[n]->d_name);
-
-			if (SysfsGetString(target_path,"type", acpi_name, sizeof(acpi_name)) > -1) {
-				struct thermalZone tz = { 0 };
-				tz.zoneType = zt;
-				esif_ccb_sprintf(MAX_ZONE_NAME_LEN,tz.acpiCode,"%s",acpi_name);
-				esif_ccb_sprintf(MAX_SYSFS_PATH,tz.thermalPath,"%s",target_path);
-				thermalZones[thermal_counter] = tz;
-				thermal_counter++;
+			if ((esif_ccb_strstr(namelist[n]->d_name, "cooling_device") != NULL) ||
+				(esif_ccb_strstr(namelist[n]->d_name, "thermal_zone") != NULL)) {
+				esif_ccb_sprintf(MAX_SYSFS_PATH, node_path, "%s/%s", SYSFS_THERMAL, namelist[n]->d_name);
+				hash = hashSysfsString(hash, namelist[n]->d_name);
+				hash = hashSysfsFile(hash, node_path, "type");
 			}
+			free(namelist[n]);
+		}
+		free(namelist);
+	}
+	hash = (hash ^ (UInt8)'\n') * SYSFS_FNV1A_64_PRIME;
 
-exit_zone:
+	// Only these slots are read by the scan, so they are looked up instead of listing every PCI device
+	for (cpu_loc_counter = 0; cpu_loc_counter < NUM_CPU_LOCATIONS; cpu_loc_counter++) {
+		esif_ccb_sprintf(MAX_SYSFS_PATH, node_path, "%s/%s", SYSFS_PCI, CPU_location[cpu_loc_counter]);
+		if (esif_ccb_file_exists(node_path)) {
+			hash = hashSysfsString(hash, CPU_location[cpu_loc_counter]);
+		}
+	}
+	hash = (hash ^ (UInt8)'\n') * SYSFS_FNV1A_64_PRIME;
+
+	n = scandir(SYSFS_PLATFORM, &namelist, 0, alphasort);
+	if (n >= 0) {
+		while (n--) {
+			if (esif_ccb_strncmp(namelist[n]->d_name, DPTF_PARTICIPANT_PREFIX, prefix_len) == 0) {
+				hash = hashSysfsString(hash, namelist[n]->d_name);
+			}
 			free(namelist[n]);
 		}
 		free(namelist);
 	}
-	closedir(dir);
+	return hash;
+}
+
+static eEsifError loadEnumSnapshot(struct enumSnapshot *snapshotPtr)
+{
+	eEsifError rc = ESIF_E_NOT_FOUND;
+	char snapshotPath[MAX_PATH] = { 0 };
+	FILE *fp = NULL;
+
+	esif_build_path(snapshotPath, sizeof(snapshotPath), ESIF_PATHTYPE_DV, SYSFS_ENUM_SNAPSHOT_NAME, SYSFS_ENUM_SNAPSHOT_EXT);
+	fp = esif_ccb_fopen(snapshotPath, FILEMODE_READ FILEMODE_BINARY, NULL);
+	if (NULL == fp) {
+		goto exit;
+	}
+
+	if ((esif_ccb_fread(snapshotPtr, sizeof(*snapshotPtr), sizeof(*snapshotPtr), 1, fp) != 1) ||
+		(snapshotPtr->signature != SYSFS_ENUM_SNAPSHOT_SIGNATURE) ||
+		(snapshotPtr->version != SYSFS_ENUM_SNAPSHOT_VERSION) ||
+		(snapshotPtr->size != sizeof(*snapshotPtr)) ||
+		(snapshotPtr->zoneCount < 0) || (snapshotPtr->zoneCount > MAX_PARTICIPANT_ENTRY) ||
+		(snapshotPtr->pciCount < 0) || (snapshotPtr->pciCount > 1) ||
+		(snapshotPtr->platCount < 0) || (snapshotPtr->platCount > MAX_PARTICIPANT_ENTRY)) {
+		rc = ESIF_E_INVALID_REQUEST_TYPE;
+		goto exit;
+	}
+	rc = ESIF_OK;
+exit:
+	if (fp) {
+		esif_ccb_fclose(fp);
+	}
+	return rc;
+}
+
+static void saveEnumSnapshot(struct enumSnapshot *snapshotPtr)
+{
+	char snapshotPath[MAX_PATH] = { 0 };
+	FILE *fp = NULL;
+
+	esif_build_path(snapshotPath, sizeof(snapshotPath), ESIF_PATHTYPE_DV, SYSFS_ENUM_SNAPSHOT_NAME, SYSFS_ENUM_SNAPSHOT_EXT);
+	fp = esif_ccb_fopen(snapshotPath, FILEMODE_WRITE FILEMODE_BINARY, NULL);
+	if (NULL == fp) {
+		ESIF_TRACE_DEBUG("Unable to save sysfs enumeration snapshot %s\n", snapshotPath);
+		return;
+	}
+	if (esif_ccb_fwrite(snapshotPtr, sizeof(*snapshotPtr), 1, fp) != 1) {
+		esif_ccb_fclose(fp);
+		esif_ccb_unlink(snapshotPath);
+		return;
+	}
+	esif_ccb_fclose(fp);
+}
+
+// Reads the sysfs nodes again after participants were created from a saved snapshot.  If they no longer match, the
+// snapshot is replaced and the participants are brought in line with the fresh scan.
+static void *ESIF_CALLCONV enumReconcileWorkerThread(void *ptr)
+{
+	struct enumSnapshot *cachedPtr = (struct enumSnapshot *)ptr;
+	struct enumSnapshot *freshPtr = NULL;
+
+	freshPtr = (struct enumSnapshot *)esif_ccb_malloc(sizeof(*freshPtr));
+	if (NULL == freshPtr) {
+		goto exit;
+	}
 
-	g_zone_count = thermal_counter;
+	collectEnumSnapshot(freshPtr);
+	freshPtr->fingerprint = cachedPtr->fingerprint;
+	if (memcmp(freshPtr, cachedPtr, sizeof(*freshPtr)) != 0) {
+		ESIF_TRACE_WARN("Sysfs enumeration snapshot is out of date; updating participants\n");
+		saveEnumSnapshot(freshPtr);
+		replaceSnapshotParticipants(freshPtr);
+	}
 
-	return 0;
+exit:
+	esif_ccb_free(freshPtr);
+	esif_ccb_free(cachedPtr);
+	return NULL;
+}
+
+// Registers the participants of a newer snapshot.  Participants whose sysfs node changed are created again on the new
+// node and those the newer snapshot no longer finds are destroyed.
+static void replaceSnapshotParticipants(struct enumSnapshot *snapshotPtr)
+{
+	char previous[MAX_PARTICIPANT_ENTRY][ESIF_NAME_LEN] = { {0} };
+	int previousCount = g_scannedParticipantCount;
+	EsifUpPtr upPtr = NULL;
+	Bool isStale = ESIF_FALSE;
+	int i = 0;
+
+	esif_ccb_memcpy(previous, g_scannedParticipants, sizeof(previous));
+	registerSnapshotParticipants(snapshotPtr);
+
+	for (i = 0; i < previousCount; i++) {
+		if (isScannedParticipant(previous[i])) {
+			continue;
+		}
+		upPtr = EsifUpPm_GetAvailableParticipantByName(previous[i]);
+		isStale = isSysfsParticipant(upPtr);
+		EsifUp_PutRef(upPtr);
+		if (isStale) {
+			ESIF_TRACE_INFO("Participant %s is no longer found in sysfs; destroying it\n", previous[i]);
+			EsifUpPm_DestroyParticipant(previous[i]);
+		}
+	}
+}
+
+static void startEnumReconcile(struct enumSnapshot *snapshotPtr)
+{
+	esif_ccb_thread_init(&g_enumReconcileThread);
+	if (esif_ccb_thread_create(&g_enumReconcileThread, enumReconcileWorkerThread, snapshotPtr) != ESIF_OK) {
+		esif_ccb_free(snapshotPtr);
+		return;
+	}
+	g_enumReconcileStarted = ESIF_TRUE;
 }
 
 static Bool match_thermal_zone(const char *matchToName, char *participant_path)
@@ -477,7 +882,7 @@ static Bool match_thermal_zone(const char *matchToName, char *participant_path)
 	int thermal_counter = 0;
 	Bool thermalZoneFound = ESIF_FALSE;
 
-	for (thermal_counter=0; thermal_counter <= g_zone_count; thermal_counter++) {
+	for (thermal_counter=0; thermal_counter < g_zone_count; thermal_counter++) {
 		struct thermalZone tz = (struct thermalZone)thermalZones[thermal_counter];
 		if (esif_ccb_strcmp(tz.acpiCode, matchToName)==0) {
 			thermalZoneFound = ESIF_TRUE;
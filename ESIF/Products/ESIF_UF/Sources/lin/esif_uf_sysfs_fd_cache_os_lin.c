@@ -0,0 +1,273 @@
+/******************************************************************************
+** Copyright (c) 2013-2020 Intel Corporation All Rights Reserved
+**
+** Licensed under the Apache License, Version 2.0 (the "License"); you may not
+** use this file except in compliance with the License.
+**
+** You may obtain a copy of the License at
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+** WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+******************************************************************************/
+
+#define ESIF_TRACE_ID	ESIF_TRACEMODULE_LINUX
+
+#include "esif_uf.h"
+#include "esif_uf_sysfs_fd_cache_os_lin.h"
+#include "esif_uf_sysfs_os_lin.h"
+
+#include <fcntl.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define SYSFS_FD_NONE (-1)
+
+/*
+ * Attributes are usually read through /sys/class or /sys/bus symlinks while
+ * remove events name the device by its canonical /sys/devices path, so each
+ * entry also keeps the resolved path that remove events are matched against.
+ */
+typedef struct SysfsFdCacheEntry_s {
+	char path[MAX_SYSFS_PATH];
+	char realPath[MAX_SYSFS_PATH];
+	u32 pathHash;
+	int fd;
+	atomic64_t lastUsed;
+} SysfsFdCacheEntry, *SysfsFdCacheEntryPtr;
+
+static struct {
+	u8 initialized;
+	esif_ccb_lock_t lock;
+	atomic64_t useCounter;
+	char sysfsRoot[MAX_SYSFS_PATH];
+	SysfsFdCacheEntry entries[ESIF_SYSFS_FD_CACHE_SIZE];
+} g_sysfsFdCache;
+
+static void EsifSysfsFdCache_CloseEntry(SysfsFdCacheEntryPtr entryPtr)
+{
+	if (entryPtr->fd != SYSFS_FD_NONE) {
+		close(entryPtr->fd);
+		entryPtr->fd = SYSFS_FD_NONE;
+		entryPtr->path[0] = 0;
+		entryPtr->realPath[0] = 0;
+		entryPtr->pathHash = 0;
+	}
+}
+
+/* FNV-1a hash of the path so most lookups compare a single integer */
+static u32 EsifSysfsFdCache_Hash(const char *path)
+{
+	u32 hash = 2166136261U;
+
+	while (*path) {
+		hash ^= (u8)*path++;
+		hash *= 16777619U;
+	}
+	return hash;
+}
+
+/* Caller must hold the cache lock */
+static SysfsFdCacheEntryPtr EsifSysfsFdCache_Find(const char *path, u32 pathHash)
+{
+	int i = 0;
+
+	for (i = 0; i < ESIF_SYSFS_FD_CACHE_SIZE; i++) {
+		SysfsFdCacheEntryPtr entryPtr = &g_sysfsFdCache.entries[i];
+		if ((entryPtr->fd != SYSFS_FD_NONE) &&
+			(entryPtr->pathHash == pathHash) &&
+			(esif_ccb_strcmp(entryPtr->path, path) == 0)) {
+			return entryPtr;
+		}
+	}
+	return NULL;
+}
+
+/* Keeps fd open in the cache, closing the least recently used descriptor if the cache is full */
+static void EsifSysfsFdCache_Insert(const char *path, u32 pathHash, int fd)
+{
+	SysfsFdCacheEntryPtr entryPtr = NULL;
+	SysfsFdCacheEntryPtr lruEntryPtr = NULL;
+	char resolved[PATH_MAX] = { 0 };
+	int i = 0;
+
+	// Resolved outside the lock since it walks every symlink in the path
+	if (realpath(path, resolved) == NULL) {
+		esif_ccb_strcpy(resolved, path, sizeof(resolved));
+	}
+
+	esif_ccb_write_lock(&g_sysfsFdCache.lock);
+
+	if (!g_sysfsFdCache.initialized || (EsifSysfsFdCache_Find(path, pathHash) != NULL)) {
+		// Another thread cached the same file first
+		close(fd);
+		goto exit;
+	}
+
+	for (i = 0; i < ESIF_SYSFS_FD_CACHE_SIZE; i++) {
+		entryPtr = &g_sysfsFdCache.entries[i];
+		if (entryPtr->fd == SYSFS_FD_NONE) {
+			lruEntryPtr = entryPtr;
+			break;
+		}
+		if ((lruEntryPtr == NULL) || (atomic64_read(&entryPtr->lastUsed) < atomic64_read(&lruEntryPtr->lastUsed))) {
+			lruEntryPtr = entryPtr;
+		}
+	}
+
+	EsifSysfsFdCache_CloseEntry(lruEntryPtr);
+	esif_ccb_strcpy(lruEntryPtr->path, path, sizeof(lruEntryPtr->path));
+	esif_ccb_strcpy(lruEntryPtr->realPath, resolved, sizeof(lruEntryPtr->realPath));
+	lruEntryPtr->pathHash = pathHash;
+	lruEntryPtr->fd = fd;
+	atomic64_set(&lruEntryPtr->lastUsed, atomic64_inc(&g_sysfsFdCache.useCounter));
+
+exit:
+	esif_ccb_write_unlock(&g_sysfsFdCache.lock);
+}
+
+/* Closes every cached descriptor whose resolved path is devicePath or below it */
+static void EsifSysfsFdCache_InvalidateDevice(const char *devicePath)
+{
+	size_t prefixLen = esif_ccb_strlen(devicePath, MAX_SYSFS_PATH);
+	int i = 0;
+
+	if (!g_sysfsFdCache.initialized) {
+		return;
+	}
+
+	esif_ccb_write_lock(&g_sysfsFdCache.lock);
+	for (i = 0; i < ESIF_SYSFS_FD_CACHE_SIZE; i++) {
+		SysfsFdCacheEntryPtr entryPtr = &g_sysfsFdCache.entries[i];
+		if ((entryPtr->fd != SYSFS_FD_NONE) &&
+			(esif_ccb_strncmp(entryPtr->realPath, devicePath, prefixLen) == 0) &&
+			((entryPtr->realPath[prefixLen] == '/') || (entryPtr->realPath[prefixLen] == 0))) {
+			EsifSysfsFdCache_CloseEntry(entryPtr);
+		}
+	}
+	esif_ccb_write_unlock(&g_sysfsFdCache.lock);
+}
+
+static void EsifSysfsFdCache_InvalidateEntry(const char *path, u32 pathHash)
+{
+	SysfsFdCacheEntryPtr entryPtr = NULL;
+
+	esif_ccb_write_lock(&g_sysfsFdCache.lock);
+	entryPtr = EsifSysfsFdCache_Find(path, pathHash);
+	if (entryPtr != NULL) {
+		EsifSysfsFdCache_CloseEntry(entryPtr);
+	}
+	esif_ccb_write_unlock(&g_sysfsFdCache.lock);
+}
+
+void EsifSysfsFdCache_Init(const char *sysfsRoot)
+{
+	char resolved[PATH_MAX] = { 0 };
+	int i = 0;
+
+	if (g_sysfsFdCache.initialized || (NULL == sysfsRoot)) {
+		return;
+	}
+
+	// The root is resolved the same way as the cached paths so their prefixes compare equal
+	if (realpath(sysfsRoot, resolved) == NULL) {
+		esif_ccb_strcpy(resolved, sysfsRoot, sizeof(resolved));
+	}
+	esif_ccb_strcpy(g_sysfsFdCache.sysfsRoot, resolved, sizeof(g_sysfsFdCache.sysfsRoot));
+
+	esif_ccb_lock_init(&g_sysfsFdCache.lock);
+	for (i = 0; i < ESIF_SYSFS_FD_CACHE_SIZE; i++) {
+		g_sysfsFdCache.entries[i].fd = SYSFS_FD_NONE;
+	}
+	g_sysfsFdCache.initialized = ESIF_TRUE;
+}
+
+void EsifSysfsFdCache_Exit(void)
+{
+	int i = 0;
+
+	if (!g_sysfsFdCache.initialized) {
+		return;
+	}
+
+	esif_ccb_write_lock(&g_sysfsFdCache.lock);
+	g_sysfsFdCache.initialized = ESIF_FALSE;
+	for (i = 0; i < ESIF_SYSFS_FD_CACHE_SIZE; i++) {
+		EsifSysfsFdCache_CloseEntry(&g_sysfsFdCache.entries[i]);
+	}
+	esif_ccb_write_unlock(&g_sysfsFdCache.lock);
+	esif_ccb_lock_uninit(&g_sysfsFdCache.lock);
+}
+
+int EsifSysfsFdCache_Read(const char *filepath, char *buf, size_t buf_len)
+{
+	SysfsFdCacheEntryPtr entryPtr = NULL;
+	u32 pathHash = 0;
+	ssize_t len = -1;
+	int fd = SYSFS_FD_NONE;
+
+	if (buf_len < 1) {
+		return -1;
+	}
+
+	if (g_sysfsFdCache.initialized) {
+		pathHash = EsifSysfsFdCache_Hash(filepath);
+
+		esif_ccb_read_lock(&g_sysfsFdCache.lock);
+		entryPtr = EsifSysfsFdCache_Find(filepath, pathHash);
+		if (entryPtr != NULL) {
+			len = pread(entryPtr->fd, buf, buf_len - 1, 0);
+			atomic64_set(&entryPtr->lastUsed, atomic64_inc(&g_sysfsFdCache.useCounter));
+		}
+		esif_ccb_read_unlock(&g_sysfsFdCache.lock);
+
+		if (len >= 0) {
+			goto exit;
+		}
+		if (entryPtr != NULL) {
+			// The file may belong to a device that went away; drop it and open the file again
+			EsifSysfsFdCache_InvalidateEntry(filepath, pathHash);
+		}
+	}
+
+	fd = open(filepath, O_RDONLY);
+	if (fd == SYSFS_FD_NONE) {
+		goto exit;
+	}
+
+	len = pread(fd, buf, buf_len - 1, 0);
+	if ((len < 0) || !g_sysfsFdCache.initialized) {
+		close(fd);
+	}
+	else {
+		EsifSysfsFdCache_Insert(filepath, pathHash, fd);
+	}
+
+exit:
+	buf[(len > 0) ? len : 0] = 0;
+	return (int)len;
+}
+
+void EsifSysfsFdCache_ProcessUevent(const char *buffer, int len)
+{
+	static const char remove_at[] = "remove@";
+	size_t remove_at_len = sizeof(remove_at) - 1;
+	char removed_path[MAX_SYSFS_PATH] = { 0 };
+
+	if (g_sysfsFdCache.initialized &&
+		((size_t)len > remove_at_len) && (esif_ccb_strncmp(buffer, remove_at, remove_at_len) == 0)) {
+		esif_ccb_sprintf(MAX_SYSFS_PATH, removed_path, "%s%.*s", g_sysfsFdCache.sysfsRoot,
+			(int)esif_ccb_strlen(buffer + remove_at_len, len - remove_at_len), buffer + remove_at_len);
+		EsifSysfsFdCache_InvalidateDevice(removed_path);
+	}
+}
+
+/*****************************************************************************/
+/*****************************************************************************/
+/*****************************************************************************/
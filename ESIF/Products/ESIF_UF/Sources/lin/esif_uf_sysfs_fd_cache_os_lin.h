@@ -0,0 +1,64 @@
+/******************************************************************************
+** Copyright (c) 2013-2020 Intel Corporation All Rights Reserved
+**
+** Licensed under the Apache License, Version 2.0 (the "License"); you may not
+** use this file except in compliance with the License.
+**
+** You may obtain a copy of the License at
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+** WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+******************************************************************************/
+
+#ifndef _ESIF_UF_SYSFS_FD_CACHE_LIN_
+#define _ESIF_UF_SYSFS_FD_CACHE_LIN_
+
+#include "esif.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Sysfs File Descriptor Cache
+ * Sysfs attributes are generated again each time they are read from offset 0,
+ * so descriptors for the attributes that are read are kept open and read with
+ * pread() instead of being opened, scanned and closed on every call.  The
+ * cache is bounded and the least recently used descriptor is closed when room
+ * is needed.  Descriptors below a device are closed when the udev remove event
+ * for the device arrives or when a read on them fails.
+ */
+#define ESIF_SYSFS_FD_CACHE_SIZE 64
+#define ESIF_SYSFS_ROOT "/sys"
+
+/*
+ * sysfsRoot is the directory uevent DEVPATHs are relative to; ESIF_SYSFS_ROOT
+ * except in tests
+ */
+void EsifSysfsFdCache_Init(const char *sysfsRoot);
+void EsifSysfsFdCache_Exit(void);
+
+/*
+ * Reads the contents of a sysfs file into a null terminated buffer
+ * Returns the number of bytes read or -1 if the file cannot be read
+ */
+int EsifSysfsFdCache_Read(const char *filepath, char *buf, size_t buf_len);
+
+/* Closes the cached descriptors below the device of a udev remove event */
+void EsifSysfsFdCache_ProcessUevent(const char *buffer, int len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	// _ESIF_UF_SYSFS_FD_CACHE_LIN_
+
+/*****************************************************************************/
+/*****************************************************************************/
+/*****************************************************************************/
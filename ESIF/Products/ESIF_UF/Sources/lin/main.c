@@ -27,8 +27,13 @@
 #include "esif_uf_sensor_manager_os_lin.h"
 #include "esif_uf_ccb_imp_spec.h"
 #include "esif_uf_sysfs_os_lin.h"
+#include "esif_uf_sysfs_fd_cache_os_lin.h"
+#include "esif_uf_rapl_sampler_os_lin.h"
+#include "esif_uf_reactor_os_lin.h"
+#include "esif_hash_table.h"
 
 #include <sys/socket.h>
+#include <sys/epoll.h>
 #include <linux/netlink.h>
 #include <termios.h>
 #include <errno.h>
@@ -54,14 +59,20 @@ static void esif_udev_start();
 static void esif_udev_stop();
 static void esif_udev_exit();
 static Bool esif_udev_is_started();
-static void *esif_udev_listen(void *ptr);
+static void esif_udev_callback(int fd, UInt32 events, void *ctx);
 static void esif_process_udev_event(char *udev_target);
 static int kobj_uevent_parse(char *buffer, int len, char **zone_name, int *temp, int *event);
+static eEsifError tz_index_init(void);
+static void tz_index_exit(void);
 
-static esif_thread_t g_udev_thread;
 static Bool g_udev_quit = ESIF_TRUE;
 static char *g_udev_target = NULL;
 
+/* Thermal zone name -> participant instance (esif_handle_t *) */
+#define TZ_INDEX_SIZE 31
+static struct esif_ht *g_tz_index = NULL;
+static esif_ccb_lock_t g_tz_index_lock;
+
 /* Dedicated thread pool to handle SIGRTMIN timer signals */
 static esif_thread_t *g_sigrtmin_thread_pool;
 static Bool g_os_quit = ESIF_FALSE; /* global flag to supress KW flagging as while(1) alternative */
@@ -83,7 +94,7 @@ static long g_nproc = 1;
 static struct sockaddr_nl sock_addr_src, sock_addr_dest;
 static struct nlmsghdr *netlink_msg = NULL;
 static struct iovec msg_buf;
-static int sock_fd;
+static int sock_fd = -1;
 static struct msghdr msg;
 
 
@@ -94,8 +105,8 @@ static struct msghdr msg;
 
 #ifdef ESIF_FEAT_OPT_DBUS
 #include <dbus/dbus.h>
-esif_thread_t g_dbus_thread;
 DBusConnection *g_dbus_conn;
+int g_dbus_fd = -1;
 #endif
 
 /* Instance Lock */
@@ -338,9 +349,11 @@ static int check_for_uevent(int fd) {
 
 	len = recv(fd, buffer, sizeof(buffer), 0);
 	if (len <= 0) {
-		return 0;
+		return -1;
 	}
 
+	EsifSysfsFdCache_ProcessUevent(buffer, len);
+
 	while (i < len) {
 
 		buf_ptr = buffer + i;
@@ -436,24 +449,6 @@ void sigterm_enable()
 	sigaction(SIGQUIT, &action, NULL);
 }
 
-// The SIGUSR1 handler below is the alternative
-// solution for Android where the pthread_cancel()
-// is not implemented in Android NDK
-
-/* SIGUSR1 Signal Handler */
-static void sigusr1_handler(int signum)
-{
-	pthread_exit(0);
-}
-
-/* Enable or Disable SIGTERM Handler */
-static void sigusr1_enable()
-{
-	struct sigaction action={0};
-	action.sa_handler = sigusr1_handler;
-	sigaction(SIGUSR1, &action, NULL);
-}
-
 static void sigrtmin_block(void)
 {
 	/* Block SIGRTMIN; other threads created from the main thread
@@ -566,27 +561,38 @@ static void release_timer_thread_pool(void)
 	}
 }
 
+#define SYSFS_INT_STR_LEN	64
+
 int SysfsGetString(char *path, char *filename, char *str, size_t buf_len)
 {
-	FILE *fd = NULL;
 	int ret = -1;
 	char filepath[MAX_PATH] = { 0 };
-	char scanf_fmt[IIO_STR_LEN] = { 0 };
+	char buf[MAX_SYSFS_STRING] = { 0 };
+	char *token = buf;
+	size_t token_len = 0;
 
-	if (str == NULL) {
+	if (str == NULL || buf_len < 1) {
 		return ret;
 	}
 
 	esif_ccb_sprintf(MAX_PATH, filepath, "%s/%s", path, filename);
 
-	if ((fd = esif_ccb_fopen(filepath, "r", NULL)) == NULL) {
+	if (EsifSysfsFdCache_Read(filepath, buf, sizeof(buf)) < 0) {
 		return ret;
 	}
 
-	// Use dynamic format width specifier to avoid scanf buffer overflow
-	esif_ccb_sprintf(sizeof(scanf_fmt), scanf_fmt, "%%%ds", (int)buf_len - 1);
-	ret = esif_ccb_fscanf(fd, scanf_fmt, str);
-	esif_ccb_fclose(fd);
+	// Return the first whitespace delimited word, the same as scanf("%s") would
+	while (*token && isspace((u8)*token)) {
+		token++;
+	}
+	while (token[token_len] && !isspace((u8)token[token_len]) && token_len < buf_len - 1) {
+		token_len++;
+	}
+	if (token_len > 0) {
+		esif_ccb_memcpy(str, token, token_len);
+		str[token_len] = 0;
+		ret = 1;
+	}
 
 	return ret;
 }
@@ -618,9 +624,10 @@ exit:
 
 int SysfsGetInt64(const char *path, const char *filename, Int64 *p64)
 {
-	FILE *fd = NULL;
 	int rc = 0;
 	char filepath[MAX_SYSFS_PATH] = { 0 };
+	char buf[SYSFS_INT_STR_LEN] = { 0 };
+	char *endptr = NULL;
 
 	if (path == NULL || filename == NULL) {
 		goto exit;
@@ -628,11 +635,11 @@ int SysfsGetInt64(const char *path, const char *filename, Int64 *p64)
 
 	esif_ccb_sprintf(MAX_SYSFS_PATH, filepath, "%s/%s", path, filename);
 
-	if ((fd = esif_ccb_fopen(filepath, "r", NULL)) == NULL) {
+	if (EsifSysfsFdCache_Read(filepath, buf, sizeof(buf)) <= 0) {
 		goto exit;
 	}
-	rc = esif_ccb_fscanf(fd, "%lld", p64);
-	esif_ccb_fclose(fd);
+	*p64 = (Int64)strtoll(buf, &endptr, 10);
+	rc = (endptr != buf) ? 1 : 0;
 
 exit:
 	// Klocwork bounds check. Should depend on context
@@ -647,8 +654,7 @@ int SysfsGetInt64Direct(int fd, Int64 *p64)
 	int rc = 0;
 	char buf[MAX_SYSFS_STRING] = {0};
 
-	lseek(fd, 0, SEEK_SET);
-	if (read(fd, buf, MAX_SYSFS_STRING) > 0) {
+	if (pread(fd, buf, sizeof(buf) - 1, 0) > 0) {
 		rc = esif_ccb_sscanf(buf, "%lld", p64);
 		if (rc < 1) {
 			ESIF_TRACE_WARN("Failed to get file scan. Error code: %d .\n",rc);
@@ -663,21 +669,21 @@ int SysfsGetInt64Direct(int fd, Int64 *p64)
 
 eEsifError SysfsGetInt(const char *path, const char *filename, int *pInt)
 {
-	FILE *fp = NULL;
 	eEsifError rc = ESIF_OK;
 	char filepath[MAX_PATH] = { 0 };
+	char buf[SYSFS_INT_STR_LEN] = { 0 };
+	char *endptr = NULL;
 	esif_ccb_sprintf(MAX_PATH, filepath, "%s/%s", path, filename);
 
-	if ((fp = esif_ccb_fopen(filepath, "r", NULL)) == NULL) {
+	if (EsifSysfsFdCache_Read(filepath, buf, sizeof(buf)) <= 0) {
 		rc = ESIF_E_INVALID_HANDLE;
 		goto exit;
 	}
-	if (esif_ccb_fscanf(fp, "%d", pInt) <= 0) {
+	*pInt = (int)strtol(buf, &endptr, 10);
+	if (endptr == buf) {
 		rc = ESIF_E_INVALID_HANDLE;
 	}
 
-	esif_ccb_fclose(fp);
-
 exit:
 	return rc;
 }
@@ -687,8 +693,7 @@ eEsifError SysfsGetIntDirect(int fd, int *pInt)
 	eEsifError rc = ESIF_OK;
 	char buf[IIO_STR_LEN] = {0};
 
-	lseek(fd, 0, SEEK_SET);
-	if (read(fd, buf, IIO_STR_LEN) > 0) {
+	if (pread(fd, buf, sizeof(buf) - 1, 0) > 0) {
 		if (esif_ccb_sscanf(buf, "%d", pInt) <= 0) {
 			rc = ESIF_E_INVALID_HANDLE;
 			ESIF_TRACE_WARN("Failed to get file scan. Error code: %d .\n",rc);
@@ -704,21 +709,21 @@ eEsifError SysfsGetIntDirect(int fd, int *pInt)
 
 eEsifError SysfsGetFloat(const char *path, const char *filename, float *pFloat)
 {
-	FILE *fp = NULL;
 	eEsifError rc = ESIF_OK;
 	char filepath[MAX_PATH] = { 0 };
+	char buf[SYSFS_INT_STR_LEN] = { 0 };
+	char *endptr = NULL;
 	esif_ccb_sprintf(MAX_PATH, filepath, "%s/%s", path, filename);
 
-	if ((fp = esif_ccb_fopen(filepath, "r", NULL)) == NULL) {
+	if (EsifSysfsFdCache_Read(filepath, buf, sizeof(buf)) <= 0) {
 		rc = ESIF_E_INVALID_HANDLE;
 		goto exit;
 	}
-	if (esif_ccb_fscanf(fp, "%f", pFloat) <= 0) {
+	*pFloat = strtof(buf, &endptr);
+	if (endptr == buf) {
 		rc = ESIF_E_INVALID_HANDLE;
 	}
 
-	esif_ccb_fclose(fp);
-
 exit:
 	return rc;
 }
@@ -828,15 +833,58 @@ int instance_islocked()
 static void esif_udev_start()
 {
 	if (!esif_udev_is_started()) {
-		g_udev_quit = ESIF_FALSE;
 		g_udev_target = esif_ccb_malloc(MAX_PAYLOAD);
-		if (g_udev_target != NULL) {
-			esif_ccb_thread_create(&g_udev_thread, esif_udev_listen, NULL);
-		}
-		else {
+		if (g_udev_target == NULL) {
 			CMD_DEBUG("Unable to start ESIF udev listener (no memory)");
+			goto exit;
+		}
+
+		sock_fd = socket(PF_NETLINK, SOCK_RAW | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_KOBJECT_UEVENT);
+		if (sock_fd < 0) {
+			goto exit;
 		}
+
+		memset(&sock_addr_src, 0, sizeof(sock_addr_src));
+		sock_addr_src.nl_family = AF_NETLINK;
+		sock_addr_src.nl_pid = getpid();
+		sock_addr_src.nl_groups = -1;
+
+		if (bind(sock_fd, (struct sockaddr *)&sock_addr_src, sizeof(sock_addr_src)) < 0) {
+			CMD_DEBUG("Unable to start ESIF udev listener (bind failed; errno = %d)", errno);
+			goto exit;
+		}
+
+		memset(&sock_addr_dest, 0, sizeof(sock_addr_dest));
+		sock_addr_dest.nl_family = AF_NETLINK;
+		sock_addr_dest.nl_pid = 0;
+		sock_addr_dest.nl_groups = 0;
+
+		netlink_msg = (struct nlmsghdr *)esif_ccb_malloc(NLMSG_SPACE(MAX_PAYLOAD));
+		if (netlink_msg == NULL) {
+			goto exit;
+		}
+		memset(netlink_msg, 0, NLMSG_SPACE(MAX_PAYLOAD));
+		netlink_msg->nlmsg_len = NLMSG_SPACE(MAX_PAYLOAD);
+		netlink_msg->nlmsg_pid = getpid();
+		netlink_msg->nlmsg_flags = 0;
+
+		msg_buf.iov_base = (void *)netlink_msg;
+		msg_buf.iov_len = netlink_msg->nlmsg_len;
+		msg.msg_name = (void *)&sock_addr_dest;
+		msg.msg_namelen = sizeof(sock_addr_dest);
+		msg.msg_iov = &msg_buf;
+		msg.msg_iovlen = 1;
+
+		/* Messages from the kernel are read on the reactor thread */
+		if (EsifReactor_AddSource(sock_fd, EPOLLIN, esif_udev_callback, NULL) != ESIF_OK) {
+			CMD_DEBUG("Unable to start ESIF udev listener (reactor unavailable)");
+			goto exit;
+		}
+		g_udev_quit = ESIF_FALSE;
 	}
+	return;
+exit:
+	esif_udev_exit();
 }
 
 static void esif_udev_stop()
@@ -859,15 +907,15 @@ void register_events_for_available_uf_participants(EnumerableUFParticipants type
 static void esif_udev_exit()
 {
 	g_udev_quit = ESIF_TRUE;
-#ifdef ESIF_ATTR_OS_ANDROID
-	// Android NDK does not support pthread_cancel()
-	// Use pthread_kill() to emualte
-	pthread_kill(g_udev_thread, SIGUSR1);
-#else
-	pthread_cancel(g_udev_thread);
-#endif
-	esif_ccb_thread_join(&g_udev_thread);
+	if (sock_fd >= 0) {
+		EsifReactor_RemoveSource(sock_fd);
+		close(sock_fd);
+		sock_fd = -1;
+	}
+	esif_ccb_free(netlink_msg);
+	netlink_msg = NULL;
 	esif_ccb_free(g_udev_target);
+	g_udev_target = NULL;
 }
 
 static Bool esif_udev_is_started()
@@ -876,148 +924,267 @@ static Bool esif_udev_is_started()
 }
 
 
-static void *esif_udev_listen(void *ptr)
+static void esif_udev_callback(int fd, UInt32 events, void *ctx)
 {
-	UNREFERENCED_PARAMETER(ptr);
-#ifdef ESIF_ATTR_OS_ANDROID
-	sigusr1_enable();
-#endif
-	sock_fd = socket(PF_NETLINK, SOCK_RAW, NETLINK_KOBJECT_UEVENT);
-	if (sock_fd < 0) {
-		goto exit;
+	UNREFERENCED_PARAMETER(events);
+	UNREFERENCED_PARAMETER(ctx);
+
+	/* Drain every queued message; the socket is non-blocking */
+	while (check_for_uevent(fd) >= 0) {
+		;
 	}
+}
+
+/*
+ * Thermal Zone Index
+ *
+ * Maps the thermal zone name at the end of a participant device path (e.g.
+ * "thermal_zone3") to the participant instance, so a uevent for a zone is
+ * resolved without walking every participant.  Entries are maintained from
+ * the participant create/unregister events and are checked against the
+ * participant on each lookup in case an event has not been processed yet.
+ */
+static Bool tz_index_get_zone_name(EsifUpPtr up_ptr, char *zone_name, size_t zone_name_len)
+{
+	char path[ESIF_PATH_LEN] = { 0 };
+	char *sep = NULL;
+	char *name = path;
+
+	esif_ccb_strcpy(path, up_ptr->fMetadata.fDevicePath, sizeof(path));
 
-	memset(&sock_addr_src, 0, sizeof(sock_addr_src));
-	sock_addr_src.nl_family = AF_NETLINK;
-	sock_addr_src.nl_pid = getpid();
-	sock_addr_src.nl_groups = -1;
+	/* Ignore any alternate path */
+	sep = esif_ccb_strchr(path, '|');
+	if (sep != NULL) {
+		*sep = 0;
+	}
+	sep = esif_ccb_strrchr(path, '/');
+	if (sep != NULL) {
+		name = sep + 1;
+	}
+	if (*name == 0) {
+		return ESIF_FALSE;
+	}
+	esif_ccb_strcpy(zone_name, name, zone_name_len);
+	return ESIF_TRUE;
+}
 
-	bind(sock_fd, (struct sockaddr *)&sock_addr_src, sizeof(sock_addr_src));
+static void tz_index_entry_destroy(void *item_ptr)
+{
+	esif_ccb_free(item_ptr);
+}
 
-	memset(&sock_addr_dest, 0, sizeof(sock_addr_dest));
-	sock_addr_dest.nl_family = AF_NETLINK;
-	sock_addr_dest.nl_pid = 0;
-	sock_addr_dest.nl_groups = 0;
+static void tz_index_add(EsifUpPtr up_ptr)
+{
+	char zone_name[ESIF_PATH_LEN] = { 0 };
+	u32 key_len = 0;
+	esif_handle_t *entry_ptr = NULL;
 
-	netlink_msg = (struct nlmsghdr *)esif_ccb_malloc(NLMSG_SPACE(MAX_PAYLOAD));
-	if (netlink_msg == NULL) {
-		goto exit;
+	if (!tz_index_get_zone_name(up_ptr, zone_name, sizeof(zone_name))) {
+		return;
 	}
-	memset(netlink_msg, 0, NLMSG_SPACE(MAX_PAYLOAD));
-	netlink_msg->nlmsg_len = NLMSG_SPACE(MAX_PAYLOAD);
-	netlink_msg->nlmsg_pid = getpid();
-	netlink_msg->nlmsg_flags = 0;
+	key_len = (u32)esif_ccb_strlen(zone_name, sizeof(zone_name));
 
-	msg_buf.iov_base = (void *)netlink_msg;
-	msg_buf.iov_len = netlink_msg->nlmsg_len;
-	msg.msg_name = (void *)&sock_addr_dest;
-	msg.msg_namelen = sizeof(sock_addr_dest);
-	msg.msg_iov = &msg_buf;
-	msg.msg_iovlen = 1;
+	entry_ptr = (esif_handle_t *)esif_ccb_malloc(sizeof(*entry_ptr));
+	if (entry_ptr == NULL) {
+		return;
+	}
+	*entry_ptr = EsifUp_GetInstance(up_ptr);
 
-	/* Read message from kernel */
-	while(!g_udev_quit) {
-		check_for_uevent(sock_fd);
+	esif_ccb_write_lock(&g_tz_index_lock);
+	esif_ccb_free(esif_ht_get_item(g_tz_index, (u8 *)zone_name, key_len));
+	esif_ht_remove_item(g_tz_index, (u8 *)zone_name, key_len);
+	if (esif_ht_add_item(g_tz_index, (u8 *)zone_name, key_len, entry_ptr) != ESIF_OK) {
+		esif_ccb_free(entry_ptr);
 	}
+	esif_ccb_write_unlock(&g_tz_index_lock);
+}
 
-exit:
-	if (sock_fd >= 0) {
-		close(sock_fd);
+/* Remove the entry for a zone only if it still refers to the given participant */
+static void tz_index_remove(const char *zone_name, esif_handle_t participant_id)
+{
+	u32 key_len = (u32)esif_ccb_strlen(zone_name, ESIF_PATH_LEN);
+	esif_handle_t *entry_ptr = NULL;
+
+	esif_ccb_write_lock(&g_tz_index_lock);
+	entry_ptr = (esif_handle_t *)esif_ht_get_item(g_tz_index, (u8 *)zone_name, key_len);
+	if ((entry_ptr != NULL) && (*entry_ptr == participant_id)) {
+		esif_ht_remove_item(g_tz_index, (u8 *)zone_name, key_len);
+		esif_ccb_free(entry_ptr);
 	}
-	esif_ccb_free(netlink_msg);
-	netlink_msg = NULL;
-	return NULL;
+	esif_ccb_write_unlock(&g_tz_index_lock);
 }
 
-static void esif_domain_signal_and_stop_poll(EsifUpPtr up_ptr, UInt8 participant_id, char *udev_target)
+static eEsifError ESIF_CALLCONV tz_index_event_callback(
+	esif_context_t context,
+	esif_handle_t participant_id,
+	UInt16 domain_id,
+	EsifFpcEventPtr fpc_event_ptr,
+	EsifDataPtr event_data_ptr
+	)
 {
-	eEsifError iter_rc = ESIF_OK;
-	EsifUpDomainPtr domainPtr = NULL;
-	UpDomainIterator udIter = { 0 };
-	UInt32 domain_index = 0;
+	EsifUpPtr up_ptr = NULL;
+	char zone_name[ESIF_PATH_LEN] = { 0 };
 
-	iter_rc = EsifUpDomain_InitIterator(&udIter, up_ptr);
-	if (ESIF_OK != iter_rc) {
-		return;
+	UNREFERENCED_PARAMETER(context);
+	UNREFERENCED_PARAMETER(domain_id);
+	UNREFERENCED_PARAMETER(event_data_ptr);
+
+	if (fpc_event_ptr == NULL) {
+		return ESIF_E_PARAMETER_IS_NULL;
 	}
 
-	iter_rc = EsifUpDomain_GetNextUd(&udIter, &domainPtr);
-	while (ESIF_OK == iter_rc) {
-		if (NULL == domainPtr) {
-			iter_rc = EsifUpDomain_GetNextUd(&udIter, &domainPtr);
-			domain_index++;
-			continue;
+	up_ptr = EsifUpPm_GetAvailableParticipantByInstance(participant_id);
+	if (up_ptr == NULL) {
+		return ESIF_OK;
+	}
+
+	switch (fpc_event_ptr->esif_event) {
+	case ESIF_EVENT_PARTICIPANT_CREATE_COMPLETE:
+		tz_index_add(up_ptr);
+		break;
+	case ESIF_EVENT_PARTICIPANT_UNREGISTER:
+		if (tz_index_get_zone_name(up_ptr, zone_name, sizeof(zone_name))) {
+			tz_index_remove(zone_name, participant_id);
 		}
+		break;
+	default:
+		break;
+	}
 
-		ESIF_TRACE_INFO("Udev Event: THRESHOLD CROSSED in thermal zone: %s\n",udev_target);
-		EsifEventMgr_SignalEvent(participant_id, domain_index++, ESIF_EVENT_DOMAIN_TEMP_THRESHOLD_CROSSED, NULL);
+	EsifUp_PutRef(up_ptr);
+	return ESIF_OK;
+}
+
+static eEsifError tz_index_init(void)
+{
+	eEsifError rc = ESIF_OK;
+	UfPmIterator up_iter = { 0 };
+	EsifUpPtr up_ptr = NULL;
 
-		// Find a valid domain, check if it is being polled
-		if (domainPtr->tempPollType != ESIF_POLL_NONE) {
-			EsifUpDomain_StopTempPoll(domainPtr);
+	esif_ccb_lock_init(&g_tz_index_lock);
+	g_tz_index = esif_ht_create(TZ_INDEX_SIZE);
+	if (g_tz_index == NULL) {
+		return ESIF_E_NO_MEMORY;
+	}
+
+	EsifEventMgr_RegisterEventByType(ESIF_EVENT_PARTICIPANT_CREATE_COMPLETE,
+		EVENT_MGR_MATCH_ANY,
+		EVENT_MGR_DOMAIN_D0,
+		tz_index_event_callback,
+		0);
+
+	EsifEventMgr_RegisterEventByType(ESIF_EVENT_PARTICIPANT_UNREGISTER,
+		EVENT_MGR_MATCH_ANY,
+		EVENT_MGR_DOMAIN_D0,
+		tz_index_event_callback,
+		0);
+
+	/* Index any participants created before the event registration */
+	rc = EsifUpPm_InitIterator(&up_iter);
+	if (rc == ESIF_OK) {
+		rc = EsifUpPm_GetNextUp(&up_iter, &up_ptr);
+		while (ESIF_OK == rc) {
+			tz_index_add(up_ptr);
+			rc = EsifUpPm_GetNextUp(&up_iter, &up_ptr);
+		}
+		if (rc != ESIF_E_ITERATION_DONE) {
+			EsifUp_PutRef(up_ptr);
 		}
-		iter_rc = EsifUpDomain_GetNextUd(&udIter, &domainPtr);
 	}
+	return ESIF_OK;
+}
 
-	if (iter_rc != ESIF_E_ITERATION_DONE) {
-		EsifUp_PutRef(up_ptr);
+static void tz_index_exit(void)
+{
+	if (g_tz_index == NULL) {
+		return;
 	}
+
+	EsifEventMgr_UnregisterEventByType(ESIF_EVENT_PARTICIPANT_CREATE_COMPLETE,
+		EVENT_MGR_MATCH_ANY,
+		EVENT_MGR_DOMAIN_D0,
+		tz_index_event_callback,
+		0);
+
+	EsifEventMgr_UnregisterEventByType(ESIF_EVENT_PARTICIPANT_UNREGISTER,
+		EVENT_MGR_MATCH_ANY,
+		EVENT_MGR_DOMAIN_D0,
+		tz_index_event_callback,
+		0);
+
+	esif_ccb_write_lock(&g_tz_index_lock);
+	esif_ht_destroy(g_tz_index, tz_index_entry_destroy);
+	g_tz_index = NULL;
+	esif_ccb_write_unlock(&g_tz_index_lock);
+	esif_ccb_lock_uninit(&g_tz_index_lock);
+}
+
+/*
+ * The thermal zone reports the temperature of the first domain with the
+ * temperature status capability; fall back to the first domain.
+ */
+static EsifUpDomainPtr tz_index_get_zone_domain(EsifUpPtr up_ptr)
+{
+	UInt8 domain_count = EsifUp_GetDomainCount(up_ptr);
+	UInt8 i = 0;
+
+	for (i = 0; i < domain_count; i++) {
+		EsifUpDomainPtr domain_ptr = EsifUp_GetDomainByIndex(up_ptr, i);
+		if ((domain_ptr != NULL) && (domain_ptr->capability_for_domain.capability_flags & ESIF_CAPABILITY_TEMP_STATUS)) {
+			return domain_ptr;
+		}
+	}
+	return (domain_count > 0) ? EsifUp_GetDomainByIndex(up_ptr, 0) : NULL;
 }
 
 static void esif_process_udev_event(char *udev_target)
 {
-	char *participant_device_path = NULL;
+	char zone_name[ESIF_PATH_LEN] = { 0 };
+	esif_handle_t *entry_ptr = NULL;
+	esif_handle_t participant_id = ESIF_INVALID_HANDLE;
 	EsifUpPtr up_ptr = NULL;
-	EsifUpPtr up_proc_ptr = NULL;
-	char *parsed = NULL;
-	char *ctx = NULL;
-	UInt8 participant_id = 0;
-	UInt8 processor_id = 0;
-	eEsifError iter_rc = ESIF_OK;
-	UfPmIterator up_iter = { 0 };
-	Bool target_tz_found = ESIF_FALSE;
+	EsifUpDomainPtr domain_ptr = NULL;
 
-	participant_device_path = esif_ccb_malloc(MAX_PAYLOAD);
-	if (participant_device_path == NULL) {
-		goto exit;
+	if (g_tz_index == NULL) {
+		return;
 	}
 
-	iter_rc = EsifUpPm_InitIterator(&up_iter);
-	if (iter_rc != ESIF_OK) {
-		goto exit;
+	esif_ccb_read_lock(&g_tz_index_lock);
+	entry_ptr = (esif_handle_t *)esif_ht_get_item(g_tz_index, (u8 *)udev_target, (u32)esif_ccb_strlen(udev_target, MAX_PAYLOAD));
+	if (entry_ptr != NULL) {
+		participant_id = *entry_ptr;
 	}
+	esif_ccb_read_unlock(&g_tz_index_lock);
 
-	iter_rc = EsifUpPm_GetNextUp(&up_iter, &up_ptr);
-	while (ESIF_OK == iter_rc) {
-		char *path_to_compare = esif_ccb_strdup(up_ptr->fMetadata.fDevicePath);
-		participant_id = EsifUp_GetInstance(up_ptr);
-		if (!esif_ccb_strcmp(up_ptr->fMetadata.fAcpiDevice, "INT3401")) {
-			processor_id = participant_id;
-			up_proc_ptr = up_ptr;
-		}
-
-		parsed = esif_ccb_strtok(path_to_compare,"/",&ctx);
-		while (parsed != NULL) {
-			esif_ccb_strcpy(participant_device_path,parsed,MAX_PAYLOAD);
-			parsed = esif_ccb_strtok(NULL,"/",&ctx);
-		}
-		if (!esif_ccb_strcmp(udev_target, participant_device_path)) {
-			target_tz_found = ESIF_TRUE;
-			esif_domain_signal_and_stop_poll(up_ptr, participant_id, udev_target);
-			esif_ccb_free(path_to_compare);
-			break;
-		}
+	if (participant_id == ESIF_INVALID_HANDLE) {
+		return;
+	}
 
-		esif_ccb_free(path_to_compare);
-		iter_rc = EsifUpPm_GetNextUp(&up_iter, &up_ptr);
+	up_ptr = EsifUpPm_GetAvailableParticipantByInstance(participant_id);
+	if ((up_ptr == NULL) ||
+		!tz_index_get_zone_name(up_ptr, zone_name, sizeof(zone_name)) ||
+		esif_ccb_strcmp(zone_name, udev_target)) {
+		/* The participant is gone or was re-created for another zone */
+		tz_index_remove(udev_target, participant_id);
+		goto exit;
 	}
 
-	if (ESIF_E_ITERATION_DONE != iter_rc) {
-		EsifUp_PutRef(up_ptr);
+	domain_ptr = tz_index_get_zone_domain(up_ptr);
+	if (domain_ptr == NULL) {
+		goto exit;
 	}
 
+	ESIF_TRACE_INFO("Udev Event: THRESHOLD CROSSED in thermal zone: %s\n", udev_target);
+	EsifEventMgr_SignalEvent(participant_id, domain_ptr->domain, ESIF_EVENT_DOMAIN_TEMP_THRESHOLD_CROSSED, NULL);
+
+	// The thermal zone notifies threshold crossings, so the domain no longer needs to be polled
+	if (domain_ptr->tempPollType != ESIF_POLL_NONE) {
+		EsifUpDomain_StopTempPoll(domain_ptr);
+	}
 exit:
-	esif_ccb_free(participant_device_path);
+	if (up_ptr != NULL) {
+		EsifUp_PutRef(up_ptr);
+	}
 }
 
 #ifdef ESIF_FEAT_OPT_DBUS
@@ -1054,13 +1221,31 @@ s3_callback(DBusConnection *conn, DBusMessage *message, void *user_data)
 	return DBUS_HANDLER_RESULT_HANDLED;
 }
 
-void* dbus_listen()
+static void dbus_dispatch(void)
 {
-	DBusError err = {0};
+	while (dbus_connection_dispatch(g_dbus_conn) == DBUS_DISPATCH_DATA_REMAINS) {
+		;
+	}
+}
 
-#ifdef ESIF_ATTR_OS_ANDROID
-	sigusr1_enable();
-#endif
+static void dbus_callback(int fd, UInt32 events, void *ctx)
+{
+	UNREFERENCED_PARAMETER(fd);
+	UNREFERENCED_PARAMETER(events);
+	UNREFERENCED_PARAMETER(ctx);
+
+	/* Read what is available without blocking, then run the filters */
+	if (!dbus_connection_read_write(g_dbus_conn, 0)) {
+		EsifReactor_RemoveSource(g_dbus_fd);
+		g_dbus_fd = -1;
+		return;
+	}
+	dbus_dispatch();
+}
+
+static void dbus_start()
+{
+	DBusError err = {0};
 
 	dbus_error_init(&err);
 	g_dbus_conn = dbus_bus_get(DBUS_BUS_SYSTEM, &err);
@@ -1068,24 +1253,42 @@ void* dbus_listen()
 	if (dbus_error_is_set(&err)) {
 		fprintf(stderr, "Connection Error (%s)\n", err.message);
 		dbus_error_free(&err);
-		return NULL;
+		return;
 	}
 
 	dbus_bus_add_match(g_dbus_conn, "type='signal'", &err);
 	if (dbus_error_is_set(&err)) {
 		fprintf(stderr, "Connection Error (%s)\n", err.message);
 		dbus_error_free(&err);
-		return NULL;
+		return;
 	}
 
 	if (!dbus_connection_add_filter(g_dbus_conn, s3_callback, NULL, NULL)) {
 		fprintf(stderr, "Couldn't add filter!\n");
-		return NULL;
+		return;
+	}
+
+	if (!dbus_connection_get_unix_fd(g_dbus_conn, &g_dbus_fd) ||
+		(EsifReactor_AddSource(g_dbus_fd, EPOLLIN, dbus_callback, NULL) != ESIF_OK)) {
+		fprintf(stderr, "Couldn't watch D-Bus connection!\n");
+		g_dbus_fd = -1;
+		return;
 	}
 
-	while (dbus_connection_read_write_dispatch(g_dbus_conn, -1));
+	/* Messages may already be queued from the match request */
+	dbus_dispatch();
+}
 
-	return NULL;
+static void dbus_stop()
+{
+	if (g_dbus_fd >= 0) {
+		EsifReactor_RemoveSource(g_dbus_fd);
+		g_dbus_fd = -1;
+	}
+	if (g_dbus_conn) {
+		dbus_connection_unref(g_dbus_conn);
+		g_dbus_conn = NULL;
+	}
 }
 #endif
 
@@ -1213,9 +1416,9 @@ static int run_as_daemon(int start_with_pipe, int start_with_log, int start_in_b
 	esif_udev_start();
 #endif
 
-	/* Start D-Bus listener thread if necessary */
+	/* Start D-Bus listener if necessary */
 #ifdef ESIF_FEAT_OPT_DBUS
-	esif_ccb_thread_create(&g_dbus_thread, dbus_listen, "D-Bus Listener");
+	dbus_start();
 #endif
 
 	/* UF Startup Script may have enabled/disabled ESIF Shell */
@@ -1324,9 +1527,9 @@ static int run_as_server(FILE* input, char* command, int quit_after_command)
 	esif_udev_start();
 #endif
 
-	/* Start D-Bus listener thread if necessary */
+	/* Start D-Bus listener if necessary */
 #ifdef ESIF_FEAT_OPT_DBUS
-	esif_ccb_thread_create(&g_dbus_thread, dbus_listen, "D-Bus Listener");
+	dbus_start();
 #endif
 
 	while (!g_quit) {
@@ -1609,17 +1812,8 @@ int main (int argc, char **argv)
 	CMD_DEBUG("Errorlevel Returned: %d\n", g_errorlevel);
 
 #ifdef ESIF_FEAT_OPT_DBUS
-	CMD_DEBUG("Stopping D-Bus listener thread...\n");
-#ifdef ESIF_ATTR_OS_ANDROID
-	// Android NDK does not support pthread_cancel()
-	// Use pthread_kill() to emualte
-	pthread_kill(g_dbus_thread, SIGUSR1);
-#else
-	pthread_cancel(g_dbus_thread);
-#endif
-	esif_ccb_thread_join(&g_dbus_thread);
-	if (g_dbus_conn)
-		dbus_connection_unref(g_dbus_conn);
+	CMD_DEBUG("Stopping D-Bus listener...\n");
+	dbus_stop();
 #endif
 
 
@@ -1638,9 +1832,23 @@ int main (int argc, char **argv)
 
 eEsifError esif_uf_os_init ()
 {
+	/* Start the event loop shared by the uevent, sensor and D-Bus listeners */
+	if (EsifReactor_Init() != ESIF_OK) {
+		ESIF_TRACE_ERROR("Unable to start reactor; event sources will not be monitored\n");
+	}
+
+	EsifSysfsFdCache_Init(ESIF_SYSFS_ROOT);
+
+	if (tz_index_init() != ESIF_OK) {
+		ESIF_TRACE_WARN("Unable to create thermal zone index\n");
+	}
+
 	/* Start sensor manager thread */
 	EsifSensorMgr_Init();
 
+	/* Sample RAPL energy counters in the background */
+	EsifRaplSampler_Init();
+
 	return ESIF_OK;
 }
 
@@ -1650,11 +1858,18 @@ void esif_uf_os_exit ()
 	/* Stop uevent listener */
 	esif_udev_stop();
 
-	/* If uevent listener thread is canceled, the netlink_msg may not be freed yet */
-	esif_ccb_free(netlink_msg);
+	tz_index_exit();
 
-	/* Stop sensor manager thread */
+	/* Stop sensor manager */
 	EsifSensorMgr_Exit();
+
+	EsifRaplSampler_Exit();
+
+	/* Stop the event loop once all of its sources are removed */
+	EsifReactor_Exit();
+
+	/* Close the cached sysfs file descriptors */
+	EsifSysfsFdCache_Exit();
 }
 
 eEsifError esif_uf_os_shell_enable()
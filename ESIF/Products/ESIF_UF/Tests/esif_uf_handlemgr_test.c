@@ -0,0 +1,387 @@
+/******************************************************************************
+** Copyright (c) 2013-2020 Intel Corporation All Rights Reserved
+**
+** Licensed under the Apache License, Version 2.0 (the "License"); you may not
+** use this file except in compliance with the License.
+**
+** You may obtain a copy of the License at
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+** WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+******************************************************************************/
+
+/*
+ * Handle manager allocate/free churn test.  Every handle the handle manager
+ * returns is compared with a reference allocator that searches the handle map
+ * a bit at a time, as the handle manager did before it searched by word, so
+ * reuse order and instance counter (reuse delay) semantics must be identical.
+ * With --bench the same churn is then timed for both.  An optional argument
+ * sets the number of churn operations.
+ */
+#define ESIF_TRACE_ID	ESIF_TRACEMODULE_APP
+
+#include "esif_uf.h"
+#include "esif_uf_handlemgr.h"
+
+#include <time.h>
+
+#define TEST_DEFAULT_OPS	200000
+#define TEST_LIVE_HANDLES	4000	/* Number of handles held during the churn */
+#define TEST_FILL_HANDLES	60000	/* Number of handles held during the churn near capacity */
+
+#define TEST_CHECK(cond) \
+	do { \
+		if (!(cond)) { \
+			fprintf(stderr, "FAIL %s:%d: %s\n", __FUNCTION__, __LINE__, #cond); \
+			g_failures++; \
+		} \
+	} while (0)
+
+/* Reference allocator: the handle manager search before it was done a word at a time */
+typedef struct RefHandleMgr_s {
+	UInt64 *handleMapPtr;
+	size_t handleMapSize;
+	UInt64 numAvailableHandles;
+	size_t curLine;
+	UInt32 curPos;
+	UInt64 instanceCounter;
+	esif_ccb_lock_t lock;	/* Taken like the handle manager's so timings are comparable */
+} RefHandleMgr, *RefHandleMgrPtr;
+
+/* Handles currently allocated from both allocators */
+typedef struct LiveHandles_s {
+	esif_handle_t *handles;
+	size_t count;
+	size_t capacity;
+} LiveHandles, *LiveHandlesPtr;
+
+static int g_failures = 0;
+static UInt64 g_randomState = 0x2545F4914F6CDD1DULL;
+
+static UInt64 TestRandom(void)
+{
+	/* xorshift64 so each run churns the same way */
+	g_randomState ^= g_randomState << 13;
+	g_randomState ^= g_randomState >> 7;
+	g_randomState ^= g_randomState << 17;
+	return g_randomState;
+}
+
+static UInt64 TestTimeNs(void)
+{
+	struct timespec now = { 0 };
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((UInt64)now.tv_sec * 1000000000) + (UInt64)now.tv_nsec;
+}
+
+static Bool RefHandleMgr_IsReservedHandle(esif_handle_t handle)
+{
+	return (handle == ESIF_HANDLE_DEFAULT) ||
+		(handle == ESIF_HANDLE_PRIMARY_PARTICIPANT) ||
+		(handle == ESIF_HANDLE_MATCH_ANY_EVENT) ||
+		(handle == ESIF_INVALID_HANDLE);
+}
+
+static Bool RefHandleMgr_Init(RefHandleMgrPtr self)
+{
+	esif_ccb_memset(self, 0, sizeof(*self));
+	self->handleMapSize = ESIF_HNDLMGR_MIN_HANDLE_LINES * ESIF_HNDLMGR_LINE_SIZE;
+	self->handleMapPtr = (UInt64 *)esif_ccb_malloc(self->handleMapSize);
+	self->numAvailableHandles = ESIF_HNDLMGR_MIN_HANDLES;
+	esif_ccb_lock_init(&self->lock);
+	return (self->handleMapPtr != NULL);
+}
+
+static void RefHandleMgr_Exit(RefHandleMgrPtr self)
+{
+	esif_ccb_free(self->handleMapPtr);
+	self->handleMapPtr = NULL;
+	esif_ccb_lock_uninit(&self->lock);
+}
+
+static eEsifError RefHandleMgr_FindHandleInRegion(
+	RefHandleMgrPtr self,
+	size_t startLineNum,
+	size_t stopLineNum,
+	UInt32 startPos,
+	UInt32 stopPos,
+	esif_handle_t *handlePtr
+	)
+{
+	esif_handle_t handle = 0;
+	UInt64 line = 0;
+	size_t lineNum = 0;
+	UInt32 pos = startPos;
+	UInt32 lastPos = 0;
+
+	for (lineNum = startLineNum; lineNum <= stopLineNum; lineNum++) {
+		line = self->handleMapPtr[lineNum];
+		lastPos = (lineNum == stopLineNum) ? stopPos : ESIF_HNDLMGR_HANDLES_PER_LINE - 1;
+
+		for (; pos <= lastPos; pos++) {
+			if (!(line & ((UInt64)1 << pos))) {
+				handle = (esif_handle_t)(size_t)((lineNum * ESIF_HNDLMGR_HANDLES_PER_LINE + pos) | (self->instanceCounter << ESIF_HNDLMGR_NUM_HANDLE_BITS));
+				if (RefHandleMgr_IsReservedHandle(handle)) {
+					continue;
+				}
+				self->handleMapPtr[lineNum] |= ((UInt64)1 << pos);
+				self->curLine = lineNum;
+				self->curPos = pos;
+				self->numAvailableHandles--;
+				*handlePtr = handle;
+				return ESIF_OK;
+			}
+		}
+		pos = 0;
+	}
+	return ESIF_E_INVALID_HANDLE;
+}
+
+static eEsifError RefHandleMgr_GetHandle(RefHandleMgrPtr self, esif_handle_t *handlePtr)
+{
+	eEsifError rc = ESIF_E_INVALID_HANDLE;
+	size_t numLines = 0;
+	UInt64 *handleMapPtr = NULL;
+
+	*handlePtr = ESIF_INVALID_HANDLE;
+	esif_ccb_write_lock(&self->lock);
+	if (!self->numAvailableHandles && (self->handleMapSize >= ESIF_HNDLMGR_MAX_HANDLE_MAP_SIZE)) {
+		goto exit;
+	}
+	if ((self->numAvailableHandles < ESIF_HNDLMGR_HANDLES_PER_LINE) && (self->handleMapSize < ESIF_HNDLMGR_MAX_HANDLE_MAP_SIZE)) {
+		handleMapPtr = esif_ccb_realloc(self->handleMapPtr, self->handleMapSize + ESIF_HNDLMGR_LINE_SIZE);
+		if (NULL == handleMapPtr) {
+			rc = ESIF_E_NO_MEMORY;
+			goto exit;
+		}
+		esif_ccb_memset((char *)handleMapPtr + self->handleMapSize, 0, ESIF_HNDLMGR_LINE_SIZE);
+		self->handleMapPtr = handleMapPtr;
+		self->handleMapSize += ESIF_HNDLMGR_LINE_SIZE;
+		self->numAvailableHandles += ESIF_HNDLMGR_HANDLES_PER_LINE;
+	}
+
+	numLines = self->handleMapSize / ESIF_HNDLMGR_LINE_SIZE;
+	if ((self->curPos != (ESIF_HNDLMGR_HANDLES_PER_LINE - 1)) || (self->curLine != (numLines - 1))) {
+		rc = RefHandleMgr_FindHandleInRegion(self, self->curLine, numLines - 1, self->curPos, ESIF_HNDLMGR_HANDLES_PER_LINE - 1, handlePtr);
+	}
+	if (rc != ESIF_OK) {
+		self->instanceCounter++;
+		rc = RefHandleMgr_FindHandleInRegion(self, 0, self->curLine, 0, self->curPos, handlePtr);
+	}
+exit:
+	esif_ccb_write_unlock(&self->lock);
+	return rc;
+}
+
+static void RefHandleMgr_PutHandle(RefHandleMgrPtr self, esif_handle_t handle)
+{
+	UInt64 handleValue = (UInt64)(size_t)handle & ESIF_HNDLMGR_HANDLE_MASK;
+	size_t lineNum = (size_t)(handleValue / ESIF_HNDLMGR_HANDLES_PER_LINE);
+	UInt32 pos = (UInt32)(handleValue % ESIF_HNDLMGR_HANDLES_PER_LINE);
+
+	if (!RefHandleMgr_IsReservedHandle(handle)) {
+		esif_ccb_write_lock(&self->lock);
+		if (lineNum < (self->handleMapSize / ESIF_HNDLMGR_LINE_SIZE)) {
+			self->handleMapPtr[lineNum] &= ~((UInt64)1 << pos);
+			self->numAvailableHandles++;
+		}
+		esif_ccb_write_unlock(&self->lock);
+	}
+}
+
+static Bool LiveHandles_Init(LiveHandlesPtr liveHandlesPtr, size_t capacity)
+{
+	liveHandlesPtr->handles = (esif_handle_t *)esif_ccb_malloc(capacity * sizeof(*liveHandlesPtr->handles));
+	liveHandlesPtr->count = 0;
+	liveHandlesPtr->capacity = capacity;
+	return (liveHandlesPtr->handles != NULL);
+}
+
+static void LiveHandles_Exit(LiveHandlesPtr liveHandlesPtr)
+{
+	esif_ccb_free(liveHandlesPtr->handles);
+	liveHandlesPtr->handles = NULL;
+}
+
+/* Allocates from both allocators; returns ESIF_FALSE if they disagree */
+static Bool TestAllocate(RefHandleMgrPtr refPtr, LiveHandlesPtr liveHandlesPtr)
+{
+	esif_handle_t handle = ESIF_INVALID_HANDLE;
+	esif_handle_t refHandle = ESIF_INVALID_HANDLE;
+	eEsifError rc = EsifHandleMgr_GetNextHandle(&handle);
+	eEsifError refRc = RefHandleMgr_GetHandle(refPtr, &refHandle);
+
+	if ((rc != refRc) || (handle != refHandle)) {
+		fprintf(stderr, "Handle mismatch after %u live: got 0x%llx (rc %d), expected 0x%llx (rc %d)\n",
+			(UInt32)liveHandlesPtr->count, (unsigned long long)handle, rc, (unsigned long long)refHandle, refRc);
+		return ESIF_FALSE;
+	}
+	if ((ESIF_OK == rc) && (liveHandlesPtr->count < liveHandlesPtr->capacity)) {
+		liveHandlesPtr->handles[liveHandlesPtr->count++] = handle;
+	}
+	return ESIF_TRUE;
+}
+
+/* Frees a random live handle to both allocators */
+static void TestFree(RefHandleMgrPtr refPtr, LiveHandlesPtr liveHandlesPtr)
+{
+	size_t index = (size_t)(TestRandom() % liveHandlesPtr->count);
+	esif_handle_t handle = liveHandlesPtr->handles[index];
+
+	liveHandlesPtr->handles[index] = liveHandlesPtr->handles[--liveHandlesPtr->count];
+	EsifHandleMgr_PutHandle(handle);
+	RefHandleMgr_PutHandle(refPtr, handle);
+}
+
+/*
+ * Grows to about targetLive handles, then randomly allocates and frees around
+ * that level for numOps operations, checking every handle against the
+ * reference, and finally frees everything.
+ */
+static void Test_Churn(size_t targetLive, UInt64 numOps)
+{
+	RefHandleMgr ref = { 0 };
+	LiveHandles liveHandles = { 0 };
+	UInt64 op = 0;
+	Bool matched = ESIF_TRUE;
+
+	TEST_CHECK(EsifHandleMgr_Init() == ESIF_OK);
+	TEST_CHECK(RefHandleMgr_Init(&ref));
+	TEST_CHECK(LiveHandles_Init(&liveHandles, ESIF_HNDLMGR_MAX_HANDLES));
+
+	while (matched && (liveHandles.count < targetLive)) {
+		matched = TestAllocate(&ref, &liveHandles);
+	}
+	for (op = 0; matched && (op < numOps); op++) {
+		if ((liveHandles.count > 0) && ((liveHandles.count >= targetLive) || (TestRandom() % 2))) {
+			TestFree(&ref, &liveHandles);
+		}
+		else {
+			matched = TestAllocate(&ref, &liveHandles);
+		}
+	}
+	TEST_CHECK(matched);
+	TEST_CHECK(ref.instanceCounter > 0);	/* The churn must have wrapped around the map */
+
+	while (liveHandles.count > 0) {
+		TestFree(&ref, &liveHandles);
+	}
+
+	LiveHandles_Exit(&liveHandles);
+	RefHandleMgr_Exit(&ref);
+	EsifHandleMgr_Exit();
+}
+
+/* Both allocators run out of handles at the same point and recover once one is freed */
+static void Test_Exhaustion(void)
+{
+	RefHandleMgr ref = { 0 };
+	LiveHandles liveHandles = { 0 };
+	esif_handle_t handle = ESIF_INVALID_HANDLE;
+	Bool matched = ESIF_TRUE;
+
+	TEST_CHECK(EsifHandleMgr_Init() == ESIF_OK);
+	TEST_CHECK(RefHandleMgr_Init(&ref));
+	TEST_CHECK(LiveHandles_Init(&liveHandles, ESIF_HNDLMGR_MAX_HANDLES));
+
+	while (matched && (liveHandles.count < ESIF_HNDLMGR_MAX_HANDLES)) {
+		size_t count = liveHandles.count;
+		matched = TestAllocate(&ref, &liveHandles);
+		if (count == liveHandles.count) {
+			break;
+		}
+	}
+	TEST_CHECK(matched);
+	TEST_CHECK(EsifHandleMgr_GetNextHandle(&handle) != ESIF_OK);
+
+	TestFree(&ref, &liveHandles);
+	TEST_CHECK(TestAllocate(&ref, &liveHandles));
+
+	while (liveHandles.count > 0) {
+		TestFree(&ref, &liveHandles);
+	}
+
+	LiveHandles_Exit(&liveHandles);
+	RefHandleMgr_Exit(&ref);
+	EsifHandleMgr_Exit();
+}
+
+/* Times the same churn with each allocator on its own */
+static void Bench_Churn(const char *name, size_t targetLive, UInt64 numOps, Bool useRef)
+{
+	RefHandleMgr ref = { 0 };
+	LiveHandles liveHandles = { 0 };
+	esif_handle_t handle = ESIF_INVALID_HANDLE;
+	UInt64 startNs = 0;
+	UInt64 op = 0;
+	size_t index = 0;
+
+	g_randomState = 0x2545F4914F6CDD1DULL;
+	EsifHandleMgr_Init();
+	RefHandleMgr_Init(&ref);
+	LiveHandles_Init(&liveHandles, ESIF_HNDLMGR_MAX_HANDLES);
+
+	startNs = TestTimeNs();
+	for (op = 0; op < numOps + targetLive; op++) {
+		if ((op >= targetLive) && ((liveHandles.count >= targetLive) || (TestRandom() % 2))) {
+			index = (size_t)(TestRandom() % liveHandles.count);
+			handle = liveHandles.handles[index];
+			liveHandles.handles[index] = liveHandles.handles[--liveHandles.count];
+			if (useRef) {
+				RefHandleMgr_PutHandle(&ref, handle);
+			}
+			else {
+				EsifHandleMgr_PutHandle(handle);
+			}
+		}
+		else if ((useRef ? RefHandleMgr_GetHandle(&ref, &handle) : EsifHandleMgr_GetNextHandle(&handle)) == ESIF_OK) {
+			liveHandles.handles[liveHandles.count++] = handle;
+		}
+	}
+	printf("%-40s %8.1f ns/op\n", name, (double)(TestTimeNs() - startNs) / (double)(numOps + targetLive));
+
+	LiveHandles_Exit(&liveHandles);
+	RefHandleMgr_Exit(&ref);
+	EsifHandleMgr_Exit();
+}
+
+int main(int argc, char *argv[])
+{
+	UInt64 numOps = TEST_DEFAULT_OPS;
+	Bool runBench = ESIF_FALSE;
+	int arg = 0;
+
+	for (arg = 1; arg < argc; arg++) {
+		if (esif_ccb_strcmp(argv[arg], "--bench") == 0) {
+			runBench = ESIF_TRUE;
+		}
+		else {
+			numOps = strtoull(argv[arg], NULL, 10);
+		}
+	}
+
+	Test_Churn(TEST_LIVE_HANDLES, numOps);
+	Test_Churn(TEST_FILL_HANDLES, numOps);
+	Test_Exhaustion();
+
+	if (runBench && !g_failures) {
+		Bench_Churn("churn, 4000 live (bit search)", TEST_LIVE_HANDLES, numOps, ESIF_TRUE);
+		Bench_Churn("churn, 4000 live (EsifHandleMgr)", TEST_LIVE_HANDLES, numOps, ESIF_FALSE);
+		Bench_Churn("churn, 60000 live (bit search)", TEST_FILL_HANDLES, numOps, ESIF_TRUE);
+		Bench_Churn("churn, 60000 live (EsifHandleMgr)", TEST_FILL_HANDLES, numOps, ESIF_FALSE);
+	}
+
+	printf("esif_uf_handlemgr_test: %s (%d failures)\n", g_failures ? "FAILED" : "PASSED", g_failures);
+	return g_failures ? 1 : 0;
+}
+
+/*****************************************************************************/
+/*****************************************************************************/
+/*****************************************************************************/
@@ -0,0 +1,272 @@
+/******************************************************************************
+** Copyright (c) 2013-2020 Intel Corporation All Rights Reserved
+**
+** Licensed under the Apache License, Version 2.0 (the "License"); you may not
+** use this file except in compliance with the License.
+**
+** You may obtain a copy of the License at
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+** WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+******************************************************************************/
+
+/*
+ * Reactor dispatch tests.  A datagram socket pair stands in for the kernel
+ * uevent (netlink) socket and eventfds stand in for IIO buffer devices, so
+ * the tests run without any thermal hardware or privileges.
+ */
+#define ESIF_TRACE_ID	ESIF_TRACEMODULE_LINUX
+
+#include "esif_uf.h"
+#include "lin/esif_uf_reactor_os_lin.h"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+
+#define TEST_WAIT_MS		2000	// Upper bound for a dispatch that is expected to happen
+#define TEST_QUIET_MS		100		// How long to wait to show that a dispatch does not happen
+#define TEST_UEVENT_MSG		"change@/devices/virtual/thermal/thermal_zone0"
+
+#define TEST_CHECK(cond) \
+	do { \
+		if (!(cond)) { \
+			fprintf(stderr, "FAIL %s:%d: %s\n", __FUNCTION__, __LINE__, #cond); \
+			g_failures++; \
+		} \
+	} while (0)
+
+typedef struct TestSource_s {
+	esif_ccb_event_t dispatched;
+	atomic_t calls;
+	UInt64 total;			// Sum of all eventfd counts read
+	char message[128];		// Last datagram received
+	Bool removeSelf;		// Remove the source from within its own callback
+} TestSource, *TestSourcePtr;
+
+static int g_failures = 0;
+
+static void TestSource_Init(TestSourcePtr sourcePtr)
+{
+	esif_ccb_memset(sourcePtr, 0, sizeof(*sourcePtr));
+	esif_ccb_event_init(&sourcePtr->dispatched);
+}
+
+static void TestSource_Uninit(TestSourcePtr sourcePtr)
+{
+	esif_ccb_event_uninit(&sourcePtr->dispatched);
+}
+
+static Bool TestSource_WaitForCall(TestSourcePtr sourcePtr, UInt32 timeoutMs)
+{
+	Bool called = (esif_ccb_event_try_wait(&sourcePtr->dispatched, timeoutMs) == ESIF_OK);
+
+	esif_ccb_event_reset(&sourcePtr->dispatched);
+	return called;
+}
+
+static void TestUeventCallback(int fd, UInt32 events, void *contextPtr)
+{
+	TestSourcePtr sourcePtr = (TestSourcePtr)contextPtr;
+	ssize_t len = 0;
+
+	if (events & EPOLLIN) {
+		len = recv(fd, sourcePtr->message, sizeof(sourcePtr->message) - 1, MSG_DONTWAIT);
+		sourcePtr->message[len > 0 ? len : 0] = 0;
+	}
+	if (sourcePtr->removeSelf) {
+		EsifReactor_RemoveSource(fd);
+	}
+	atomic_inc(&sourcePtr->calls);
+	esif_ccb_event_set(&sourcePtr->dispatched);
+}
+
+static void TestIioCallback(int fd, UInt32 events, void *contextPtr)
+{
+	TestSourcePtr sourcePtr = (TestSourcePtr)contextPtr;
+	UInt64 count = 0;
+
+	if ((events & EPOLLIN) && (read(fd, &count, sizeof(count)) == sizeof(count))) {
+		sourcePtr->total += count;
+	}
+	if (sourcePtr->removeSelf) {
+		EsifReactor_RemoveSource(fd);
+	}
+	atomic_inc(&sourcePtr->calls);
+	esif_ccb_event_set(&sourcePtr->dispatched);
+}
+
+static void TestEventFdWrite(int fd, UInt64 count)
+{
+	if (write(fd, &count, sizeof(count)) != sizeof(count)) {
+		g_failures++;
+	}
+}
+
+/* A message on the fake uevent socket is delivered to its callback with its context */
+static void Test_UeventDispatch(void)
+{
+	TestSource source;
+	int sv[2] = { -1, -1 };
+
+	TestSource_Init(&source);
+	TEST_CHECK(socketpair(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0, sv) == 0);
+	TEST_CHECK(EsifReactor_AddSource(sv[0], EPOLLIN, TestUeventCallback, &source) == ESIF_OK);
+	TEST_CHECK(EsifReactor_AddSource(sv[0], EPOLLIN, TestUeventCallback, &source) == ESIF_E_IO_ALREADY_EXISTS);
+
+	TEST_CHECK(send(sv[1], TEST_UEVENT_MSG, sizeof(TEST_UEVENT_MSG), 0) == sizeof(TEST_UEVENT_MSG));
+	TEST_CHECK(TestSource_WaitForCall(&source, TEST_WAIT_MS));
+	TEST_CHECK(esif_ccb_strcmp(source.message, TEST_UEVENT_MSG) == 0);
+
+	// Level triggered: the datagram was consumed, so there must be no further calls
+	TEST_CHECK(!TestSource_WaitForCall(&source, TEST_QUIET_MS));
+	TEST_CHECK(atomic_read(&source.calls) == 1);
+
+	EsifReactor_RemoveSource(sv[0]);
+	close(sv[0]);
+	close(sv[1]);
+	TestSource_Uninit(&source);
+}
+
+/* Several fake IIO buffers are dispatched independently */
+static void Test_IioDispatch(void)
+{
+	TestSource sources[3];
+	int fds[3] = { -1, -1, -1 };
+	int i = 0;
+
+	for (i = 0; i < 3; i++) {
+		TestSource_Init(&sources[i]);
+		fds[i] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		TEST_CHECK(fds[i] >= 0);
+		TEST_CHECK(EsifReactor_AddSource(fds[i], EPOLLIN, TestIioCallback, &sources[i]) == ESIF_OK);
+	}
+
+	for (i = 0; i < 3; i++) {
+		TestEventFdWrite(fds[i], i + 1);
+	}
+	for (i = 0; i < 3; i++) {
+		TEST_CHECK(TestSource_WaitForCall(&sources[i], TEST_WAIT_MS));
+		TEST_CHECK(sources[i].total == (UInt64)(i + 1));
+	}
+
+	// A source that is switched to output only must not be dispatched for input
+	TEST_CHECK(EsifReactor_ModifySource(fds[0], 0) == ESIF_OK);
+	TestEventFdWrite(fds[0], 1);
+	TEST_CHECK(!TestSource_WaitForCall(&sources[0], TEST_QUIET_MS));
+	TEST_CHECK(EsifReactor_ModifySource(fds[0], EPOLLIN) == ESIF_OK);
+	TEST_CHECK(TestSource_WaitForCall(&sources[0], TEST_WAIT_MS));
+	TEST_CHECK(sources[0].total == 2);
+
+	for (i = 0; i < 3; i++) {
+		EsifReactor_RemoveSource(fds[i]);
+		close(fds[i]);
+		TestSource_Uninit(&sources[i]);
+	}
+}
+
+/* A callback may remove its own source and is not called again */
+static void Test_RemoveFromCallback(void)
+{
+	TestSource source;
+	int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+	TestSource_Init(&source);
+	source.removeSelf = ESIF_TRUE;
+	TEST_CHECK(EsifReactor_AddSource(fd, EPOLLIN, TestIioCallback, &source) == ESIF_OK);
+
+	TestEventFdWrite(fd, 1);
+	TEST_CHECK(TestSource_WaitForCall(&source, TEST_WAIT_MS));
+	TestEventFdWrite(fd, 1);
+	TEST_CHECK(!TestSource_WaitForCall(&source, TEST_QUIET_MS));
+	TEST_CHECK(atomic_read(&source.calls) == 1);
+	TEST_CHECK(EsifReactor_ModifySource(fd, EPOLLIN) == ESIF_E_NOT_FOUND);
+
+	close(fd);
+	TestSource_Uninit(&source);
+}
+
+/* Once RemoveSource returns, pending input is no longer dispatched and the fd may be reused */
+static void Test_RemoveSource(void)
+{
+	TestSource source;
+	TestSource reused;
+	int sv[2] = { -1, -1 };
+
+	TestSource_Init(&source);
+	TestSource_Init(&reused);
+	TEST_CHECK(socketpair(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0, sv) == 0);
+	TEST_CHECK(EsifReactor_AddSource(sv[0], EPOLLIN, TestUeventCallback, &source) == ESIF_OK);
+
+	EsifReactor_RemoveSource(sv[0]);
+	TEST_CHECK(send(sv[1], TEST_UEVENT_MSG, sizeof(TEST_UEVENT_MSG), 0) == sizeof(TEST_UEVENT_MSG));
+	TEST_CHECK(!TestSource_WaitForCall(&source, TEST_QUIET_MS));
+	TEST_CHECK(atomic_read(&source.calls) == 0);
+
+	// The pending datagram is delivered to the new owner of the fd, not the old one
+	TEST_CHECK(EsifReactor_AddSource(sv[0], EPOLLIN, TestUeventCallback, &reused) == ESIF_OK);
+	TEST_CHECK(TestSource_WaitForCall(&reused, TEST_WAIT_MS));
+	TEST_CHECK(esif_ccb_strcmp(reused.message, TEST_UEVENT_MSG) == 0);
+	TEST_CHECK(atomic_read(&source.calls) == 0);
+
+	EsifReactor_RemoveSource(sv[0]);
+	close(sv[0]);
+	close(sv[1]);
+	TestSource_Uninit(&reused);
+	TestSource_Uninit(&source);
+}
+
+/* The source table is bounded and slots are released on removal */
+static void Test_Capacity(void)
+{
+	int fds[ESIF_REACTOR_MAX_SOURCES + 1];
+	TestSource source;
+	int i = 0;
+
+	TestSource_Init(&source);
+	for (i = 0; i < ESIF_REACTOR_MAX_SOURCES; i++) {
+		fds[i] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		TEST_CHECK(EsifReactor_AddSource(fds[i], EPOLLIN, TestIioCallback, &source) == ESIF_OK);
+	}
+	fds[i] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	TEST_CHECK(EsifReactor_AddSource(fds[i], EPOLLIN, TestIioCallback, &source) == ESIF_E_MAXIMUM_CAPACITY_REACHED);
+
+	EsifReactor_RemoveSource(fds[0]);
+	TEST_CHECK(EsifReactor_AddSource(fds[i], EPOLLIN, TestIioCallback, &source) == ESIF_OK);
+	EsifReactor_RemoveSource(fds[i]);
+
+	for (i = 0; i <= ESIF_REACTOR_MAX_SOURCES; i++) {
+		EsifReactor_RemoveSource(fds[i]);
+		close(fds[i]);
+	}
+	TEST_CHECK(atomic_read(&source.calls) == 0);
+	TestSource_Uninit(&source);
+}
+
+int main(void)
+{
+	TEST_CHECK(EsifReactor_AddSource(0, EPOLLIN, TestIioCallback, NULL) == ESIF_E_NOT_INITIALIZED);
+	TEST_CHECK(EsifReactor_Init() == ESIF_OK);
+
+	Test_UeventDispatch();
+	Test_IioDispatch();
+	Test_RemoveFromCallback();
+	Test_RemoveSource();
+	Test_Capacity();
+
+	EsifReactor_Exit();
+	TEST_CHECK(EsifReactor_AddSource(0, EPOLLIN, TestIioCallback, NULL) == ESIF_E_NOT_INITIALIZED);
+
+	printf("esif_uf_reactor_test: %s (%d failures)\n", g_failures ? "FAILED" : "PASSED", g_failures);
+	return g_failures ? 1 : 0;
+}
+
+/*****************************************************************************/
+/*****************************************************************************/
+/*****************************************************************************/
@@ -0,0 +1,245 @@
+/******************************************************************************
+** Copyright (c) 2013-2020 Intel Corporation All Rights Reserved
+**
+** Licensed under the Apache License, Version 2.0 (the "License"); you may not
+** use this file except in compliance with the License.
+**
+** You may obtain a copy of the License at
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+** WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+******************************************************************************/
+
+/*
+ * Sysfs file descriptor cache tests.  A temporary directory stands in for
+ * /sys with device directories under devices/ and class/ symlinks to them,
+ * the way attributes are normally read.  A cached descriptor keeps reading
+ * the file it opened, so replacing a file shows whether its descriptor is
+ * still cached.
+ */
+#define ESIF_TRACE_ID	ESIF_TRACEMODULE_LINUX
+
+#include "esif_uf.h"
+#include "lin/esif_uf_sysfs_fd_cache_os_lin.h"
+#include "lin/esif_uf_sysfs_os_lin.h"
+
+#include <sys/stat.h>
+
+#define TEST_DEVICE_DIR		"devices/virtual/thermal"
+#define TEST_CLASS_DIR		"class/thermal"
+
+#define TEST_CHECK(cond) \
+	do { \
+		if (!(cond)) { \
+			fprintf(stderr, "FAIL %s:%d: %s\n", __FUNCTION__, __LINE__, #cond); \
+			g_failures++; \
+		} \
+	} while (0)
+
+static int g_failures = 0;
+static char g_root[MAX_SYSFS_PATH] = { 0 };
+
+static void TestWriteFile(char *path, const char *contents)
+{
+	FILE *fp = esif_ccb_fopen(path, "w", NULL);
+
+	TEST_CHECK(fp != NULL);
+	if (fp != NULL) {
+		fputs(contents, fp);
+		esif_ccb_fclose(fp);
+	}
+}
+
+/* Replaces the file instead of rewriting it so a descriptor still open on it keeps the old contents */
+static void TestReplaceFile(char *path, const char *contents)
+{
+	TEST_CHECK(unlink(path) == 0);
+	TestWriteFile(path, contents);
+}
+
+/* Creates devices/virtual/thermal/<zone>/temp and the class/thermal/<zone> symlink to its directory */
+static void TestCreateZone(const char *zone, const char *temp)
+{
+	char path[MAX_SYSFS_PATH] = { 0 };
+	char target[MAX_SYSFS_PATH] = { 0 };
+
+	esif_ccb_sprintf(sizeof(path), path, "%s/%s/%s", g_root, TEST_DEVICE_DIR, zone);
+	TEST_CHECK(mkdir(path, 0755) == 0);
+	esif_ccb_sprintf(sizeof(path), path, "%s/%s/%s/temp", g_root, TEST_DEVICE_DIR, zone);
+	TestWriteFile(path, temp);
+
+	esif_ccb_sprintf(sizeof(target), target, "../../%s/%s", TEST_DEVICE_DIR, zone);
+	esif_ccb_sprintf(sizeof(path), path, "%s/%s/%s", g_root, TEST_CLASS_DIR, zone);
+	TEST_CHECK(symlink(target, path) == 0);
+}
+
+static void TestRemoveZone(const char *zone)
+{
+	char path[MAX_SYSFS_PATH] = { 0 };
+
+	esif_ccb_sprintf(sizeof(path), path, "%s/%s/%s", g_root, TEST_CLASS_DIR, zone);
+	unlink(path);
+	esif_ccb_sprintf(sizeof(path), path, "%s/%s/%s/temp", g_root, TEST_DEVICE_DIR, zone);
+	unlink(path);
+	esif_ccb_sprintf(sizeof(path), path, "%s/%s/%s", g_root, TEST_DEVICE_DIR, zone);
+	rmdir(path);
+}
+
+static void TestDevicePath(char *path, size_t pathLen, const char *zone)
+{
+	esif_ccb_sprintf(pathLen, path, "%s/%s/%s/temp", g_root, TEST_DEVICE_DIR, zone);
+}
+
+static void TestClassPath(char *path, size_t pathLen, const char *zone)
+{
+	esif_ccb_sprintf(pathLen, path, "%s/%s/%s/temp", g_root, TEST_CLASS_DIR, zone);
+}
+
+/* Sends a uevent the way the kernel formats it: "<action>@<devpath>" followed by NUL separated variables */
+static void TestSendUevent(const char *action, const char *zone)
+{
+	char buffer[MAX_SYSFS_PATH] = { 0 };
+	int len = 0;
+
+	len = esif_ccb_sprintf(sizeof(buffer), buffer, "%s@/%s/%s", action, TEST_DEVICE_DIR, zone) + 1;
+	len += esif_ccb_sprintf(sizeof(buffer) - len, buffer + len, "ACTION=%s", action) + 1;
+	EsifSysfsFdCache_ProcessUevent(buffer, len);
+}
+
+static Bool TestReadEquals(const char *path, const char *expected)
+{
+	char buf[MAX_SYSFS_PATH] = { 0 };
+
+	return (EsifSysfsFdCache_Read(path, buf, sizeof(buf)) >= 0) && (esif_ccb_strcmp(buf, expected) == 0);
+}
+
+/* A file read through a class symlink is cached and keeps being read from its open descriptor */
+static void Test_ReadIsCached(void)
+{
+	char classPath[MAX_SYSFS_PATH] = { 0 };
+	char devicePath[MAX_SYSFS_PATH] = { 0 };
+
+	TestCreateZone("thermal_zone0", "40000");
+	TestClassPath(classPath, sizeof(classPath), "thermal_zone0");
+	TestDevicePath(devicePath, sizeof(devicePath), "thermal_zone0");
+
+	TEST_CHECK(TestReadEquals(classPath, "40000"));
+	TestReplaceFile(devicePath, "41000");
+	TEST_CHECK(TestReadEquals(classPath, "40000"));
+	TEST_CHECK(TestReadEquals(devicePath, "41000"));
+
+	TestRemoveZone("thermal_zone0");
+}
+
+/* A remove event for a device closes descriptors cached through its class symlink */
+static void Test_RemoveByDevpath(void)
+{
+	char classPath[MAX_SYSFS_PATH] = { 0 };
+	char devicePath[MAX_SYSFS_PATH] = { 0 };
+
+	TestCreateZone("thermal_zone1", "50000");
+	TestClassPath(classPath, sizeof(classPath), "thermal_zone1");
+	TestDevicePath(devicePath, sizeof(devicePath), "thermal_zone1");
+
+	TEST_CHECK(TestReadEquals(classPath, "50000"));
+	TestReplaceFile(devicePath, "51000");
+
+	// Events other than remove leave the descriptor cached
+	TestSendUevent("change", "thermal_zone1");
+	TEST_CHECK(TestReadEquals(classPath, "50000"));
+
+	TestSendUevent("remove", "thermal_zone1");
+	TEST_CHECK(TestReadEquals(classPath, "51000"));
+
+	TestRemoveZone("thermal_zone1");
+}
+
+/* A remove event only matches whole path components, so thermal_zone2 does not remove thermal_zone20 */
+static void Test_RemoveMatchesWholeDevice(void)
+{
+	char classPath[MAX_SYSFS_PATH] = { 0 };
+	char devicePath[MAX_SYSFS_PATH] = { 0 };
+
+	TestCreateZone("thermal_zone2", "60000");
+	TestCreateZone("thermal_zone20", "70000");
+	TestClassPath(classPath, sizeof(classPath), "thermal_zone20");
+	TestDevicePath(devicePath, sizeof(devicePath), "thermal_zone20");
+
+	TEST_CHECK(TestReadEquals(classPath, "70000"));
+	TestReplaceFile(devicePath, "71000");
+
+	TestSendUevent("remove", "thermal_zone2");
+	TEST_CHECK(TestReadEquals(classPath, "70000"));
+
+	TestRemoveZone("thermal_zone20");
+	TestRemoveZone("thermal_zone2");
+}
+
+/* A file that cannot be opened is reported and not cached */
+static void Test_MissingFile(void)
+{
+	char classPath[MAX_SYSFS_PATH] = { 0 };
+	char buf[MAX_SYSFS_PATH] = { 0 };
+
+	TestClassPath(classPath, sizeof(classPath), "thermal_zone3");
+	TEST_CHECK(EsifSysfsFdCache_Read(classPath, buf, sizeof(buf)) < 0);
+
+	TestCreateZone("thermal_zone3", "80000");
+	TEST_CHECK(TestReadEquals(classPath, "80000"));
+	TestRemoveZone("thermal_zone3");
+}
+
+int main(void)
+{
+	char path[MAX_SYSFS_PATH] = { 0 };
+
+	esif_ccb_sprintf(sizeof(g_root), g_root, "%s", "/tmp/esif_sysfs_fd_cache_test.XXXXXX");
+	if (mkdtemp(g_root) == NULL) {
+		fprintf(stderr, "Unable to create %s\n", g_root);
+		return 1;
+	}
+	esif_ccb_sprintf(sizeof(path), path, "%s/devices", g_root);
+	mkdir(path, 0755);
+	esif_ccb_sprintf(sizeof(path), path, "%s/devices/virtual", g_root);
+	mkdir(path, 0755);
+	esif_ccb_sprintf(sizeof(path), path, "%s/%s", g_root, TEST_DEVICE_DIR);
+	mkdir(path, 0755);
+	esif_ccb_sprintf(sizeof(path), path, "%s/class", g_root);
+	mkdir(path, 0755);
+	esif_ccb_sprintf(sizeof(path), path, "%s/%s", g_root, TEST_CLASS_DIR);
+	mkdir(path, 0755);
+
+	EsifSysfsFdCache_Init(g_root);
+
+	Test_ReadIsCached();
+	Test_RemoveByDevpath();
+	Test_RemoveMatchesWholeDevice();
+	Test_MissingFile();
+
+	EsifSysfsFdCache_Exit();
+
+	esif_ccb_sprintf(sizeof(path), path, "%s/%s", g_root, TEST_CLASS_DIR);
+	rmdir(path);
+	esif_ccb_sprintf(sizeof(path), path, "%s/class", g_root);
+	rmdir(path);
+	esif_ccb_sprintf(sizeof(path), path, "%s/%s", g_root, TEST_DEVICE_DIR);
+	rmdir(path);
+	esif_ccb_sprintf(sizeof(path), path, "%s/devices/virtual", g_root);
+	rmdir(path);
+	esif_ccb_sprintf(sizeof(path), path, "%s/devices", g_root);
+	rmdir(path);
+	rmdir(g_root);
+
+	printf("esif_uf_sysfs_fd_cache_test: %s (%d failures)\n", g_failures ? "FAILED" : "PASSED", g_failures);
+	return g_failures ? 1 : 0;
+}
+
+/*****************************************************************************/
+/*****************************************************************************/
+/*****************************************************************************/
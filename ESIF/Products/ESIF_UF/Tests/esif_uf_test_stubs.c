@@ -0,0 +1,61 @@
+/******************************************************************************
+** Copyright (c) 2013-2020 Intel Corporation All Rights Reserved
+**
+** Licensed under the Apache License, Version 2.0 (the "License"); you may not
+** use this file except in compliance with the License.
+**
+** You may obtain a copy of the License at
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+** WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+******************************************************************************/
+
+/*
+ * Minimal trace support so individual upper framework modules can be linked
+ * into standalone test programs without pulling in esif_uf_trace.c and the
+ * rest of the daemon.  Only FATAL and ERROR messages are printed.
+ */
+#include "esif_uf.h"
+
+#include <stdarg.h>
+
+int g_traceLevel = ESIF_TRACELEVEL_ERROR;
+
+struct esif_tracelevel_s g_traceinfo[] = {
+	{"FATAL",	ESIF_TRACELEVEL_FATAL,	ESIF_TRACEMASK_ALL,		ESIF_TRACEROUTE_CONSOLE},
+	{"ERROR",	ESIF_TRACELEVEL_ERROR,	ESIF_TRACEMASK_ALL,		ESIF_TRACEROUTE_CONSOLE},
+	{"WARNING",	ESIF_TRACELEVEL_WARN,	ESIF_TRACEMASK_ALL,		ESIF_TRACEROUTE_CONSOLE},
+	{"INFO",	ESIF_TRACELEVEL_INFO,	ESIF_TRACEMASK_ALL,		ESIF_TRACEROUTE_CONSOLE},
+	{"DEBUG",	ESIF_TRACELEVEL_DEBUG,	ESIF_TRACEMASK_ALL,		ESIF_TRACEROUTE_CONSOLE},
+};
+
+int EsifUfTraceMessage(
+	esif_tracemask_t module,
+	int level,
+	const char *func,
+	const char *file,
+	int line,
+	const char *msg,
+	...)
+{
+	int rc = 0;
+	va_list args;
+
+	UNREFERENCED_PARAMETER(module);
+
+	fprintf(stderr, "%s:%s@%s#%d: ", g_traceinfo[level].label, func, file, line);
+	va_start(args, msg);
+	rc = vfprintf(stderr, msg, args);
+	va_end(args);
+	return rc;
+}
+
+/*****************************************************************************/
+/*****************************************************************************/
+/*****************************************************************************/